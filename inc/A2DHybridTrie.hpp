@@ -0,0 +1,388 @@
+/*
+ * File:   A2DHybridTrie.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:15 PM
+ */
+
+#ifndef A2DHYBRIDTRIE_HPP
+#define	A2DHYBRIDTRIE_HPP
+
+#include <string>       // std::string
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+
+#include "LayeredTrieBase.hpp"
+
+#include "AWordIndex.hpp"
+#include "HashingWordIndex.hpp"
+#include "ModelMGram.hpp"
+#include "ByteMGramId.hpp"
+
+#include "ArrayUtils.hpp"
+#include "FixedSizeHashMap.hpp"
+
+#include "C2WArrayTrie.hpp"
+#include "G2DMapTrie.hpp"
+
+using namespace std;
+using namespace uva::utils::containers;
+using namespace uva::smt::tries::dictionary;
+using namespace uva::smt::tries::m_grams;
+using namespace uva::smt::utils::array;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            /**
+             * This is the Auto to Data hybrid trie. The uni-grams are stored in a dense
+             * array indexed by the word ids. For each of the higher levels the trie picks
+             * one of the two representations, based on the m-gram counts from pre_allocate:
+             *
+             * 1. A sorted array, C2WArrayMGramLevel or C2WArrayNGramLevel as in C2WArrayTrie:
+             *    the m-grams are stored per context, sorted by the word id, the array indexes
+             *    are the next level context ids. This is compact but the lookup is a binary
+             *    search. These levels support the pre-sorted build mode, see set_presorted,
+             *    and the build memory limit, see set_build_mem_limit.
+             * 2. A gram-id hash map, G2DMapLevel as in G2DMapTrie: the m-grams are stored
+             *    under their byte m-gram ids. This takes more memory but the lookup is done
+             *    in constant time and needs no context id.
+             *
+             * For both of the representations the memory in bits per m-gram and the number
+             * of cache missing memory accesses per lookup are estimated from the m-gram
+             * counts. The level gets the representation that exceeds its worst target,
+             * see __A2DHybridTrie, the least. The sorted
+             * array levels need the context ids of the previous level, therefore once a
+             * level is stored in a hash map all the higher levels are stored in hash maps.
+             *
+             * WARNING: This trie assumes that the M-grams (1 <= M < N) are added
+             * to the Trie in an ordered way and there are no duplicates in the
+             * 1-Grams. The order is assumed to be lexicographical as in the ARPA
+             * files! This is also checked if the sanity checks are on see Globals.hpp!
+             *
+             * @param MAX_LEVEL the maximum number of levels in the trie.
+             */
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            class A2DHybridTrie : public LayeredTrieBase<A2DHybridTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __A2DHybridTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> {
+            public:
+                typedef LayeredTrieBase<A2DHybridTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __A2DHybridTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> BASE;
+                typedef typename WordIndexType::TWordIdType TWordIdType;
+
+                /**
+                 * The basic constructor
+                 * @param word_index the word index (dictionary) container
+                 */
+                explicit A2DHybridTrie(WordIndexType & word_index);
+
+                /**
+                 * Allows to log the information about the instantiated trie type
+                 */
+                inline void log_trie_type_usage_info() const {
+                    LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
+                    LOG_INFO << "Using the #buckets factor: "
+                            << SSTR(__A2DHybridTrie::BUCKETS_FACTOR) << END_LOG;
+                }
+
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    breakdown.add("A2DHybridTrie", "payloads", M_GRAM_LEVEL_1, m_one_gram_arr_size * sizeof (T_M_Gram_Payload));
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                        if (is_array_level(idx + BASE::MGRAM_IDX_OFFSET)) {
+                            m_m_gram_arrays[idx].memory_breakdown("A2DHybridTrie", breakdown);
+                        } else {
+                            m_m_gram_maps[idx].memory_breakdown("A2DHybridTrie", breakdown);
+                        }
+                    }
+                    if (is_array_level(MAX_LEVEL)) {
+                        m_n_gram_array.memory_breakdown("A2DHybridTrie", breakdown);
+                    } else {
+                        m_n_gram_map.memory_breakdown("A2DHybridTrie", breakdown);
+                    }
+                }
+
+                /**
+                 * Allows to check if the given m-gram level is stored in a sorted array
+                 * @param curr_level the m-gram level, must be > 1
+                 * @return true if the level is stored in a sorted array, false if it is stored in a hash map
+                 */
+                inline bool is_array_level(const TModelLevel curr_level) const {
+                    return (curr_level < m_first_map_level);
+                }
+
+                /**
+                 * Computes the M-Gram context using the previous context and the current word id
+                 * Must only be called for the sorted array levels 1 < M < N.
+                 * @see LayeredTrieBese
+                 */
+                inline bool get_ctx_id(const TModelLevel level_idx, const TShortId word_id, TLongId & ctx_id) const {
+                    //Perform sanity checks if needed
+                    ASSERT_SANITY_THROW(!is_array_level(level_idx + BASE::MGRAM_IDX_OFFSET),
+                            string("The level: ") + std::to_string(level_idx + BASE::MGRAM_IDX_OFFSET) + string(" is not stored in an array!"));
+
+                    LOG_DEBUG2 << "Searching for the next ctx_id of " << SSTR(level_idx + BASE::MGRAM_IDX_OFFSET)
+                            << "-gram with word_id: " << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
+
+                    if (m_m_gram_arrays[level_idx].get_ctx_id(word_id, ctx_id)) {
+                        LOG_DEBUG2 << "The next ctx_id for word_id: " << SSTR(word_id) << ", is: " << SSTR(ctx_id) << END_LOG;
+                        return true;
+                    }
+                    return false;
+                }
+
+                /**
+                 * This method can be used to provide the N-gram count information
+                 * That should allow for pre-allocation of the memory. The per level
+                 * representations are chosen here.
+                 * @see LayeredTrieBase
+                 */
+                virtual void pre_allocate(const size_t counts[MAX_LEVEL]);
+
+                /**
+                 * This method allows to check if post processing should be called after
+                 * all the X level grams are read. This method is virtual.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel level>
+                bool is_post_grams() const {
+                    //The sorted array levels are to be sorted after reading
+                    return (level > M_GRAM_LEVEL_1) || BASE::template is_post_grams<level>();
+                };
+
+                /**
+                 * This method should be called after all the X level grams are read.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void post_grams() {
+                    //Call the base class method first
+                    if (BASE::template is_post_grams<CURR_LEVEL>()) {
+                        BASE::template post_grams<CURR_LEVEL>();
+                    }
+
+                    //The sorted array levels are to be sorted, the hash map levels
+                    //are to free the reserved but unused id arena memory
+                    if (CURR_LEVEL == MAX_LEVEL) {
+                        if (is_array_level(CURR_LEVEL)) {
+                            m_n_gram_array.post_n_grams();
+                        } else {
+                            m_n_gram_map.post_m_grams();
+                        }
+                    } else {
+                        if (CURR_LEVEL > M_GRAM_LEVEL_1) {
+                            if (is_array_level(CURR_LEVEL)) {
+                                m_m_gram_arrays[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].post_m_grams();
+                            } else {
+                                m_m_gram_maps[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].post_m_grams();
+                            }
+                        }
+                    }
+                };
+
+                /**
+                 * This method adds a M-Gram (word) to the trie
+                 * @see GenericTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
+                    const TShortId word_id = gram.get_end_word_id();
+                    if (CURR_LEVEL == M_GRAM_LEVEL_1) {
+                        //Store the payload
+                        m_1_gram_data[word_id] = gram.m_payload;
+                    } else {
+                        //Register the m-gram in the hash cache
+                        this->register_m_gram_cache(gram);
+
+                        if (is_array_level(CURR_LEVEL)) {
+                            //Obtain the m-gram context id
+                            TLongId ctx_id = WordIndexType::UNKNOWN_WORD_ID;
+                            __LayeredTrieBase::get_context_id<A2DHybridTrie<MAX_LEVEL, WordIndexType>, CURR_LEVEL, DebugLevelsEnum::DEBUG2>(*this, gram, ctx_id);
+
+                            if (CURR_LEVEL == MAX_LEVEL) {
+                                m_n_gram_array.add_n_gram(ctx_id, word_id, gram.m_payload.m_prob);
+                            } else {
+                                m_m_gram_arrays[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].add_m_gram(ctx_id, word_id, gram.m_payload);
+                            }
+                        } else {
+                            if (CURR_LEVEL == MAX_LEVEL) {
+                                m_n_gram_map.template add_m_gram<CURR_LEVEL>(gram, gram.m_payload.m_prob);
+                            } else {
+                                m_m_gram_maps[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].template add_m_gram<CURR_LEVEL>(gram, gram.m_payload);
+                            }
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==1.
+                 * The retrieval of a uni-gram data is always a success
+                 * @see GenericTrieBase
+                 */
+                inline void get_unigram_payload(typename BASE::T_Query_Exec_Data & query) const {
+                    //Get the word index for convenience
+                    const TModelLevel & word_idx = query.m_begin_word_idx;
+
+                    LOG_DEBUG << "Getting the payload for sub-uni-gram : [" << SSTR(word_idx)
+                            << "," << SSTR(word_idx) << "]" << END_LOG;
+
+                    //The data is always present.
+                    query.m_payloads[word_idx][word_idx] = &m_1_gram_data[query.m_gram[word_idx]];
+                };
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for 1<m<n
+                 * @see GenericTrieBase
+                 */
+                inline void get_m_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    //Get the current level of the sub-m-gram
+                    const TModelLevel & curr_level = CURR_LEVEL_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+                    const TModelLevel & level_idx = CURR_LEVEL_MIN_2_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+
+                    LOG_DEBUG << "Getting the payload for sub-" << SSTR(curr_level) << "-gram : [" << SSTR(query.m_begin_word_idx)
+                            << ", " << SSTR(query.m_end_word_idx) << "]" << END_LOG;
+
+                    if (is_array_level(curr_level)) {
+                        //First ensure the context of the given sub-m-gram
+                        LAYERED_BASE_ENSURE_CONTEXT(query, status);
+
+                        //If the context is successfully ensured, then move on to the m-gram and try to obtain its payload
+                        if (status == MGramStatusEnum::GOOD_PRESENT_MGS) {
+                            //Store the shorthand for the context and end word id
+                            TLongId & ctx_id = query.m_last_ctx_ids[query.m_begin_word_idx];
+                            const TShortId & word_id = query.m_gram[query.m_end_word_idx];
+
+                            //Get the next context id, it is the index of the m-gram data
+                            if (get_ctx_id(level_idx, word_id, ctx_id)) {
+                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_m_gram_arrays[level_idx].get_payload(ctx_id);
+                                LOG_DEBUG << "The payload is retrieved: " << (string) m_m_gram_arrays[level_idx].get_payload(ctx_id) << END_LOG;
+                            } else {
+                                LOG_DEBUG1 << "Unable to find m-gram data for ctx_id: " << SSTR(ctx_id)
+                                        << ", word_id: " << SSTR(word_id) << END_LOG;
+                                status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                            }
+                        }
+                    } else {
+                        status = m_m_gram_maps[level_idx].get_payload(query);
+                    }
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==n
+                 * @see GenericTrieBase
+                 */
+                inline void get_n_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    LOG_DEBUG << "Searching in " << SSTR(MAX_LEVEL) << "-grams" << END_LOG;
+
+                    if (is_array_level(MAX_LEVEL)) {
+                        //First ensure the context of the given sub-m-gram
+                        LAYERED_BASE_ENSURE_CONTEXT(query, status);
+
+                        //If the context is successfully ensured, then move on to the m-gram and try to obtain its payload
+                        if (status == MGramStatusEnum::GOOD_PRESENT_MGS) {
+                            //Store the shorthand for the context and end word id
+                            const TLongId & ctx_id = query.m_last_ctx_ids[query.m_begin_word_idx];
+                            const TShortId & word_id = query.m_gram[query.m_end_word_idx];
+
+                            //Search for the payload by the context and word ids
+                            const TLogProbBackOff * payload = m_n_gram_array.get_payload(ctx_id, word_id);
+                            if (payload != NULL) {
+                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = payload;
+                                LOG_DEBUG << "The payload is retrieved: " << *payload << END_LOG;
+                            } else {
+                                LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: " << SSTR(ctx_id)
+                                        << ", word_id: " << SSTR(word_id) << END_LOG;
+                                status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                            }
+                        }
+                    } else {
+                        status = m_n_gram_map.get_payload(query);
+                    }
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                virtual ~A2DHybridTrie();
+
+            protected:
+
+                typedef __C2WArrayTrie::TSubArrReference TSubArrReference;
+                typedef __C2WArrayTrie::TWordIdPBData TWordIdPBEntry;
+                typedef __C2WArrayTrie::TCtxIdProbData TCtxIdProbEntry;
+
+                typedef __G2DMapTrie::G2DMapLevel<T_M_Gram_Payload, TWordIdType, MAX_LEVEL> TProbBackLevel;
+                typedef __G2DMapTrie::G2DMapLevel<TLogProbBackOff, TWordIdType, MAX_LEVEL> TProbLevel;
+
+                /**
+                 * Allows to estimate the memory needed for an m-gram level stored in a sorted array
+                 * @param curr_level the m-gram level, must be > 1
+                 * @param counts the m-gram counts per level
+                 * @return the estimated number of bits per m-gram
+                 */
+                double get_array_bits_per_m_gram(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const;
+
+                /**
+                 * Allows to estimate the lookup cost for an m-gram level stored in a sorted array
+                 * @param curr_level the m-gram level, must be > 1
+                 * @param counts the m-gram counts per level
+                 * @return the estimated number of cache missing memory accesses per lookup
+                 */
+                double get_array_misses_per_lookup(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const;
+
+                /**
+                 * Allows to estimate the memory needed for an m-gram level stored in a hash map
+                 * @param curr_level the m-gram level, must be > 1
+                 * @param counts the m-gram counts per level
+                 * @return the estimated number of bits per m-gram
+                 */
+                double get_map_bits_per_m_gram(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const;
+
+            private:
+
+                //Stores the first m-gram level stored in a hash map, MAX_LEVEL + 1 if there is none
+                TModelLevel m_first_map_level;
+
+                //Stores the 1-gram data
+                T_M_Gram_Payload * m_1_gram_data;
+                //Stores the size of the One-gram
+                TShortId m_one_gram_arr_size;
+
+                //Stores the sorted array M-gram levels: 1 < M < N
+                __C2WArrayTrie::C2WArrayMGramLevel<BASE> m_m_gram_arrays[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the sorted array N-gram level
+                __C2WArrayTrie::C2WArrayNGramLevel<BASE> m_n_gram_array;
+
+                //Stores the hash map M-gram levels: 1 < M < N
+                TProbBackLevel m_m_gram_maps[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the hash map N-gram level
+                TProbLevel m_n_gram_map;
+            };
+        }
+    }
+}
+
+#endif	/* A2DHYBRIDTRIE_HPP */
@@ -39,6 +39,9 @@ namespace uva {
     namespace smt {
         namespace file {
 
+            //The value of the undefined file descriptor
+            static const int UNDEFINED_FILE_DESCRIPTOR = -1;
+
             /**
              * This is an abstract base class for the file readers
              * we are going to be using to read model files
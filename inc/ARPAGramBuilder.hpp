@@ -26,17 +26,20 @@
 #ifndef NGRAMBUILDER_HPP
 #define	NGRAMBUILDER_HPP
 
-#include <regex>      // std::regex, std::regex_match
-#include <functional> // std::function 
+#include <string>    // std::string
 
 #include "Globals.hpp"
+#include "Logger.hpp"
+#include "StringUtils.hpp"
 #include "Exceptions.hpp"
-#include "MemoryMappedFileReader.hpp"
+#include "TextPieceReader.hpp"
 
 #include "ModelMGram.hpp"
 
 using namespace std;
+using namespace uva::smt::logging;
 using namespace uva::smt::file;
+using namespace uva::smt::utils::text;
 using namespace uva::smt::tries::m_grams;
 
 namespace uva {
@@ -44,27 +47,33 @@ namespace uva {
         namespace tries {
             namespace arpa {
 
-                template<typename WordIndexType> struct TAddGramFunct {
-                    typedef std::function<void (const T_Model_M_Gram<WordIndexType>&) > func;
-                };
-
                 /**
-                 * This class is responsible for splitting a piece of text in a number of ngrams and place it into the trie
+                 * This class is responsible for splitting a piece of text in a number of ngrams and place it into the trie.
+                 * The builder is specialized for the trie type and the m-gram level, the parsed m-grams are added
+                 * by calling the trie's add_m_gram<CURR_LEVEL> method directly, so that the call can be inlined.
+                 * @param TrieType the type of the trie to add the m-grams to
+                 * @param CURR_LEVEL the level of the m-grams to be processed
                  */
-                template<typename WordIndexType, TModelLevel CURR_LEVEL>
+                template<typename TrieType, TModelLevel CURR_LEVEL>
                 class ARPAGramBuilder {
                 public:
+                    typedef typename TrieType::WordIndexType WordIndexType;
+
+                    //Make sure that the builder is only instantiated for the proper levels
+                    static_assert((CURR_LEVEL >= M_GRAM_LEVEL_1) && (CURR_LEVEL <= TrieType::MAX_LEVEL),
+                            "The m-gram builder level must be within [1, MAX_LEVEL]!");
 
                     /**
                      * The constructor to be used in order to instantiate a N-Gram builder
-                     * @param word_index the word index to be used
-                     * @param level the level of the N-grams to be processed
-                     * @param addGarmFunc the strategy for adding the N-grams
+                     * @param trie the trie to add the N-grams to
                      */
-                    ARPAGramBuilder(WordIndexType & word_index, typename TAddGramFunct<WordIndexType>::func addGarmFunc);
+                    ARPAGramBuilder(TrieType & trie)
+                    : m_trie(trie), m_token(), m_m_gram(trie.get_word_index(), CURR_LEVEL) {
+                        LOG_DEBUG2 << "Constructing ARPANGramBuilder(" << CURR_LEVEL << ", trie)" << END_LOG;
+                    }
 
                     /**
-                     * This pure virtual method is supposed to parse the N-Gram
+                     * This method is supposed to parse the N-Gram
                      * string from the ARPA file format of a Back-Off language
                      * model and then add the obtained data to the Trie.
                      * This method has a default implementation that should work
@@ -74,7 +83,81 @@ namespace uva {
                      * @result returns true if the provided line is NOT recognized
                      *         as the N-Gram of the specified level.
                      */
-                    bool parse_line(TextPieceReader & data);
+                    inline bool parse_line(TextPieceReader & line) {
+                        LOG_DEBUG << "Processing the " << CURR_LEVEL << "-Gram (?) line: '" << line << "'" << END_LOG;
+                        //We expect a good input, so the result is set to false by default.
+                        bool result = false;
+
+                        //First tokenize as a pattern "prob \t gram \t back-off"
+                        if (parse_to_gram(line)) {
+                            //Prepare the N-gram and for being added to the trie
+                            m_m_gram.prepare_for_adding();
+
+                            LOG_DEBUG << "Adding a " << SSTR(CURR_LEVEL) << "-Gram "
+                                    << (string) m_m_gram << " to the Trie" << END_LOG;
+
+                            //Add the obtained N-gram data to the Trie
+                            m_trie.template add_m_gram<CURR_LEVEL>(m_m_gram);
+                        } else {
+                            //If we could not parse the line to gram then it should
+                            //be the beginning of the next m-gram section
+                            result = true;
+                        }
+
+                        LOG_DEBUG << "Finished processing the " << CURR_LEVEL << "-Gram (?) line: '"
+                                << line << "', it is " << (result ? "NOT " : "") << "accepted" << END_LOG;
+
+                        return result;
+                    }
+
+                    /**
+                     * Parses the m-gram line the same way as parse_line does but
+                     * does not add the m-gram to the trie, the last m-gram token
+                     * and the payload are returned instead. This is used to keep
+                     * the parsed uni-grams until the word index is ready.
+                     * @param line the string to process
+                     * @param word [out] the last m-gram token, i.e. the uni-gram word
+                     * @param payload [out] the m-gram payload
+                     * @return true if the provided line is NOT recognized as the N-Gram of the specified level.
+                     */
+                    inline bool parse_line(TextPieceReader & line, TextPieceReader & word, T_M_Gram_Payload & payload) {
+                        LOG_DEBUG << "Parsing the " << CURR_LEVEL << "-Gram (?) line: '" << line << "'" << END_LOG;
+
+                        //First tokenize as a pattern "prob \t gram \t back-off"
+                        if (parse_to_gram(line)) {
+                            const TextPieceReader & token = m_m_gram.tokens()[m_m_gram.get_end_word_idx()];
+                            word.set(token.get_begin_ptr(), token.length());
+                            payload = m_m_gram.m_payload;
+                            return false;
+                        } else {
+                            //If we could not parse the line to gram then it should
+                            //be the beginning of the next m-gram section
+                            return true;
+                        }
+                    }
+
+                    /**
+                     * Allows to add the uni-gram parsed before into the trie
+                     * @param word the uni-gram word
+                     * @param payload the uni-gram payload
+                     */
+                    inline void add_unigram(const TextPieceReader & word, const T_M_Gram_Payload & payload) {
+                        static_assert(CURR_LEVEL == M_GRAM_LEVEL_1, "Only uni-grams can be added by the word and payload!");
+
+                        //Set the uni-gram data
+                        m_m_gram.start_new_m_gram();
+                        m_m_gram.get_next_new_token().set(word.get_begin_ptr(), word.length());
+                        m_m_gram.m_payload = payload;
+
+                        //Prepare the N-gram and for being added to the trie
+                        m_m_gram.prepare_for_adding();
+
+                        LOG_DEBUG << "Adding a " << SSTR(CURR_LEVEL) << "-Gram "
+                                << (string) m_m_gram << " to the Trie" << END_LOG;
+
+                        //Add the obtained N-gram data to the Trie
+                        m_trie.template add_m_gram<CURR_LEVEL>(m_m_gram);
+                    }
 
                     /**
                      * Takes the uni-gram line and parses it to the word and its probability, no back-off weight!
@@ -115,38 +198,99 @@ namespace uva {
                         }
                     }
 
-                    virtual ~ARPAGramBuilder();
                 protected:
-                    //The function that is to be used to add an N-gram to a trie
-                    typename TAddGramFunct<WordIndexType>::func m_add_garm_func;
+                    //The trie to add the N-grams to
+                    TrieType & m_trie;
 
                     //The temporary storage for read pieces of text
                     TextPieceReader m_token;
 
                     //This is the N-Gram container to store the parsed N-gram data
-                    T_Model_M_Gram<WordIndexType> m_m_gram;
-
-                    //The minimum and maximum number of tokens in the N-Gram string
-                    static const unsigned short int MIN_NUM_TOKENS_NGRAM_STR;
-                    static const unsigned short int MAX_NUM_TOKENS_NGRAM_STR;
+                    typename TrieType::TModelMGram m_m_gram;
 
                     /**
                      * Parse the given text into a N-Gram entry from the ARPA file
                      * @param line the piece of text to parse into the M-gram
                      * @return true if the line has been successfully parsed
                      */
-                    bool parse_to_gram(TextPieceReader & line);
+                    inline bool parse_to_gram(TextPieceReader & line) {
+                        //Read the first element until the tab, we read until the tab because it should be the probability
+                        if (line.get_first_tab(m_token)) {
+                            //Try to parse it float
+                            if (fast_s_to_f(m_m_gram.m_payload.m_prob, m_token.get_rest_c_str())) {
+                                LOG_DEBUG2 << "Parsed the N-gram probability: " << m_m_gram.m_payload.m_prob << END_LOG;
+
+                                //Start the new m-gram
+                                m_m_gram.start_new_m_gram();
+
+                                //Read the first N-1 tokens of the N-gram - space separated
+                                for (int i = 0; i < (CURR_LEVEL - 1); i++) {
+                                    if (!line.get_first_space(m_m_gram.get_next_new_token())) {
+                                        LOG_WARNING << "An unexpected end of line '" << line.str()
+                                                << "' when reading the " << (i + 1)
+                                                << "'th " << CURR_LEVEL << "-gram token!" << END_LOG;
+                                        //The unexpected end of file, broken file format (?)
+                                        return false;
+                                    }
+                                }
+
+                                //Read the last token of the N-gram, which is followed by the new line or a tab
+                                if (!line.get_first_tab(m_m_gram.get_next_new_token())) {
+                                    LOG_WARNING << "An unexpected end of line '" << line.str()
+                                            << "' when reading the " << CURR_LEVEL << "'th "
+                                            << CURR_LEVEL << "-gram token!" << END_LOG;
+                                    //The unexpected end of file, broken file format (?)
+                                    return false;
+                                }
+
+                                //Now if there is something left it should be the back-off weight, otherwise we are done
+                                if (line.has_more()) {
+                                    //Take the remainder of the line and try to parse it!
+                                    if (!fast_s_to_f(m_m_gram.m_payload.m_back, line.get_rest_c_str())) {
+                                        LOG_WARNING << "Could not parse the remainder of the line '" << line.str()
+                                                << "' as a back-off weight!" << END_LOG;
+                                        //The first token was not a float, need to skip to another N-Gram section(?)
+                                        return false;
+                                    }
+                                    LOG_DEBUG2 << "Parsed the N-gram back-off weight: " << m_m_gram.m_payload.m_back << END_LOG;
+                                } else {
+                                    //There is no back-off so set it to zero
+                                    m_m_gram.m_payload.m_back = ZERO_BACK_OFF_WEIGHT;
+                                    LOG_DEBUG2 << "The parsed N-gram '" << line.str()
+                                            << "' does not have back-off using: " << m_m_gram.m_payload.m_back << END_LOG;
+                                }
+                                return true;
+                            } else {
+                                //NOTE: Do it as a debug3 level and not a warning because 
+                                //this will happen each time we need to move on to a new section!
+                                LOG_DEBUG3 << "Could not parse the the string '" << m_token.str()
+                                        << "' as a probability!" << END_LOG;
+                                //The first token was not a float, need to skip to another N-Gram section(?)
+
+                                //Take the line and convert it into a string, then trim it.
+                                string line = m_token.str();
+                                trim(line);
+                                //Skip to the next section only if we are dealing with a non-empty line!
+                                return (line == "");
+                            }
+                        } else {
+                            LOG_DEBUG3 << "An unexpected end of line '" << line.str()
+                                    << "', an empty line detected!" << END_LOG;
+                            //The unexpected end of line, it is an empty line so we skip it but keep reading this N-gram section
+                            return true;
+                        }
+                    }
 
                     /**
                      * The copy constructor
                      * @param orig the other builder to copy
                      */
-                    ARPAGramBuilder(const ARPAGramBuilder & orig);
-
+                    ARPAGramBuilder(const ARPAGramBuilder & orig)
+                    : m_trie(orig.m_trie), m_token(), m_m_gram(orig.m_m_gram.get_word_index(), CURR_LEVEL) {
+                    }
                 };
             }
         }
     }
 }
 #endif	/* NGRAMBUILDER_HPP */
-
@@ -27,13 +27,28 @@
 #define	TRIEBUILDER_HPP
 
 #include <fstream>      // std::ifstream
-#include <regex>        // std::regex, std::regex_match
+#include <cstring>      // std::strncmp
+#include <vector>       // std::vector
+#include <thread>       // std::thread
+#include <exception>    // std::exception_ptr
+#include <type_traits>  // std::is_same
 
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "StringUtils.hpp"
+#include "PerfCounters.hpp"
 #include "TextPieceReader.hpp"
 #include "AFileReader.hpp"
+#include "MemoryMappedFileReader.hpp"
+#include "BaseMGram.hpp"
+#include "ARPAGramBuilder.hpp"
 
 using namespace std;
 using namespace uva::smt::file;
+using namespace uva::smt::logging;
+using namespace uva::smt::utils::text;
+using namespace uva::smt::monitore;
+using namespace uva::smt::tries::m_grams;
 
 namespace uva {
     namespace smt {
@@ -44,6 +59,146 @@ namespace uva {
                 static const string END_OF_ARPA_FILE = "\\end\\";
                 //The N-gram Data Section Amoung delimiter
                 static const char NGRAM_COUNTS_DELIM = '=';
+                //The N-gram Data Section Amount entry prefix
+                static const char NGRAM_COUNTS_PREFIX[] = "ngram ";
+                //The N-gram section header prefix and suffix, e.g. \\1-grams:
+                static const char NGRAM_SECTION_PREFIX = '\\';
+                static const char NGRAM_SECTION_SUFFIX[] = "-grams:";
+                //The maximum number of digits we parse in the ARPA header values
+                static constexpr size_t MAX_ARPA_NUMBER_DIGITS = 19;
+                //The expected average uni-gram word length, used to reserve the uni-gram buffer
+                static constexpr size_t UNIGRAM_WORD_LEN_ESTIMATE = 8;
+
+                /**
+                 * Parses an unsigned decimal number, at least one digit is expected
+                 * @param begin_ptr [in/out] the pointer to the number begin, is moved past the number
+                 * @param end_ptr the pointer to the end of the text
+                 * @param value [out] the parsed value
+                 * @return true if a number was parsed, otherwise false
+                 */
+                static inline bool parse_arpa_number(const char * & begin_ptr, const char * end_ptr, size_t & value) {
+                    const char * const digits_ptr = begin_ptr;
+                    value = 0;
+                    while ((begin_ptr != end_ptr) && ((*begin_ptr) >= '0') && ((*begin_ptr) <= '9')) {
+                        value = value * 10 + ((*begin_ptr) - '0');
+                        ++begin_ptr;
+                    }
+                    const size_t num_digits = begin_ptr - digits_ptr;
+                    return (num_digits > 0) && (num_digits <= MAX_ARPA_NUMBER_DIGITS);
+                }
+
+                /**
+                 * Checks if the given line is an n-gram amount entry of
+                 * the data section, i.e. "ngram <level>=<amount>", and
+                 * if so then parses the level and the amount values
+                 * @param line the line to check
+                 * @param level [out] the m-gram level
+                 * @param amount [out] the number of m-grams
+                 * @return true if the line is an n-gram amount entry
+                 */
+                static inline bool get_m_gram_amount(const TextPieceReader & line, size_t & level, size_t & amount) {
+                    const size_t prefix_len = sizeof (NGRAM_COUNTS_PREFIX) - 1;
+                    const char * ptr = line.get_begin_c_str();
+                    const char * const end_ptr = ptr + line.length();
+
+                    if ((line.length() <= prefix_len) || (strncmp(ptr, NGRAM_COUNTS_PREFIX, prefix_len) != 0)) {
+                        return false;
+                    }
+                    ptr += prefix_len;
+
+                    if (!parse_arpa_number(ptr, end_ptr, level) || (ptr == end_ptr) || (*ptr != NGRAM_COUNTS_DELIM)) {
+                        return false;
+                    }
+                    ++ptr;
+
+                    return parse_arpa_number(ptr, end_ptr, amount) && (ptr == end_ptr);
+                }
+
+                /**
+                 * This structure stores the ARPA model header data, i.e. the data
+                 * section m-gram amounts, the maximum m-gram level and the line
+                 * following the data section. It is read once, before the trie
+                 * type is chosen, and is then handed over to the trie builder.
+                 */
+                typedef struct {
+                    //The m-gram amounts of the data section, indexed by level - 1
+                    vector<size_t> m_counts;
+                    //The maximum m-gram level of the data section
+                    size_t m_max_level;
+                    //The first line after the data section, i.e. the 1-grams section header,
+                    //it is only valid until the next line is read from the model file
+                    TextPieceReader m_line;
+                } TARPAHeader;
+
+                /**
+                 * Allows to read the ARPA headers and data section from the model file.
+                 * The file is read up to and including the first m-gram section header
+                 * and is not rewound, so the trie builder continues reading from there.
+                 * @param file the model file to read from
+                 * @param header [out] the model header data
+                 */
+                template<typename TFileReaderModel>
+                static inline void read_arpa_header(TFileReaderModel & file, TARPAHeader & header) {
+                    TextPieceReader & line = header.m_line;
+                    size_t level = 0, amount = 0;
+
+                    LOG_DEBUG << "Start reading ARPA headers." << END_LOG;
+
+                    header.m_counts.clear();
+                    header.m_max_level = 0;
+
+                    //Skip on the empty lines and the lines starting with '<', these are ARPA headers
+                    bool is_line = file.get_first_line(line);
+                    while (is_line && !(line.has_more() && (line[0] != '<'))) {
+                        LOG_DEBUG1 << "Skipping the header line: '" << line.str() << "'" << END_LOG;
+                        is_line = file.get_first_line(line);
+                    }
+                    if (!is_line) {
+                        throw Exception("Incorrect ARPA format: An unexpected end of file while reading the ARPA headers!");
+                    }
+
+                    //We stumbled upon something meaningful, that must be the begin of the data section
+                    if (line == END_OF_ARPA_FILE) {
+                        stringstream msg;
+                        msg << "Incorrect ARPA format: Got '" << line << "' instead of '"
+                                << END_OF_ARPA_FILE << "' when starting on the data section!";
+                        throw Exception(msg.str());
+                    }
+
+                    LOG_DEBUG << "Start reading ARPA data." << END_LOG;
+
+                    //Read the m-gram amounts until the first m-gram section header
+                    while (true) {
+                        if (!file.get_first_line(line)) {
+                            throw Exception("Incorrect ARPA format: An unexpected end of file while reading the ARPA data section!");
+                        }
+                        LOG_DEBUG1 << "Read data (?) line: '" << line.str() << "'" << END_LOG;
+
+                        //If the line is empty then we keep reading
+                        if (line.has_more()) {
+                            if (!get_m_gram_amount(line, level, amount)) {
+                                LOG_DEBUG1 << "Is something other than n-gram amount, moving to n-gram sections!" << END_LOG;
+                                break;
+                            }
+                            LOG_DEBUG1 << "Reading " << level << "-gram amount, got: '" << line << "'!" << END_LOG;
+
+                            if (level < M_GRAM_LEVEL_1) {
+                                stringstream msg;
+                                msg << "Incorrect ARPA format: Invalid m-gram level "
+                                        << level << " in: '" << line << "'";
+                                throw Exception(msg.str());
+                            }
+
+                            if (level > header.m_counts.size()) {
+                                header.m_counts.resize(level, 0);
+                            }
+                            header.m_counts[level - 1] = amount;
+                            header.m_max_level = max(header.m_max_level, level);
+                        }
+                    }
+
+                    LOG_DEBUG << "Finished reading ARPA data." << END_LOG;
+                }
 
                 /**
                  * This is the Trie builder class that reads an input file stream
@@ -58,9 +213,10 @@ namespace uva {
                     /**
                      * The basic constructor that accepts a trie to be build up and the file stream to read from
                      * @param trie the trie to fill in with data from the text corpus
-                     * @param _fstr the file stream to read from
+                     * @param _fstr the file stream to read from, positioned after the model header
+                     * @param header the model header, as read from the file by read_arpa_header
                      */
-                    ARPATrieBuilder(TrieType & trie, TFileReaderModel & file);
+                    ARPATrieBuilder(TrieType & trie, TFileReaderModel & file, const TARPAHeader & header);
 
                     /**
                      * This function will read from the file and build the trie
@@ -73,12 +229,32 @@ namespace uva {
                     TrieType & m_trie;
                     //The reference to the input file with language model
                     TFileReaderModel & m_file;
+                    //The reference to the already read model header
+                    const TARPAHeader & m_header;
                     //Stores the next line data
                     TextPieceReader m_line;
-                    //The regular expression for matching the n-gram amount entry of the data section
-                    const regex m_ng_amount_reg_exp;
-                    //The regular expression for matching the n-grams section
-                    const regex m_ng_section_reg_exp;
+                    //Stores true if the 2-Grams to N-Grams are read in parallel
+                    bool m_is_parallel_build;
+
+                    /**
+                     * The buffered uni-gram entry, the word is stored in the
+                     * uni-gram words buffer, at the given offset
+                     */
+                    typedef struct {
+                        //The offset of the word in the words buffer
+                        size_t m_word_offset;
+                        //The length of the word
+                        size_t m_word_len;
+                        //The uni-gram payload
+                        T_M_Gram_Payload m_payload;
+                    } TUnigramEntry;
+
+                    //Stores true if the uni-grams are parsed into the buffer
+                    bool m_is_unigrams_buffered;
+                    //Stores the parsed uni-grams if the word counts are needed
+                    vector<TUnigramEntry> m_unigrams;
+                    //Stores the parsed uni-gram words
+                    vector<char> m_unigram_words;
 
                     /**
                      * The copy constructor
@@ -87,10 +263,28 @@ namespace uva {
                     ARPATrieBuilder(const ARPATrieBuilder<TrieType, TFileReaderModel>& orig);
 
                     /**
-                     * This method is used to read and process the ARPA headers
-                     * @param line the in/out parameter storing the last read line
+                     * Checks if the given line is the header of the m-grams section
+                     * of the given level, i.e. "\\<level>-grams:"
+                     * @param line the line to check
+                     * @param level the m-gram level
+                     * @return true if the line is the given level m-grams section header
                      */
-                    void read_headers();
+                    static inline bool is_m_gram_section(const TextPieceReader & line, const TModelLevel level) {
+                        const size_t suffix_len = sizeof (NGRAM_SECTION_SUFFIX) - 1;
+                        const char * ptr = line.get_begin_c_str();
+                        const char * const end_ptr = ptr + line.length();
+                        size_t line_level = 0;
+
+                        if ((line.length() <= (suffix_len + 1)) || (*ptr != NGRAM_SECTION_PREFIX)) {
+                            return false;
+                        }
+                        ++ptr;
+
+                        //The level is expected without leading zeros
+                        return (*ptr != '0') && parse_arpa_number(ptr, end_ptr, line_level) && (line_level == level)
+                                && (static_cast<size_t> (end_ptr - ptr) == suffix_len)
+                                && (strncmp(ptr, NGRAM_SECTION_SUFFIX, suffix_len) == 0);
+                    }
 
                     /**
                      * Allows to pre-allocate memory in the tries and dictionaries
@@ -98,14 +292,6 @@ namespace uva {
                      */
                     void pre_allocate(size_t counts[MAX_LEVEL]);
 
-                    /**
-                     * This method is used to read and process the ARPA data section
-                     * @param line the in/out parameter storing the last read line
-                     * @param counts the out parameters to store the retrieved
-                     *               N-Gram counts from the data descriptions
-                     */
-                    void read_data(size_t counts[MAX_LEVEL]);
-
                     /**
                      * Allows to read the given Trie level M-grams from the file
                      * @param level the currently read M-gram level M
@@ -167,6 +353,146 @@ namespace uva {
                         Func<CURR_LEVEL>::check_and_go_m_grams(*this);
                     }
 
+                    /**
+                     * Allows to read the given level M-grams from the given section
+                     * text. This method is run in a separate thread when the M-gram
+                     * levels are read in parallel, so it does not use the progress bar.
+                     * @param section the M-grams section text or its chunk, without the section header
+                     * @param error [out] stores the exception thrown while reading, if any
+                     */
+                    template<TModelLevel CURR_LEVEL>
+                    void read_m_gram_section(TextPieceReader & section, exception_ptr & error);
+
+                    /**
+                     * Allows to find the end of the M-grams section within the given
+                     * text, i.e. the beginning of the first line starting with '\\'
+                     * @param begin_ptr the pointer to the section text begin
+                     * @param end_ptr the pointer to the end of the file text
+                     * @return the pointer to the end of the section, or end_ptr if not found
+                     */
+                    static inline const char * find_section_end(const char * begin_ptr, const char * end_ptr) {
+                        const char * ptr = begin_ptr;
+                        while (ptr != end_ptr) {
+                            ptr = static_cast<const char *> (memchr(ptr, NGRAM_SECTION_PREFIX, end_ptr - ptr));
+                            if (ptr == NULL) {
+                                return end_ptr;
+                            }
+                            if ((ptr == begin_ptr) || (*(ptr - 1) == '\n')) {
+                                return ptr;
+                            }
+                            ++ptr;
+                        }
+                        return end_ptr;
+                    }
+
+                    /**
+                     * Allows to read the 2-Grams to N-Grams sections in parallel, one thread per
+                     * level. The sections are first located in the memory mapped model file and
+                     * then each of them is read by its own thread. If the trie allows for it the
+                     * larger sections are split into chunks, read by several threads each. The
+                     * post-gram actions are done in the level order once all the threads are finished.
+                     */
+                    void read_grams_parallel();
+
+                    /**
+                     * Allows to split the given M-grams section into the given number
+                     * of chunks of about the same size, the chunks end at line ends.
+                     * @param section the M-grams section text, without the section header
+                     * @param num_chunks the number of chunks to split into, at least one
+                     * @param chunks [out] the vector to add the chunks to
+                     */
+                    static inline void split_section(const TextPieceReader & section, const size_t num_chunks, vector<TextPieceReader> & chunks) {
+                        const char * const begin_ptr = section.get_begin_c_str();
+                        const char * const end_ptr = begin_ptr + section.length();
+                        const char * chunk_ptr = begin_ptr;
+                        for (size_t idx = 1; idx <= num_chunks; ++idx) {
+                            const char * cut_ptr = end_ptr;
+                            if (idx < num_chunks) {
+                                //Move the cut to the end of the line it falls into
+                                cut_ptr = max(chunk_ptr, begin_ptr + (section.length() * idx) / num_chunks);
+                                cut_ptr = static_cast<const char *> (memchr(cut_ptr, '\n', end_ptr - cut_ptr));
+                                cut_ptr = (cut_ptr == NULL) ? end_ptr : cut_ptr + 1;
+                            }
+                            chunks.push_back(TextPieceReader());
+                            chunks.back().set(chunk_ptr, cut_ptr - chunk_ptr);
+                            chunk_ptr = cut_ptr;
+                        }
+                    }
+
+                    /**
+                     * Allows to split the located M-gram sections into chunks, for the tries
+                     * that allow for concurrent insertions within a level the threads are
+                     * given out proportionally to the section sizes, otherwise one per level.
+                     * @param num_levels the number of M-gram levels present in the model file
+                     * @param sections the located M-gram sections, indexed by level - 1
+                     * @param chunks [out] the M-gram section chunks, indexed by level - 1
+                     */
+                    void split_sections(const TModelLevel num_levels, const TextPieceReader sections[MAX_LEVEL], vector<TextPieceReader> chunks[MAX_LEVEL]);
+
+                    /**
+                     * Allows to start the threads reading the given level M-gram section chunks
+                     * @param chunks the M-grams section chunks, one thread is started per chunk
+                     * @param threads [in/out] the vector to add the started threads to
+                     * @param errors the thread errors, indexed by the thread index
+                     */
+                    template<TModelLevel CURR_LEVEL>
+                    void start_section_threads(vector<TextPieceReader> & chunks, vector<thread> & threads, vector<exception_ptr> & errors);
+
+                    template<TModelLevel CURR_LEVEL, typename DUMMY = void>
+                    struct ParFunc {
+
+                        /**
+                         * Starts the section reading threads for the levels from CURR_LEVEL to num_levels
+                         * @param builder the trie builder
+                         * @param num_levels the number of M-gram levels present in the model file
+                         * @param chunks the located M-gram section chunks, indexed by level - 1
+                         * @param threads [in/out] the vector to add the started threads to
+                         * @param errors the thread errors, indexed by the thread index
+                         */
+                        static inline void start_threads(ARPATrieBuilder<TrieType, TFileReaderModel> & builder, const TModelLevel num_levels,
+                                vector<TextPieceReader> chunks[MAX_LEVEL], vector<thread> & threads, vector<exception_ptr> & errors) {
+                            if (CURR_LEVEL <= num_levels) {
+                                builder.template start_section_threads<CURR_LEVEL>(chunks[CURR_LEVEL - 1], threads, errors);
+                                ParFunc < CURR_LEVEL + 1 > ::start_threads(builder, num_levels, chunks, threads, errors);
+                            }
+                        }
+
+                        /**
+                         * Performs the post-gram actions for the levels from CURR_LEVEL to num_levels
+                         * @param builder the trie builder
+                         * @param num_levels the number of M-gram levels present in the model file
+                         */
+                        static inline void do_post_m_gram_actions(ARPATrieBuilder<TrieType, TFileReaderModel> & builder, const TModelLevel num_levels) {
+                            if (CURR_LEVEL <= num_levels) {
+                                builder.template do_post_m_gram_actions<CURR_LEVEL>();
+                                ParFunc < CURR_LEVEL + 1 > ::do_post_m_gram_actions(builder, num_levels);
+                            }
+                        }
+                    };
+
+                    template<typename DUMMY>
+                    struct ParFunc<MAX_LEVEL, DUMMY> {
+
+                        /**
+                         * This template specialization is to be used for the level parameter values == MAX_LEVEL
+                         */
+                        static inline void start_threads(ARPATrieBuilder<TrieType, TFileReaderModel> & builder, const TModelLevel num_levels,
+                                vector<TextPieceReader> chunks[MAX_LEVEL], vector<thread> & threads, vector<exception_ptr> & errors) {
+                            if (MAX_LEVEL <= num_levels) {
+                                builder.template start_section_threads<MAX_LEVEL>(chunks[MAX_LEVEL - 1], threads, errors);
+                            }
+                        }
+
+                        /**
+                         * This template specialization is to be used for the level parameter values == MAX_LEVEL
+                         */
+                        static inline void do_post_m_gram_actions(ARPATrieBuilder<TrieType, TFileReaderModel> & builder, const TModelLevel num_levels) {
+                            if (MAX_LEVEL <= num_levels) {
+                                builder.template do_post_m_gram_actions<MAX_LEVEL>();
+                            }
+                        }
+                    };
+
                     /**
                      * Allows to perform the post-gram actions if needed
                      * @param level the currently read M-gram level M
@@ -180,29 +506,29 @@ namespace uva {
                     void do_word_index_post_1_gram_actions();
 
                     /**
-                     * If the word counts are needed then this method will 
-                     * read all the M-gram sections of the ARPA file to get them.
-                     * Afterwards the file will be rewind to the beginning
-                     * of the 1-Gram sections.
+                     * If the word counts are needed then this method will read
+                     * the 1-Gram section of the ARPA file into the uni-gram buffer
+                     * and will count the words from there. The uni-grams are then
+                     * added to the trie from the buffer, so the file is read once.
+                     * @param num_unigrams the expected number of uni-grams
                      */
-                    void get_word_counts();
+                    void get_word_counts(const size_t num_unigrams);
 
                     /**
                      * If the word counts are needed then we are starting
-                     * on reading the M-gram section of the ARPA file.
-                     * All we need to do is then read all the words in
-                     * M-Gram sections and count them with the word index.
-                     * @param level the M-gram level we are counting words for.
+                     * on reading the 1-Gram section of the ARPA file.
+                     * The uni-gram lines are parsed once and are stored
+                     * in the uni-gram buffer, the line following the
+                     * 1-Gram section is then left in m_line.
+                     * @param num_unigrams the expected number of uni-grams
                      */
-                    void get_word_counts_from_unigrams();
+                    void read_unigrams_to_buffer(const size_t num_unigrams);
 
                     /**
-                     * This method should be called after the word counting is done.
-                     * Then we can re-start reading the file and move forward to the
-                     * one gram section again. After this method we can proceed
-                     * reading M-grams and add them to the trie.
+                     * Allows to add the buffered uni-grams to the trie,
+                     * the uni-gram buffer is freed afterwards.
                      */
-                    void return_to_grams();
+                    void add_buffered_unigrams();
 
                     /**
                      * This recursive method is used to read and process the ARPA N-Grams.
@@ -215,6 +541,518 @@ namespace uva {
 
                 template<typename TrieType, typename TFileReaderModel>
                 constexpr TModelLevel ARPATrieBuilder<TrieType, TFileReaderModel>::MAX_LEVEL;
+
+                template<typename TrieType, typename TFileReaderModel>
+                ARPATrieBuilder<TrieType, TFileReaderModel>::ARPATrieBuilder(TrieType & trie, TFileReaderModel & file, const TARPAHeader & header) :
+                m_trie(trie), m_file(file), m_header(header), m_line(), m_is_parallel_build(false), m_is_unigrams_buffered(false) {
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                ARPATrieBuilder<TrieType, TFileReaderModel>::ARPATrieBuilder(const ARPATrieBuilder<TrieType, TFileReaderModel>& orig) :
+                m_trie(orig.m_trie), m_file(orig.m_file), m_header(orig.m_header), m_line(orig.m_line), m_is_parallel_build(orig.m_is_parallel_build),
+                m_is_unigrams_buffered(false) {
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                ARPATrieBuilder<TrieType, TFileReaderModel>::~ARPATrieBuilder() {
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::pre_allocate(size_t counts[MAX_LEVEL]) {
+                    LOG_INFO << "Expected number of M-grams per level: "
+                            << arrayToString<size_t, MAX_LEVEL>(counts) << END_LOG;
+
+                    //Do the progress bard indicator
+                    Logger::start_progress_bar(string("Pre-allocating memory"));
+
+                    //Provide the N-Gram counts data to the Trie
+                    m_trie.pre_allocate(counts);
+
+                    Logger::update_progress_bar();
+
+                    LOG_DEBUG << "Finished pre-allocating memory" << END_LOG;
+                    //Stop the progress bar in case of no exception
+                    Logger::stop_progress_bar();
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                template<TModelLevel CURR_LEVEL>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::read_m_gram_level() {
+                    //Declare the N-Gram builder, it adds the N-grams straight into the trie
+                    ARPAGramBuilder<TrieType, CURR_LEVEL> gram_builder(m_trie);
+
+                    //The counter of the N-grams
+                    uint numNgrams = 0;
+                    //Read the current level N-grams and add them to the trie
+                    while (true) {
+                        //Try to read the next line
+                        if (m_file.get_first_line(m_line)) {
+                            LOG_DEBUG1 << "Read " << CURR_LEVEL << "-Gram (?) line: '" << m_line.str() << "'" << END_LOG;
+
+                            //Empty lines will just be skipped
+                            if (m_line.has_more()) {
+                                //Pass the given N-gram string to the N-Gram Builder. If the
+                                //N-gram is not matched then stop the loop and move on
+                                if (gram_builder.parse_line(m_line)) {
+                                    //If there was no match then it is something else
+                                    //than the given level N-gram so we move on
+                                    LOG_DEBUG << "Actual number of " << CURR_LEVEL << "-grams is: " << numNgrams << END_LOG;
+
+                                    //Now stop reading this level N-grams and move on
+                                    break;
+                                }
+                                numNgrams++;
+                            }
+
+                            //Update the progress bar status
+                            Logger::update_progress_bar();
+                        } else {
+                            //If the next line does not exist then it an error as we expect the end of data section any way
+                            stringstream msg;
+                            msg << "Incorrect ARPA format: Unexpected end of file, missing the '" << END_OF_ARPA_FILE << "' tag!";
+                            throw Exception(msg.str());
+                        }
+                    }
+
+                    LOG_DEBUG << "Finished reading ARPA " << CURR_LEVEL << "-Grams." << END_LOG;
+                    //Stop the progress bar in case of no exception
+                    Logger::stop_progress_bar();
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                template<TModelLevel CURR_LEVEL>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::do_post_m_gram_actions() {
+                    //Check if the post gram actions are needed! If yes - perform.
+                    if (m_trie.template is_post_grams<CURR_LEVEL>()) {
+                        //Do the progress bard indicator
+                        stringstream msg;
+                        msg << "Cultivating " << CURR_LEVEL << "-Grams";
+                        Logger::start_progress_bar(msg.str());
+
+                        //Do the post level actions
+                        PerfPhase phase(string("Cultivating ") + std::to_string(CURR_LEVEL) + string("-Grams"));
+                        m_trie.template post_grams<CURR_LEVEL>();
+                        phase.stop();
+
+                        //Stop the progress bar in case of no exception
+                        Logger::stop_progress_bar();
+                        LOG_DEBUG << "Finished post actions of " << CURR_LEVEL << "-Grams." << END_LOG;
+                    } else {
+                        LOG_INFO3 << "Cultivating " << CURR_LEVEL << "-Grams:\t Not needed!" << END_LOG;
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::get_word_counts(const size_t num_unigrams) {
+                    //Check if we need to count the words
+                    if (m_trie.get_word_index().is_word_counts_needed()) {
+                        //Do the progress bard indicator
+                        Logger::start_progress_bar(string("Counting all words"));
+
+                        //Parse the uni-grams into the buffer
+                        read_unigrams_to_buffer(num_unigrams);
+
+                        //Count the words from the buffered uni-grams
+                        typename TrieType::WordIndexType & word_index = m_trie.get_word_index();
+                        TextPieceReader word;
+                        for (typename vector<TUnigramEntry>::const_iterator iter = m_unigrams.begin(); iter != m_unigrams.end(); ++iter) {
+                            word.set(&m_unigram_words[iter->m_word_offset], iter->m_word_len);
+                            TLogProbBackOff prob = iter->m_payload.m_prob;
+                            word_index.count_word(word, prob);
+                        }
+                        LOG_DEBUG1 << "Finished counting words in M-grams!" << END_LOG;
+
+                        //Perform the post counting actions;
+                        word_index.do_post_word_count();
+
+                        LOG_DEBUG << "Finished counting all words" << END_LOG;
+                        //Stop the progress bar in case of no exception
+                        Logger::stop_progress_bar();
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::do_word_index_post_1_gram_actions() {
+                    //Perform the post actions if needed
+                    if (m_trie.get_word_index().is_post_actions_needed()) {
+                        //Do the progress bard indicator
+                        Logger::start_progress_bar(string("Word Index actions"));
+
+                        LOG_DEBUG << "Starting to perform the Word Index post actions" << END_LOG;
+
+                        //Perform the post actions
+                        m_trie.get_word_index().do_post_actions();
+
+                        LOG_DEBUG << "Finished performing the Word Index post actions" << END_LOG;
+
+                        //Stop the progress bar in case of no exception
+                        Logger::stop_progress_bar();
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                template<TModelLevel CURR_LEVEL>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::read_grams() {
+                    stringstream msg;
+                    //Do the progress bard indicator
+                    msg << "Reading ARPA " << CURR_LEVEL << "-Grams";
+                    Logger::start_progress_bar(msg.str());
+
+                    //The uni-grams may have already been read into the buffer
+                    const bool is_buffered = (CURR_LEVEL == M_GRAM_LEVEL_1) && m_is_unigrams_buffered;
+
+                    //Check if the line that was input is the header of the N-grams section for N=level
+                    if (is_buffered || is_m_gram_section(m_line, CURR_LEVEL)) {
+                        //Read the M-grams of the given level
+                        PerfPhase phase(string("Reading ") + std::to_string(CURR_LEVEL) + string("-Grams"));
+                        if (is_buffered) {
+                            add_buffered_unigrams();
+                        } else {
+                            read_m_gram_level<CURR_LEVEL>();
+                        }
+                        phase.stop();
+
+                        //If the first M-gram level has been read then do
+                        //the word index post-actions if needed.
+                        if (CURR_LEVEL == M_GRAM_LEVEL_1) {
+                            do_word_index_post_1_gram_actions();
+                        }
+
+                        //Perform the post-M-gram actions if needed
+                        do_post_m_gram_actions<CURR_LEVEL>();
+
+                        //Check if we need to keep reading and recurse or we are done,
+                        //the higher M-gram levels can also be read all at once in parallel
+                        if ((CURR_LEVEL == M_GRAM_LEVEL_1) && m_is_parallel_build) {
+                            read_grams_parallel();
+                        } else {
+                            check_and_go_m_grams<CURR_LEVEL>();
+                        }
+                    } else {
+                        //The obtained string is something else than the next n-grams section header
+                        //So the only thing it is allowed to be is the end of file, let's check on
+                        //it and otherwise report an error
+                        if (m_line != END_OF_ARPA_FILE) {
+                            stringstream msg;
+                            msg << "Incorrect ARPA format: Got '" << m_line
+                                    << "' when trying to read the " << CURR_LEVEL
+                                    << "-grams section!";
+                            throw Exception(msg.str());
+                        }
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                template<TModelLevel CURR_LEVEL>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::read_m_gram_section(TextPieceReader & section, exception_ptr & error) {
+                    try {
+                        //Declare the N-Gram builder, it adds the N-grams straight into the trie
+                        ARPAGramBuilder<TrieType, CURR_LEVEL> gram_builder(m_trie);
+                        TextPieceReader line;
+
+                        //The counter of the N-grams
+                        uint numNgrams = 0;
+                        //Read the section N-grams and add them to the trie
+                        while (section.get_first_line(line)) {
+                            //Empty lines will just be skipped
+                            if (line.has_more()) {
+                                //The section contains nothing but the given level N-grams
+                                if (gram_builder.parse_line(line)) {
+                                    stringstream msg;
+                                    msg << "Incorrect ARPA format: Got '" << line
+                                            << "' when reading the " << CURR_LEVEL
+                                            << "-grams section!";
+                                    throw Exception(msg.str());
+                                }
+                                numNgrams++;
+                            }
+                        }
+
+                        LOG_DEBUG << "Actual number of " << CURR_LEVEL << "-grams is: " << numNgrams << END_LOG;
+                    } catch (...) {
+                        //Store the exception, it is re-thrown by the main thread
+                        error = current_exception();
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                template<TModelLevel CURR_LEVEL>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::start_section_threads(vector<TextPieceReader> & chunks,
+                        vector<thread> & threads, vector<exception_ptr> & errors) {
+                    for (vector<TextPieceReader>::iterator iter = chunks.begin(); iter != chunks.end(); ++iter) {
+                        exception_ptr & error = errors[threads.size()];
+                        threads.push_back(thread(&ARPATrieBuilder<TrieType, TFileReaderModel>::template read_m_gram_section<CURR_LEVEL>,
+                                this, ref(*iter), ref(error)));
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::split_sections(const TModelLevel num_levels,
+                        const TextPieceReader sections[MAX_LEVEL], vector<TextPieceReader> chunks[MAX_LEVEL]) {
+                    //Use at least one thread per level, and at least one thread per core
+                    const size_t num_threads = max(static_cast<size_t> (thread::hardware_concurrency()), static_cast<size_t> (num_levels - 1));
+
+                    //Compute the total sections size, to give the threads out proportionally
+                    size_t total_bytes = 0;
+                    for (TModelLevel idx = M_GRAM_LEVEL_1; idx < num_levels; ++idx) {
+                        total_bytes += sections[idx].length();
+                    }
+
+                    for (TModelLevel idx = M_GRAM_LEVEL_1; idx < num_levels; ++idx) {
+                        size_t num_chunks = 1;
+                        //Only split the levels that can be filled by several threads at once
+                        if (TrieType::is_level_concurrent() && (total_bytes > 0)) {
+                            const size_t len = sections[idx].length();
+                            num_chunks = (len * num_threads) / total_bytes;
+                            num_chunks = min(num_chunks, len / __ARPATrieBuilder::MIN_SECTION_CHUNK_BYTES);
+                            num_chunks = max(num_chunks, static_cast<size_t> (1));
+                        }
+                        LOG_DEBUG << "The " << SSTR(idx + 1) << "-grams section is read by " << num_chunks << " thread(s)" << END_LOG;
+                        split_section(sections[idx], num_chunks, chunks[idx]);
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::read_grams_parallel() {
+                    //The located M-gram sections, indexed by level - 1
+                    TextPieceReader sections[MAX_LEVEL];
+                    //The number of M-gram levels present in the model file
+                    TModelLevel num_levels = M_GRAM_LEVEL_1;
+
+                    //Locate the M-gram sections, the current line follows the 1-Grams section
+                    const char * const end_ptr = m_file.get_begin_c_str() + m_file.length();
+                    const char * section_ptr = m_file.get_rest_c_str();
+                    TextPieceReader rest;
+                    while ((num_levels < MAX_LEVEL) && (m_line != END_OF_ARPA_FILE)) {
+                        const TModelLevel level = num_levels + 1;
+
+                        //The current line must be the next level section header
+                        if (!is_m_gram_section(m_line, level)) {
+                            stringstream msg;
+                            msg << "Incorrect ARPA format: Got '" << m_line
+                                    << "' when trying to read the " << level
+                                    << "-grams section!";
+                            throw Exception(msg.str());
+                        }
+
+                        //The section lasts until the next section header or the end tag
+                        const char * const section_end = find_section_end(section_ptr, end_ptr);
+                        if (section_end == end_ptr) {
+                            stringstream msg;
+                            msg << "Incorrect ARPA format: Unexpected end of file, missing the '" << END_OF_ARPA_FILE << "' tag!";
+                            throw Exception(msg.str());
+                        }
+                        sections[level - 1].set(section_ptr, section_end - section_ptr);
+                        LOG_DEBUG << "Located the " << level << "-grams section of " << sections[level - 1].length() << " bytes" << END_LOG;
+
+                        //Read the line following the section
+                        rest.set(section_end, end_ptr - section_end);
+                        rest.get_first_line(m_line);
+                        section_ptr = rest.get_rest_c_str();
+                        num_levels = level;
+                    }
+
+                    //Here we must have read a valid \end\ tag, otherwise an error!
+                    if (m_line != END_OF_ARPA_FILE) {
+                        stringstream msg;
+                        msg << "Incorrect ARPA format: Got '" << m_line
+                                << "' instead of '" << END_OF_ARPA_FILE
+                                << "' when reading " << MAX_LEVEL << "-grams section!";
+                        throw Exception(msg.str());
+                    }
+                    if (num_levels < MAX_LEVEL) {
+                        //We did encounter the \end\ tag, this is not really expected, but it is not fatal
+                        LOG_WARNING << "End of ARPA file, read " << num_levels << "-grams and there is "
+                                << "nothing more to read. The maximum allowed N-gram level is " << MAX_LEVEL << END_LOG;
+                    }
+
+                    if (num_levels > M_GRAM_LEVEL_1) {
+                        //Do the progress bard indicator, it is not updated by the threads
+                        stringstream msg;
+                        msg << "Reading ARPA 2-" << num_levels << "-Grams in parallel";
+                        Logger::start_progress_bar(msg.str());
+
+                        //Split the sections into chunks, one thread per chunk
+                        vector<TextPieceReader> chunks[MAX_LEVEL];
+                        split_sections(num_levels, sections, chunks);
+                        size_t num_chunks = 0;
+                        for (TModelLevel idx = M_GRAM_LEVEL_1; idx < num_levels; ++idx) {
+                            num_chunks += chunks[idx].size();
+                        }
+                        vector<thread> threads;
+                        threads.reserve(num_chunks);
+                        vector<exception_ptr> errors(num_chunks);
+
+                        //Read every chunk in its own thread
+                        PerfPhase phase(string("Reading 2-") + std::to_string(num_levels) + string("-Grams in parallel"));
+                        try {
+                            ParFunc<M_GRAM_LEVEL_2>::start_threads(*this, num_levels, chunks, threads, errors);
+                        } catch (...) {
+                            //Wait for the already started threads before re-throwing
+                            for (vector<thread>::iterator iter = threads.begin(); iter != threads.end(); ++iter) {
+                                iter->join();
+                            }
+                            throw;
+                        }
+                        for (vector<thread>::iterator iter = threads.begin(); iter != threads.end(); ++iter) {
+                            iter->join();
+                        }
+                        phase.stop();
+
+                        //Report the lowest level error, if any
+                        for (vector<exception_ptr>::const_iterator iter = errors.begin(); iter != errors.end(); ++iter) {
+                            if (*iter) {
+                                rethrow_exception(*iter);
+                            }
+                        }
+
+                        LOG_DEBUG << "Finished reading ARPA 2-" << num_levels << "-Grams." << END_LOG;
+                        //Stop the progress bar in case of no exception
+                        Logger::stop_progress_bar();
+
+                        //Perform the post-M-gram actions in the level order
+                        ParFunc<M_GRAM_LEVEL_2>::do_post_m_gram_actions(*this, num_levels);
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::read_unigrams_to_buffer(const size_t num_unigrams) {
+                    //Check if the line that was input is the header of the N-grams section for N=level
+                    if (is_m_gram_section(m_line, M_GRAM_LEVEL_1)) {
+                        //Declare the uni-gram parser and the variables to parse into
+                        ARPAGramBuilder<TrieType, M_GRAM_LEVEL_1> gram_builder(m_trie);
+                        TextPieceReader word;
+                        TUnigramEntry entry;
+
+                        //Reserve the buffer memory, assume short words
+                        m_unigrams.reserve(num_unigrams);
+                        m_unigram_words.reserve(num_unigrams * UNIGRAM_WORD_LEN_ESTIMATE);
+
+                        //Read the uni-grams into the buffer, the words are copied as
+                        //the line data is only valid until the next line is read
+                        while (true) {
+                            if (m_file.get_first_line(m_line)) {
+                                LOG_DEBUG1 << "Reading " << SSTR(M_GRAM_LEVEL_1) << "-gram, got: [" << m_line.str() << "]" << END_LOG;
+
+                                //Empty lines will just be skipped
+                                if (m_line.has_more()) {
+                                    //If it is not the uni-gram line then we stop
+                                    if (gram_builder.parse_line(m_line, word, entry.m_payload)) {
+                                        LOG_DEBUG1 << "Stopping reading " << SSTR(M_GRAM_LEVEL_1) << "-grams, the number of "
+                                                << SSTR(M_GRAM_LEVEL_1) << "-grams is: " << m_unigrams.size() << END_LOG;
+                                        break;
+                                    }
+                                    entry.m_word_offset = m_unigram_words.size();
+                                    entry.m_word_len = word.length();
+                                    m_unigram_words.insert(m_unigram_words.end(), word.get_begin_c_str(), word.get_begin_c_str() + word.length());
+                                    m_unigrams.push_back(entry);
+                                }
+
+                                //Update the progress bar status
+                                Logger::update_progress_bar();
+                            } else {
+                                //If the next line does not exist then it an error as we expect the end of data section any way
+                                stringstream msg;
+                                msg << "Incorrect ARPA format: Unexpected end of file, missing the '" << END_OF_ARPA_FILE << "' tag!";
+                                throw Exception(msg.str());
+                            }
+                        }
+                        m_is_unigrams_buffered = true;
+
+                        LOG_DEBUG1 << "Finished reading " << SSTR(M_GRAM_LEVEL_1) << "-grams, the words take "
+                                << m_unigram_words.size() << " bytes" << END_LOG;
+                    } else {
+                        THROW_EXCEPTION("Could not count words, did not get a match with for the beginning of the 1-gram section!");
+                    }
+                }
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::add_buffered_unigrams() {
+                    //Declare the N-Gram builder, it adds the N-grams straight into the trie
+                    ARPAGramBuilder<TrieType, M_GRAM_LEVEL_1> gram_builder(m_trie);
+                    TextPieceReader word;
+
+                    //Add the buffered uni-grams to the trie
+                    for (typename vector<TUnigramEntry>::const_iterator iter = m_unigrams.begin(); iter != m_unigrams.end(); ++iter) {
+                        word.set(&m_unigram_words[iter->m_word_offset], iter->m_word_len);
+                        gram_builder.add_unigram(word, iter->m_payload);
+
+                        //Update the progress bar status
+                        Logger::update_progress_bar();
+                    }
+                    LOG_DEBUG << "Actual number of " << SSTR(M_GRAM_LEVEL_1) << "-grams is: " << m_unigrams.size() << END_LOG;
+
+                    //Free the buffer memory, it is not needed any more
+                    vector<TUnigramEntry>().swap(m_unigrams);
+                    vector<char>().swap(m_unigram_words);
+                    m_is_unigrams_buffered = false;
+
+                    LOG_DEBUG << "Finished reading ARPA " << SSTR(M_GRAM_LEVEL_1) << "-Grams." << END_LOG;
+                    //Stop the progress bar in case of no exception
+                    Logger::stop_progress_bar();
+                }
+
+                //Iterate through the ARPA file and fill in the back-off model of the trie
+                //Note that, this file reader will be made ads flexible as possible,
+                //in other words is will ignore as much data as possible and will report
+                //as few errors as possible, mostly warnings. Also the Maximum N-Gram Level
+                //will be limited by the N parameter provided to the class template and not
+                //the maximum N-gram level present in the file.
+
+                template<typename TrieType, typename TFileReaderModel>
+                void ARPATrieBuilder<TrieType, TFileReaderModel>::build() {
+                    LOG_DEBUG << "Starting to read the file and build the trie ..." << END_LOG;
+
+                    //Declare an array of N-Gram counts, that is to be filled from the
+                    //headers. This data will be used to pre-allocate memory for the Trie 
+                    size_t counts[MAX_LEVEL];
+                    memset(counts, 0, MAX_LEVEL * sizeof (size_t));
+
+                    try {
+                        //Check if the M-gram levels can be read in parallel
+                        if (m_trie.is_parallel_build()) {
+                            if (!TrieType::is_levels_independent()) {
+                                LOG_WARNING << "The parallel build is not supported by this trie, "
+                                        << "the M-gram levels are read one by one!" << END_LOG;
+                            } else if (!is_same<TFileReaderModel, MemoryMappedFileReader>::value) {
+                                LOG_WARNING << "The parallel build needs the memory mapped model "
+                                        << "file reader, the M-gram levels are read one by one!" << END_LOG;
+                            } else {
+                                m_is_parallel_build = true;
+                            }
+                            //Tell the trie whether the M-grams will be inserted concurrently, by several threads
+                            m_trie.set_parallel_build(m_is_parallel_build);
+                        }
+
+                        //The ARPA headers and data section are already read, continue from the following line
+                        m_line = m_header.m_line;
+
+                        //Take the N-gram counts from the DATA section of ARPA
+                        for (size_t idx = 0; idx < m_header.m_counts.size(); ++idx) {
+                            if (idx < MAX_LEVEL) {
+                                counts[idx] = m_header.m_counts[idx];
+                            } else {
+                                LOG_WARNING << "The model has " << (idx + 1) << "-grams, the maximum allowed N-gram level is "
+                                        << MAX_LEVEL << "!" << END_LOG;
+                            }
+                        }
+
+                        //Pre-allocate memory
+                        pre_allocate(counts);
+
+                        //Get the word counts, if needed
+                        get_word_counts(counts[0]);
+
+                        //Read the N-grams, starting from 1-Grams
+                        read_grams<M_GRAM_LEVEL_1>();
+                    } catch (...) {
+                        //Stop the progress bar in case of an exception
+                        Logger::stop_progress_bar();
+                        throw;
+                    }
+
+                    LOG_DEBUG << "Done reading the file and building the trie." << END_LOG;
+                }
             }
         }
     }
@@ -31,6 +31,7 @@
 #include "Globals.hpp"
 #include "Logger.hpp"
 #include "TextPieceReader.hpp"
+#include "MemoryBreakdown.hpp"
 
 using namespace std;
 using namespace uva::smt::file;
@@ -189,6 +190,16 @@ namespace uva {
                         return false;
                     }
 
+                    /**
+                     * Allows to add the word index memory usage into the memory breakdown,
+                     * the entries are not related to one m-gram level.
+                     * This method is to be overridden by the children classes.
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                        THROW_MUST_OVERRIDE();
+                    }
+
                     /**
                      * The basic destructor
                      */
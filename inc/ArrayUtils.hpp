@@ -219,6 +219,51 @@ namespace uva {
                     BSEARCH_TWO_FIELDS(word_id, ctx_id);
                 }
 
+                /**
+                 * This is a binary search algorithm for some ordered array for two keys
+                 * @param ARR_ELEM_TYPE the array element structure, must have ctx_id field as this method will specifically use it to compare elements.
+                 * @param array the pointer to the first array element
+                 * @param l_idx the initial left border index for searching
+                 * @param u_idx the initial right border index for searching
+                 * @param key1 the context id we are searching for
+                 * @param key2 the word id we are searching for
+                 * @param found_pos the out parameter that stores the found element index, if any
+                 * @return true if the element was found, otherwise false
+                 * @throws Exception in case (l_idx < 0) || (l_idx > u_idx), with sanity checks on
+                 */
+                template<typename ARR_ELEM_TYPE>
+                inline bool my_bsearch_ctxId_wordId(const ARR_ELEM_TYPE * array, int64_t l_idx, int64_t u_idx, const TShortId key1, const TShortId key2, TShortId & found_pos) {
+                    BSEARCH_TWO_FIELDS(ctx_id, word_id);
+                }
+
+                /**
+                 * This is a branch-free binary search algorithm for some ordered array. The range
+                 * is halved a fixed number of times and the half is chosen with a conditional move,
+                 * so there are no mis-predicted branches, which pays off on the short arrays.
+                 * @param ARR_ELEM_TYPE the array element structure, must have id field as this method will specifically use it to compare elements.
+                 * @param KEY_TYPE the key type template parameter
+                 * @param array the pointer to the first array element
+                 * @param num_elems the number of array elements, must be > 0
+                 * @param key the key we are searching for
+                 * @param found_elem the out parameter that stores the found element, if any
+                 * @return true if the element was found, otherwise false
+                 */
+                template<typename ARR_ELEM_TYPE, typename KEY_TYPE>
+                inline bool my_branchless_search_id(const ARR_ELEM_TYPE * array, uint64_t num_elems,
+                        const KEY_TYPE key, const ARR_ELEM_TYPE * & found_elem) {
+                    ASSERT_SANITY_THROW((num_elems == 0), "Impossible search parameters, num_elems = 0!");
+
+                    //Keep the last element that is not larger than the key within [array, array + num_elems)
+                    while (num_elems > 1) {
+                        const uint64_t half = num_elems >> 1;
+                        array = (array[half].id <= key) ? (array + half) : array;
+                        num_elems -= half;
+                    }
+
+                    found_elem = array;
+                    return (array->id == key);
+                }
+
                 /**
                  * This is an interpolated search algorithm for some ordered array
                  * WARNING: IS ACTUALLY VERT SLOW at least in the current implementation and for the current application!
@@ -0,0 +1,533 @@
+/*
+ * File:   AsyncFileReader.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 10:12 AM
+ */
+
+#ifndef ASYNCFILEREADER_HPP
+#define	ASYNCFILEREADER_HPP
+
+#include <fcntl.h>              // std::open std::posix_fadvise
+#include <unistd.h>             // std::read std::close
+#include <errno.h>              // errno
+#include <cstring>              // std::memchr std::memcpy std::strerror
+#include <cstdlib>              // std::malloc std::realloc std::free
+#include <thread>               // std::thread
+#include <mutex>                // std::mutex std::unique_lock
+#include <condition_variable>   // std::condition_variable
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "StringUtils.hpp"
+#include "TextPieceReader.hpp"
+#include "AFileReader.hpp"
+
+using namespace std;
+using namespace uva::smt::utils::text;
+using namespace uva::smt::file::__AsyncFileReader;
+
+namespace uva {
+    namespace smt {
+        namespace file {
+
+            /**
+             * This is the file reader that reads the file in large blocks
+             * by a background thread. The blocks are stored in a ring of
+             * buffers, so while the lines of one block are being parsed the
+             * next blocks are already being read from the disk. Unlike the
+             * MemoryMappedFileReader it does not fault the entire file into
+             * memory and unlike the CStyleFileReader it does not block on
+             * the disk I/O for every read line.
+             *
+             * The lines that span over the block boundaries are glued
+             * together in a separate carry buffer. The text piece returned
+             * by get_first_line stays valid until the next call to it.
+             *
+             * In the direct I/O mode the file is opened with O_DIRECT, so
+             * the blocks are read bypassing the page cache. If the file
+             * system does not support it we fall back to the buffered I/O.
+             */
+            class AsyncFileReader : public AFileReader {
+            protected:
+                //Stores the file descriptor
+                int m_file_desc;
+                //Stores true if the reader thread has failed reading the file
+                bool m_is_error;
+                //Stores the errno of the failed read operation, if any
+                int m_error_no;
+
+            private:
+
+                /**
+                 * Stores the data of one file block
+                 */
+                struct SFileBlock {
+                    //The pointer to the block data, has one extra byte for the \0 terminator
+                    char * m_data_ptr;
+                    //The number of bytes read into the block
+                    size_t m_len;
+                    //True if this is the last block of the file
+                    bool m_is_last;
+                };
+
+                //Stores true if the direct I/O was requested
+                const bool m_is_direct_io;
+                //Stores the ring of file blocks
+                SFileBlock m_blocks[NUM_BLOCKS];
+
+                //The index of the block to be filled in next by the reader thread
+                size_t m_write_idx;
+                //The index of the block that is currently being parsed
+                size_t m_read_idx;
+                //The number of read blocks that have not been released by the parser yet
+                size_t m_num_ready;
+                //Stores true if the reader thread is requested to stop
+                bool m_is_stop;
+                //The synchronization mutex for the block ring
+                mutex m_blocks_mutex;
+                //The condition variable to notify about the ring changes
+                condition_variable m_blocks_cond;
+                //The background reader thread
+                thread m_reader;
+
+                //Stores true if the parser currently holds a block
+                bool m_is_block;
+                //The cursor within the currently parsed block
+                const char * m_cursor_ptr;
+                //The end of the currently parsed block
+                const char * m_end_ptr;
+
+                //Stores the line carried over the block boundaries
+                char * m_carry_ptr;
+                //Stores the carry buffer length
+                size_t m_carry_len;
+                //Stores the carry buffer capacity
+                size_t m_carry_cap;
+
+            public:
+
+                /**
+                 * The basic constructor
+                 * @param fileName the file name
+                 * @param is_direct_io true if the file is to be read bypassing the page cache
+                 */
+                AsyncFileReader(const char * fileName, const bool is_direct_io = false)
+                : AsyncFileReader(fileName, is_direct_io, true) {
+                }
+
+                /**
+                 * Allows to log the information about the instantiated file reader type
+                 */
+                virtual void log_reader_type_usage_info() {
+                    LOG_USAGE << "Using the <" << __FILE__ << "> file reader"
+                            << (m_is_direct_io ? " with direct I/O" : "") << "!" << END_LOG;
+                }
+
+                virtual ~AsyncFileReader() {
+                    //Close the file if it is still open
+                    close();
+                    //Clear memory
+                    free_buffers();
+                }
+
+                /**
+                 * Stops the reader thread, rewinds the file and starts reading it again
+                 */
+                virtual void reset() {
+                    if (m_file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                        stop_reader();
+
+                        //Re-set the ring and the parser state
+                        m_write_idx = 0;
+                        m_read_idx = 0;
+                        m_num_ready = 0;
+                        m_is_stop = false;
+                        m_is_error = false;
+                        m_is_block = false;
+                        m_cursor_ptr = NULL;
+                        m_end_ptr = NULL;
+                        m_carry_len = 0;
+
+                        //Rewind the file and start reading the blocks again
+                        rewind();
+                        start_reader();
+                    }
+                };
+
+                inline bool get_first_line(TextPieceReader& out) {
+                    LOG_DEBUG3 << "Searching for a new line, m_cursor_ptr = "
+                            << SSTR(static_cast<const void *> (m_cursor_ptr)) << END_LOG;
+
+                    //The carried over line, if any, has already been consumed
+                    m_carry_len = 0;
+
+                    while (true) {
+                        //Search for the end of line in the current block
+                        if (m_cursor_ptr < m_end_ptr) {
+                            const char * nl_ptr = static_cast<const char *> (memchr(m_cursor_ptr, '\n', m_end_ptr - m_cursor_ptr));
+                            if (nl_ptr != NULL) {
+                                if (m_carry_len == 0) {
+                                    //The entire line is within the current block
+                                    set_line(out, m_cursor_ptr, nl_ptr - m_cursor_ptr);
+                                } else {
+                                    //Complete the carried over line, keep the end of line for the look ahead
+                                    append_carry(m_cursor_ptr, (nl_ptr - m_cursor_ptr) + 1);
+                                    set_line(out, m_carry_ptr, m_carry_len - 1);
+                                }
+                                m_cursor_ptr = nl_ptr + 1;
+                                return true;
+                            } else {
+                                //The line continues in the next block
+                                append_carry(m_cursor_ptr, m_end_ptr - m_cursor_ptr);
+                                m_cursor_ptr = m_end_ptr;
+                            }
+                        }
+
+                        //The current block is exhausted, move on to the next one
+                        if (!next_block()) {
+                            if (m_is_error) {
+                                LOG_ERROR << "Error while reading the file: " << strerror(m_error_no) << END_LOG;
+                                return false;
+                            }
+                            if (m_carry_len != 0) {
+                                //The last line of the file has no end of line
+                                m_carry_ptr[m_carry_len] = '\0';
+                                set_line(out, m_carry_ptr, m_carry_len);
+                                return true;
+                            }
+                            LOG_DEBUG2 << "The end of file is reached!" << END_LOG;
+                            return false;
+                        }
+                    }
+                }
+
+                /**
+                 * This method is used to check if the file was successfully opened.
+                 * @return true if the file is successfully opened otherwise false.
+                 */
+                virtual bool is_open() const {
+                    return (m_file_desc != UNDEFINED_FILE_DESCRIPTOR);
+                }
+
+                /**
+                 * Checks if the file is present.
+                 * @return true if it is
+                 */
+                virtual operator bool() const {
+                    return is_open();
+                }
+
+                /**
+                 * This method should be used to close the file
+                 */
+                virtual void close() {
+                    if (m_file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                        stop_reader();
+                        LOG_DEBUG << "Closing the Async File Reader file!" << END_LOG;
+                        ::close(m_file_desc);
+                        m_file_desc = UNDEFINED_FILE_DESCRIPTOR;
+                    }
+                };
+
+            protected:
+
+                /**
+                 * The constructor to be used by the derived classes. The
+                 * derived class that overrides fill_block must start the
+                 * reader thread itself, once it is fully constructed.
+                 * @param fileName the file name
+                 * @param is_direct_io true if the file is to be read bypassing the page cache
+                 * @param is_start_reader true if the reader thread is to be started right away
+                 */
+                AsyncFileReader(const char * fileName, const bool is_direct_io, const bool is_start_reader)
+                : AFileReader(), m_file_desc(UNDEFINED_FILE_DESCRIPTOR), m_is_error(false), m_error_no(0),
+                m_is_direct_io(is_direct_io), m_write_idx(0), m_read_idx(0), m_num_ready(0), m_is_stop(false),
+                m_is_block(false), m_cursor_ptr(NULL), m_end_ptr(NULL), m_carry_ptr(NULL), m_carry_len(0), m_carry_cap(0) {
+                    //Open the file for reading
+                    m_file_desc = open_file(fileName);
+
+                    LOG_DEBUG << "Opened the file '" << fileName << "' descriptor: "
+                            << SSTR(m_file_desc) << ", attempting to allocate "
+                            << NUM_BLOCKS << " blocks of " << BLOCK_SIZE_BYTES
+                            << " bytes" << END_LOG;
+
+                    for (size_t idx = 0; idx < NUM_BLOCKS; ++idx) {
+                        m_blocks[idx].m_data_ptr = NULL;
+                        m_blocks[idx].m_len = 0;
+                        m_blocks[idx].m_is_last = false;
+                    }
+
+                    if (m_file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+#ifndef __APPLE__
+                        //Tell the kernel we are going to read the file sequentially
+                        (void) posix_fadvise(m_file_desc, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+                        //Allocate the blocks memory, aligned for the direct I/O
+                        bool is_allocated = true;
+                        for (size_t idx = 0; is_allocated && (idx < NUM_BLOCKS); ++idx) {
+                            void * data_ptr = NULL;
+                            is_allocated = (posix_memalign(&data_ptr, BLOCK_ALIGNMENT_BYTES,
+                                    BLOCK_SIZE_BYTES + BLOCK_ALIGNMENT_BYTES) == 0);
+                            m_blocks[idx].m_data_ptr = (is_allocated ? static_cast<char *> (data_ptr) : NULL);
+                        }
+
+                        //Allocate the initial carry buffer
+                        if (is_allocated) {
+                            m_carry_cap = MAX_N_GRAM_STRING_LENGTH;
+                            m_carry_ptr = static_cast<char *> (malloc(m_carry_cap));
+                            is_allocated = (m_carry_ptr != NULL);
+                        }
+
+                        //The destructor is not called if the constructor throws, so clean up here
+                        if (!is_allocated) {
+                            close();
+                            free_buffers();
+                            THROW_EXCEPTION(string("Unable to allocate the read buffers of the file: ") + fileName);
+                        }
+
+                        //Start reading the file blocks, unless the derived class does it
+                        if (is_start_reader) {
+                            start_reader();
+                        }
+                    }
+                }
+
+                /**
+                 * Frees the blocks and the carry buffer memory, if allocated
+                 */
+                inline void free_buffers() {
+                    for (size_t idx = 0; idx < NUM_BLOCKS; ++idx) {
+                        if (m_blocks[idx].m_data_ptr != NULL) {
+                            free(m_blocks[idx].m_data_ptr);
+                            m_blocks[idx].m_data_ptr = NULL;
+                        }
+                    }
+                    if (m_carry_ptr != NULL) {
+                        free(m_carry_ptr);
+                        m_carry_ptr = NULL;
+                    }
+                }
+
+
+                /**
+                 * Starts the background reader thread
+                 */
+                inline void start_reader() {
+                    m_reader = thread(&AsyncFileReader::read_blocks, this);
+                }
+
+                /**
+                 * Asks the reader thread to stop and waits for it to finish
+                 */
+                inline void stop_reader() {
+                    if (m_reader.joinable()) {
+                        {
+                            lock_guard<mutex> lock(m_blocks_mutex);
+                            m_is_stop = true;
+                        }
+                        m_blocks_cond.notify_all();
+                        m_reader.join();
+                    }
+                }
+
+                /**
+                 * Rewinds the file to its beginning, is called when the reader thread is stopped
+                 */
+                virtual void rewind() {
+                    lseek(m_file_desc, 0, SEEK_SET);
+                }
+
+                /**
+                 * Reads as much data as fits into the block or until the end of file.
+                 * Is called from the reader thread, so the derived classes can put
+                 * here some extra data processing, e.g. decompression.
+                 * @param data_ptr the block data pointer, has BLOCK_SIZE_BYTES of space
+                 * @param len [out] the number of bytes put into the block
+                 * @return true if the end of file is reached or an error occurred
+                 */
+                virtual bool fill_block(char * data_ptr, size_t & len) {
+                    len = 0;
+                    while (len < BLOCK_SIZE_BYTES) {
+                        const ssize_t num_read = read(m_file_desc, data_ptr + len, BLOCK_SIZE_BYTES - len);
+                        if (num_read > 0) {
+                            len += num_read;
+                        } else {
+                            if ((num_read < 0) && (errno == EINTR)) {
+                                continue;
+                            }
+#if defined(O_DIRECT)
+                            if ((num_read < 0) && (errno == EINVAL) && m_is_direct_io) {
+                                //The direct I/O constraints are not met, switch to buffered I/O
+                                (void) fcntl(m_file_desc, F_SETFL, fcntl(m_file_desc, F_GETFL) & ~O_DIRECT);
+                                continue;
+                            }
+#endif
+                            if (num_read < 0) {
+                                m_error_no = errno;
+                                m_is_error = true;
+                            }
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+            private:
+
+                /**
+                 * Opens the file for reading, in the direct I/O mode tries to bypass the page cache
+                 * @param fileName the file name
+                 * @return the file descriptor
+                 */
+                inline int open_file(const char * fileName) {
+                    if (m_is_direct_io) {
+#if defined(O_DIRECT)
+                        const int file_desc = open(fileName, O_RDONLY | O_DIRECT);
+                        if (file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                            return file_desc;
+                        }
+                        LOG_WARNING << "Could not open '" << fileName << "' for direct I/O: "
+                                << strerror(errno) << ", using the buffered I/O!" << END_LOG;
+#elif defined(F_NOCACHE)
+                        const int file_desc = open(fileName, O_RDONLY);
+                        if (file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                            (void) fcntl(file_desc, F_NOCACHE, 1);
+                        }
+                        return file_desc;
+#endif
+                    }
+                    return open(fileName, O_RDONLY);
+                }
+
+                /**
+                 * Sets the line into the output parameter, removes the trailing \r if any
+                 * @param out the output text piece
+                 * @param begin_ptr the line begin pointer
+                 * @param len the line length without the end of line
+                 */
+                inline void set_line(TextPieceReader& out, const char * begin_ptr, size_t len) {
+                    //For Windows-format strings, remove the '\r' as well
+                    if (len && (begin_ptr[len - 1] == '\r')) {
+                        len--;
+                    }
+                    LOG_DEBUG2 << "Read " << len << " symbols!" << END_LOG;
+                    out.set(begin_ptr, len);
+                }
+
+                /**
+                 * Appends the given text to the carry buffer, leaves place for the \0 terminator
+                 * @param begin_ptr the text begin pointer
+                 * @param len the text length
+                 */
+                inline void append_carry(const char * begin_ptr, const size_t len) {
+                    if (m_carry_len + len + 1 > m_carry_cap) {
+                        while (m_carry_len + len + 1 > m_carry_cap) {
+                            m_carry_cap *= 2;
+                        }
+                        char * const carry_ptr = static_cast<char *> (realloc(m_carry_ptr, m_carry_cap));
+                        if (carry_ptr == NULL) {
+                            THROW_EXCEPTION(string("Unable to increase the carry buffer capacity to ")
+                                    + std::to_string(m_carry_cap) + string(" bytes"));
+                        }
+                        m_carry_ptr = carry_ptr;
+                        LOG_DEBUG1 << "Increased the carry buffer capacity to " << m_carry_cap << " bytes" << END_LOG;
+                    }
+                    memcpy(m_carry_ptr + m_carry_len, begin_ptr, len);
+                    m_carry_len += len;
+                }
+
+                /**
+                 * Releases the currently parsed block, if any, and waits for the next one
+                 * @return true if the next block is available, false if it is the end of file
+                 */
+                inline bool next_block() {
+                    unique_lock<mutex> lock(m_blocks_mutex);
+
+                    if (m_is_block) {
+                        //Check if the released block was the last one
+                        if (m_blocks[m_read_idx].m_is_last) {
+                            m_cursor_ptr = m_end_ptr = NULL;
+                            return false;
+                        }
+                        //Give the block back to the reader thread
+                        m_read_idx = (m_read_idx + 1) % NUM_BLOCKS;
+                        m_num_ready--;
+                        m_is_block = false;
+                        m_blocks_cond.notify_all();
+                    }
+
+                    //Wait until the next block has been read
+                    m_blocks_cond.wait(lock, [this] {
+                        return (m_num_ready > 0);
+                    });
+
+                    //Take the next block for parsing
+                    m_is_block = true;
+                    m_cursor_ptr = m_blocks[m_read_idx].m_data_ptr;
+                    m_end_ptr = m_cursor_ptr + m_blocks[m_read_idx].m_len;
+
+                    LOG_DEBUG1 << "Got the next block of " << m_blocks[m_read_idx].m_len << " bytes" << END_LOG;
+
+                    return (m_blocks[m_read_idx].m_len != 0) || !m_blocks[m_read_idx].m_is_last;
+                }
+
+                /**
+                 * The reader thread function, fills in the free blocks of the ring
+                 */
+                void read_blocks() {
+                    bool is_last = false;
+                    while (!is_last) {
+                        //Wait until there is a free block or we are asked to stop
+                        {
+                            unique_lock<mutex> lock(m_blocks_mutex);
+                            m_blocks_cond.wait(lock, [this] {
+                                return m_is_stop || (m_num_ready < NUM_BLOCKS);
+                            });
+                            if (m_is_stop) {
+                                return;
+                            }
+                        }
+
+                        //Read the block, this is done without holding the lock
+                        SFileBlock & block = m_blocks[m_write_idx];
+                        is_last = fill_block(block.m_data_ptr, block.m_len);
+                        block.m_is_last = is_last;
+                        //Terminate the data for the look-ahead float parsing
+                        block.m_data_ptr[block.m_len] = '\0';
+
+                        //Give the block to the parser
+                        {
+                            lock_guard<mutex> lock(m_blocks_mutex);
+                            m_write_idx = (m_write_idx + 1) % NUM_BLOCKS;
+                            m_num_ready++;
+                        }
+                        m_blocks_cond.notify_all();
+                    }
+                }
+            };
+        }
+    }
+}
+
+#endif	/* ASYNCFILEREADER_HPP */
+
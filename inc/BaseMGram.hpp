@@ -186,6 +186,15 @@ namespace uva {
                         return m_word_ids;
                     }
 
+                    /**
+                     * Allows to get the m-gram tokens, as read from the text.
+                     * @return the pointer to the first token element
+                     */
+                    inline const TextPieceReader * tokens() const {
+
+                        return m_tokens;
+                    }
+
                     /**
                      * The basic to string conversion operator for the m-gram
                      */
@@ -230,6 +239,18 @@ namespace uva {
                         return len_bytes;
                     }
 
+                    /**
+                     * Allows to compute the m-gram id for the sub-m-gram into the given memory
+                     * @param begin_word_idx the index of the first word in the sub-m-gram, indexes start with 0
+                     * @param number_of_words the number of sub-m-gram words
+                     * @param p_m_gram_id the pointer to the memory to write the id into, must have
+                     *                    at least T_M_Gram_Id::MAX_ID_LEN_BYTES[number_of_words] bytes
+                     * @return the id length in bytes
+                     */
+                    inline uint8_t compute_m_gram_id(const TModelLevel begin_word_idx, const TModelLevel number_of_words, TM_Gram_Id_Value_Ptr p_m_gram_id) const {
+                        return T_M_Gram_Id::compute_m_gram_id(&m_word_ids[begin_word_idx], number_of_words, p_m_gram_id);
+                    }
+
                     /**
                      * Allows to create a new m-gram id for the sub-m-gram defined by the given of the method template parameters.
                      * For the argument reference to the id data pointer the following holds:
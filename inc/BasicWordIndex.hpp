@@ -194,6 +194,26 @@ namespace uva {
                         return true;
                     }
 
+                    /**
+                     * @see AWordIndex
+                     * The map nodes and buckets are in the greedy memory storage, the
+                     * words not fitting into the string objects are on the heap.
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                        if (m_word_index_map_ptr != NULL) {
+                            breakdown.add("BasicWordIndex", "map", MemoryBreakdown::NO_LEVEL,
+                                    m_word_index_alloc_ptr->getStorageRef().getBufferSizeBytes());
+                            uint64_t strings_bytes = 0;
+                            for (TWordIndexMapConstIter iter = m_word_index_map_ptr->begin(); iter != m_word_index_map_ptr->end(); ++iter) {
+                                const char * const begin = reinterpret_cast<const char *> (&iter->first);
+                                if ((iter->first.data() < begin) || (iter->first.data() >= begin + sizeof (string))) {
+                                    strings_bytes += iter->first.capacity() + 1;
+                                }
+                            }
+                            breakdown.add("BasicWordIndex", "strings", MemoryBreakdown::NO_LEVEL, strings_bytes);
+                        }
+                    }
+
                     /**
                      * The basic destructor
                      */
@@ -36,6 +36,7 @@
 #include "ModelMGram.hpp"
 #include "HashingUtils.hpp"
 #include "MathUtils.hpp"
+#include "MemoryBreakdown.hpp"
 
 using namespace std;
 
@@ -106,14 +107,14 @@ namespace uva {
                      * Allows to add the M-gram to the cache
                      * @param gram the M-gram to cache
                      */
-                    template<typename WordIndexType>
-                    inline void cache_m_gram_hash(const T_Model_M_Gram<WordIndexType> gram) {
+                    template<typename WordIndexType, TModelLevel MAX_LEVEL>
+                    inline void cache_m_gram_hash(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> gram) {
                         LOG_DEBUG2 << "Adding M-gram: " << (string) gram << END_LOG;
 
                         //Get the bit position
                         uint32_t byte_idx = 0;
                         uint32_t bit_offset_idx = 0;
-                        get_bit_pos<WordIndexType>(gram, byte_idx, bit_offset_idx);
+                        get_bit_pos<WordIndexType, MAX_LEVEL>(gram, byte_idx, bit_offset_idx);
 
                         LOG_DEBUG2 << "Adding: " << bitset<NUM_BITS_IN_UINT_8>(ON_BIT_ARRAY[bit_offset_idx])
                                 << ", to: " << bitset<NUM_BITS_IN_UINT_8>(m_data_ptr[byte_idx]) << END_LOG;
@@ -122,6 +123,25 @@ namespace uva {
                         m_data_ptr[byte_idx] |= ON_BIT_ARRAY[bit_offset_idx];
                     }
 
+                    /**
+                     * Allows to add the M-gram to the cache, this method may be called from several
+                     * threads at once, the bit is set with an atomic or. The cache may only be
+                     * queried once all the adding threads are joined.
+                     * @param gram the M-gram to cache
+                     */
+                    template<typename WordIndexType, TModelLevel MAX_LEVEL>
+                    inline void cache_m_gram_hash_concurrent(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
+                        LOG_DEBUG2 << "Adding M-gram: " << (string) gram << END_LOG;
+
+                        //Get the bit position
+                        uint32_t byte_idx = 0;
+                        uint32_t bit_offset_idx = 0;
+                        get_bit_pos<WordIndexType, MAX_LEVEL>(gram, byte_idx, bit_offset_idx);
+
+                        //Set the bit on, the neighbouring bits may be set by the other threads
+                        (void) __atomic_fetch_or(&m_data_ptr[byte_idx], ON_BIT_ARRAY[bit_offset_idx], __ATOMIC_RELAXED);
+                    }
+
                     /**
                      * Allows to check if the given sub-m-gram, defined by the begin_word_idx
                      * and end_word_idx parameters, is potentially present in the trie.
@@ -142,6 +162,17 @@ namespace uva {
                         return (m_data_ptr[byte_idx] & ON_BIT_ARRAY[bit_offset_idx]);
                     }
 
+                    /**
+                     * Allows to add the bitset memory usage into the memory breakdown
+                     * @param breakdown the memory breakdown to add to
+                     * @param level the m-gram level of the cached m-grams
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown, const TModelLevel level) const {
+                        if (m_data_ptr != NULL) {
+                            breakdown.add("BitmapHashCache", "filter", level, NUM_BYTES_4_BITS(m_num_buckets));
+                        }
+                    }
+
                 private:
                     //Stores the number of elements this bitset was pre-allocated for
                     size_t m_num_buckets;
@@ -179,8 +210,8 @@ namespace uva {
                      * @param byte_idx [out] the M-gram byte index
                      * @param bit_offset_idx [out] the M-gram relative bit index
                      */
-                    template<typename WordIndexType>
-                    inline void get_bit_pos(const T_Model_M_Gram<WordIndexType> &gram, uint32_t & byte_idx, uint32_t & bit_offset_idx) const {
+                    template<typename WordIndexType, TModelLevel MAX_LEVEL>
+                    inline void get_bit_pos(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> &gram, uint32_t & byte_idx, uint32_t & bit_offset_idx) const {
                         uint_fast64_t key = gram.get_hash();
 
                         LOG_DEBUG2 << "The M-gram: " << (string) gram << " hash: " << key << END_LOG;
@@ -27,6 +27,7 @@
 #define	BYTEMGRAMID_HPP
 
 #include <string>       // std::string
+#include <cstdlib>      // std::realloc std::free
 
 #include "Globals.hpp"
 #include "Exceptions.hpp"
@@ -57,12 +58,17 @@ namespace uva {
                     //Define the basic type as an alias for the compressed M-Gram id
                     typedef uint8_t * TM_Gram_Id_Value_Ptr;
 
+                    //Define the offset of an m-gram id stored in the Byte_M_Gram_Id_Arena
+                    typedef uint32_t TM_Gram_Id_Offset;
+
                     /**
                      * This structure defined the m-gram id key which consists of the m-gram id and its length in bytes
+                     * and the beginning of the id arena, the stored elements keep their ids as offsets into it
                      */
                     typedef struct {
                         TM_Gram_Id_Value_Ptr m_id;
                         uint8_t m_len_bytes;
+                        TM_Gram_Id_Value_Ptr m_arena;
                     } T_Gram_Id_Key;
 
                     /**
@@ -88,6 +94,126 @@ namespace uva {
                         }
                     }
 
+                    /**
+                     * This is a contiguous byte storage for the m-gram ids of one level.
+                     * The ids are appended one after another and are referenced by their
+                     * 32 bit offsets, this way there is no per-id heap allocation and no
+                     * pointer to store. The storage is re-allocated if it runs out of space
+                     * so the id pointers are only stable once all the ids are added.
+                     */
+                    class Byte_M_Gram_Id_Arena {
+                    public:
+
+                        /**
+                         * The basic constructor, creates an empty arena
+                         */
+                        Byte_M_Gram_Id_Arena() : m_data(NULL), m_size(0), m_capacity(0), m_pad_bytes(0) {
+                        }
+
+                        //The arena owns its memory, so copying it would free the memory twice
+                        Byte_M_Gram_Id_Arena(const Byte_M_Gram_Id_Arena &) = delete;
+                        Byte_M_Gram_Id_Arena & operator=(const Byte_M_Gram_Id_Arena &) = delete;
+
+                        /**
+                         * Allows to reserve the memory for the given number of ids
+                         * @param num_ids the number of ids to be stored
+                         * @param max_len_bytes the maximum length of one id in bytes
+                         */
+                        inline void reserve(const size_t num_ids, const uint8_t max_len_bytes) {
+                            //Keep one maximum id length after the last id, so that comparing
+                            //with a longer key never reads outside of the allocated memory
+                            m_pad_bytes = max_len_bytes;
+                            re_allocate(num_ids * max_len_bytes + m_pad_bytes);
+                        }
+
+                        /**
+                         * Allows to get the pointer to write the next id into
+                         * @param max_len_bytes the maximum length of the id to be written
+                         * @return the pointer to the free memory of at least max_len_bytes
+                         */
+                        inline TM_Gram_Id_Value_Ptr get_free_ptr(const uint8_t max_len_bytes) {
+                            if ((m_size + max_len_bytes + m_pad_bytes) > m_capacity) {
+                                re_allocate(2 * m_capacity + max_len_bytes + m_pad_bytes);
+                            }
+                            return m_data + m_size;
+                        }
+
+                        /**
+                         * Allows to register the id written into the pointer given by get_free_ptr
+                         * @param len_bytes the length of the written id in bytes
+                         * @return the offset of the id in the arena
+                         */
+                        inline TM_Gram_Id_Offset commit(const uint8_t len_bytes) {
+                            ASSERT_CONDITION_THROW(((m_size + len_bytes) > UINT32_MAX),
+                                    string("The m-gram id arena exceeds the maximum offset: ") + std::to_string(UINT32_MAX));
+                            const TM_Gram_Id_Offset offset = static_cast<TM_Gram_Id_Offset> (m_size);
+                            m_size += len_bytes;
+                            return offset;
+                        }
+
+                        /**
+                         * Allows to free the reserved but unused memory, to be called once all the ids are added
+                         */
+                        inline void shrink() {
+                            if (m_data != NULL) {
+                                re_allocate(m_size + m_pad_bytes);
+                            }
+                        }
+
+                        /**
+                         * Allows to get the beginning of the arena, the ids are stored at their offsets from it
+                         * @return the beginning of the arena
+                         */
+                        inline TM_Gram_Id_Value_Ptr data() const {
+                            return m_data;
+                        }
+
+                        /**
+                         * Allows to get the number of used bytes
+                         * @return the number of used bytes
+                         */
+                        inline size_t size() const {
+                            return m_size;
+                        }
+
+                        /**
+                         * Allows to get the number of allocated bytes
+                         * @return the number of allocated bytes
+                         */
+                        inline size_t capacity() const {
+                            return m_capacity;
+                        }
+
+                        /**
+                         * The basic destructor
+                         */
+                        ~Byte_M_Gram_Id_Arena() {
+                            free(m_data);
+                        }
+
+                    private:
+                        //Stores the arena memory
+                        TM_Gram_Id_Value_Ptr m_data;
+                        //Stores the number of used bytes
+                        size_t m_size;
+                        //Stores the number of allocated bytes
+                        size_t m_capacity;
+                        //Stores the number of bytes to be kept after the last id
+                        uint8_t m_pad_bytes;
+
+                        /**
+                         * Re-allocates the arena memory to the given capacity
+                         * @param capacity the new capacity in bytes
+                         */
+                        inline void re_allocate(const size_t capacity) {
+                            TM_Gram_Id_Value_Ptr data = static_cast<TM_Gram_Id_Value_Ptr> (realloc(m_data, capacity));
+                            ASSERT_CONDITION_THROW((data == NULL), string("Could not allocate the m-gram id arena of ")
+                                    + std::to_string(capacity) + string(" bytes"));
+                            m_data = data;
+                            m_capacity = capacity;
+                        }
+                    };
+
                     /**
                      * The byte-compressed implementation of the M-gram id class
                      */
@@ -99,7 +225,7 @@ namespace uva {
                         static constexpr uint8_t NUM_BYTES_WORD_ID = sizeof (TWordIdType);
 
                         /**
-                         * Stores the m-gram id multipliers multipliers up to and including level 7
+                         * Stores the m-gram id multipliers multipliers up to and including level 10
                          */
                         static constexpr uint32_t NUMBER_ID_TYPES_PER_LEVEL[] = {
                             const_expr::power(NUM_BYTES_WORD_ID, 0),
@@ -109,7 +235,10 @@ namespace uva {
                             const_expr::power(NUM_BYTES_WORD_ID, 4),
                             const_expr::power(NUM_BYTES_WORD_ID, 5),
                             const_expr::power(NUM_BYTES_WORD_ID, 6),
-                            const_expr::power(NUM_BYTES_WORD_ID, 7)
+                            const_expr::power(NUM_BYTES_WORD_ID, 7),
+                            const_expr::power(NUM_BYTES_WORD_ID, 8),
+                            const_expr::power(NUM_BYTES_WORD_ID, 9),
+                            const_expr::power(NUM_BYTES_WORD_ID, 10)
                         };
 
                         //Allows to compute the byte length of the id type if the word ids are of
@@ -128,7 +257,10 @@ namespace uva {
                             N_GRAM_ID_TYPE_LEN_BYTES(4),
                             N_GRAM_ID_TYPE_LEN_BYTES(5),
                             N_GRAM_ID_TYPE_LEN_BYTES(6),
-                            N_GRAM_ID_TYPE_LEN_BYTES(7)
+                            N_GRAM_ID_TYPE_LEN_BYTES(7),
+                            N_GRAM_ID_TYPE_LEN_BYTES(8),
+                            N_GRAM_ID_TYPE_LEN_BYTES(9),
+                            N_GRAM_ID_TYPE_LEN_BYTES(10)
                         };
 
                         //Allows to compute the byte length of the N-gram id if the word ids are of
@@ -138,7 +270,7 @@ namespace uva {
 #define MAX_N_GRAM_ID_LEN_BYTES(LEVEL)  static_cast<uint8_t> ((LEVEL) * NUM_BYTES_WORD_ID + ID_TYPE_LEN_BYTES[LEVEL])
 
                         //Stores the maximum number of bits up to and including M-grams
-                        //of level 7.  We use sizeof (TWordIdType) as each word_id is of type
+                        //of level 10.  We use sizeof (TWordIdType) as each word_id is of type
                         //TWordIdType, and the maximum number of bits is thus defined by the
                         //number of word_ids in the M-gram and their max size in bytes.
                         static constexpr uint8_t MAX_ID_LEN_BYTES[] = {
@@ -149,15 +281,19 @@ namespace uva {
                             MAX_N_GRAM_ID_LEN_BYTES(4),
                             MAX_N_GRAM_ID_LEN_BYTES(5),
                             MAX_N_GRAM_ID_LEN_BYTES(6),
-                            MAX_N_GRAM_ID_LEN_BYTES(7)
+                            MAX_N_GRAM_ID_LEN_BYTES(7),
+                            MAX_N_GRAM_ID_LEN_BYTES(8),
+                            MAX_N_GRAM_ID_LEN_BYTES(9),
+                            MAX_N_GRAM_ID_LEN_BYTES(10)
                         };
 
+                        //Make sure the id type values fit into the uint32_t for all the supported levels
+                        static_assert((const_expr::power(NUM_BYTES_WORD_ID, MAX_SUPP_GRAM_LEVEL) - 1) <= UINT32_MAX,
+                                "The m-gram id type of the maximum supported level does not fit into uint32_t!");
+
                         //Allows to declare the stack allocated m-gram id for the given level and with the given name
 #define DECLARE_STACK_GRAM_ID(type, name, level) uint8_t name[type::MAX_ID_LEN_BYTES[(level)]];
 
-                        //Stores the mapping from the m-gram id lengths into the id type value, is pre-computed
-#include "ByteMGramIdTables.hpp"
-
                         /**
                          * This method allows to create new M-gram id for the given M-gram.
                          * There should be no memory allocated for the M-gram id. This method
@@ -189,16 +325,30 @@ namespace uva {
                          */
                         static inline void allocate_byte_m_gram_id(const TModelLevel level, TM_Gram_Id_Value_Ptr & m_p_gram_id) {
                             //Do the sanity check for against overflows
-                            ASSERT_SANITY_THROW((level > M_GRAM_LEVEL_6),
+                            ASSERT_SANITY_THROW((level > MAX_SUPP_GRAM_LEVEL),
                                     string("Byte_M_Gram_Id: Unsupported m-gram level: ")
                                     + std::to_string(level) + string(", must be within [")
                                     + std::to_string(M_GRAM_LEVEL_2) + string(", ")
-                                    + std::to_string(M_GRAM_LEVEL_6) + string("], see M_GRAM_MAX_ID_LEN_BYTES array!"));
+                                    + std::to_string(MAX_SUPP_GRAM_LEVEL) + string("], see M_GRAM_MAX_ID_LEN_BYTES array!"));
 
                             //Allocate maximum memory that could be needed to store the given M-gram level id
                             m_gram_id::allocate_m_gram_id(m_p_gram_id, MAX_ID_LEN_BYTES[level]);
                         }
 
+                        /**
+                         * Allows to get the maximum id length in bytes for the given level and the maximum word id
+                         * @param level the m-gram level
+                         * @param max_word_id the maximum word id
+                         * @return the maximum id length in bytes
+                         */
+                        static inline uint8_t get_max_id_len_bytes(const TModelLevel level, const TWordIdType max_word_id) {
+                            uint8_t word_len_bytes = 1;
+                            while ((word_len_bytes < NUM_BYTES_WORD_ID) && ((max_word_id >> BYTES_TO_BITS(word_len_bytes)) != 0)) {
+                                ++word_len_bytes;
+                            }
+                            return ID_TYPE_LEN_BYTES[level] + level * word_len_bytes;
+                        }
+
                         /**
                          * Allows to compare two M-Gram ids of a fixed M-gram level
                          * @param id_len_bytes the minimum total number of bytes in both m-gram ids.
@@ -248,61 +398,45 @@ namespace uva {
 
                         /**
                          * Allows to compute the byte length for the id of the given type.
-                         * Can compute the byte length for the M-grams until ( and including) M = 6.
+                         * The id type is a NUM_BYTES_WORD_ID-based number with one digit per
+                         * word id, each digit is the word id length in bytes minus one, see
+                         * gram_id_byte_len_2_type. So we just sum up the decoded lengths.
                          * @param CURR_LEVEL the M-Gram level M
                          * @param id_type the type id
-                         * @return the total byte length to store the id of this type.
+                         * @return the total byte length of the word ids stored in the id of this type.
                          */
                         template<TModelLevel CURR_LEVEL>
-                        static inline const uint8_t & gram_id_type_2_byte_len(uint32_t id_type) {
+                        static inline uint8_t gram_id_type_2_byte_len(uint32_t id_type) {
                             LOG_DEBUG3 << "Computing the " << SSTR(CURR_LEVEL) << "-gram id len in bytes" << END_LOG;
 
-                            //Depending on the level return the pre-computed value
-                            switch (CURR_LEVEL) {
-                                case M_GRAM_LEVEL_5:
-                                    return LEVEL_5_GRAM_TO_BYTE_LEN[id_type];
-                                case M_GRAM_LEVEL_4:
-                                    return LEVEL_4_GRAM_TO_BYTE_LEN[id_type];
-                                case M_GRAM_LEVEL_3:
-                                    return LEVEL_3_GRAM_TO_BYTE_LEN[id_type];
-                                case M_GRAM_LEVEL_2:
-                                    return LEVEL_2_GRAM_TO_BYTE_LEN[id_type];
-                                case M_GRAM_LEVEL_6:
-                                    return LEVEL_6_GRAM_TO_BYTE_LEN[id_type];
-                                default:
-                                    THROW_EXCEPTION(string("Unsupported m-gram level: ") + std::to_string(CURR_LEVEL) +
-                                            string(", must be within [") + std::to_string(M_GRAM_LEVEL_2) + string(", ") +
-                                            std::to_string(M_GRAM_LEVEL_6) + string("], insufficient data!"));
+                            uint8_t id_len_bytes = CURR_LEVEL;
+                            for (TModelLevel idx = 0; idx < CURR_LEVEL; ++idx) {
+                                id_len_bytes += static_cast<uint8_t> (id_type % NUM_BYTES_WORD_ID);
+                                id_type /= NUM_BYTES_WORD_ID;
                             }
+                            return id_len_bytes;
                         }
 
                         /**
                          * This method is needed to compute the id type identifier.
-                         * Can compute the id type for the M-grams until (and including) M = 6
+                         * The type is computed as in a NUM_BYTES_WORD_ID-based numeric system, e.g. for M==5:
+                         *          (len_bytes[0]-1)*N^0 + (len_bytes[1]-1)*N^1 +
+                         *          (len_bytes[2]-1)*N^2 + (len_bytes[3]-1)*N^3 +
+                         *          (len_bytes[4]-1)*N^4
+                         * where N is NUM_BYTES_WORD_ID. This way there are no per-level
+                         * tables and any level up to MAX_SUPP_GRAM_LEVEL is supported.
                          * @param gram_level the number of word ids
                          * @param len_bytes the bytes needed per word id
-                         * @param return the resulting id type the initial value is expected to be 0
+                         * @param return the resulting id type
                          */
-                        static inline const uint32_t & gram_id_byte_len_2_type(const TModelLevel gram_level, uint8_t * len_bytes) {
+                        static inline uint32_t gram_id_byte_len_2_type(const TModelLevel gram_level, const uint8_t * len_bytes) {
                             LOG_DEBUG3 << "Computing the " << SSTR(gram_level) << "-gram id type" << END_LOG;
 
-                            //Depending on the level return the pre-computed value
-                            switch (gram_level) {
-                                case M_GRAM_LEVEL_5:
-                                    return LEVEL_5_GRAM_TO_TYPE_LEN[len_bytes[0]][len_bytes[1]][len_bytes[2]][len_bytes[3]][len_bytes[4]];
-                                case M_GRAM_LEVEL_4:
-                                    return LEVEL_4_GRAM_TO_TYPE_LEN[len_bytes[0]][len_bytes[1]][len_bytes[2]][len_bytes[3]];
-                                case M_GRAM_LEVEL_3:
-                                    return LEVEL_3_GRAM_TO_TYPE_LEN[len_bytes[0]][len_bytes[1]][len_bytes[2]];
-                                case M_GRAM_LEVEL_2:
-                                    return LEVEL_2_GRAM_TO_TYPE_LEN[len_bytes[0]][len_bytes[1]];
-                                case M_GRAM_LEVEL_6:
-                                    return LEVEL_6_GRAM_TO_TYPE_LEN[len_bytes[0]][len_bytes[1]][len_bytes[2]][len_bytes[3]][len_bytes[4]][len_bytes[5]];
-                                default:
-                                    THROW_EXCEPTION(string("Unsupported m-gram level: ") + std::to_string(gram_level) +
-                                            string(", must be within [") + std::to_string(M_GRAM_LEVEL_2) + string(", ") +
-                                            std::to_string(M_GRAM_LEVEL_6) + string("], insufficient data!"));
+                            uint32_t id_type = 0;
+                            for (TModelLevel idx = 0; idx < gram_level; ++idx) {
+                                id_type += (static_cast<uint32_t> (len_bytes[idx]) - 1) * NUMBER_ID_TYPES_PER_LEVEL[idx];
                             }
+                            return id_type;
                         };
 
                         /**
@@ -325,7 +459,7 @@ namespace uva {
                                 copy_begin_bytes_to_end(one, id_type_len_bytes, type_one);
 
                                 //Compute the length of the remainder of the m-gram id 
-                                const uint8_t & id_len_bytes = gram_id_type_2_byte_len<CURR_LEVEL>(type_one);
+                                const uint8_t id_len_bytes = gram_id_type_2_byte_len<CURR_LEVEL>(type_one);
 
                                 //Compare the remainders of the m-gram ids
                                 result = memcmp(one + id_type_len_bytes, two + id_type_len_bytes, id_len_bytes);
@@ -360,36 +494,6 @@ namespace uva {
                     template<typename TWordIdType, TModelLevel MAX_LEVEL>
                     constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::NUMBER_ID_TYPES_PER_LEVEL[];
 
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_2_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_3_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_4_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_5_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint32_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_6_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_2_GRAM_TO_BYTE_LEN[];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_3_GRAM_TO_BYTE_LEN[];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_4_GRAM_TO_BYTE_LEN[];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_5_GRAM_TO_BYTE_LEN[];
-
-                    template<typename TWordIdType, TModelLevel MAX_LEVEL>
-                    constexpr uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::LEVEL_6_GRAM_TO_BYTE_LEN[];
-
                 }
             }
         }
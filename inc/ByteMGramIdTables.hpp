@@ -1,2368 +0,0 @@
-/* 
- * File:   ByteMGramIdTables.hpp
- * Author: Dr. Ivan S. Zapreev
- *
- * Visit my Linked-in profile:
- *      <https://nl.linkedin.com/in/zapreevis>
- * Visit my GitHub:
- *      <https://github.com/ivan-zapreev>
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.#
- *
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program.  If not, see <http://www.gnu.org/licenses/>.
- *
- * Created on November 30, 2015, 2:11 PM
- */
-
-#ifndef BYTE_M_GRAM_ID_TABLES_HPP
-#define	BYTE_M_GRAM_ID_TABLES_HPP
-
-/**
- * This method is needed to compute the id type identifier.
- * Can compute the id type for M-grams until (including) M = 5
- * The type is computed as in a 32-based numeric system, e.g. for M==5:
- *          (len_bits[0]-1)*32^0 + (len_bits[1]-1)*32^1 +
- *          (len_bits[2]-1)*32^2 + (len_bits[3]-1)*32^3 +
- *          (len_bits[4]-1)*32^4
- * @param gram_level the number of word ids
- * @param len_bytes the bytes needed per word id
- * @param id_type [out] the resulting id type the initial value is expected to be 0
-
-    static inline void gram_id_byte_len_2_type(const TModelLevel gram_level, uint8_t * len_bytes, uint32_t & id_type) {
-       //Do the sanity check for against overflows
-       ASSERT_SANITY_THROW((gram_level > M_GRAM_LEVEL_5), string("Unsupported m-gram level: ") +
-               std::to_string(gram_level) + string(", must be within [") + std::to_string(M_GRAM_LEVEL_2) +
-               string(", ") + std::to_string(M_GRAM_LEVEL_6) + string("], insufficient multipliers!"));
-
-       LOG_DEBUG3 << "Computing the " << SSTR(gram_level) << "-gram id type" << END_LOG;
-
-       //Compute the M-gram id type. Here we use the pre-computed multipliers
-       for (size_t idx = 0; idx < gram_level; ++idx) {
-           LOG_DEBUG3 << ((uint32_t) len_bytes[idx] - 1) << " * " << NUMBER_ID_TYPES_PER_LEVEL[idx] << " =  "
-                   << ((uint32_t) len_bytes[idx] - 1) * NUMBER_ID_TYPES_PER_LEVEL[idx] << END_LOG;
-
-           id_type += ((uint32_t) len_bytes[idx] - 1) * NUMBER_ID_TYPES_PER_LEVEL[idx];
-       }
-       LOG_DEBUG3 << "Resulting id_type = " << SSTR(id_type) << END_LOG;
-    };
- */
-
-
-static constexpr uint32_t LEVEL_2_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID] = {
-    { 0, 4, 8, 12},
-    { 1, 5, 9, 13},
-    { 2, 6, 10, 14},
-    { 3, 7, 11, 15}
-};
-static constexpr uint32_t LEVEL_3_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID] = {
-    {
-        { 0, 16, 32, 48},
-        { 4, 20, 36, 52},
-        { 8, 24, 40, 56},
-        { 12, 28, 44, 60}
-    },
-    {
-        { 1, 17, 33, 49},
-        { 5, 21, 37, 53},
-        { 9, 25, 41, 57},
-        { 13, 29, 45, 61}
-    },
-    {
-        { 2, 18, 34, 50},
-        { 6, 22, 38, 54},
-        { 10, 26, 42, 58},
-        { 14, 30, 46, 62}
-    },
-    {
-        { 3, 19, 35, 51},
-        { 7, 23, 39, 55},
-        { 11, 27, 43, 59},
-        { 15, 31, 47, 63}
-    }
-};
-static constexpr uint32_t LEVEL_4_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID] = {
-    {
-        {
-            { 0, 64, 128, 192},
-            { 16, 80, 144, 208},
-            { 32, 96, 160, 224},
-            { 48, 112, 176, 240}
-        },
-        {
-            { 4, 68, 132, 196},
-            { 20, 84, 148, 212},
-            { 36, 100, 164, 228},
-            { 52, 116, 180, 244}
-        },
-        {
-            { 8, 72, 136, 200},
-            { 24, 88, 152, 216},
-            { 40, 104, 168, 232},
-            { 56, 120, 184, 248}
-        },
-        {
-            { 12, 76, 140, 204},
-            { 28, 92, 156, 220},
-            { 44, 108, 172, 236},
-            { 60, 124, 188, 252}
-        }
-    },
-    {
-        {
-            { 1, 65, 129, 193},
-            { 17, 81, 145, 209},
-            { 33, 97, 161, 225},
-            { 49, 113, 177, 241}
-        },
-        {
-            { 5, 69, 133, 197},
-            { 21, 85, 149, 213},
-            { 37, 101, 165, 229},
-            { 53, 117, 181, 245}
-        },
-        {
-            { 9, 73, 137, 201},
-            { 25, 89, 153, 217},
-            { 41, 105, 169, 233},
-            { 57, 121, 185, 249}
-        },
-        {
-            { 13, 77, 141, 205},
-            { 29, 93, 157, 221},
-            { 45, 109, 173, 237},
-            { 61, 125, 189, 253}
-        }
-    },
-    {
-        {
-            { 2, 66, 130, 194},
-            { 18, 82, 146, 210},
-            { 34, 98, 162, 226},
-            { 50, 114, 178, 242}
-        },
-        {
-            { 6, 70, 134, 198},
-            { 22, 86, 150, 214},
-            { 38, 102, 166, 230},
-            { 54, 118, 182, 246}
-        },
-        {
-            { 10, 74, 138, 202},
-            { 26, 90, 154, 218},
-            { 42, 106, 170, 234},
-            { 58, 122, 186, 250}
-        },
-        {
-            { 14, 78, 142, 206},
-            { 30, 94, 158, 222},
-            { 46, 110, 174, 238},
-            { 62, 126, 190, 254}
-        }
-    },
-    {
-        {
-            { 3, 67, 131, 195},
-            { 19, 83, 147, 211},
-            { 35, 99, 163, 227},
-            { 51, 115, 179, 243}
-        },
-        {
-            { 7, 71, 135, 199},
-            { 23, 87, 151, 215},
-            { 39, 103, 167, 231},
-            { 55, 119, 183, 247}
-        },
-        {
-            { 11, 75, 139, 203},
-            { 27, 91, 155, 219},
-            { 43, 107, 171, 235},
-            { 59, 123, 187, 251}
-        },
-        {
-            { 15, 79, 143, 207},
-            { 31, 95, 159, 223},
-            { 47, 111, 175, 239},
-            { 63, 127, 191, 255}
-        }
-    }
-};
-static constexpr uint32_t LEVEL_5_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID] = {
-    {
-        {
-            {
-                { 0, 256, 512, 768},
-                { 64, 320, 576, 832},
-                { 128, 384, 640, 896},
-                { 192, 448, 704, 960}
-            },
-            {
-                { 16, 272, 528, 784},
-                { 80, 336, 592, 848},
-                { 144, 400, 656, 912},
-                { 208, 464, 720, 976}
-            },
-            {
-                { 32, 288, 544, 800},
-                { 96, 352, 608, 864},
-                { 160, 416, 672, 928},
-                { 224, 480, 736, 992}
-            },
-            {
-                { 48, 304, 560, 816},
-                { 112, 368, 624, 880},
-                { 176, 432, 688, 944},
-                { 240, 496, 752, 1008}
-            }
-        },
-        {
-            {
-                { 4, 260, 516, 772},
-                { 68, 324, 580, 836},
-                { 132, 388, 644, 900},
-                { 196, 452, 708, 964}
-            },
-            {
-                { 20, 276, 532, 788},
-                { 84, 340, 596, 852},
-                { 148, 404, 660, 916},
-                { 212, 468, 724, 980}
-            },
-            {
-                { 36, 292, 548, 804},
-                { 100, 356, 612, 868},
-                { 164, 420, 676, 932},
-                { 228, 484, 740, 996}
-            },
-            {
-                { 52, 308, 564, 820},
-                { 116, 372, 628, 884},
-                { 180, 436, 692, 948},
-                { 244, 500, 756, 1012}
-            }
-        },
-        {
-            {
-                { 8, 264, 520, 776},
-                { 72, 328, 584, 840},
-                { 136, 392, 648, 904},
-                { 200, 456, 712, 968}
-            },
-            {
-                { 24, 280, 536, 792},
-                { 88, 344, 600, 856},
-                { 152, 408, 664, 920},
-                { 216, 472, 728, 984}
-            },
-            {
-                { 40, 296, 552, 808},
-                { 104, 360, 616, 872},
-                { 168, 424, 680, 936},
-                { 232, 488, 744, 1000}
-            },
-            {
-                { 56, 312, 568, 824},
-                { 120, 376, 632, 888},
-                { 184, 440, 696, 952},
-                { 248, 504, 760, 1016}
-            }
-        },
-        {
-            {
-                { 12, 268, 524, 780},
-                { 76, 332, 588, 844},
-                { 140, 396, 652, 908},
-                { 204, 460, 716, 972}
-            },
-            {
-                { 28, 284, 540, 796},
-                { 92, 348, 604, 860},
-                { 156, 412, 668, 924},
-                { 220, 476, 732, 988}
-            },
-            {
-                { 44, 300, 556, 812},
-                { 108, 364, 620, 876},
-                { 172, 428, 684, 940},
-                { 236, 492, 748, 1004}
-            },
-            {
-                { 60, 316, 572, 828},
-                { 124, 380, 636, 892},
-                { 188, 444, 700, 956},
-                { 252, 508, 764, 1020}
-            }
-        }
-    },
-    {
-        {
-            {
-                { 1, 257, 513, 769},
-                { 65, 321, 577, 833},
-                { 129, 385, 641, 897},
-                { 193, 449, 705, 961}
-            },
-            {
-                { 17, 273, 529, 785},
-                { 81, 337, 593, 849},
-                { 145, 401, 657, 913},
-                { 209, 465, 721, 977}
-            },
-            {
-                { 33, 289, 545, 801},
-                { 97, 353, 609, 865},
-                { 161, 417, 673, 929},
-                { 225, 481, 737, 993}
-            },
-            {
-                { 49, 305, 561, 817},
-                { 113, 369, 625, 881},
-                { 177, 433, 689, 945},
-                { 241, 497, 753, 1009}
-            }
-        },
-        {
-            {
-                { 5, 261, 517, 773},
-                { 69, 325, 581, 837},
-                { 133, 389, 645, 901},
-                { 197, 453, 709, 965}
-            },
-            {
-                { 21, 277, 533, 789},
-                { 85, 341, 597, 853},
-                { 149, 405, 661, 917},
-                { 213, 469, 725, 981}
-            },
-            {
-                { 37, 293, 549, 805},
-                { 101, 357, 613, 869},
-                { 165, 421, 677, 933},
-                { 229, 485, 741, 997}
-            },
-            {
-                { 53, 309, 565, 821},
-                { 117, 373, 629, 885},
-                { 181, 437, 693, 949},
-                { 245, 501, 757, 1013}
-            }
-        },
-        {
-            {
-                { 9, 265, 521, 777},
-                { 73, 329, 585, 841},
-                { 137, 393, 649, 905},
-                { 201, 457, 713, 969}
-            },
-            {
-                { 25, 281, 537, 793},
-                { 89, 345, 601, 857},
-                { 153, 409, 665, 921},
-                { 217, 473, 729, 985}
-            },
-            {
-                { 41, 297, 553, 809},
-                { 105, 361, 617, 873},
-                { 169, 425, 681, 937},
-                { 233, 489, 745, 1001}
-            },
-            {
-                { 57, 313, 569, 825},
-                { 121, 377, 633, 889},
-                { 185, 441, 697, 953},
-                { 249, 505, 761, 1017}
-            }
-        },
-        {
-            {
-                { 13, 269, 525, 781},
-                { 77, 333, 589, 845},
-                { 141, 397, 653, 909},
-                { 205, 461, 717, 973}
-            },
-            {
-                { 29, 285, 541, 797},
-                { 93, 349, 605, 861},
-                { 157, 413, 669, 925},
-                { 221, 477, 733, 989}
-            },
-            {
-                { 45, 301, 557, 813},
-                { 109, 365, 621, 877},
-                { 173, 429, 685, 941},
-                { 237, 493, 749, 1005}
-            },
-            {
-                { 61, 317, 573, 829},
-                { 125, 381, 637, 893},
-                { 189, 445, 701, 957},
-                { 253, 509, 765, 1021}
-            }
-        }
-    },
-    {
-        {
-            {
-                { 2, 258, 514, 770},
-                { 66, 322, 578, 834},
-                { 130, 386, 642, 898},
-                { 194, 450, 706, 962}
-            },
-            {
-                { 18, 274, 530, 786},
-                { 82, 338, 594, 850},
-                { 146, 402, 658, 914},
-                { 210, 466, 722, 978}
-            },
-            {
-                { 34, 290, 546, 802},
-                { 98, 354, 610, 866},
-                { 162, 418, 674, 930},
-                { 226, 482, 738, 994}
-            },
-            {
-                { 50, 306, 562, 818},
-                { 114, 370, 626, 882},
-                { 178, 434, 690, 946},
-                { 242, 498, 754, 1010}
-            }
-        },
-        {
-            {
-                { 6, 262, 518, 774},
-                { 70, 326, 582, 838},
-                { 134, 390, 646, 902},
-                { 198, 454, 710, 966}
-            },
-            {
-                { 22, 278, 534, 790},
-                { 86, 342, 598, 854},
-                { 150, 406, 662, 918},
-                { 214, 470, 726, 982}
-            },
-            {
-                { 38, 294, 550, 806},
-                { 102, 358, 614, 870},
-                { 166, 422, 678, 934},
-                { 230, 486, 742, 998}
-            },
-            {
-                { 54, 310, 566, 822},
-                { 118, 374, 630, 886},
-                { 182, 438, 694, 950},
-                { 246, 502, 758, 1014}
-            }
-        },
-        {
-            {
-                { 10, 266, 522, 778},
-                { 74, 330, 586, 842},
-                { 138, 394, 650, 906},
-                { 202, 458, 714, 970}
-            },
-            {
-                { 26, 282, 538, 794},
-                { 90, 346, 602, 858},
-                { 154, 410, 666, 922},
-                { 218, 474, 730, 986}
-            },
-            {
-                { 42, 298, 554, 810},
-                { 106, 362, 618, 874},
-                { 170, 426, 682, 938},
-                { 234, 490, 746, 1002}
-            },
-            {
-                { 58, 314, 570, 826},
-                { 122, 378, 634, 890},
-                { 186, 442, 698, 954},
-                { 250, 506, 762, 1018}
-            }
-        },
-        {
-            {
-                { 14, 270, 526, 782},
-                { 78, 334, 590, 846},
-                { 142, 398, 654, 910},
-                { 206, 462, 718, 974}
-            },
-            {
-                { 30, 286, 542, 798},
-                { 94, 350, 606, 862},
-                { 158, 414, 670, 926},
-                { 222, 478, 734, 990}
-            },
-            {
-                { 46, 302, 558, 814},
-                { 110, 366, 622, 878},
-                { 174, 430, 686, 942},
-                { 238, 494, 750, 1006}
-            },
-            {
-                { 62, 318, 574, 830},
-                { 126, 382, 638, 894},
-                { 190, 446, 702, 958},
-                { 254, 510, 766, 1022}
-            }
-        }
-    },
-    {
-        {
-            {
-                { 3, 259, 515, 771},
-                { 67, 323, 579, 835},
-                { 131, 387, 643, 899},
-                { 195, 451, 707, 963}
-            },
-            {
-                { 19, 275, 531, 787},
-                { 83, 339, 595, 851},
-                { 147, 403, 659, 915},
-                { 211, 467, 723, 979}
-            },
-            {
-                { 35, 291, 547, 803},
-                { 99, 355, 611, 867},
-                { 163, 419, 675, 931},
-                { 227, 483, 739, 995}
-            },
-            {
-                { 51, 307, 563, 819},
-                { 115, 371, 627, 883},
-                { 179, 435, 691, 947},
-                { 243, 499, 755, 1011}
-            }
-        },
-        {
-            {
-                { 7, 263, 519, 775},
-                { 71, 327, 583, 839},
-                { 135, 391, 647, 903},
-                { 199, 455, 711, 967}
-            },
-            {
-                { 23, 279, 535, 791},
-                { 87, 343, 599, 855},
-                { 151, 407, 663, 919},
-                { 215, 471, 727, 983}
-            },
-            {
-                { 39, 295, 551, 807},
-                { 103, 359, 615, 871},
-                { 167, 423, 679, 935},
-                { 231, 487, 743, 999}
-            },
-            {
-                { 55, 311, 567, 823},
-                { 119, 375, 631, 887},
-                { 183, 439, 695, 951},
-                { 247, 503, 759, 1015}
-            }
-        },
-        {
-            {
-                { 11, 267, 523, 779},
-                { 75, 331, 587, 843},
-                { 139, 395, 651, 907},
-                { 203, 459, 715, 971}
-            },
-            {
-                { 27, 283, 539, 795},
-                { 91, 347, 603, 859},
-                { 155, 411, 667, 923},
-                { 219, 475, 731, 987}
-            },
-            {
-                { 43, 299, 555, 811},
-                { 107, 363, 619, 875},
-                { 171, 427, 683, 939},
-                { 235, 491, 747, 1003}
-            },
-            {
-                { 59, 315, 571, 827},
-                { 123, 379, 635, 891},
-                { 187, 443, 699, 955},
-                { 251, 507, 763, 1019}
-            }
-        },
-        {
-            {
-                { 15, 271, 527, 783},
-                { 79, 335, 591, 847},
-                { 143, 399, 655, 911},
-                { 207, 463, 719, 975}
-            },
-            {
-                { 31, 287, 543, 799},
-                { 95, 351, 607, 863},
-                { 159, 415, 671, 927},
-                { 223, 479, 735, 991}
-            },
-            {
-                { 47, 303, 559, 815},
-                { 111, 367, 623, 879},
-                { 175, 431, 687, 943},
-                { 239, 495, 751, 1007}
-            },
-            {
-                { 63, 319, 575, 831},
-                { 127, 383, 639, 895},
-                { 191, 447, 703, 959},
-                { 255, 511, 767, 1023}
-            }
-        }
-    }
-};
-static constexpr uint32_t LEVEL_6_GRAM_TO_TYPE_LEN[NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID][NUM_BYTES_WORD_ID] = {
-    {
-        {
-            {
-                {
-                    { 0, 1024, 2048, 3072},
-                    { 256, 1280, 2304, 3328},
-                    { 512, 1536, 2560, 3584},
-                    { 768, 1792, 2816, 3840}
-                },
-                {
-                    { 64, 1088, 2112, 3136},
-                    { 320, 1344, 2368, 3392},
-                    { 576, 1600, 2624, 3648},
-                    { 832, 1856, 2880, 3904}
-                },
-                {
-                    { 128, 1152, 2176, 3200},
-                    { 384, 1408, 2432, 3456},
-                    { 640, 1664, 2688, 3712},
-                    { 896, 1920, 2944, 3968}
-                },
-                {
-                    { 192, 1216, 2240, 3264},
-                    { 448, 1472, 2496, 3520},
-                    { 704, 1728, 2752, 3776},
-                    { 960, 1984, 3008, 4032}
-                }
-            },
-            {
-                {
-                    { 16, 1040, 2064, 3088},
-                    { 272, 1296, 2320, 3344},
-                    { 528, 1552, 2576, 3600},
-                    { 784, 1808, 2832, 3856}
-                },
-                {
-                    { 80, 1104, 2128, 3152},
-                    { 336, 1360, 2384, 3408},
-                    { 592, 1616, 2640, 3664},
-                    { 848, 1872, 2896, 3920}
-                },
-                {
-                    { 144, 1168, 2192, 3216},
-                    { 400, 1424, 2448, 3472},
-                    { 656, 1680, 2704, 3728},
-                    { 912, 1936, 2960, 3984}
-                },
-                {
-                    { 208, 1232, 2256, 3280},
-                    { 464, 1488, 2512, 3536},
-                    { 720, 1744, 2768, 3792},
-                    { 976, 2000, 3024, 4048}
-                }
-            },
-            {
-                {
-                    { 32, 1056, 2080, 3104},
-                    { 288, 1312, 2336, 3360},
-                    { 544, 1568, 2592, 3616},
-                    { 800, 1824, 2848, 3872}
-                },
-                {
-                    { 96, 1120, 2144, 3168},
-                    { 352, 1376, 2400, 3424},
-                    { 608, 1632, 2656, 3680},
-                    { 864, 1888, 2912, 3936}
-                },
-                {
-                    { 160, 1184, 2208, 3232},
-                    { 416, 1440, 2464, 3488},
-                    { 672, 1696, 2720, 3744},
-                    { 928, 1952, 2976, 4000}
-                },
-                {
-                    { 224, 1248, 2272, 3296},
-                    { 480, 1504, 2528, 3552},
-                    { 736, 1760, 2784, 3808},
-                    { 992, 2016, 3040, 4064}
-                }
-            },
-            {
-                {
-                    { 48, 1072, 2096, 3120},
-                    { 304, 1328, 2352, 3376},
-                    { 560, 1584, 2608, 3632},
-                    { 816, 1840, 2864, 3888}
-                },
-                {
-                    { 112, 1136, 2160, 3184},
-                    { 368, 1392, 2416, 3440},
-                    { 624, 1648, 2672, 3696},
-                    { 880, 1904, 2928, 3952}
-                },
-                {
-                    { 176, 1200, 2224, 3248},
-                    { 432, 1456, 2480, 3504},
-                    { 688, 1712, 2736, 3760},
-                    { 944, 1968, 2992, 4016}
-                },
-                {
-                    { 240, 1264, 2288, 3312},
-                    { 496, 1520, 2544, 3568},
-                    { 752, 1776, 2800, 3824},
-                    { 1008, 2032, 3056, 4080}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 4, 1028, 2052, 3076},
-                    { 260, 1284, 2308, 3332},
-                    { 516, 1540, 2564, 3588},
-                    { 772, 1796, 2820, 3844}
-                },
-                {
-                    { 68, 1092, 2116, 3140},
-                    { 324, 1348, 2372, 3396},
-                    { 580, 1604, 2628, 3652},
-                    { 836, 1860, 2884, 3908}
-                },
-                {
-                    { 132, 1156, 2180, 3204},
-                    { 388, 1412, 2436, 3460},
-                    { 644, 1668, 2692, 3716},
-                    { 900, 1924, 2948, 3972}
-                },
-                {
-                    { 196, 1220, 2244, 3268},
-                    { 452, 1476, 2500, 3524},
-                    { 708, 1732, 2756, 3780},
-                    { 964, 1988, 3012, 4036}
-                }
-            },
-            {
-                {
-                    { 20, 1044, 2068, 3092},
-                    { 276, 1300, 2324, 3348},
-                    { 532, 1556, 2580, 3604},
-                    { 788, 1812, 2836, 3860}
-                },
-                {
-                    { 84, 1108, 2132, 3156},
-                    { 340, 1364, 2388, 3412},
-                    { 596, 1620, 2644, 3668},
-                    { 852, 1876, 2900, 3924}
-                },
-                {
-                    { 148, 1172, 2196, 3220},
-                    { 404, 1428, 2452, 3476},
-                    { 660, 1684, 2708, 3732},
-                    { 916, 1940, 2964, 3988}
-                },
-                {
-                    { 212, 1236, 2260, 3284},
-                    { 468, 1492, 2516, 3540},
-                    { 724, 1748, 2772, 3796},
-                    { 980, 2004, 3028, 4052}
-                }
-            },
-            {
-                {
-                    { 36, 1060, 2084, 3108},
-                    { 292, 1316, 2340, 3364},
-                    { 548, 1572, 2596, 3620},
-                    { 804, 1828, 2852, 3876}
-                },
-                {
-                    { 100, 1124, 2148, 3172},
-                    { 356, 1380, 2404, 3428},
-                    { 612, 1636, 2660, 3684},
-                    { 868, 1892, 2916, 3940}
-                },
-                {
-                    { 164, 1188, 2212, 3236},
-                    { 420, 1444, 2468, 3492},
-                    { 676, 1700, 2724, 3748},
-                    { 932, 1956, 2980, 4004}
-                },
-                {
-                    { 228, 1252, 2276, 3300},
-                    { 484, 1508, 2532, 3556},
-                    { 740, 1764, 2788, 3812},
-                    { 996, 2020, 3044, 4068}
-                }
-            },
-            {
-                {
-                    { 52, 1076, 2100, 3124},
-                    { 308, 1332, 2356, 3380},
-                    { 564, 1588, 2612, 3636},
-                    { 820, 1844, 2868, 3892}
-                },
-                {
-                    { 116, 1140, 2164, 3188},
-                    { 372, 1396, 2420, 3444},
-                    { 628, 1652, 2676, 3700},
-                    { 884, 1908, 2932, 3956}
-                },
-                {
-                    { 180, 1204, 2228, 3252},
-                    { 436, 1460, 2484, 3508},
-                    { 692, 1716, 2740, 3764},
-                    { 948, 1972, 2996, 4020}
-                },
-                {
-                    { 244, 1268, 2292, 3316},
-                    { 500, 1524, 2548, 3572},
-                    { 756, 1780, 2804, 3828},
-                    { 1012, 2036, 3060, 4084}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 8, 1032, 2056, 3080},
-                    { 264, 1288, 2312, 3336},
-                    { 520, 1544, 2568, 3592},
-                    { 776, 1800, 2824, 3848}
-                },
-                {
-                    { 72, 1096, 2120, 3144},
-                    { 328, 1352, 2376, 3400},
-                    { 584, 1608, 2632, 3656},
-                    { 840, 1864, 2888, 3912}
-                },
-                {
-                    { 136, 1160, 2184, 3208},
-                    { 392, 1416, 2440, 3464},
-                    { 648, 1672, 2696, 3720},
-                    { 904, 1928, 2952, 3976}
-                },
-                {
-                    { 200, 1224, 2248, 3272},
-                    { 456, 1480, 2504, 3528},
-                    { 712, 1736, 2760, 3784},
-                    { 968, 1992, 3016, 4040}
-                }
-            },
-            {
-                {
-                    { 24, 1048, 2072, 3096},
-                    { 280, 1304, 2328, 3352},
-                    { 536, 1560, 2584, 3608},
-                    { 792, 1816, 2840, 3864}
-                },
-                {
-                    { 88, 1112, 2136, 3160},
-                    { 344, 1368, 2392, 3416},
-                    { 600, 1624, 2648, 3672},
-                    { 856, 1880, 2904, 3928}
-                },
-                {
-                    { 152, 1176, 2200, 3224},
-                    { 408, 1432, 2456, 3480},
-                    { 664, 1688, 2712, 3736},
-                    { 920, 1944, 2968, 3992}
-                },
-                {
-                    { 216, 1240, 2264, 3288},
-                    { 472, 1496, 2520, 3544},
-                    { 728, 1752, 2776, 3800},
-                    { 984, 2008, 3032, 4056}
-                }
-            },
-            {
-                {
-                    { 40, 1064, 2088, 3112},
-                    { 296, 1320, 2344, 3368},
-                    { 552, 1576, 2600, 3624},
-                    { 808, 1832, 2856, 3880}
-                },
-                {
-                    { 104, 1128, 2152, 3176},
-                    { 360, 1384, 2408, 3432},
-                    { 616, 1640, 2664, 3688},
-                    { 872, 1896, 2920, 3944}
-                },
-                {
-                    { 168, 1192, 2216, 3240},
-                    { 424, 1448, 2472, 3496},
-                    { 680, 1704, 2728, 3752},
-                    { 936, 1960, 2984, 4008}
-                },
-                {
-                    { 232, 1256, 2280, 3304},
-                    { 488, 1512, 2536, 3560},
-                    { 744, 1768, 2792, 3816},
-                    { 1000, 2024, 3048, 4072}
-                }
-            },
-            {
-                {
-                    { 56, 1080, 2104, 3128},
-                    { 312, 1336, 2360, 3384},
-                    { 568, 1592, 2616, 3640},
-                    { 824, 1848, 2872, 3896}
-                },
-                {
-                    { 120, 1144, 2168, 3192},
-                    { 376, 1400, 2424, 3448},
-                    { 632, 1656, 2680, 3704},
-                    { 888, 1912, 2936, 3960}
-                },
-                {
-                    { 184, 1208, 2232, 3256},
-                    { 440, 1464, 2488, 3512},
-                    { 696, 1720, 2744, 3768},
-                    { 952, 1976, 3000, 4024}
-                },
-                {
-                    { 248, 1272, 2296, 3320},
-                    { 504, 1528, 2552, 3576},
-                    { 760, 1784, 2808, 3832},
-                    { 1016, 2040, 3064, 4088}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 12, 1036, 2060, 3084},
-                    { 268, 1292, 2316, 3340},
-                    { 524, 1548, 2572, 3596},
-                    { 780, 1804, 2828, 3852}
-                },
-                {
-                    { 76, 1100, 2124, 3148},
-                    { 332, 1356, 2380, 3404},
-                    { 588, 1612, 2636, 3660},
-                    { 844, 1868, 2892, 3916}
-                },
-                {
-                    { 140, 1164, 2188, 3212},
-                    { 396, 1420, 2444, 3468},
-                    { 652, 1676, 2700, 3724},
-                    { 908, 1932, 2956, 3980}
-                },
-                {
-                    { 204, 1228, 2252, 3276},
-                    { 460, 1484, 2508, 3532},
-                    { 716, 1740, 2764, 3788},
-                    { 972, 1996, 3020, 4044}
-                }
-            },
-            {
-                {
-                    { 28, 1052, 2076, 3100},
-                    { 284, 1308, 2332, 3356},
-                    { 540, 1564, 2588, 3612},
-                    { 796, 1820, 2844, 3868}
-                },
-                {
-                    { 92, 1116, 2140, 3164},
-                    { 348, 1372, 2396, 3420},
-                    { 604, 1628, 2652, 3676},
-                    { 860, 1884, 2908, 3932}
-                },
-                {
-                    { 156, 1180, 2204, 3228},
-                    { 412, 1436, 2460, 3484},
-                    { 668, 1692, 2716, 3740},
-                    { 924, 1948, 2972, 3996}
-                },
-                {
-                    { 220, 1244, 2268, 3292},
-                    { 476, 1500, 2524, 3548},
-                    { 732, 1756, 2780, 3804},
-                    { 988, 2012, 3036, 4060}
-                }
-            },
-            {
-                {
-                    { 44, 1068, 2092, 3116},
-                    { 300, 1324, 2348, 3372},
-                    { 556, 1580, 2604, 3628},
-                    { 812, 1836, 2860, 3884}
-                },
-                {
-                    { 108, 1132, 2156, 3180},
-                    { 364, 1388, 2412, 3436},
-                    { 620, 1644, 2668, 3692},
-                    { 876, 1900, 2924, 3948}
-                },
-                {
-                    { 172, 1196, 2220, 3244},
-                    { 428, 1452, 2476, 3500},
-                    { 684, 1708, 2732, 3756},
-                    { 940, 1964, 2988, 4012}
-                },
-                {
-                    { 236, 1260, 2284, 3308},
-                    { 492, 1516, 2540, 3564},
-                    { 748, 1772, 2796, 3820},
-                    { 1004, 2028, 3052, 4076}
-                }
-            },
-            {
-                {
-                    { 60, 1084, 2108, 3132},
-                    { 316, 1340, 2364, 3388},
-                    { 572, 1596, 2620, 3644},
-                    { 828, 1852, 2876, 3900}
-                },
-                {
-                    { 124, 1148, 2172, 3196},
-                    { 380, 1404, 2428, 3452},
-                    { 636, 1660, 2684, 3708},
-                    { 892, 1916, 2940, 3964}
-                },
-                {
-                    { 188, 1212, 2236, 3260},
-                    { 444, 1468, 2492, 3516},
-                    { 700, 1724, 2748, 3772},
-                    { 956, 1980, 3004, 4028}
-                },
-                {
-                    { 252, 1276, 2300, 3324},
-                    { 508, 1532, 2556, 3580},
-                    { 764, 1788, 2812, 3836},
-                    { 1020, 2044, 3068, 4092}
-                }
-            }
-        }
-    },
-    {
-        {
-            {
-                {
-                    { 1, 1025, 2049, 3073},
-                    { 257, 1281, 2305, 3329},
-                    { 513, 1537, 2561, 3585},
-                    { 769, 1793, 2817, 3841}
-                },
-                {
-                    { 65, 1089, 2113, 3137},
-                    { 321, 1345, 2369, 3393},
-                    { 577, 1601, 2625, 3649},
-                    { 833, 1857, 2881, 3905}
-                },
-                {
-                    { 129, 1153, 2177, 3201},
-                    { 385, 1409, 2433, 3457},
-                    { 641, 1665, 2689, 3713},
-                    { 897, 1921, 2945, 3969}
-                },
-                {
-                    { 193, 1217, 2241, 3265},
-                    { 449, 1473, 2497, 3521},
-                    { 705, 1729, 2753, 3777},
-                    { 961, 1985, 3009, 4033}
-                }
-            },
-            {
-                {
-                    { 17, 1041, 2065, 3089},
-                    { 273, 1297, 2321, 3345},
-                    { 529, 1553, 2577, 3601},
-                    { 785, 1809, 2833, 3857}
-                },
-                {
-                    { 81, 1105, 2129, 3153},
-                    { 337, 1361, 2385, 3409},
-                    { 593, 1617, 2641, 3665},
-                    { 849, 1873, 2897, 3921}
-                },
-                {
-                    { 145, 1169, 2193, 3217},
-                    { 401, 1425, 2449, 3473},
-                    { 657, 1681, 2705, 3729},
-                    { 913, 1937, 2961, 3985}
-                },
-                {
-                    { 209, 1233, 2257, 3281},
-                    { 465, 1489, 2513, 3537},
-                    { 721, 1745, 2769, 3793},
-                    { 977, 2001, 3025, 4049}
-                }
-            },
-            {
-                {
-                    { 33, 1057, 2081, 3105},
-                    { 289, 1313, 2337, 3361},
-                    { 545, 1569, 2593, 3617},
-                    { 801, 1825, 2849, 3873}
-                },
-                {
-                    { 97, 1121, 2145, 3169},
-                    { 353, 1377, 2401, 3425},
-                    { 609, 1633, 2657, 3681},
-                    { 865, 1889, 2913, 3937}
-                },
-                {
-                    { 161, 1185, 2209, 3233},
-                    { 417, 1441, 2465, 3489},
-                    { 673, 1697, 2721, 3745},
-                    { 929, 1953, 2977, 4001}
-                },
-                {
-                    { 225, 1249, 2273, 3297},
-                    { 481, 1505, 2529, 3553},
-                    { 737, 1761, 2785, 3809},
-                    { 993, 2017, 3041, 4065}
-                }
-            },
-            {
-                {
-                    { 49, 1073, 2097, 3121},
-                    { 305, 1329, 2353, 3377},
-                    { 561, 1585, 2609, 3633},
-                    { 817, 1841, 2865, 3889}
-                },
-                {
-                    { 113, 1137, 2161, 3185},
-                    { 369, 1393, 2417, 3441},
-                    { 625, 1649, 2673, 3697},
-                    { 881, 1905, 2929, 3953}
-                },
-                {
-                    { 177, 1201, 2225, 3249},
-                    { 433, 1457, 2481, 3505},
-                    { 689, 1713, 2737, 3761},
-                    { 945, 1969, 2993, 4017}
-                },
-                {
-                    { 241, 1265, 2289, 3313},
-                    { 497, 1521, 2545, 3569},
-                    { 753, 1777, 2801, 3825},
-                    { 1009, 2033, 3057, 4081}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 5, 1029, 2053, 3077},
-                    { 261, 1285, 2309, 3333},
-                    { 517, 1541, 2565, 3589},
-                    { 773, 1797, 2821, 3845}
-                },
-                {
-                    { 69, 1093, 2117, 3141},
-                    { 325, 1349, 2373, 3397},
-                    { 581, 1605, 2629, 3653},
-                    { 837, 1861, 2885, 3909}
-                },
-                {
-                    { 133, 1157, 2181, 3205},
-                    { 389, 1413, 2437, 3461},
-                    { 645, 1669, 2693, 3717},
-                    { 901, 1925, 2949, 3973}
-                },
-                {
-                    { 197, 1221, 2245, 3269},
-                    { 453, 1477, 2501, 3525},
-                    { 709, 1733, 2757, 3781},
-                    { 965, 1989, 3013, 4037}
-                }
-            },
-            {
-                {
-                    { 21, 1045, 2069, 3093},
-                    { 277, 1301, 2325, 3349},
-                    { 533, 1557, 2581, 3605},
-                    { 789, 1813, 2837, 3861}
-                },
-                {
-                    { 85, 1109, 2133, 3157},
-                    { 341, 1365, 2389, 3413},
-                    { 597, 1621, 2645, 3669},
-                    { 853, 1877, 2901, 3925}
-                },
-                {
-                    { 149, 1173, 2197, 3221},
-                    { 405, 1429, 2453, 3477},
-                    { 661, 1685, 2709, 3733},
-                    { 917, 1941, 2965, 3989}
-                },
-                {
-                    { 213, 1237, 2261, 3285},
-                    { 469, 1493, 2517, 3541},
-                    { 725, 1749, 2773, 3797},
-                    { 981, 2005, 3029, 4053}
-                }
-            },
-            {
-                {
-                    { 37, 1061, 2085, 3109},
-                    { 293, 1317, 2341, 3365},
-                    { 549, 1573, 2597, 3621},
-                    { 805, 1829, 2853, 3877}
-                },
-                {
-                    { 101, 1125, 2149, 3173},
-                    { 357, 1381, 2405, 3429},
-                    { 613, 1637, 2661, 3685},
-                    { 869, 1893, 2917, 3941}
-                },
-                {
-                    { 165, 1189, 2213, 3237},
-                    { 421, 1445, 2469, 3493},
-                    { 677, 1701, 2725, 3749},
-                    { 933, 1957, 2981, 4005}
-                },
-                {
-                    { 229, 1253, 2277, 3301},
-                    { 485, 1509, 2533, 3557},
-                    { 741, 1765, 2789, 3813},
-                    { 997, 2021, 3045, 4069}
-                }
-            },
-            {
-                {
-                    { 53, 1077, 2101, 3125},
-                    { 309, 1333, 2357, 3381},
-                    { 565, 1589, 2613, 3637},
-                    { 821, 1845, 2869, 3893}
-                },
-                {
-                    { 117, 1141, 2165, 3189},
-                    { 373, 1397, 2421, 3445},
-                    { 629, 1653, 2677, 3701},
-                    { 885, 1909, 2933, 3957}
-                },
-                {
-                    { 181, 1205, 2229, 3253},
-                    { 437, 1461, 2485, 3509},
-                    { 693, 1717, 2741, 3765},
-                    { 949, 1973, 2997, 4021}
-                },
-                {
-                    { 245, 1269, 2293, 3317},
-                    { 501, 1525, 2549, 3573},
-                    { 757, 1781, 2805, 3829},
-                    { 1013, 2037, 3061, 4085}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 9, 1033, 2057, 3081},
-                    { 265, 1289, 2313, 3337},
-                    { 521, 1545, 2569, 3593},
-                    { 777, 1801, 2825, 3849}
-                },
-                {
-                    { 73, 1097, 2121, 3145},
-                    { 329, 1353, 2377, 3401},
-                    { 585, 1609, 2633, 3657},
-                    { 841, 1865, 2889, 3913}
-                },
-                {
-                    { 137, 1161, 2185, 3209},
-                    { 393, 1417, 2441, 3465},
-                    { 649, 1673, 2697, 3721},
-                    { 905, 1929, 2953, 3977}
-                },
-                {
-                    { 201, 1225, 2249, 3273},
-                    { 457, 1481, 2505, 3529},
-                    { 713, 1737, 2761, 3785},
-                    { 969, 1993, 3017, 4041}
-                }
-            },
-            {
-                {
-                    { 25, 1049, 2073, 3097},
-                    { 281, 1305, 2329, 3353},
-                    { 537, 1561, 2585, 3609},
-                    { 793, 1817, 2841, 3865}
-                },
-                {
-                    { 89, 1113, 2137, 3161},
-                    { 345, 1369, 2393, 3417},
-                    { 601, 1625, 2649, 3673},
-                    { 857, 1881, 2905, 3929}
-                },
-                {
-                    { 153, 1177, 2201, 3225},
-                    { 409, 1433, 2457, 3481},
-                    { 665, 1689, 2713, 3737},
-                    { 921, 1945, 2969, 3993}
-                },
-                {
-                    { 217, 1241, 2265, 3289},
-                    { 473, 1497, 2521, 3545},
-                    { 729, 1753, 2777, 3801},
-                    { 985, 2009, 3033, 4057}
-                }
-            },
-            {
-                {
-                    { 41, 1065, 2089, 3113},
-                    { 297, 1321, 2345, 3369},
-                    { 553, 1577, 2601, 3625},
-                    { 809, 1833, 2857, 3881}
-                },
-                {
-                    { 105, 1129, 2153, 3177},
-                    { 361, 1385, 2409, 3433},
-                    { 617, 1641, 2665, 3689},
-                    { 873, 1897, 2921, 3945}
-                },
-                {
-                    { 169, 1193, 2217, 3241},
-                    { 425, 1449, 2473, 3497},
-                    { 681, 1705, 2729, 3753},
-                    { 937, 1961, 2985, 4009}
-                },
-                {
-                    { 233, 1257, 2281, 3305},
-                    { 489, 1513, 2537, 3561},
-                    { 745, 1769, 2793, 3817},
-                    { 1001, 2025, 3049, 4073}
-                }
-            },
-            {
-                {
-                    { 57, 1081, 2105, 3129},
-                    { 313, 1337, 2361, 3385},
-                    { 569, 1593, 2617, 3641},
-                    { 825, 1849, 2873, 3897}
-                },
-                {
-                    { 121, 1145, 2169, 3193},
-                    { 377, 1401, 2425, 3449},
-                    { 633, 1657, 2681, 3705},
-                    { 889, 1913, 2937, 3961}
-                },
-                {
-                    { 185, 1209, 2233, 3257},
-                    { 441, 1465, 2489, 3513},
-                    { 697, 1721, 2745, 3769},
-                    { 953, 1977, 3001, 4025}
-                },
-                {
-                    { 249, 1273, 2297, 3321},
-                    { 505, 1529, 2553, 3577},
-                    { 761, 1785, 2809, 3833},
-                    { 1017, 2041, 3065, 4089}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 13, 1037, 2061, 3085},
-                    { 269, 1293, 2317, 3341},
-                    { 525, 1549, 2573, 3597},
-                    { 781, 1805, 2829, 3853}
-                },
-                {
-                    { 77, 1101, 2125, 3149},
-                    { 333, 1357, 2381, 3405},
-                    { 589, 1613, 2637, 3661},
-                    { 845, 1869, 2893, 3917}
-                },
-                {
-                    { 141, 1165, 2189, 3213},
-                    { 397, 1421, 2445, 3469},
-                    { 653, 1677, 2701, 3725},
-                    { 909, 1933, 2957, 3981}
-                },
-                {
-                    { 205, 1229, 2253, 3277},
-                    { 461, 1485, 2509, 3533},
-                    { 717, 1741, 2765, 3789},
-                    { 973, 1997, 3021, 4045}
-                }
-            },
-            {
-                {
-                    { 29, 1053, 2077, 3101},
-                    { 285, 1309, 2333, 3357},
-                    { 541, 1565, 2589, 3613},
-                    { 797, 1821, 2845, 3869}
-                },
-                {
-                    { 93, 1117, 2141, 3165},
-                    { 349, 1373, 2397, 3421},
-                    { 605, 1629, 2653, 3677},
-                    { 861, 1885, 2909, 3933}
-                },
-                {
-                    { 157, 1181, 2205, 3229},
-                    { 413, 1437, 2461, 3485},
-                    { 669, 1693, 2717, 3741},
-                    { 925, 1949, 2973, 3997}
-                },
-                {
-                    { 221, 1245, 2269, 3293},
-                    { 477, 1501, 2525, 3549},
-                    { 733, 1757, 2781, 3805},
-                    { 989, 2013, 3037, 4061}
-                }
-            },
-            {
-                {
-                    { 45, 1069, 2093, 3117},
-                    { 301, 1325, 2349, 3373},
-                    { 557, 1581, 2605, 3629},
-                    { 813, 1837, 2861, 3885}
-                },
-                {
-                    { 109, 1133, 2157, 3181},
-                    { 365, 1389, 2413, 3437},
-                    { 621, 1645, 2669, 3693},
-                    { 877, 1901, 2925, 3949}
-                },
-                {
-                    { 173, 1197, 2221, 3245},
-                    { 429, 1453, 2477, 3501},
-                    { 685, 1709, 2733, 3757},
-                    { 941, 1965, 2989, 4013}
-                },
-                {
-                    { 237, 1261, 2285, 3309},
-                    { 493, 1517, 2541, 3565},
-                    { 749, 1773, 2797, 3821},
-                    { 1005, 2029, 3053, 4077}
-                }
-            },
-            {
-                {
-                    { 61, 1085, 2109, 3133},
-                    { 317, 1341, 2365, 3389},
-                    { 573, 1597, 2621, 3645},
-                    { 829, 1853, 2877, 3901}
-                },
-                {
-                    { 125, 1149, 2173, 3197},
-                    { 381, 1405, 2429, 3453},
-                    { 637, 1661, 2685, 3709},
-                    { 893, 1917, 2941, 3965}
-                },
-                {
-                    { 189, 1213, 2237, 3261},
-                    { 445, 1469, 2493, 3517},
-                    { 701, 1725, 2749, 3773},
-                    { 957, 1981, 3005, 4029}
-                },
-                {
-                    { 253, 1277, 2301, 3325},
-                    { 509, 1533, 2557, 3581},
-                    { 765, 1789, 2813, 3837},
-                    { 1021, 2045, 3069, 4093}
-                }
-            }
-        }
-    },
-    {
-        {
-            {
-                {
-                    { 2, 1026, 2050, 3074},
-                    { 258, 1282, 2306, 3330},
-                    { 514, 1538, 2562, 3586},
-                    { 770, 1794, 2818, 3842}
-                },
-                {
-                    { 66, 1090, 2114, 3138},
-                    { 322, 1346, 2370, 3394},
-                    { 578, 1602, 2626, 3650},
-                    { 834, 1858, 2882, 3906}
-                },
-                {
-                    { 130, 1154, 2178, 3202},
-                    { 386, 1410, 2434, 3458},
-                    { 642, 1666, 2690, 3714},
-                    { 898, 1922, 2946, 3970}
-                },
-                {
-                    { 194, 1218, 2242, 3266},
-                    { 450, 1474, 2498, 3522},
-                    { 706, 1730, 2754, 3778},
-                    { 962, 1986, 3010, 4034}
-                }
-            },
-            {
-                {
-                    { 18, 1042, 2066, 3090},
-                    { 274, 1298, 2322, 3346},
-                    { 530, 1554, 2578, 3602},
-                    { 786, 1810, 2834, 3858}
-                },
-                {
-                    { 82, 1106, 2130, 3154},
-                    { 338, 1362, 2386, 3410},
-                    { 594, 1618, 2642, 3666},
-                    { 850, 1874, 2898, 3922}
-                },
-                {
-                    { 146, 1170, 2194, 3218},
-                    { 402, 1426, 2450, 3474},
-                    { 658, 1682, 2706, 3730},
-                    { 914, 1938, 2962, 3986}
-                },
-                {
-                    { 210, 1234, 2258, 3282},
-                    { 466, 1490, 2514, 3538},
-                    { 722, 1746, 2770, 3794},
-                    { 978, 2002, 3026, 4050}
-                }
-            },
-            {
-                {
-                    { 34, 1058, 2082, 3106},
-                    { 290, 1314, 2338, 3362},
-                    { 546, 1570, 2594, 3618},
-                    { 802, 1826, 2850, 3874}
-                },
-                {
-                    { 98, 1122, 2146, 3170},
-                    { 354, 1378, 2402, 3426},
-                    { 610, 1634, 2658, 3682},
-                    { 866, 1890, 2914, 3938}
-                },
-                {
-                    { 162, 1186, 2210, 3234},
-                    { 418, 1442, 2466, 3490},
-                    { 674, 1698, 2722, 3746},
-                    { 930, 1954, 2978, 4002}
-                },
-                {
-                    { 226, 1250, 2274, 3298},
-                    { 482, 1506, 2530, 3554},
-                    { 738, 1762, 2786, 3810},
-                    { 994, 2018, 3042, 4066}
-                }
-            },
-            {
-                {
-                    { 50, 1074, 2098, 3122},
-                    { 306, 1330, 2354, 3378},
-                    { 562, 1586, 2610, 3634},
-                    { 818, 1842, 2866, 3890}
-                },
-                {
-                    { 114, 1138, 2162, 3186},
-                    { 370, 1394, 2418, 3442},
-                    { 626, 1650, 2674, 3698},
-                    { 882, 1906, 2930, 3954}
-                },
-                {
-                    { 178, 1202, 2226, 3250},
-                    { 434, 1458, 2482, 3506},
-                    { 690, 1714, 2738, 3762},
-                    { 946, 1970, 2994, 4018}
-                },
-                {
-                    { 242, 1266, 2290, 3314},
-                    { 498, 1522, 2546, 3570},
-                    { 754, 1778, 2802, 3826},
-                    { 1010, 2034, 3058, 4082}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 6, 1030, 2054, 3078},
-                    { 262, 1286, 2310, 3334},
-                    { 518, 1542, 2566, 3590},
-                    { 774, 1798, 2822, 3846}
-                },
-                {
-                    { 70, 1094, 2118, 3142},
-                    { 326, 1350, 2374, 3398},
-                    { 582, 1606, 2630, 3654},
-                    { 838, 1862, 2886, 3910}
-                },
-                {
-                    { 134, 1158, 2182, 3206},
-                    { 390, 1414, 2438, 3462},
-                    { 646, 1670, 2694, 3718},
-                    { 902, 1926, 2950, 3974}
-                },
-                {
-                    { 198, 1222, 2246, 3270},
-                    { 454, 1478, 2502, 3526},
-                    { 710, 1734, 2758, 3782},
-                    { 966, 1990, 3014, 4038}
-                }
-            },
-            {
-                {
-                    { 22, 1046, 2070, 3094},
-                    { 278, 1302, 2326, 3350},
-                    { 534, 1558, 2582, 3606},
-                    { 790, 1814, 2838, 3862}
-                },
-                {
-                    { 86, 1110, 2134, 3158},
-                    { 342, 1366, 2390, 3414},
-                    { 598, 1622, 2646, 3670},
-                    { 854, 1878, 2902, 3926}
-                },
-                {
-                    { 150, 1174, 2198, 3222},
-                    { 406, 1430, 2454, 3478},
-                    { 662, 1686, 2710, 3734},
-                    { 918, 1942, 2966, 3990}
-                },
-                {
-                    { 214, 1238, 2262, 3286},
-                    { 470, 1494, 2518, 3542},
-                    { 726, 1750, 2774, 3798},
-                    { 982, 2006, 3030, 4054}
-                }
-            },
-            {
-                {
-                    { 38, 1062, 2086, 3110},
-                    { 294, 1318, 2342, 3366},
-                    { 550, 1574, 2598, 3622},
-                    { 806, 1830, 2854, 3878}
-                },
-                {
-                    { 102, 1126, 2150, 3174},
-                    { 358, 1382, 2406, 3430},
-                    { 614, 1638, 2662, 3686},
-                    { 870, 1894, 2918, 3942}
-                },
-                {
-                    { 166, 1190, 2214, 3238},
-                    { 422, 1446, 2470, 3494},
-                    { 678, 1702, 2726, 3750},
-                    { 934, 1958, 2982, 4006}
-                },
-                {
-                    { 230, 1254, 2278, 3302},
-                    { 486, 1510, 2534, 3558},
-                    { 742, 1766, 2790, 3814},
-                    { 998, 2022, 3046, 4070}
-                }
-            },
-            {
-                {
-                    { 54, 1078, 2102, 3126},
-                    { 310, 1334, 2358, 3382},
-                    { 566, 1590, 2614, 3638},
-                    { 822, 1846, 2870, 3894}
-                },
-                {
-                    { 118, 1142, 2166, 3190},
-                    { 374, 1398, 2422, 3446},
-                    { 630, 1654, 2678, 3702},
-                    { 886, 1910, 2934, 3958}
-                },
-                {
-                    { 182, 1206, 2230, 3254},
-                    { 438, 1462, 2486, 3510},
-                    { 694, 1718, 2742, 3766},
-                    { 950, 1974, 2998, 4022}
-                },
-                {
-                    { 246, 1270, 2294, 3318},
-                    { 502, 1526, 2550, 3574},
-                    { 758, 1782, 2806, 3830},
-                    { 1014, 2038, 3062, 4086}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 10, 1034, 2058, 3082},
-                    { 266, 1290, 2314, 3338},
-                    { 522, 1546, 2570, 3594},
-                    { 778, 1802, 2826, 3850}
-                },
-                {
-                    { 74, 1098, 2122, 3146},
-                    { 330, 1354, 2378, 3402},
-                    { 586, 1610, 2634, 3658},
-                    { 842, 1866, 2890, 3914}
-                },
-                {
-                    { 138, 1162, 2186, 3210},
-                    { 394, 1418, 2442, 3466},
-                    { 650, 1674, 2698, 3722},
-                    { 906, 1930, 2954, 3978}
-                },
-                {
-                    { 202, 1226, 2250, 3274},
-                    { 458, 1482, 2506, 3530},
-                    { 714, 1738, 2762, 3786},
-                    { 970, 1994, 3018, 4042}
-                }
-            },
-            {
-                {
-                    { 26, 1050, 2074, 3098},
-                    { 282, 1306, 2330, 3354},
-                    { 538, 1562, 2586, 3610},
-                    { 794, 1818, 2842, 3866}
-                },
-                {
-                    { 90, 1114, 2138, 3162},
-                    { 346, 1370, 2394, 3418},
-                    { 602, 1626, 2650, 3674},
-                    { 858, 1882, 2906, 3930}
-                },
-                {
-                    { 154, 1178, 2202, 3226},
-                    { 410, 1434, 2458, 3482},
-                    { 666, 1690, 2714, 3738},
-                    { 922, 1946, 2970, 3994}
-                },
-                {
-                    { 218, 1242, 2266, 3290},
-                    { 474, 1498, 2522, 3546},
-                    { 730, 1754, 2778, 3802},
-                    { 986, 2010, 3034, 4058}
-                }
-            },
-            {
-                {
-                    { 42, 1066, 2090, 3114},
-                    { 298, 1322, 2346, 3370},
-                    { 554, 1578, 2602, 3626},
-                    { 810, 1834, 2858, 3882}
-                },
-                {
-                    { 106, 1130, 2154, 3178},
-                    { 362, 1386, 2410, 3434},
-                    { 618, 1642, 2666, 3690},
-                    { 874, 1898, 2922, 3946}
-                },
-                {
-                    { 170, 1194, 2218, 3242},
-                    { 426, 1450, 2474, 3498},
-                    { 682, 1706, 2730, 3754},
-                    { 938, 1962, 2986, 4010}
-                },
-                {
-                    { 234, 1258, 2282, 3306},
-                    { 490, 1514, 2538, 3562},
-                    { 746, 1770, 2794, 3818},
-                    { 1002, 2026, 3050, 4074}
-                }
-            },
-            {
-                {
-                    { 58, 1082, 2106, 3130},
-                    { 314, 1338, 2362, 3386},
-                    { 570, 1594, 2618, 3642},
-                    { 826, 1850, 2874, 3898}
-                },
-                {
-                    { 122, 1146, 2170, 3194},
-                    { 378, 1402, 2426, 3450},
-                    { 634, 1658, 2682, 3706},
-                    { 890, 1914, 2938, 3962}
-                },
-                {
-                    { 186, 1210, 2234, 3258},
-                    { 442, 1466, 2490, 3514},
-                    { 698, 1722, 2746, 3770},
-                    { 954, 1978, 3002, 4026}
-                },
-                {
-                    { 250, 1274, 2298, 3322},
-                    { 506, 1530, 2554, 3578},
-                    { 762, 1786, 2810, 3834},
-                    { 1018, 2042, 3066, 4090}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 14, 1038, 2062, 3086},
-                    { 270, 1294, 2318, 3342},
-                    { 526, 1550, 2574, 3598},
-                    { 782, 1806, 2830, 3854}
-                },
-                {
-                    { 78, 1102, 2126, 3150},
-                    { 334, 1358, 2382, 3406},
-                    { 590, 1614, 2638, 3662},
-                    { 846, 1870, 2894, 3918}
-                },
-                {
-                    { 142, 1166, 2190, 3214},
-                    { 398, 1422, 2446, 3470},
-                    { 654, 1678, 2702, 3726},
-                    { 910, 1934, 2958, 3982}
-                },
-                {
-                    { 206, 1230, 2254, 3278},
-                    { 462, 1486, 2510, 3534},
-                    { 718, 1742, 2766, 3790},
-                    { 974, 1998, 3022, 4046}
-                }
-            },
-            {
-                {
-                    { 30, 1054, 2078, 3102},
-                    { 286, 1310, 2334, 3358},
-                    { 542, 1566, 2590, 3614},
-                    { 798, 1822, 2846, 3870}
-                },
-                {
-                    { 94, 1118, 2142, 3166},
-                    { 350, 1374, 2398, 3422},
-                    { 606, 1630, 2654, 3678},
-                    { 862, 1886, 2910, 3934}
-                },
-                {
-                    { 158, 1182, 2206, 3230},
-                    { 414, 1438, 2462, 3486},
-                    { 670, 1694, 2718, 3742},
-                    { 926, 1950, 2974, 3998}
-                },
-                {
-                    { 222, 1246, 2270, 3294},
-                    { 478, 1502, 2526, 3550},
-                    { 734, 1758, 2782, 3806},
-                    { 990, 2014, 3038, 4062}
-                }
-            },
-            {
-                {
-                    { 46, 1070, 2094, 3118},
-                    { 302, 1326, 2350, 3374},
-                    { 558, 1582, 2606, 3630},
-                    { 814, 1838, 2862, 3886}
-                },
-                {
-                    { 110, 1134, 2158, 3182},
-                    { 366, 1390, 2414, 3438},
-                    { 622, 1646, 2670, 3694},
-                    { 878, 1902, 2926, 3950}
-                },
-                {
-                    { 174, 1198, 2222, 3246},
-                    { 430, 1454, 2478, 3502},
-                    { 686, 1710, 2734, 3758},
-                    { 942, 1966, 2990, 4014}
-                },
-                {
-                    { 238, 1262, 2286, 3310},
-                    { 494, 1518, 2542, 3566},
-                    { 750, 1774, 2798, 3822},
-                    { 1006, 2030, 3054, 4078}
-                }
-            },
-            {
-                {
-                    { 62, 1086, 2110, 3134},
-                    { 318, 1342, 2366, 3390},
-                    { 574, 1598, 2622, 3646},
-                    { 830, 1854, 2878, 3902}
-                },
-                {
-                    { 126, 1150, 2174, 3198},
-                    { 382, 1406, 2430, 3454},
-                    { 638, 1662, 2686, 3710},
-                    { 894, 1918, 2942, 3966}
-                },
-                {
-                    { 190, 1214, 2238, 3262},
-                    { 446, 1470, 2494, 3518},
-                    { 702, 1726, 2750, 3774},
-                    { 958, 1982, 3006, 4030}
-                },
-                {
-                    { 254, 1278, 2302, 3326},
-                    { 510, 1534, 2558, 3582},
-                    { 766, 1790, 2814, 3838},
-                    { 1022, 2046, 3070, 4094}
-                }
-            }
-        }
-    },
-    {
-        {
-            {
-                {
-                    { 3, 1027, 2051, 3075},
-                    { 259, 1283, 2307, 3331},
-                    { 515, 1539, 2563, 3587},
-                    { 771, 1795, 2819, 3843}
-                },
-                {
-                    { 67, 1091, 2115, 3139},
-                    { 323, 1347, 2371, 3395},
-                    { 579, 1603, 2627, 3651},
-                    { 835, 1859, 2883, 3907}
-                },
-                {
-                    { 131, 1155, 2179, 3203},
-                    { 387, 1411, 2435, 3459},
-                    { 643, 1667, 2691, 3715},
-                    { 899, 1923, 2947, 3971}
-                },
-                {
-                    { 195, 1219, 2243, 3267},
-                    { 451, 1475, 2499, 3523},
-                    { 707, 1731, 2755, 3779},
-                    { 963, 1987, 3011, 4035}
-                }
-            },
-            {
-                {
-                    { 19, 1043, 2067, 3091},
-                    { 275, 1299, 2323, 3347},
-                    { 531, 1555, 2579, 3603},
-                    { 787, 1811, 2835, 3859}
-                },
-                {
-                    { 83, 1107, 2131, 3155},
-                    { 339, 1363, 2387, 3411},
-                    { 595, 1619, 2643, 3667},
-                    { 851, 1875, 2899, 3923}
-                },
-                {
-                    { 147, 1171, 2195, 3219},
-                    { 403, 1427, 2451, 3475},
-                    { 659, 1683, 2707, 3731},
-                    { 915, 1939, 2963, 3987}
-                },
-                {
-                    { 211, 1235, 2259, 3283},
-                    { 467, 1491, 2515, 3539},
-                    { 723, 1747, 2771, 3795},
-                    { 979, 2003, 3027, 4051}
-                }
-            },
-            {
-                {
-                    { 35, 1059, 2083, 3107},
-                    { 291, 1315, 2339, 3363},
-                    { 547, 1571, 2595, 3619},
-                    { 803, 1827, 2851, 3875}
-                },
-                {
-                    { 99, 1123, 2147, 3171},
-                    { 355, 1379, 2403, 3427},
-                    { 611, 1635, 2659, 3683},
-                    { 867, 1891, 2915, 3939}
-                },
-                {
-                    { 163, 1187, 2211, 3235},
-                    { 419, 1443, 2467, 3491},
-                    { 675, 1699, 2723, 3747},
-                    { 931, 1955, 2979, 4003}
-                },
-                {
-                    { 227, 1251, 2275, 3299},
-                    { 483, 1507, 2531, 3555},
-                    { 739, 1763, 2787, 3811},
-                    { 995, 2019, 3043, 4067}
-                }
-            },
-            {
-                {
-                    { 51, 1075, 2099, 3123},
-                    { 307, 1331, 2355, 3379},
-                    { 563, 1587, 2611, 3635},
-                    { 819, 1843, 2867, 3891}
-                },
-                {
-                    { 115, 1139, 2163, 3187},
-                    { 371, 1395, 2419, 3443},
-                    { 627, 1651, 2675, 3699},
-                    { 883, 1907, 2931, 3955}
-                },
-                {
-                    { 179, 1203, 2227, 3251},
-                    { 435, 1459, 2483, 3507},
-                    { 691, 1715, 2739, 3763},
-                    { 947, 1971, 2995, 4019}
-                },
-                {
-                    { 243, 1267, 2291, 3315},
-                    { 499, 1523, 2547, 3571},
-                    { 755, 1779, 2803, 3827},
-                    { 1011, 2035, 3059, 4083}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 7, 1031, 2055, 3079},
-                    { 263, 1287, 2311, 3335},
-                    { 519, 1543, 2567, 3591},
-                    { 775, 1799, 2823, 3847}
-                },
-                {
-                    { 71, 1095, 2119, 3143},
-                    { 327, 1351, 2375, 3399},
-                    { 583, 1607, 2631, 3655},
-                    { 839, 1863, 2887, 3911}
-                },
-                {
-                    { 135, 1159, 2183, 3207},
-                    { 391, 1415, 2439, 3463},
-                    { 647, 1671, 2695, 3719},
-                    { 903, 1927, 2951, 3975}
-                },
-                {
-                    { 199, 1223, 2247, 3271},
-                    { 455, 1479, 2503, 3527},
-                    { 711, 1735, 2759, 3783},
-                    { 967, 1991, 3015, 4039}
-                }
-            },
-            {
-                {
-                    { 23, 1047, 2071, 3095},
-                    { 279, 1303, 2327, 3351},
-                    { 535, 1559, 2583, 3607},
-                    { 791, 1815, 2839, 3863}
-                },
-                {
-                    { 87, 1111, 2135, 3159},
-                    { 343, 1367, 2391, 3415},
-                    { 599, 1623, 2647, 3671},
-                    { 855, 1879, 2903, 3927}
-                },
-                {
-                    { 151, 1175, 2199, 3223},
-                    { 407, 1431, 2455, 3479},
-                    { 663, 1687, 2711, 3735},
-                    { 919, 1943, 2967, 3991}
-                },
-                {
-                    { 215, 1239, 2263, 3287},
-                    { 471, 1495, 2519, 3543},
-                    { 727, 1751, 2775, 3799},
-                    { 983, 2007, 3031, 4055}
-                }
-            },
-            {
-                {
-                    { 39, 1063, 2087, 3111},
-                    { 295, 1319, 2343, 3367},
-                    { 551, 1575, 2599, 3623},
-                    { 807, 1831, 2855, 3879}
-                },
-                {
-                    { 103, 1127, 2151, 3175},
-                    { 359, 1383, 2407, 3431},
-                    { 615, 1639, 2663, 3687},
-                    { 871, 1895, 2919, 3943}
-                },
-                {
-                    { 167, 1191, 2215, 3239},
-                    { 423, 1447, 2471, 3495},
-                    { 679, 1703, 2727, 3751},
-                    { 935, 1959, 2983, 4007}
-                },
-                {
-                    { 231, 1255, 2279, 3303},
-                    { 487, 1511, 2535, 3559},
-                    { 743, 1767, 2791, 3815},
-                    { 999, 2023, 3047, 4071}
-                }
-            },
-            {
-                {
-                    { 55, 1079, 2103, 3127},
-                    { 311, 1335, 2359, 3383},
-                    { 567, 1591, 2615, 3639},
-                    { 823, 1847, 2871, 3895}
-                },
-                {
-                    { 119, 1143, 2167, 3191},
-                    { 375, 1399, 2423, 3447},
-                    { 631, 1655, 2679, 3703},
-                    { 887, 1911, 2935, 3959}
-                },
-                {
-                    { 183, 1207, 2231, 3255},
-                    { 439, 1463, 2487, 3511},
-                    { 695, 1719, 2743, 3767},
-                    { 951, 1975, 2999, 4023}
-                },
-                {
-                    { 247, 1271, 2295, 3319},
-                    { 503, 1527, 2551, 3575},
-                    { 759, 1783, 2807, 3831},
-                    { 1015, 2039, 3063, 4087}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 11, 1035, 2059, 3083},
-                    { 267, 1291, 2315, 3339},
-                    { 523, 1547, 2571, 3595},
-                    { 779, 1803, 2827, 3851}
-                },
-                {
-                    { 75, 1099, 2123, 3147},
-                    { 331, 1355, 2379, 3403},
-                    { 587, 1611, 2635, 3659},
-                    { 843, 1867, 2891, 3915}
-                },
-                {
-                    { 139, 1163, 2187, 3211},
-                    { 395, 1419, 2443, 3467},
-                    { 651, 1675, 2699, 3723},
-                    { 907, 1931, 2955, 3979}
-                },
-                {
-                    { 203, 1227, 2251, 3275},
-                    { 459, 1483, 2507, 3531},
-                    { 715, 1739, 2763, 3787},
-                    { 971, 1995, 3019, 4043}
-                }
-            },
-            {
-                {
-                    { 27, 1051, 2075, 3099},
-                    { 283, 1307, 2331, 3355},
-                    { 539, 1563, 2587, 3611},
-                    { 795, 1819, 2843, 3867}
-                },
-                {
-                    { 91, 1115, 2139, 3163},
-                    { 347, 1371, 2395, 3419},
-                    { 603, 1627, 2651, 3675},
-                    { 859, 1883, 2907, 3931}
-                },
-                {
-                    { 155, 1179, 2203, 3227},
-                    { 411, 1435, 2459, 3483},
-                    { 667, 1691, 2715, 3739},
-                    { 923, 1947, 2971, 3995}
-                },
-                {
-                    { 219, 1243, 2267, 3291},
-                    { 475, 1499, 2523, 3547},
-                    { 731, 1755, 2779, 3803},
-                    { 987, 2011, 3035, 4059}
-                }
-            },
-            {
-                {
-                    { 43, 1067, 2091, 3115},
-                    { 299, 1323, 2347, 3371},
-                    { 555, 1579, 2603, 3627},
-                    { 811, 1835, 2859, 3883}
-                },
-                {
-                    { 107, 1131, 2155, 3179},
-                    { 363, 1387, 2411, 3435},
-                    { 619, 1643, 2667, 3691},
-                    { 875, 1899, 2923, 3947}
-                },
-                {
-                    { 171, 1195, 2219, 3243},
-                    { 427, 1451, 2475, 3499},
-                    { 683, 1707, 2731, 3755},
-                    { 939, 1963, 2987, 4011}
-                },
-                {
-                    { 235, 1259, 2283, 3307},
-                    { 491, 1515, 2539, 3563},
-                    { 747, 1771, 2795, 3819},
-                    { 1003, 2027, 3051, 4075}
-                }
-            },
-            {
-                {
-                    { 59, 1083, 2107, 3131},
-                    { 315, 1339, 2363, 3387},
-                    { 571, 1595, 2619, 3643},
-                    { 827, 1851, 2875, 3899}
-                },
-                {
-                    { 123, 1147, 2171, 3195},
-                    { 379, 1403, 2427, 3451},
-                    { 635, 1659, 2683, 3707},
-                    { 891, 1915, 2939, 3963}
-                },
-                {
-                    { 187, 1211, 2235, 3259},
-                    { 443, 1467, 2491, 3515},
-                    { 699, 1723, 2747, 3771},
-                    { 955, 1979, 3003, 4027}
-                },
-                {
-                    { 251, 1275, 2299, 3323},
-                    { 507, 1531, 2555, 3579},
-                    { 763, 1787, 2811, 3835},
-                    { 1019, 2043, 3067, 4091}
-                }
-            }
-        },
-        {
-            {
-                {
-                    { 15, 1039, 2063, 3087},
-                    { 271, 1295, 2319, 3343},
-                    { 527, 1551, 2575, 3599},
-                    { 783, 1807, 2831, 3855}
-                },
-                {
-                    { 79, 1103, 2127, 3151},
-                    { 335, 1359, 2383, 3407},
-                    { 591, 1615, 2639, 3663},
-                    { 847, 1871, 2895, 3919}
-                },
-                {
-                    { 143, 1167, 2191, 3215},
-                    { 399, 1423, 2447, 3471},
-                    { 655, 1679, 2703, 3727},
-                    { 911, 1935, 2959, 3983}
-                },
-                {
-                    { 207, 1231, 2255, 3279},
-                    { 463, 1487, 2511, 3535},
-                    { 719, 1743, 2767, 3791},
-                    { 975, 1999, 3023, 4047}
-                }
-            },
-            {
-                {
-                    { 31, 1055, 2079, 3103},
-                    { 287, 1311, 2335, 3359},
-                    { 543, 1567, 2591, 3615},
-                    { 799, 1823, 2847, 3871}
-                },
-                {
-                    { 95, 1119, 2143, 3167},
-                    { 351, 1375, 2399, 3423},
-                    { 607, 1631, 2655, 3679},
-                    { 863, 1887, 2911, 3935}
-                },
-                {
-                    { 159, 1183, 2207, 3231},
-                    { 415, 1439, 2463, 3487},
-                    { 671, 1695, 2719, 3743},
-                    { 927, 1951, 2975, 3999}
-                },
-                {
-                    { 223, 1247, 2271, 3295},
-                    { 479, 1503, 2527, 3551},
-                    { 735, 1759, 2783, 3807},
-                    { 991, 2015, 3039, 4063}
-                }
-            },
-            {
-                {
-                    { 47, 1071, 2095, 3119},
-                    { 303, 1327, 2351, 3375},
-                    { 559, 1583, 2607, 3631},
-                    { 815, 1839, 2863, 3887}
-                },
-                {
-                    { 111, 1135, 2159, 3183},
-                    { 367, 1391, 2415, 3439},
-                    { 623, 1647, 2671, 3695},
-                    { 879, 1903, 2927, 3951}
-                },
-                {
-                    { 175, 1199, 2223, 3247},
-                    { 431, 1455, 2479, 3503},
-                    { 687, 1711, 2735, 3759},
-                    { 943, 1967, 2991, 4015}
-                },
-                {
-                    { 239, 1263, 2287, 3311},
-                    { 495, 1519, 2543, 3567},
-                    { 751, 1775, 2799, 3823},
-                    { 1007, 2031, 3055, 4079}
-                }
-            },
-            {
-                {
-                    { 63, 1087, 2111, 3135},
-                    { 319, 1343, 2367, 3391},
-                    { 575, 1599, 2623, 3647},
-                    { 831, 1855, 2879, 3903}
-                },
-                {
-                    { 127, 1151, 2175, 3199},
-                    { 383, 1407, 2431, 3455},
-                    { 639, 1663, 2687, 3711},
-                    { 895, 1919, 2943, 3967}
-                },
-                {
-                    { 191, 1215, 2239, 3263},
-                    { 447, 1471, 2495, 3519},
-                    { 703, 1727, 2751, 3775},
-                    { 959, 1983, 3007, 4031}
-                },
-                {
-                    { 255, 1279, 2303, 3327},
-                    { 511, 1535, 2559, 3583},
-                    { 767, 1791, 2815, 3839},
-                    { 1023, 2047, 3071, 4095}
-                }
-            }
-        }
-    }
-};
-
-/*
- * Allows to compute the byte length for the id of the given type
- * @param CURR_LEVEL the M-Gram level M
- * @param id_type the type id
- * @param id_len_bytes [out] the total byte length to store the id
- *                           of this type, this input value will
- *                           be incremented with the byte lengths.
-
-    template<TModelLevel CURR_LEVEL>
-    static inline void gram_id_type_2_byte_len(uint32_t id_type, uint8_t & id_len_bytes) {
-        //Compute the M-gram id length from the M-gram id type.
-        //Here we use the pre-computed multipliers we add the
-        //final bits at the end of the function.
-        uint8_t word_len_bypes = 0;
-        for (int idx = (CURR_LEVEL - 1); idx >= 0; --idx) {
-
-            word_len_bypes = (uint8_t) (id_type / NUMBER_ID_TYPES_PER_LEVEL[idx]);
-
-            LOG_DEBUG3 << SSTR(id_type) << " / " << SSTR(NUMBER_ID_TYPES_PER_LEVEL[idx])
-                    << " =  " << SSTR((uint32_t) word_len_bypes) << END_LOG;
-
-            id_type = (uint8_t) (id_type % NUMBER_ID_TYPES_PER_LEVEL[idx]);
-            id_len_bytes += word_len_bypes;
-        }
-        //Note that in the loop above we have "coeff = len_bits[idx] - 1"
-        //Therefore, here we add the number of tokens to account for this -1's
-        id_len_bytes += (uint8_t) CURR_LEVEL;
-    }
- */
-
-static constexpr uint8_t LEVEL_2_GRAM_TO_BYTE_LEN[] = {2, 3, 4, 5, 3, 4, 5, 6, 4, 5, 6, 7, 5, 6, 7, 8};
-static constexpr uint8_t LEVEL_3_GRAM_TO_BYTE_LEN[] = {3, 4, 5, 6, 4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12};
-static constexpr uint8_t LEVEL_4_GRAM_TO_BYTE_LEN[] = {4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16};
-static constexpr uint8_t LEVEL_5_GRAM_TO_BYTE_LEN[] = {5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20};
-static constexpr uint8_t LEVEL_6_GRAM_TO_BYTE_LEN[] = {6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 18, 19, 20, 21, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 18, 19, 20, 21, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 18, 19, 20, 21, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 12, 13, 14, 15, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 13, 14, 15, 16, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 14, 15, 16, 17, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 15, 16, 17, 18, 16, 17, 18, 19, 17, 18, 19, 20, 18, 19, 20, 21};
-
-#endif	/* NEWFILE_HPP */
-
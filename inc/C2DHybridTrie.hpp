@@ -35,7 +35,7 @@
 #include "LayeredTrieBase.hpp"
 
 #include "HashingWordIndex.hpp"
-#include "GreedyMemoryAllocator.hpp"
+#include "IntegerKeyHashMap.hpp"
 #include "HashingUtils.hpp"
 #include "TextPieceReader.hpp"
 
@@ -86,6 +86,9 @@ namespace uva {
                  * This breaks encapsulation a bit, exposing the internals, but
                  * there is no other better way, for fine tuning the memory usage.
                  * 
+                 * If the flat integer key maps are configured, see __C2DHybridTrie::INTEGER_KEY_MAP_TYPE,
+                 * then the factors are the buckets factors of the flat maps instead.
+                 * 
                  * @param _pWordIndex the word index to be used
                  * @param _oGramMemFactor The One-Gram memory factor needed for
                  * the greedy allocator for the unordered_map
@@ -95,8 +98,8 @@ namespace uva {
                  * the greedy allocator for the unordered_map
                  */
                 explicit C2DHybridTrie(WordIndexType & word_index,
-                        const float mram_mem_factor = __C2DHybridTrie::UM_M_GRAM_MEMORY_FACTOR,
-                        const float ngram_mem_factor = __C2DHybridTrie::UM_N_GRAM_MEMORY_FACTOR);
+                        const float mram_mem_factor = __C2DHybridTrie::M_GRAM_MEMORY_FACTOR,
+                        const float ngram_mem_factor = __C2DHybridTrie::N_GRAM_MEMORY_FACTOR);
 
                 /**
                  * Computes the M-Gram context using the previous context and the current word id
@@ -106,13 +109,13 @@ namespace uva {
                     const TLongId key = TShortId_TShortId_2_TLongId(ctx_id, word_id);
 
                     //Search for the map for that context id
-                    TMGramsMap::const_iterator result = m_m_gram_map_ptrs[level_idx]->find(key);
-                    if (result == m_m_gram_map_ptrs[level_idx]->end()) {
+                    const TShortId * next_ctx_id = m_m_gram_map_ptrs[level_idx]->find(key);
+                    if (next_ctx_id == NULL) {
                         //There is no data found under this context
                         return false;
                     } else {
                         //Update the context with the found value uf the next context
-                        ctx_id = result->second;
+                        ctx_id = *next_ctx_id;
                         //The context can always be computed
                         return true;
                     }
@@ -125,6 +128,29 @@ namespace uva {
                     LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    if (m_1_gram_data != NULL) {
+                        breakdown.add("C2DHybridTrie", "payloads", M_GRAM_LEVEL_1, BASE::get_num_word_ids() * sizeof (T_M_Gram_Payload));
+                    }
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                        if (m_m_gram_map_ptrs[idx] != NULL) {
+                            m_m_gram_map_ptrs[idx]->memory_breakdown(breakdown, idx + BASE::MGRAM_IDX_OFFSET);
+                        }
+                        if (m_m_gram_data[idx] != NULL) {
+                            breakdown.add("C2DHybridTrie", "payloads", idx + BASE::MGRAM_IDX_OFFSET,
+                                    m_M_gram_num_ctx_ids[idx] * sizeof (T_M_Gram_Payload));
+                        }
+                    }
+                    if (m_n_gram_map_ptr != NULL) {
+                        m_n_gram_map_ptr->memory_breakdown(breakdown, MAX_LEVEL);
+                    }
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -139,7 +165,7 @@ namespace uva {
                  * For more details @see LayeredTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     const TShortId word_id = gram.get_end_word_id();
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Store the payload
@@ -245,16 +271,16 @@ namespace uva {
                         const TLongId key = TShortId_TShortId_2_TLongId(ctx_id, word_id);
 
                         //Search for the map for that context id
-                        TNGramsMap::const_iterator result = m_n_gram_map_ptr->find(key);
-                        if (result == m_n_gram_map_ptr->end()) {
+                        const TLogProbBackOff * prob = m_n_gram_map_ptr->find(key);
+                        if (prob == NULL) {
                             //The payload could not be found
                             LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: "
                                     << SSTR(ctx_id) << ", word_id: " << SSTR(word_id) << END_LOG;
                             status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
                         } else {
                             //There is data found under this context
-                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &result->second;
-                            LOG_DEBUG << "The payload is retrieved: " << result->second << END_LOG;
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = prob;
+                            LOG_DEBUG << "The payload is retrieved: " << (*prob) << END_LOG;
                         }
                     }
                 }
@@ -266,9 +292,9 @@ namespace uva {
 
             private:
 
-                //The M-Gram memory factor needed for the greedy allocator for the unordered_map
+                //The M-Gram memory factor of the M-Gram maps, see the constructor
                 const float m_mgram_mem_factor;
-                //The N-Gram memory factor needed for the greedy allocator for the unordered_map
+                //The N-Gram memory factor of the N-Gram map, see the constructor
                 const float m_ngram_mem_factor;
 
                 //Stores the context id counters per M-gram level: 1 < M < N
@@ -279,28 +305,16 @@ namespace uva {
                 //Stores the 1-gram data
                 T_M_Gram_Payload * m_1_gram_data;
 
-                //The type of key,value pairs to be stored in the M Grams map
-                typedef pair< const TLongId, TShortId> TMGramEntry;
-                //The typedef for the M Grams map allocator
-                typedef GreedyMemoryAllocator< TMGramEntry > TMGramAllocator;
-                //The N Grams map type
-                typedef unordered_map<TLongId, TShortId, std::hash<TLongId>, std::equal_to<TLongId>, TMGramAllocator > TMGramsMap;
-                //The actual data storage for the M Grams for 1 < M < N
-                TMGramAllocator * m_m_gram_alloc_ptrs[BASE::NUM_M_GRAM_LEVELS];
+                //The M Grams map type, the integer key map type is configurable
+                typedef typename S_Integer_Key_Map_Type<__C2DHybridTrie::INTEGER_KEY_MAP_TYPE, TShortId>::type TMGramsMap;
                 //The array of maps map storing M-grams for 1 < M < N
                 TMGramsMap * m_m_gram_map_ptrs[BASE::NUM_M_GRAM_LEVELS];
                 //Stores the M-gram data for the M levels: 1 < M < N
                 //This is a two dimensional array
                 T_M_Gram_Payload * m_m_gram_data[BASE::NUM_M_GRAM_LEVELS];
 
-                //The type of key,value pairs to be stored in the N Grams map
-                typedef pair< const TLongId, TLogProbBackOff> TNGramEntry;
-                //The typedef for the N Grams map allocator
-                typedef GreedyMemoryAllocator< TNGramEntry > TNGramAllocator;
-                //The N Grams map type
-                typedef unordered_map<TLongId, TLogProbBackOff, std::hash<TLongId>, std::equal_to<TLongId>, TNGramAllocator > TNGramsMap;
-                //The actual data storage for the N Grams
-                TNGramAllocator * m_n_gram_alloc_ptr;
+                //The N Grams map type, the integer key map type is configurable
+                typedef typename S_Integer_Key_Map_Type<__C2DHybridTrie::INTEGER_KEY_MAP_TYPE, TLogProbBackOff>::type TNGramsMap;
                 //The map storing the N-Grams, they do not have back-off values
                 TNGramsMap * m_n_gram_map_ptr;
 
@@ -326,12 +340,6 @@ namespace uva {
                 void preAllocateNGrams(const size_t counts[MAX_LEVEL]);
 
             };
-
-            typedef C2DHybridTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TC2DHybridTrieBasic;
-            typedef C2DHybridTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TC2DHybridTrieCount;
-            typedef C2DHybridTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TC2DHybridTrieOptBasic;
-            typedef C2DHybridTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TC2DHybridTrieOptCount;
-            typedef C2DHybridTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TC2DHybridTrieHashing;
         }
     }
 }
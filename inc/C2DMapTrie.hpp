@@ -46,7 +46,7 @@
 
 #include "LayeredTrieBase.hpp"
 
-#include "GreedyMemoryAllocator.hpp"
+#include "IntegerKeyHashMap.hpp"
 #include "HashingUtils.hpp"
 #include "TextPieceReader.hpp"
 #include "HashingWordIndex.hpp"
@@ -103,15 +103,16 @@ namespace uva {
                  * This breaks encapsulation a bit, exposing the internals, but
                  * there is no other better way, for fine tuning the memory usage.
                  * 
+                 * If the flat integer key maps are configured, see __C2DMapTrie::INTEGER_KEY_MAP_TYPE,
+                 * then the factors are the buckets factors of the flat maps instead.
+                 * 
                  * @param word_index the word index to be used
-                 * @param mgram_mem_factor The M-Gram memory factor needed for
-                 * the greedy allocator for the unordered_map
-                 * @param ngram_mem_factor The N-Gram memory factor needed for
-                 * the greedy allocator for the unordered_map
+                 * @param mgram_mem_factor The M-Gram memory factor of the M-Gram maps
+                 * @param ngram_mem_factor The N-Gram memory factor of the N-Gram map
                  */
                 explicit C2DMapTrie(WordIndexType & word_index,
-                        const float mgram_mem_factor = __C2DMapTrie::UM_M_GRAM_MEMORY_FACTOR,
-                        const float ngram_mem_factor = __C2DMapTrie::UM_N_GRAM_MEMORY_FACTOR);
+                        const float mgram_mem_factor = __C2DMapTrie::M_GRAM_MEMORY_FACTOR,
+                        const float ngram_mem_factor = __C2DMapTrie::N_GRAM_MEMORY_FACTOR);
 
                 /**
                  * Computes the M-Gram context using the previous context and the current word id
@@ -131,6 +132,25 @@ namespace uva {
                     LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    if (m_1_gram_data != NULL) {
+                        breakdown.add("C2DMapTrie", "payloads", M_GRAM_LEVEL_1, BASE::get_num_word_ids() * sizeof (T_M_Gram_Payload));
+                    }
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                        if (m_m_gram_map_ptrs[idx] != NULL) {
+                            m_m_gram_map_ptrs[idx]->memory_breakdown(breakdown, idx + BASE::MGRAM_IDX_OFFSET);
+                        }
+                    }
+                    if (m_n_gram_map_ptr != NULL) {
+                        m_n_gram_map_ptr->memory_breakdown(breakdown, MAX_LEVEL);
+                    }
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -145,7 +165,7 @@ namespace uva {
                  * For more details @see LayeredTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     const TShortId word_id = gram.get_end_word_id();
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Store the payload
@@ -213,16 +233,16 @@ namespace uva {
                         const TModelLevel & level_idx = CURR_LEVEL_MIN_2_MAP[query.m_begin_word_idx][query.m_end_word_idx];
                         if (get_ctx_id(level_idx, word_id, ctx_id)) {
                             LOG_DEBUG << "level_idx: " << SSTR(level_idx) << ", ctx_id: " << ctx_id << END_LOG;
-                            TMGramsMap::const_iterator result = m_m_gram_map_ptrs[level_idx]->find(ctx_id);
-                            if (result == m_m_gram_map_ptrs[level_idx]->end()) {
+                            const T_M_Gram_Payload * payload = m_m_gram_map_ptrs[level_idx]->find(ctx_id);
+                            if (payload == NULL) {
                                 //The payload could not be found
                                 LOG_DEBUG1 << "Unable to find m-gram data for ctx_id: " << SSTR(ctx_id)
                                         << ", word_id: " << SSTR(word_id) << END_LOG;
                                 status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
                             } else {
                                 //There is data found under this context
-                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &result->second;
-                                LOG_DEBUG << "The payload is retrieved: " << (string) result->second << END_LOG;
+                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = payload;
+                                LOG_DEBUG << "The payload is retrieved: " << (string) (*payload) << END_LOG;
                             }
                         } else {
                             //The payload could not be found
@@ -254,16 +274,16 @@ namespace uva {
                         const TModelLevel & level_idx = CURR_LEVEL_MIN_2_MAP[query.m_begin_word_idx][query.m_end_word_idx];
                         if (get_ctx_id(level_idx, word_id, ctx_id)) {
                             LOG_DEBUG << "ctx_id: " << ctx_id << END_LOG;
-                            TNGramsMap::const_iterator result = m_n_gram_map_ptr->find(ctx_id);
-                            if (result == m_n_gram_map_ptr->end()) {
+                            const TLogProbBackOff * prob = m_n_gram_map_ptr->find(ctx_id);
+                            if (prob == NULL) {
                                 //The payload could not be found
                                 LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: "
                                         << SSTR(ctx_id) << ", word_id: " << SSTR(word_id) << END_LOG;
                                 status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
                             } else {
                                 //There is data found under this context
-                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &result->second;
-                                LOG_DEBUG << "The payload is retrieved: " << result->second << END_LOG;
+                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = prob;
+                                LOG_DEBUG << "The payload is retrieved: " << (*prob) << END_LOG;
                             }
                         } else {
                             //The payload could not be found
@@ -281,33 +301,21 @@ namespace uva {
 
             private:
 
-                //The M-Gram memory factor needed for the greedy allocator for the unordered_map
+                //The M-Gram memory factor of the M-Gram maps, see the constructor
                 const float m_mgram_mem_factor;
-                //The N-Gram memory factor needed for the greedy allocator for the unordered_map
+                //The N-Gram memory factor of the N-Gram map, see the constructor
                 const float m_ngram_mem_factor;
 
                 //Stores the 1-gram data
                 T_M_Gram_Payload * m_1_gram_data;
 
-                //The type of key,value pairs to be stored in the M Grams map
-                typedef pair< const TLongId, T_M_Gram_Payload> TMGramEntry;
-                //The typedef for the M Grams map allocator
-                typedef GreedyMemoryAllocator< TMGramEntry > TMGramAllocator;
-                //The N Grams map type
-                typedef unordered_map<TLongId, T_M_Gram_Payload, std::hash<TLongId>, std::equal_to<TLongId>, TMGramAllocator > TMGramsMap;
-                //The actual data storage for the M Grams for 1 < M < N
-                TMGramAllocator * m_m_gram_alloc_ptrs[MAX_LEVEL - BASE::MGRAM_IDX_OFFSET];
+                //The M Grams map type, the integer key map type is configurable
+                typedef typename S_Integer_Key_Map_Type<__C2DMapTrie::INTEGER_KEY_MAP_TYPE, T_M_Gram_Payload>::type TMGramsMap;
                 //The array of maps map storing M-grams for 1 < M < N
                 TMGramsMap * m_m_gram_map_ptrs[MAX_LEVEL - BASE::MGRAM_IDX_OFFSET];
 
-                //The type of key,value pairs to be stored in the N Grams map
-                typedef pair< const TLongId, TLogProbBackOff> TNGramEntry;
-                //The typedef for the N Grams map allocator
-                typedef GreedyMemoryAllocator< TNGramEntry > TNGramAllocator;
-                //The N Grams map type
-                typedef unordered_map<TLongId, TLogProbBackOff, std::hash<TLongId>, std::equal_to<TLongId>, TNGramAllocator > TNGramsMap;
-                //The actual data storage for the N Grams
-                TNGramAllocator * m_n_gram_alloc_ptr;
+                //The N Grams map type, the integer key map type is configurable
+                typedef typename S_Integer_Key_Map_Type<__C2DMapTrie::INTEGER_KEY_MAP_TYPE, TLogProbBackOff>::type TNGramsMap;
                 //The map storing the N-Grams, they do not have back-off values
                 TNGramsMap * m_n_gram_map_ptr;
 
@@ -335,12 +343,6 @@ namespace uva {
                  */
                 void pre_allocate_n_grams(const size_t counts[MAX_LEVEL]);
             };
-
-            typedef C2DMapTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TC2DMapTrieBasic;
-            typedef C2DMapTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TC2DMapTrieCount;
-            typedef C2DMapTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TC2DMapTrieHashing;
-            typedef C2DMapTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TC2DMapTrieOptBasic;
-            typedef C2DMapTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TC2DMapTrieOptCount;
         }
     }
 }
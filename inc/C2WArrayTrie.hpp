@@ -36,6 +36,7 @@
 #include "AWordIndex.hpp"
 #include "HashingWordIndex.hpp"
 #include "ArrayUtils.hpp"
+#include "ExternalMergeSorter.hpp"
 
 using namespace std;
 using namespace uva::smt::tries::dictionary;
@@ -68,6 +69,29 @@ namespace uva {
                     return (one.id < two.id);
                 }
 
+                /**
+                 * Stores the M-gram context id, word id and the probability/back-off data.
+                 * It is used to sort the M-gram data for levels 1 < M < N on the disk.
+                 * @param ctx_id the context id
+                 * @param word_id the word id
+                 * @param payload the back-off and probability data
+                 */
+                typedef struct {
+                    TShortId ctx_id;
+                    TShortId word_id;
+                    T_M_Gram_Payload payload;
+                } TCtxWordIdPBData;
+
+                /**
+                 * This is the less operator implementation
+                 * @param one the first object to compare
+                 * @param two the second object to compare
+                 * @return true if (one.ctx_id, one.word_id) < (two.ctx_id, two.word_id)
+                 */
+                inline bool operator<(const TCtxWordIdPBData & one, const TCtxWordIdPBData & two) {
+                    return (one.ctx_id < two.ctx_id) || ((one.ctx_id == two.ctx_id) && (one.word_id < two.word_id));
+                }
+
                 /**
                  * Stores the information about the context id, word id and corresponding probability
                  * This data structure is to be used for the N-Gram data, as there are no back-offs
@@ -83,22 +107,24 @@ namespace uva {
                 } TCtxIdProbData;
 
                 /**
-                 * This is the compare operator implementation
+                 * This is the compare operator implementation. The context id
+                 * goes first, this is the order in which the N-grams come from
+                 * a model sorted by word ids, see the pre-sorted build mode.
                  * @param one the first object to compare
                  * @param two the second object to compare
-                 * @return -1 if (word_id,ctx_id) < (word_id,ctx_id)
-                 *          0 if (word_id,ctx_id) == (word_id,ctx_id)
-                 *         +1 if (word_id,ctx_id) > (word_id,ctx_id)
+                 * @return -1 if (ctx_id,word_id) < (ctx_id,word_id)
+                 *          0 if (ctx_id,word_id) == (ctx_id,word_id)
+                 *         +1 if (ctx_id,word_id) > (ctx_id,word_id)
                  */
                 inline int8_t compare(const TCtxIdProbData & one, const TCtxIdProbData & two) {
-                    if (one.word_id < two.word_id) {
+                    if (one.ctx_id < two.ctx_id) {
                         return -1;
                     } else {
-                        if (one.word_id == two.word_id) {
-                            if (one.ctx_id < two.ctx_id) {
+                        if (one.ctx_id == two.ctx_id) {
+                            if (one.word_id < two.word_id) {
                                 return -1;
                             } else {
-                                if (one.ctx_id == two.ctx_id) {
+                                if (one.word_id == two.word_id) {
                                     return 0;
                                 } else {
                                     return +1;
@@ -111,8 +137,8 @@ namespace uva {
                 };
 
                 //An alternative check: Is a tiny biut slower
-                //const TLongId key1 = TShortId_TShortId_2_TLongId(one.word_id, one.ctx_id);
-                //const TLongId key2 = TShortId_TShortId_2_TLongId(two.word_id, two.ctx_id);
+                //const TLongId key1 = TShortId_TShortId_2_TLongId(one.ctx_id, one.word_id);
+                //const TLongId key2 = TShortId_TShortId_2_TLongId(two.ctx_id, two.word_id);
                 //return (key1 < key2);
 
                 inline bool operator<(const TCtxIdProbData & one, const TCtxIdProbData & two) {
@@ -126,6 +152,469 @@ namespace uva {
                 inline bool operator==(const TCtxIdProbData & one, const TCtxIdProbData & two) {
                     return (compare(one, two) == 0);
                 };
+
+                /**
+                 * This structure is needed to store begin and end index to reference pieces of an array
+                 * It is used to reference sub-array ranges for the M-gram data for levels 1 < M < N.
+                 * 
+                 * WARNING: It is not possible to get rid of this structure as the contexts are not ordered.
+                 * It is only true that the contexts will be filled one after another, but the context id 
+                 * will not be increased all the time.
+                 * 
+                 * @param beginIdx the begin index
+                 * @param endIdx the end index
+                 */
+                typedef struct {
+                    TShortId begin_idx;
+                    TShortId end_idx;
+                } TSubArrReference;
+
+                /**
+                 * This class stores an M-gram level, 1 < M < N, as a sorted array. The M-grams
+                 * are stored per context and are sorted by their last word ids, the context
+                 * references give the context sub-arrays and the M-gram array indexes are the
+                 * context ids of the next level. It is used by the tries storing such levels.
+                 * 
+                 * If the M-grams are added sorted by their word ids, see allocate, then the
+                 * array is filled in its final layout and the post-sorting is skipped. The
+                 * order is verified while adding, if the level is found unsorted then it
+                 * falls back to being sorted in the post actions.
+                 * 
+                 * If the level data exceeds the build memory limit, see allocate, then the
+                 * M-grams are sorted on the disk by their context and word ids and are merged
+                 * into the array in the post actions. The array is only allocated then, once
+                 * the sorting buffer is freed, so the level takes at most the limit on top of
+                 * its final size while building.
+                 * 
+                 * @param TRIE_BASE the trie base class, defines the reserved array indexes
+                 */
+                template<typename TRIE_BASE>
+                class C2WArrayMGramLevel {
+                public:
+
+                    /**
+                     * The basic constructor, the level is to be allocated before use
+                     */
+                    C2WArrayMGramLevel() : m_level(0), m_ctx_2_data(NULL), m_num_ctx(0), m_data(NULL),
+                    m_num_entries(0), m_next_idx(TRIE_BASE::FIRST_VALID_CTX_ID), m_sorter_ptr(NULL), m_is_sorted(false) {
+                    }
+
+                    /**
+                     * Allocates the level
+                     * @param level the M-gram level
+                     * @param num_ctx the number of contexts, i.e. the number of entries of the previous level
+                     * @param num_m_grams the number of M-grams
+                     * @param is_presorted true if the M-grams are to be added sorted by their word ids
+                     * @param mem_limit the build memory limit in bytes or zero if there is none
+                     */
+                    inline void allocate(const TModelLevel level, const size_t num_ctx,
+                            const size_t num_m_grams, const bool is_presorted, const size_t mem_limit) {
+                        m_level = level;
+                        m_is_sorted = is_presorted;
+
+                        //Allocate the context to data mappings, one per previous level entry
+                        m_num_ctx = num_ctx;
+                        m_ctx_2_data = new TSubArrReference[m_num_ctx];
+                        memset(m_ctx_2_data, 0, m_num_ctx * sizeof (TSubArrReference));
+
+                        //Due to the reserved first index, make the array one element larger, to avoid extra computations
+                        m_num_entries = num_m_grams + TRIE_BASE::FIRST_VALID_CTX_ID;
+
+                        //If the data does not fit into the build memory limit then the M-grams are sorted on the disk
+                        //and merged into the array after reading them. The pre-sorted M-grams need no sorting so they
+                        //always go straight into the array.
+                        const size_t arr_bytes = m_num_entries * sizeof (TWordIdPBData);
+                        if ((mem_limit > 0) && (arr_bytes > mem_limit) && !is_presorted) {
+                            LOG_USAGE << "The " << std::to_string(m_level) << "-grams need " << (arr_bytes / MB_SIZE_BYTES)
+                                    << " Mb, exceeding the build memory limit of " << (mem_limit / MB_SIZE_BYTES)
+                                    << " Mb, will sort them on the disk" << END_LOG;
+                            m_sorter_ptr = new ExternalMergeSorter<TCtxWordIdPBData>(mem_limit / sizeof (TCtxWordIdPBData));
+                        } else {
+                            m_data = new TWordIdPBData[m_num_entries];
+                            memset(m_data, 0, m_num_entries * sizeof (TWordIdPBData));
+                        }
+                    }
+
+                    /**
+                     * Allows to get the number of the array entries, including the reserved
+                     * ones, i.e. the number of contexts of the next level
+                     * @return the number of the array entries
+                     */
+                    inline size_t get_num_entries() const {
+                        return m_num_entries;
+                    }
+
+                    /**
+                     * Adds the M-gram to the level
+                     * @param ctx_id the M-gram context id
+                     * @param word_id the M-gram last word id
+                     * @param payload the M-gram payload
+                     */
+                    inline void add_m_gram(const TLongId ctx_id, const TShortId word_id, const T_M_Gram_Payload & payload) {
+                        //Pass the m-gram to the external sorter, the sub-array references are set when merging
+                        if (m_sorter_ptr != NULL) {
+                            const TCtxWordIdPBData entry = {static_cast<TShortId> (ctx_id), word_id, payload};
+                            m_sorter_ptr->add(entry);
+                            return;
+                        }
+
+                        //First get the sub-array reference. 
+                        TSubArrReference & ref = m_ctx_2_data[ctx_id];
+
+                        //Get the new index and increment - this will be the new end index
+                        ref.end_idx = m_next_idx++;
+
+                        //Check if there are yet no elements for this context
+                        if (ref.begin_idx == TRIE_BASE::UNDEFINED_ARR_IDX) {
+                            //There was no elements put into this context, the begin index is then equal to the end index
+                            ref.begin_idx = ref.end_idx;
+                        }
+
+                        //Store the word id and the payload
+                        m_data[ref.end_idx].id = word_id;
+                        m_data[ref.end_idx].payload = payload;
+
+                        //Verify the pre-sorted order against the previous M-gram of the same context
+                        if (m_is_sorted && (ref.begin_idx != ref.end_idx) && !(m_data[ref.end_idx - 1].id < word_id)) {
+                            LOG_WARNING << "The " << std::to_string(m_level) << "-grams are not sorted by word ids, "
+                                    << "will sort them after reading!" << END_LOG;
+                            m_is_sorted = false;
+                        }
+                    }
+
+                    /**
+                     * Computes the M-Gram context using the previous context and the current word id
+                     * @param word_id the M-gram last word id
+                     * @param ctx_id [in/out] the M-gram context id, the next context id if found
+                     * @return true if the M-gram is found, otherwise false
+                     */
+                    inline bool get_ctx_id(const TShortId word_id, TLongId & ctx_id) const {
+                        //First get the sub-array reference. Note that, even if it is the 2-Gram
+                        //case and the previous word is unknown (ctx_id == 0) we still can use
+                        //the ctx_id to get the data entry. The reason is that we allocated memory
+                        //for it but being for an unknown word context it should have no data!
+                        const TSubArrReference & ref = m_ctx_2_data[ctx_id];
+
+                        LOG_DEBUG2 << "Got context mapping for ctx_id: " << SSTR(ctx_id)
+                                << ", with beginIdx: " << SSTR(ref.begin_idx) << ", endIdx: "
+                                << SSTR(ref.end_idx) << END_LOG;
+
+                        //Check that there is data for the given context available
+                        if (ref.begin_idx != TRIE_BASE::UNDEFINED_ARR_IDX) {
+                            //The data is available search for the word index in the array
+                            //WARNING: The linear search here is much slower!!!
+                            return my_bsearch_id<TWordIdPBData>(m_data, ref.begin_idx, ref.end_idx, word_id, ctx_id);
+                        }
+                        return false;
+                    }
+
+                    /**
+                     * Allows to get the M-gram payload
+                     * @param ctx_id the M-gram id, as given by get_ctx_id
+                     * @return the M-gram payload
+                     */
+                    inline const T_M_Gram_Payload & get_payload(const TLongId ctx_id) const {
+                        return m_data[ctx_id].payload;
+                    }
+
+                    /**
+                     * Sorts the M-grams per context by their word ids, unless they are pre-sorted,
+                     * or merges the M-grams sorted on the disk
+                     */
+                    inline void post_m_grams() {
+                        //The m-grams sorted on the disk are to be merged into their array
+                        if (m_sorter_ptr != NULL) {
+                            merge_m_grams();
+                            return;
+                        }
+
+                        //The pre-sorted m-grams are already in their final layout
+                        if (m_is_sorted) {
+                            LOG_DEBUG << "The " << std::to_string(m_level) << "-grams are pre-sorted, no sorting is needed!" << END_LOG;
+                            return;
+                        }
+
+                        //Sort the entries per context with respect to the word index
+                        //the order could be arbitrary if a non-basic word index is used!
+                        LOG_DEBUG2 << "Number of previous contexts: " << m_num_ctx << END_LOG;
+                        for (size_t ctx_id = 0; ctx_id < m_num_ctx; ++ctx_id) {
+                            const TSubArrReference & info = m_ctx_2_data[ctx_id];
+                            if (info.begin_idx != TRIE_BASE::UNDEFINED_ARR_IDX) {
+                                LOG_DEBUG3 << "Sorting for context id: " << ctx_id << ", info.beginIdx: "
+                                        << info.begin_idx << ", info.endIdx: " << info.end_idx << END_LOG;
+                                my_sort<TWordIdPBData>(&m_data[info.begin_idx], (info.end_idx - info.begin_idx) + 1);
+                            }
+                        }
+                    }
+
+                    /**
+                     * Allows to add the level memory usage into the memory breakdown
+                     * @param trie_name the name of the trie storing the level
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(const char * trie_name, MemoryBreakdown & breakdown) const {
+                        breakdown.add(trie_name, "contexts", m_level, m_num_ctx * sizeof (TSubArrReference));
+                        breakdown.add(trie_name, "entries", m_level, m_num_entries * sizeof (TWordIdPBData));
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~C2WArrayMGramLevel() {
+                        delete[] m_ctx_2_data;
+                        delete[] m_data;
+                        delete m_sorter_ptr;
+                    }
+
+                private:
+                    //Stores the M-gram level
+                    TModelLevel m_level;
+                    //Stores the context to data mappings
+                    TSubArrReference * m_ctx_2_data;
+                    //Stores the number of contexts
+                    size_t m_num_ctx;
+                    //Stores the M-gram data
+                    TWordIdPBData * m_data;
+                    //Stores the number of the M-gram entries, including the reserved ones
+                    size_t m_num_entries;
+                    //Stores the next M-gram index, it is the next level context id
+                    TShortId m_next_idx;
+                    //Stores the M-gram external sorter, if the M-gram data exceeds the build memory limit
+                    ExternalMergeSorter<TCtxWordIdPBData> * m_sorter_ptr;
+                    //Stores the flag indicating that the level is filled in sorted
+                    bool m_is_sorted;
+
+                    //The level owns its arrays, so copying it would free them twice
+                    C2WArrayMGramLevel(const C2WArrayMGramLevel &) = delete;
+                    C2WArrayMGramLevel & operator=(const C2WArrayMGramLevel &) = delete;
+
+                    /**
+                     * Allocates the M-gram array and merges the externally sorted M-grams into it.
+                     * The M-grams come ordered by their context ids, so every context gets one
+                     * sub-array, and within a context by their word ids.
+                     */
+                    inline void merge_m_grams() {
+                        const size_t num_m_grams = m_sorter_ptr->size();
+                        ASSERT_CONDITION_THROW((num_m_grams >= m_num_entries), string("The number of ") + std::to_string(m_level)
+                                + string("-grams: ") + std::to_string(num_m_grams) + string(" exceeds the declared one: ")
+                                + std::to_string(m_num_entries - TRIE_BASE::FIRST_VALID_CTX_ID));
+
+                        LOG_USAGE << "Merging " << m_sorter_ptr->get_num_runs() << " sorted runs of "
+                                << num_m_grams << " " << std::to_string(m_level) << "-grams from the disk" << END_LOG;
+
+                        //The unused entries are zero and go last, as they would when adding in memory
+                        m_data = new TWordIdPBData[m_num_entries];
+                        memset(m_data, 0, m_num_entries * sizeof (TWordIdPBData));
+
+                        auto add_entry = [&](const TCtxWordIdPBData & entry) {
+                            TSubArrReference & ref = m_ctx_2_data[entry.ctx_id];
+                            ref.end_idx = m_next_idx++;
+                            if (ref.begin_idx == TRIE_BASE::UNDEFINED_ARR_IDX) {
+                                ref.begin_idx = ref.end_idx;
+                            }
+                            m_data[ref.end_idx].id = entry.word_id;
+                            m_data[ref.end_idx].payload = entry.payload;
+                        };
+                        m_sorter_ptr->sort_into(add_entry);
+
+                        delete m_sorter_ptr;
+                        m_sorter_ptr = NULL;
+                    }
+                };
+
+                /**
+                 * This class stores the N-gram level as an array sorted by the context
+                 * and word ids. It is used by the tries storing such levels.
+                 * 
+                 * If the N-grams are added sorted, see allocate, then the array is filled in
+                 * its final layout and the post-sorting is skipped. The order is verified
+                 * while adding, if the level is found unsorted then it falls back to being
+                 * sorted in the post actions.
+                 * 
+                 * If the level data exceeds the build memory limit, see allocate, then the
+                 * N-grams are sorted on the disk and merged into the array in the post actions.
+                 * The array is only allocated then, once the sorting buffer is freed, so the
+                 * level takes at most the limit on top of its final size while building.
+                 * 
+                 * @param TRIE_BASE the trie base class, defines the reserved array indexes
+                 */
+                template<typename TRIE_BASE>
+                class C2WArrayNGramLevel {
+                public:
+
+                    /**
+                     * The basic constructor, the level is to be allocated before use
+                     */
+                    C2WArrayNGramLevel() : m_level(0), m_data(NULL), m_num_entries(0), m_next_idx(TRIE_BASE::FIRST_VALID_CTX_ID),
+                    m_sorter_ptr(NULL), m_is_sorted(false) {
+                    }
+
+                    /**
+                     * Allocates the level
+                     * @param level the N-gram level
+                     * @param num_n_grams the number of N-grams
+                     * @param is_presorted true if the N-grams are to be added sorted by their context and word ids
+                     * @param mem_limit the build memory limit in bytes or zero if there is none
+                     */
+                    inline void allocate(const TModelLevel level, const size_t num_n_grams,
+                            const bool is_presorted, const size_t mem_limit) {
+                        m_level = level;
+                        m_is_sorted = is_presorted;
+
+                        //Due to the reserved first index, make the array one element larger, to avoid extra computations
+                        m_num_entries = num_n_grams + TRIE_BASE::FIRST_VALID_CTX_ID;
+
+                        //If the data does not fit into the build memory limit then the N-grams are sorted on the disk
+                        //and merged into the array after reading them. The pre-sorted N-grams need no sorting so they
+                        //always go straight into the array.
+                        const size_t arr_bytes = m_num_entries * sizeof (TCtxIdProbData);
+                        if ((mem_limit > 0) && (arr_bytes > mem_limit) && !is_presorted) {
+                            LOG_USAGE << "The " << std::to_string(m_level) << "-grams need " << (arr_bytes / MB_SIZE_BYTES)
+                                    << " Mb, exceeding the build memory limit of " << (mem_limit / MB_SIZE_BYTES)
+                                    << " Mb, will sort them on the disk" << END_LOG;
+                            m_sorter_ptr = new ExternalMergeSorter<TCtxIdProbData>(mem_limit / sizeof (TCtxIdProbData));
+                        } else {
+                            m_data = new TCtxIdProbData[m_num_entries];
+                            memset(m_data, 0, m_num_entries * sizeof (TCtxIdProbData));
+                        }
+                    }
+
+                    /**
+                     * Adds the N-gram to the level
+                     * @param ctx_id the N-gram context id
+                     * @param word_id the N-gram last word id
+                     * @param prob the N-gram probability
+                     */
+                    inline void add_n_gram(const TLongId ctx_id, const TShortId word_id, const TLogProbBackOff prob) {
+                        //Get the new n-gram index
+                        const TShortId n_gram_idx = m_next_idx++;
+
+                        if (m_sorter_ptr != NULL) {
+                            //Pass the n-gram to the external sorter
+                            const TCtxIdProbData entry = {word_id, static_cast<TShortId> (ctx_id), prob};
+                            m_sorter_ptr->add(entry);
+                        } else {
+                            //Store the context and word ids and the payload
+                            m_data[n_gram_idx].ctx_id = ctx_id;
+                            m_data[n_gram_idx].word_id = word_id;
+                            m_data[n_gram_idx].prob = prob;
+
+                            //Verify the pre-sorted order against the previous N-gram
+                            if (m_is_sorted && (n_gram_idx > TRIE_BASE::FIRST_VALID_CTX_ID)
+                                    && !(m_data[n_gram_idx - 1] < m_data[n_gram_idx])) {
+                                LOG_WARNING << "The " << std::to_string(m_level) << "-grams are not sorted by word ids, "
+                                        << "will sort them after reading!" << END_LOG;
+                                m_is_sorted = false;
+                            }
+                        }
+                    }
+
+                    /**
+                     * Allows to get the N-gram payload
+                     * @param ctx_id the N-gram context id
+                     * @param word_id the N-gram last word id
+                     * @return the pointer to the N-gram payload or NULL if the N-gram is not found
+                     */
+                    inline const TLogProbBackOff * get_payload(const TLongId ctx_id, const TShortId word_id) const {
+                        //Search for the index using binary search
+                        TShortId idx = TRIE_BASE::UNDEFINED_ARR_IDX;
+                        if (my_bsearch_ctxId_wordId<TCtxIdProbData>(m_data, TRIE_BASE::FIRST_VALID_CTX_ID,
+                                m_num_entries - 1, ctx_id, word_id, idx)) {
+                            return &m_data[idx].prob;
+                        }
+                        return NULL;
+                    }
+
+                    /**
+                     * Sorts the N-grams, unless they are pre-sorted, or merges the N-grams sorted on the disk
+                     */
+                    inline void post_n_grams() {
+                        //The n-grams sorted on the disk are to be merged into their array
+                        if (m_sorter_ptr != NULL) {
+                            merge_n_grams();
+                            return;
+                        }
+
+                        //The pre-sorted n-grams are already in their final layout
+                        if (m_is_sorted) {
+                            LOG_DEBUG << "The " << std::to_string(m_level) << "-grams are pre-sorted, no sorting is needed!" << END_LOG;
+                            return;
+                        }
+
+                        LOG_DEBUG2 << "Sorting the N-gram's data: ptr: " << m_data << ", size: " << m_num_entries << END_LOG;
+
+                        //Order the N-gram array as it is unordered and we will binary search it later!
+                        //Note: We dot not use Q-sort as it needs quite a lot of extra memory!
+                        //Also, I did not yet see any performance advantages compared to sort!
+                        //Actually the qsort provided here was 50% slower on a 20 Gb language
+                        //model when compared to the str::sort!
+                        my_sort<TCtxIdProbData>(m_data, m_num_entries);
+                    }
+
+                    /**
+                     * Allows to add the level memory usage into the memory breakdown
+                     * @param trie_name the name of the trie storing the level
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(const char * trie_name, MemoryBreakdown & breakdown) const {
+                        if (m_data != NULL) {
+                            breakdown.add(trie_name, "entries", m_level, m_num_entries * sizeof (TCtxIdProbData));
+                        }
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~C2WArrayNGramLevel() {
+                        delete[] m_data;
+                        delete m_sorter_ptr;
+                    }
+
+                private:
+                    //Stores the N-gram level
+                    TModelLevel m_level;
+                    //Stores the N-gram data
+                    TCtxIdProbData * m_data;
+                    //Stores the number of the N-gram entries, including the reserved ones
+                    size_t m_num_entries;
+                    //Stores the next N-gram index
+                    TShortId m_next_idx;
+                    //Stores the N-gram external sorter, if the N-gram data exceeds the build memory limit
+                    ExternalMergeSorter<TCtxIdProbData> * m_sorter_ptr;
+                    //Stores the flag indicating that the level is filled in sorted
+                    bool m_is_sorted;
+
+                    //The level owns its array, so copying it would free it twice
+                    C2WArrayNGramLevel(const C2WArrayNGramLevel &) = delete;
+                    C2WArrayNGramLevel & operator=(const C2WArrayNGramLevel &) = delete;
+
+                    /**
+                     * Allocates the N-gram array and merges the externally sorted N-grams into it
+                     */
+                    inline void merge_n_grams() {
+                        const size_t num_n_grams = m_sorter_ptr->size();
+                        ASSERT_CONDITION_THROW((num_n_grams >= m_num_entries), string("The number of ") + std::to_string(m_level)
+                                + string("-grams: ") + std::to_string(num_n_grams) + string(" exceeds the declared one: ")
+                                + std::to_string(m_num_entries - TRIE_BASE::FIRST_VALID_CTX_ID));
+
+                        LOG_USAGE << "Merging " << m_sorter_ptr->get_num_runs() << " sorted runs of "
+                                << num_n_grams << " " << std::to_string(m_level) << "-grams from the disk" << END_LOG;
+
+                        //The unused entries are zero and go first, as they would when sorting in memory
+                        m_data = new TCtxIdProbData[m_num_entries];
+                        const size_t first_idx = m_num_entries - num_n_grams;
+                        memset(m_data, 0, first_idx * sizeof (TCtxIdProbData));
+
+                        size_t n_gram_idx = first_idx;
+                        auto add_entry = [&](const TCtxIdProbData & entry) {
+                            m_data[n_gram_idx++] = entry;
+                        };
+                        m_sorter_ptr->sort_into(add_entry);
+
+                        delete m_sorter_ptr;
+                        m_sorter_ptr = NULL;
+                    }
+                };
             }
 
             /**
@@ -136,6 +625,10 @@ namespace uva {
              * 1-Grams. The order is assumed to be lexicographical as in the ARPA
              * files! This is also checked if the sanity checks are on see Globals.hpp!
              * 
+             * The M-gram levels (1 < M < N) are stored in C2WArrayMGramLevel and the
+             * N-gram level is stored in C2WArrayNGramLevel, see there for the pre-sorted
+             * build mode, set_presorted, and the build memory limit, set_build_mem_limit.
+             * 
              * @param N the maximum number of levels in the trie.
              */
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -164,24 +657,9 @@ namespace uva {
                             << "-gram with word_id: " << SSTR(word_id) << ", ctx_id: "
                             << SSTR(ctx_id) << END_LOG;
 
-                    //First get the sub-array reference. Note that, even if it is the 2-Gram
-                    //case and the previous word is unknown (ctx_id == 0) we still can use
-                    //the ctx_id to get the data entry. The reason is that we allocated memory
-                    //for it but being for an unknown word context it should have no data!
-                    TSubArrReference & ref = m_m_gram_ctx_2_data[level_idx][ctx_id];
-
-                    LOG_DEBUG2 << "Got context mapping for ctx_id: " << SSTR(ctx_id)
-                            << ", with beginIdx: " << SSTR(ref.begin_idx) << ", endIdx: "
-                            << SSTR(ref.end_idx) << END_LOG;
-
-                    //Check that there is data for the given context available
-                    if (ref.begin_idx != BASE::UNDEFINED_ARR_IDX) {
-                        //The data is available search for the word index in the array
-                        //WARNING: The linear search here is much slower!!!
-                        if (my_bsearch_id<TWordIdPBEntry>(m_m_gram_data[level_idx], ref.begin_idx, ref.end_idx, word_id, ctx_id)) {
-                            LOG_DEBUG2 << "The next ctx_id for word_id: " << SSTR(word_id) << ", is: " << SSTR(ctx_id) << END_LOG;
-                            return true;
-                        }
+                    if (m_m_gram_levels[level_idx].get_ctx_id(word_id, ctx_id)) {
+                        LOG_DEBUG2 << "The next ctx_id for word_id: " << SSTR(word_id) << ", is: " << SSTR(ctx_id) << END_LOG;
+                        return true;
                     }
                     return false;
                 }
@@ -193,6 +671,21 @@ namespace uva {
                     LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    if (m_1_gram_data != NULL) {
+                        breakdown.add("C2WArrayTrie", "payloads", M_GRAM_LEVEL_1, m_one_gram_arr_size * sizeof (T_M_Gram_Payload));
+                        for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                            m_m_gram_levels[idx].memory_breakdown("C2WArrayTrie", breakdown);
+                        }
+                        m_n_gram_level.memory_breakdown("C2WArrayTrie", breakdown);
+                    }
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -226,10 +719,10 @@ namespace uva {
 
                     //Do the post actions here
                     if (CURR_LEVEL == MAX_LEVEL) {
-                        post_n_grams();
+                        m_n_gram_level.post_n_grams();
                     } else {
                         if (CURR_LEVEL > M_GRAM_LEVEL_1) {
-                            post_m_grams<CURR_LEVEL>();
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].post_m_grams();
                         }
                     }
                 };
@@ -241,7 +734,7 @@ namespace uva {
                  * For more details @see LayeredTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     const TShortId word_id = gram.get_end_word_id();
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Store the payload
@@ -256,36 +749,9 @@ namespace uva {
                         __LayeredTrieBase::get_context_id<C2WArrayTrie<MAX_LEVEL, WordIndexType>, CURR_LEVEL, DebugLevelsEnum::DEBUG2>(*this, gram, ctx_id);
 
                         if (CURR_LEVEL == MAX_LEVEL) {
-                            //Get the new n-gram index
-                            const TShortId n_gram_idx = m_m_n_gram_next_ctx_id[BASE::N_GRAM_IDX_IN_M_N_ARR]++;
-
-                            //Store the context and word ids
-                            m_n_gram_data[n_gram_idx].ctx_id = ctx_id;
-                            m_n_gram_data[n_gram_idx].word_id = word_id;
-
-                            //Store the payload
-                            m_n_gram_data[n_gram_idx].prob = gram.m_payload.m_prob;
+                            m_n_gram_level.add_n_gram(ctx_id, word_id, gram.m_payload.m_prob);
                         } else {
-                            //Compute the m-gram index
-                            const TModelLevel m_gram_idx = CURR_LEVEL - BASE::MGRAM_IDX_OFFSET;
-
-                            //First get the sub-array reference. 
-                            TSubArrReference & ref = m_m_gram_ctx_2_data[m_gram_idx][ctx_id];
-
-                            //Get the new index and increment - this will be the new end index
-                            ref.end_idx = m_m_n_gram_next_ctx_id[m_gram_idx]++;
-
-                            //Check if there are yet no elements for this context
-                            if (ref.begin_idx == BASE::UNDEFINED_ARR_IDX) {
-                                //There was no elements put into this context, the begin index is then equal to the end index
-                                ref.begin_idx = ref.end_idx;
-                            }
-
-                            //Store the word id
-                            m_m_gram_data[m_gram_idx][ref.end_idx].id = word_id;
-
-                            //Store the payload
-                            m_m_gram_data[m_gram_idx][ref.end_idx].payload = gram.m_payload;
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].add_m_gram(ctx_id, word_id, gram.m_payload);
                         }
                     }
                 }
@@ -333,8 +799,8 @@ namespace uva {
                         if (get_ctx_id(level_idx, word_id, ctx_id)) {
                             LOG_DEBUG << "level_idx: " << SSTR(level_idx) << ", ctx_id: " << ctx_id << END_LOG;
                             //There is data found under this context
-                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_m_gram_data[level_idx][ctx_id].payload;
-                            LOG_DEBUG << "The payload is retrieved: " << (string) m_m_gram_data[level_idx][ctx_id].payload << END_LOG;
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_m_gram_levels[level_idx].get_payload(ctx_id);
+                            LOG_DEBUG << "The payload is retrieved: " << (string) m_m_gram_levels[level_idx].get_payload(ctx_id) << END_LOG;
                         } else {
                             //The payload could not be found
                             LOG_DEBUG1 << "Unable to find m-gram data for ctx_id: " << SSTR(ctx_id)
@@ -362,22 +828,16 @@ namespace uva {
                         LOG_DEBUG2 << "Getting " << SSTR(MAX_LEVEL) << "-gram with word_id: "
                                 << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
 
-                        //Create the search key by combining ctx and word ids, see TCtxIdProbEntryPair
-                        const TLongId key = TShortId_TShortId_2_TLongId(word_id, ctx_id);
-                        LOG_DEBUG4 << "Searching N-Gram: TShortId_TShortId_2_TLongId(word_id = " << SSTR(word_id)
-                                << ", ctx_id = " << SSTR(ctx_id) << ") = " << SSTR(key) << END_LOG;
-
-                        //Search for the index using binary search
-                        TShortId idx = BASE::UNDEFINED_ARR_IDX;
-                        if (my_bsearch_wordId_ctxId<TCtxIdProbEntry>(m_n_gram_data, BASE::FIRST_VALID_CTX_ID,
-                                m_m_n_gram_num_ctx_ids[BASE::N_GRAM_IDX_IN_M_N_ARR] - 1, word_id, ctx_id, idx)) {
+                        //Search for the payload by the context and word ids
+                        const TLogProbBackOff * payload = m_n_gram_level.get_payload(ctx_id, word_id);
+                        if (payload != NULL) {
                             //Return the data
-                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_n_gram_data[idx].prob;
-                            LOG_DEBUG << "The payload is retrieved: " << m_n_gram_data[idx].prob << END_LOG;
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = payload;
+                            LOG_DEBUG << "The payload is retrieved: " << *payload << END_LOG;
                         } else {
                             //The payload could not be found
                             LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: " << SSTR(ctx_id)
-                                    << ", word_id: " << SSTR(word_id) << ", key " << SSTR(key) << END_LOG;
+                                    << ", word_id: " << SSTR(word_id) << END_LOG;
                             status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
                         }
                     }
@@ -388,92 +848,21 @@ namespace uva {
                  */
                 virtual ~C2WArrayTrie();
 
-            protected:
-
-                /**
-                 * This structure is needed to store begin and end index to reference pieces of an array
-                 * It is used to reference sub-array ranges for the M-gram data for levels 1 < M < N.
-                 * 
-                 * WARNING: It is not possible to get rid of this structure as the contexts are not ordered.
-                 * It is only true that the contexts will be filled one after another, but the context id 
-                 * will not be increased all the time.
-                 * 
-                 * @param beginIdx the begin index
-                 * @param endIdx the end index
-                 */
-                typedef struct {
-                    TShortId begin_idx;
-                    TShortId end_idx;
-                } TSubArrReference;
-
-                typedef __C2WArrayTrie::TWordIdPBData TWordIdPBEntry;
-                typedef __C2WArrayTrie::TCtxIdProbData TCtxIdProbEntry;
-
-                template<TModelLevel CURR_LEVEL>
-                inline void post_m_grams() {
-                    //Compute the m-gram index
-                    constexpr TModelLevel mgram_idx = (CURR_LEVEL - BASE::MGRAM_IDX_OFFSET);
-
-                    LOG_DEBUG2 << "Running post actions on " << CURR_LEVEL << "-grams, m-gram array index: " << mgram_idx << END_LOG;
-
-                    //Sort the entries per context with respect to the word index
-                    //the order could be arbitrary if a non-basic word index is used!
-                    const size_t num_prev_ctx = (CURR_LEVEL == M_GRAM_LEVEL_2) ? m_one_gram_arr_size : m_m_n_gram_num_ctx_ids[mgram_idx - 1];
-                    LOG_DEBUG2 << "Number of previous contexts: " << num_prev_ctx << END_LOG;
-                    for (size_t ctx_id = 0; ctx_id < num_prev_ctx; ++ctx_id) {
-                        const TSubArrReference & info = m_m_gram_ctx_2_data[mgram_idx][ctx_id];
-                        if (info.begin_idx != BASE::UNDEFINED_ARR_IDX) {
-                            LOG_DEBUG3 << "Sorting for context id: " << ctx_id << ", info.beginIdx: "
-                                    << info.begin_idx << ", info.endIdx: " << info.end_idx << END_LOG;
-                            my_sort<TWordIdPBEntry>(&m_m_gram_data[mgram_idx][info.begin_idx], (info.end_idx - info.begin_idx) + 1);
-                        }
-                    }
-                }
-
-                inline void post_n_grams() {
-                    LOG_DEBUG2 << "Sorting the N-gram's data: ptr: " << m_n_gram_data
-                            << ", size: " << m_m_n_gram_num_ctx_ids[BASE::N_GRAM_IDX_IN_M_N_ARR] << END_LOG;
-
-                    //Order the N-gram array as it is unordered and we will binary search it later!
-                    //Note: We dot not use Q-sort as it needs quite a lot of extra memory!
-                    //Also, I did not yet see any performance advantages compared to sort!
-                    //Actually the qsort provided here was 50% slower on a 20 Gb language
-                    //model when compared to the str::sort!
-                    my_sort<TCtxIdProbEntry>(m_n_gram_data, m_m_n_gram_num_ctx_ids[BASE::N_GRAM_IDX_IN_M_N_ARR]);
-                };
-
             private:
 
                 //Stores the 1-gram data
                 T_M_Gram_Payload * m_1_gram_data;
-
-                //Stores the M-gram context to data mappings for: 1 < M < N
-                //This is a two dimensional array
-                TSubArrReference * m_m_gram_ctx_2_data[BASE::NUM_M_GRAM_LEVELS];
-                //Stores the M-gram data for the M levels: 1 < M < N
-                //This is a two dimensional array
-                TWordIdPBEntry * m_m_gram_data[BASE::NUM_M_GRAM_LEVELS];
-
-                //Stores the N-gram data
-                TCtxIdProbEntry * m_n_gram_data;
-
                 //Stores the size of the One-gram
                 TShortId m_one_gram_arr_size;
-                //Stores the maximum number of context id  per M-gram level: 1 < M <= N
-                TShortId m_m_n_gram_num_ctx_ids[BASE::NUM_M_N_GRAM_LEVELS];
-                //Stores the context id counters per M-gram level: 1 < M <= N
-                TShortId m_m_n_gram_next_ctx_id[BASE::NUM_M_N_GRAM_LEVELS];
-            };
 
-            typedef C2WArrayTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TC2WArrayTrieBasic;
-            typedef C2WArrayTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TC2WArrayTrieCount;
-            typedef C2WArrayTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TC2WArrayTrieOptBasic;
-            typedef C2WArrayTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TC2WArrayTrieOptCount;
-            typedef C2WArrayTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TC2WArrayTrieHashing;
+                //Stores the M-gram levels: 1 < M < N
+                __C2WArrayTrie::C2WArrayMGramLevel<BASE> m_m_gram_levels[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the N-gram level
+                __C2WArrayTrie::C2WArrayNGramLevel<BASE> m_n_gram_level;
+            };
         }
     }
 }
 
 
 #endif	/* CONTEXTTOWORDHYBRIDMEMORYTRIE_HPP */
-
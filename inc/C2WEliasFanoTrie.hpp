@@ -0,0 +1,457 @@
+/*
+ * File:   C2WEliasFanoTrie.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 4:40 PM
+ */
+
+#ifndef C2WELIASFANOTRIE_HPP
+#define	C2WELIASFANOTRIE_HPP
+
+#include <string>       // std::string
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+
+#include "LayeredTrieBase.hpp"
+
+#include "AWordIndex.hpp"
+#include "ArrayUtils.hpp"
+#include "EliasFanoSequence.hpp"
+
+using namespace std;
+using namespace uva::smt::tries::dictionary;
+using namespace uva::smt::utils::array;
+using namespace uva::utils::containers;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+            namespace __C2WEliasFanoTrie {
+
+                /**
+                 * Stores the m-gram data while the level is being read,
+                 * the context id, the word id and the payload.
+                 * @param m_ctx_id the context id
+                 * @param m_word_id the word id
+                 * @param m_payload the payload
+                 */
+                template<typename TPayloadType>
+                struct S_Ctx_Word_Entry {
+                    TShortId m_ctx_id;
+                    TShortId m_word_id;
+                    TPayloadType m_payload;
+
+                    /**
+                     * The less operator, the context id goes first
+                     * @param other the entry to compare with
+                     * @return true if (ctx_id, word_id) < (other.ctx_id, other.word_id)
+                     */
+                    inline bool operator<(const S_Ctx_Word_Entry<TPayloadType> & other) const {
+                        return (m_ctx_id < other.m_ctx_id) ||
+                                ((m_ctx_id == other.m_ctx_id) && (m_word_id < other.m_word_id));
+                    }
+                };
+            }
+
+            /**
+             * This is the Context to word Elias-Fano trie implementation class.
+             * The m-grams of each level, 1 < M <= N, are stored ordered by their
+             * context and word ids as in C2WArrayTrie. The m-gram context id is
+             * its index in the level. Unlike in C2WArrayTrie the keys are stored
+             * in two Elias-Fano sequences per level:
+             *
+             * 1. The context begin indexes: the i'th value is the index of the
+             *    first m-gram with the context id i, so the m-grams of the context
+             *    i are within [ctx_begin[i], ctx_begin[i + 1]);
+             * 2. The word ids, made non-decreasing by adding to each the last value
+             *    of the previous context range.
+             *
+             * Finding an m-gram is then a random access to the context range and a
+             * successor query for the word id within it. The payloads are stored in
+             * plain arrays in the same order.
+             *
+             * The m-grams of a level are collected while reading and are sorted and
+             * encoded in the post actions of the level, i.e. before the next level
+             * is read. Therefore the m-grams do not have to come in any order.
+             *
+             * @param N the maximum number of levels in the trie.
+             */
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            class C2WEliasFanoTrie : public LayeredTrieBase<C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __C2WEliasFanoTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> {
+            public:
+                typedef LayeredTrieBase<C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __C2WEliasFanoTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> BASE;
+
+                /**
+                 * The basic constructor
+                 * @param p_word_index the word index (dictionary) container
+                 */
+                explicit C2WEliasFanoTrie(WordIndexType & p_word_index);
+
+                /**
+                 * Computes the M-Gram context using the previous context and the current word id
+                 * @see LayeredTrieBese
+                 */
+                inline bool get_ctx_id(const TModelLevel level_idx, const TShortId word_id, TLongId & ctx_id) const {
+                    //Perform sanity checks if needed
+                    ASSERT_SANITY_THROW(((level_idx + BASE::MGRAM_IDX_OFFSET == MAX_LEVEL) || (level_idx >= MAX_LEVEL)),
+                            string("Unsupported level id: ") + std::to_string(level_idx + BASE::MGRAM_IDX_OFFSET));
+
+                    LOG_DEBUG2 << "Searching for the next ctx_id of " << SSTR(level_idx + BASE::MGRAM_IDX_OFFSET)
+                            << "-gram with word_id: " << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
+
+                    uint64_t idx;
+                    if (find_m_gram(level_idx, ctx_id, word_id, idx)) {
+                        ctx_id = idx + BASE::FIRST_VALID_CTX_ID;
+                        LOG_DEBUG2 << "The next ctx_id for word_id: " << SSTR(word_id) << ", is: " << SSTR(ctx_id) << END_LOG;
+                        return true;
+                    }
+                    return false;
+                }
+
+                /**
+                 * Allows to log the information about the instantiated trie type
+                 */
+                inline void log_trie_type_usage_info() const {
+                    LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
+                }
+
+                /**
+                 * @see WordIndexTrieBase
+                 * The levels that are not yet encoded are accounted for by their entry arrays
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    breakdown.add("C2WEliasFanoTrie", "payloads", M_GRAM_LEVEL_1, m_one_gram_arr_size * sizeof (T_M_Gram_Payload));
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_N_GRAM_LEVELS; ++idx) {
+                        const TModelLevel level = idx + BASE::MGRAM_IDX_OFFSET;
+                        const bool is_n_gram = (idx == BASE::N_GRAM_IDX_IN_M_N_ARR);
+                        if (m_ctx_begin_idx[idx] != NULL) {
+                            m_ctx_begin_idx[idx]->memory_breakdown(breakdown, "contexts", level);
+                            m_word_ids[idx]->memory_breakdown(breakdown, "word ids", level);
+                            if (is_n_gram) {
+                                breakdown.add("C2WEliasFanoTrie", "payloads", level, m_num_m_n_grams[idx] * sizeof (TLogProbBackOff));
+                            } else {
+                                breakdown.add("C2WEliasFanoTrie", "payloads", level,
+                                        (m_num_m_n_grams[idx] + BASE::FIRST_VALID_CTX_ID) * sizeof (T_M_Gram_Payload));
+                            }
+                        } else {
+                            breakdown.add("C2WEliasFanoTrie", "entries", level, m_max_m_n_grams[idx]
+                                    * (is_n_gram ? sizeof (TCtxWordProbEntry) : sizeof (TCtxWordPBEntry)));
+                        }
+                    }
+                }
+
+                /**
+                 * This method can be used to provide the N-gram count information
+                 * That should allow for pre-allocation of the memory
+                 * For more details @see LayeredTrieBase
+                 */
+                virtual void pre_allocate(const size_t counts[MAX_LEVEL]);
+
+                /**
+                 * This method allows to check if post processing should be called after
+                 * all the X level grams are read. This method is virtual.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel level>
+                bool is_post_grams() const {
+                    //The m-grams of the levels 1 < M <= N are to be encoded
+                    return (level > M_GRAM_LEVEL_1) || BASE::template is_post_grams<level>();
+                };
+
+                /**
+                 * This method should be called after all the X level grams are read.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void post_grams() {
+                    //Call the base class method first
+                    if (BASE::template is_post_grams<CURR_LEVEL>()) {
+                        BASE::template post_grams<CURR_LEVEL>();
+                    }
+
+                    //Encode the level
+                    if (CURR_LEVEL == MAX_LEVEL) {
+                        m_n_gram_probs = encode_level(BASE::N_GRAM_IDX_IN_M_N_ARR, m_n_gram_entries, 0);
+                        m_n_gram_entries = NULL;
+                    } else {
+                        if (CURR_LEVEL > M_GRAM_LEVEL_1) {
+                            constexpr TModelLevel LEVEL_IDX = CURR_LEVEL - BASE::MGRAM_IDX_OFFSET;
+                            m_m_gram_payloads[LEVEL_IDX] = encode_level(LEVEL_IDX, m_m_gram_entries[LEVEL_IDX], BASE::FIRST_VALID_CTX_ID);
+                            m_m_gram_entries[LEVEL_IDX] = NULL;
+                        }
+                    }
+                };
+
+                /**
+                 * Allows to retrieve the data storage structure for the M gram
+                 * with the given M-gram level Id. M-gram context and last word Id.
+                 * If the storage structure does not exist, return a new one.
+                 * For more details @see LayeredTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
+                    const TShortId word_id = gram.get_end_word_id();
+                    if (CURR_LEVEL == M_GRAM_LEVEL_1) {
+                        //Store the payload
+                        m_1_gram_data[word_id] = gram.m_payload;
+                    } else {
+                        //Register the m-gram in the hash cache
+                        this->register_m_gram_cache(gram);
+
+                        //Define the context id variable
+                        TLongId ctx_id = WordIndexType::UNKNOWN_WORD_ID;
+                        //Obtain the m-gram context id
+                        __LayeredTrieBase::get_context_id<C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>, CURR_LEVEL, DebugLevelsEnum::DEBUG2>(*this, gram, ctx_id);
+
+                        //Get the new entry index
+                        constexpr TModelLevel LEVEL_IDX = CURR_LEVEL - BASE::MGRAM_IDX_OFFSET;
+                        const uint64_t idx = m_num_m_n_grams[LEVEL_IDX]++;
+                        ASSERT_CONDITION_THROW((idx >= m_max_m_n_grams[LEVEL_IDX]), string("The number of ") + std::to_string(CURR_LEVEL)
+                                + string("-grams exceeds the declared one: ") + std::to_string(m_max_m_n_grams[LEVEL_IDX]));
+
+                        //Store the entry, it is to be encoded in the post actions
+                        if (CURR_LEVEL == MAX_LEVEL) {
+                            m_n_gram_entries[idx].m_ctx_id = ctx_id;
+                            m_n_gram_entries[idx].m_word_id = word_id;
+                            m_n_gram_entries[idx].m_payload = gram.m_payload.m_prob;
+                        } else {
+                            m_m_gram_entries[LEVEL_IDX][idx].m_ctx_id = ctx_id;
+                            m_m_gram_entries[LEVEL_IDX][idx].m_word_id = word_id;
+                            m_m_gram_entries[LEVEL_IDX][idx].m_payload = gram.m_payload;
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==1.
+                 * The retrieval of a uni-gram data is always a success
+                 * @see GenericTrieBase
+                 */
+                inline void get_unigram_payload(typename BASE::T_Query_Exec_Data & query) const {
+                    //Get the word index for convenience
+                    const TModelLevel & word_idx = query.m_begin_word_idx;
+
+                    LOG_DEBUG << "Getting the payload for sub-uni-gram : [" << SSTR(word_idx)
+                            << "," << SSTR(word_idx) << "]" << END_LOG;
+
+                    //The data is always present.
+                    query.m_payloads[word_idx][word_idx] = &m_1_gram_data[query.m_gram[word_idx]];
+                };
+
+                /**
+                 * Allows to retrieve the payload for the M-gram defined by the end word_id and ctx_id.
+                 * For more details @see LayeredTrieBase
+                 */
+                inline void get_m_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    LOG_DEBUG << "Getting the payload for sub-m-gram : [" << SSTR(query.m_begin_word_idx)
+                            << ", " << SSTR(query.m_end_word_idx) << "]" << END_LOG;
+
+                    //First ensure the context of the given sub-m-gram
+                    LAYERED_BASE_ENSURE_CONTEXT(query, status);
+
+                    //If the context is successfully ensured, then move on to the m-gram and try to obtain its payload
+                    if (status == MGramStatusEnum::GOOD_PRESENT_MGS) {
+                        //Store the shorthand for the context and end word id
+                        TLongId & ctx_id = query.m_last_ctx_ids[query.m_begin_word_idx];
+                        const TShortId & word_id = query.m_gram[query.m_end_word_idx];
+
+                        //Get the next context id
+                        const TModelLevel & level_idx = CURR_LEVEL_MIN_2_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+                        if (get_ctx_id(level_idx, word_id, ctx_id)) {
+                            //There is data found under this context
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_m_gram_payloads[level_idx][ctx_id];
+                            LOG_DEBUG << "The payload is retrieved: " << (string) m_m_gram_payloads[level_idx][ctx_id] << END_LOG;
+                        } else {
+                            //The payload could not be found
+                            LOG_DEBUG1 << "Unable to find m-gram data for ctx_id: " << SSTR(ctx_id)
+                                    << ", word_id: " << SSTR(word_id) << END_LOG;
+                            status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==n
+                 * @see GenericTrieBase
+                 */
+                inline void get_n_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    //First ensure the context of the given sub-m-gram
+                    LAYERED_BASE_ENSURE_CONTEXT(query, status);
+
+                    //If the context is successfully ensured, then move on to the m-gram and try to obtain its payload
+                    if (status == MGramStatusEnum::GOOD_PRESENT_MGS) {
+                        //Store the shorthand for the context and end word id
+                        const TLongId & ctx_id = query.m_last_ctx_ids[query.m_begin_word_idx];
+                        const TShortId & word_id = query.m_gram[query.m_end_word_idx];
+
+                        LOG_DEBUG2 << "Getting " << SSTR(MAX_LEVEL) << "-gram with word_id: "
+                                << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
+
+                        uint64_t idx;
+                        if (find_m_gram(BASE::N_GRAM_IDX_IN_M_N_ARR, ctx_id, word_id, idx)) {
+                            //Return the data
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_n_gram_probs[idx];
+                            LOG_DEBUG << "The payload is retrieved: " << m_n_gram_probs[idx] << END_LOG;
+                        } else {
+                            //The payload could not be found
+                            LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: " << SSTR(ctx_id)
+                                    << ", word_id: " << SSTR(word_id) << END_LOG;
+                            status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                        }
+                    }
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                virtual ~C2WEliasFanoTrie();
+
+            private:
+                typedef __C2WEliasFanoTrie::S_Ctx_Word_Entry<T_M_Gram_Payload> TCtxWordPBEntry;
+                typedef __C2WEliasFanoTrie::S_Ctx_Word_Entry<TLogProbBackOff> TCtxWordProbEntry;
+
+                //Stores the 1-gram data
+                T_M_Gram_Payload * m_1_gram_data;
+                //Stores the size of the One-gram
+                TShortId m_one_gram_arr_size;
+
+                //Stores the number of contexts per M-gram level: 1 < M <= N
+                uint64_t m_num_ctx_ids[BASE::NUM_M_N_GRAM_LEVELS];
+                //Stores the context begin indexes per M-gram level: 1 < M <= N
+                EliasFanoSequence * m_ctx_begin_idx[BASE::NUM_M_N_GRAM_LEVELS];
+                //Stores the prefix summed word ids per M-gram level: 1 < M <= N
+                EliasFanoSequence * m_word_ids[BASE::NUM_M_N_GRAM_LEVELS];
+
+                //Stores the M-gram payloads, indexed by the context ids, for the M levels: 1 < M < N
+                T_M_Gram_Payload * m_m_gram_payloads[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the N-gram payloads
+                TLogProbBackOff * m_n_gram_probs;
+
+                //Stores the declared number of m-grams per M-gram level: 1 < M <= N
+                uint64_t m_max_m_n_grams[BASE::NUM_M_N_GRAM_LEVELS];
+                //Stores the read number of m-grams per M-gram level: 1 < M <= N
+                uint64_t m_num_m_n_grams[BASE::NUM_M_N_GRAM_LEVELS];
+                //Stores the M-grams being read for the M levels: 1 < M < N
+                TCtxWordPBEntry * m_m_gram_entries[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the N-grams being read
+                TCtxWordProbEntry * m_n_gram_entries;
+
+                /**
+                 * Allows to find the m-gram given by the context and word ids
+                 * @param level_idx the level index, M - 2
+                 * @param ctx_id the context id
+                 * @param word_id the word id
+                 * @param idx [out] the index of the m-gram in the level, if found
+                 * @return true if the m-gram is found, otherwise false
+                 */
+                inline bool find_m_gram(const TModelLevel level_idx, const TLongId ctx_id, const TShortId word_id, uint64_t & idx) const {
+                    //Get the context range, the non existing contexts are empty
+                    if (ctx_id >= m_num_ctx_ids[level_idx]) {
+                        return false;
+                    }
+                    uint64_t begin_idx, end_idx;
+                    m_ctx_begin_idx[level_idx]->get_pair(ctx_id, begin_idx, end_idx);
+                    if (begin_idx == end_idx) {
+                        return false;
+                    }
+
+                    //Compute the searched value, the word ids are prefix summed
+                    const uint64_t base = (begin_idx == 0) ? 0 : m_word_ids[level_idx]->get(begin_idx - 1);
+                    const uint64_t value = base + word_id;
+
+                    //The successor can not be before the range as the word ids are positive
+                    uint64_t succ = 0;
+                    m_word_ids[level_idx]->successor(value, idx, succ);
+                    return (idx < end_idx) && (succ == value);
+                }
+
+                /**
+                 * Sorts the m-grams read for the level and encodes them, deletes the read m-grams
+                 * @param level_idx the level index, M - 2
+                 * @param entries the m-grams read for the level
+                 * @param payload_offset the index of the first payload in the resulting payloads array
+                 * @return the payloads array in the order of the encoded m-grams
+                 */
+                template<typename TPayloadType>
+                TPayloadType * encode_level(const TModelLevel level_idx,
+                        __C2WEliasFanoTrie::S_Ctx_Word_Entry<TPayloadType> * entries, const uint64_t payload_offset) {
+                    typedef __C2WEliasFanoTrie::S_Ctx_Word_Entry<TPayloadType> TEntry;
+                    const uint64_t num_entries = m_num_m_n_grams[level_idx];
+                    const uint64_t num_ctx = m_num_ctx_ids[level_idx];
+
+                    //Sort the entries by the context and word ids, unless they are already sorted
+                    bool is_sorted = true;
+                    for (uint64_t idx = 1; is_sorted && (idx < num_entries); ++idx) {
+                        is_sorted = entries[idx - 1] < entries[idx];
+                    }
+                    if (!is_sorted) {
+                        my_sort<TEntry>(entries, num_entries);
+                    }
+
+                    //Compute the maximum prefix summed word id
+                    uint64_t max_value = 0;
+                    for (uint64_t idx = 0, base = 0; idx < num_entries; ++idx) {
+                        if ((idx > 0) && (entries[idx].m_ctx_id != entries[idx - 1].m_ctx_id)) {
+                            base = max_value;
+                        }
+                        ASSERT_SANITY_THROW((entries[idx].m_word_id == 0), "The m-gram word id may not be zero!");
+                        max_value = base + entries[idx].m_word_id;
+                    }
+
+                    //Encode the context begin indexes and the word ids, copy the payloads
+                    m_ctx_begin_idx[level_idx] = new EliasFanoSequence(num_ctx + 1, num_entries);
+                    m_word_ids[level_idx] = new EliasFanoSequence(num_entries, max_value);
+                    TPayloadType * payloads = new TPayloadType[num_entries + payload_offset];
+                    memset(payloads, 0, payload_offset * sizeof (TPayloadType));
+                    uint64_t idx = 0, base = 0, value = 0;
+                    for (uint64_t ctx_id = 0; ctx_id <= num_ctx; ++ctx_id) {
+                        m_ctx_begin_idx[level_idx]->push_back(idx);
+                        base = value;
+                        while ((idx < num_entries) && (entries[idx].m_ctx_id == ctx_id)) {
+                            value = base + entries[idx].m_word_id;
+                            m_word_ids[level_idx]->push_back(value);
+                            payloads[idx + payload_offset] = entries[idx].m_payload;
+                            ++idx;
+                        }
+                    }
+                    m_ctx_begin_idx[level_idx]->finish();
+                    m_word_ids[level_idx]->finish();
+                    delete[] entries;
+
+                    ASSERT_CONDITION_THROW((idx != num_entries), string("Unexpected context ids in the ")
+                            + std::to_string(level_idx + BASE::MGRAM_IDX_OFFSET) + string("-grams!"));
+
+                    LOG_INFO << "The " << SSTR(level_idx + BASE::MGRAM_IDX_OFFSET) << "-grams keys: "
+                            << SSTR((m_ctx_begin_idx[level_idx]->get_size_bytes() + m_word_ids[level_idx]->get_size_bytes())
+                            * 8.0 / max(num_entries, (uint64_t) 1)) << " bits per m-gram" << END_LOG;
+
+                    return payloads;
+                }
+            };
+        }
+    }
+}
+
+
+#endif	/* C2WELIASFANOTRIE_HPP */
@@ -0,0 +1,435 @@
+/*
+ * File:   CompressedFileReader.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:37 PM
+ */
+
+#ifndef COMPRESSEDFILEREADER_HPP
+#define	COMPRESSEDFILEREADER_HPP
+
+#include <fcntl.h>      // std::open
+#include <unistd.h>     // std::read std::pread std::lseek std::close
+#include <errno.h>      // errno
+#include <cstring>      // std::memset std::memcmp std::strerror
+#include <cstdlib>      // std::malloc std::free
+#include <zlib.h>       // z_stream inflate
+#include <lzma.h>       // lzma_stream lzma_code
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "StringUtils.hpp"
+#include "TextPieceReader.hpp"
+#include "AsyncFileReader.hpp"
+
+using namespace std;
+using namespace uva::smt::utils::text;
+using namespace uva::smt::file::__AsyncFileReader;
+using namespace uva::smt::file::__CompressedFileReader;
+
+namespace uva {
+    namespace smt {
+        namespace file {
+
+            /**
+             * This is the file reader for the compressed text files. It is
+             * the AsyncFileReader which blocks are filled in with the data
+             * decompressed by the background reader thread. So the file is
+             * decompressed while the previous block is being parsed and no
+             * temporary uncompressed file is needed.
+             *
+             * The compression format is detected from the file's magic bytes:
+             *      gzip - including the multi-member files, e.g. by pigz/bgzip
+             *      zip  - the first deflated entry of the archive
+             *      xz   - including the concatenated streams
+             * A file that is not compressed is read as is.
+             */
+            class CompressedFileReader : public AsyncFileReader {
+            public:
+
+                /**
+                 * The supported compression formats
+                 */
+                enum CompressionFormatEnum {
+                    PLAIN_FORMAT = 0,
+                    GZIP_FORMAT = PLAIN_FORMAT + 1,
+                    ZIP_FORMAT = GZIP_FORMAT + 1,
+                    XZ_FORMAT = ZIP_FORMAT + 1,
+                    ZSTD_FORMAT = XZ_FORMAT + 1
+                };
+
+                /**
+                 * The basic constructor
+                 * @param fileName the file name
+                 */
+                CompressedFileReader(const char * fileName)
+                : AsyncFileReader(fileName, false, false), m_format(PLAIN_FORMAT), m_data_offset(0),
+                m_in_ptr(NULL), m_is_decoder(false), m_is_in_eof(false), m_is_stream_end(false) {
+                    memset(&m_z_strm, 0, sizeof (m_z_strm));
+                    memset(&m_lzma_strm, 0, sizeof (m_lzma_strm));
+
+                    if (m_file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                        //Detect the compression format from the file header
+                        m_format = get_format(m_file_desc, m_data_offset);
+                        if (m_format == ZSTD_FORMAT) {
+                            THROW_EXCEPTION(string("The zstd compressed files are not supported: ") + string(fileName));
+                        }
+
+                        //Allocate the input buffer and start the decoder
+                        m_in_ptr = static_cast<uint8_t *> (malloc(IN_BUFFER_BYTES));
+                        rewind();
+
+                        //Start decompressing the file blocks
+                        start_reader();
+                    }
+                }
+
+                /**
+                 * Allows to log the information about the instantiated file reader type
+                 */
+                virtual void log_reader_type_usage_info() {
+                    LOG_USAGE << "Using the <" << __FILE__ << "> file reader for the '"
+                            << get_format_name(m_format) << "' file format!" << END_LOG;
+                }
+
+                virtual ~CompressedFileReader() {
+                    //Stop the reader thread before the decoder is destroyed
+                    close();
+                    if (m_in_ptr != NULL) {
+                        free(m_in_ptr);
+                        m_in_ptr = NULL;
+                    }
+                }
+
+                /**
+                 * This method should be used to close the file
+                 */
+                virtual void close() {
+                    AsyncFileReader::close();
+                    end_decoder();
+                };
+
+                /**
+                 * Allows to check if the given file is compressed in one of the known formats
+                 * @param fileName the file name
+                 * @return true if the file is compressed, otherwise false
+                 */
+                static inline bool is_compressed(const char * fileName) {
+                    CompressionFormatEnum format = PLAIN_FORMAT;
+                    const int file_desc = open(fileName, O_RDONLY);
+                    if (file_desc != UNDEFINED_FILE_DESCRIPTOR) {
+                        off_t data_offset = 0;
+                        format = get_format(file_desc, data_offset);
+                        ::close(file_desc);
+                    }
+                    return (format != PLAIN_FORMAT);
+                }
+
+            protected:
+
+                /**
+                 * Rewinds the file to the beginning of the compressed data and re-starts the decoder
+                 */
+                virtual void rewind() {
+                    lseek(m_file_desc, m_data_offset, SEEK_SET);
+                    end_decoder();
+                    start_decoder();
+                    m_is_in_eof = false;
+                    m_is_stream_end = false;
+                }
+
+                /**
+                 * Decompresses as much data as fits into the block or until the end of file.
+                 * @param data_ptr the block data pointer, has BLOCK_SIZE_BYTES of space
+                 * @param len [out] the number of bytes put into the block
+                 * @return true if the end of file is reached or an error occurred
+                 */
+                virtual bool fill_block(char * data_ptr, size_t & len) {
+                    switch (m_format) {
+                        case GZIP_FORMAT:
+                        case ZIP_FORMAT:
+                            return inflate_block(data_ptr, len);
+                        case XZ_FORMAT:
+                            return unxz_block(data_ptr, len);
+                        default:
+                            return AsyncFileReader::fill_block(data_ptr, len);
+                    }
+                }
+
+            private:
+                //The zip local file header signature and size
+                static constexpr uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+                static constexpr size_t ZIP_LOCAL_HEADER_BYTES = 30;
+                //The zip deflate compression method
+                static constexpr uint16_t ZIP_DEFLATE_METHOD = 8;
+                //The zlib window bits for the gzip/zlib header auto detection and for the raw deflate data
+                static constexpr int ZLIB_AUTO_HEADER_WINDOW_BITS = 15 + 32;
+                static constexpr int ZLIB_RAW_DEFLATE_WINDOW_BITS = -15;
+
+                //Stores the compression format
+                CompressionFormatEnum m_format;
+                //Stores the offset of the compressed data within the file
+                off_t m_data_offset;
+                //Stores the buffer for the compressed data
+                uint8_t * m_in_ptr;
+                //Stores true if the decoder has been initialized
+                bool m_is_decoder;
+                //Stores true if the end of the compressed file has been reached
+                bool m_is_in_eof;
+                //Stores true if the last decompressed gzip member has been completed
+                bool m_is_stream_end;
+                //The zlib stream for gzip and zip
+                z_stream m_z_strm;
+                //The liblzma stream for xz
+                lzma_stream m_lzma_strm;
+
+                /**
+                 * Allows to get the compression format name
+                 * @param format the compression format
+                 * @return the format name
+                 */
+                static inline const char * get_format_name(const CompressionFormatEnum format) {
+                    switch (format) {
+                        case GZIP_FORMAT:
+                            return "gzip";
+                        case ZIP_FORMAT:
+                            return "zip";
+                        case XZ_FORMAT:
+                            return "xz";
+                        case ZSTD_FORMAT:
+                            return "zstd";
+                        default:
+                            return "plain";
+                    }
+                }
+
+                /**
+                 * Reads a little-endian unsigned integer from the given bytes
+                 * @param data_ptr the bytes pointer
+                 * @param num_bytes the number of bytes to read
+                 * @return the read value
+                 */
+                static inline uint32_t get_le_uint(const uint8_t * data_ptr, const size_t num_bytes) {
+                    uint32_t value = 0;
+                    for (size_t idx = num_bytes; idx != 0; --idx) {
+                        value = (value << 8) | data_ptr[idx - 1];
+                    }
+                    return value;
+                }
+
+                /**
+                 * Detects the compression format by the magic bytes of the file
+                 * @param file_desc the file descriptor
+                 * @param data_offset [out] the offset of the compressed data within the file
+                 * @return the compression format
+                 */
+                static inline CompressionFormatEnum get_format(const int file_desc, off_t & data_offset) {
+                    static const uint8_t GZIP_MAGIC[] = {0x1f, 0x8b};
+                    static const uint8_t XZ_MAGIC[] = {0xfd, '7', 'z', 'X', 'Z', 0x00};
+                    static const uint8_t ZSTD_MAGIC[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+                    uint8_t header[ZIP_LOCAL_HEADER_BYTES];
+                    const ssize_t num_read = pread(file_desc, header, sizeof (header), 0);
+                    const size_t len = (num_read > 0) ? num_read : 0;
+
+                    data_offset = 0;
+                    if ((len >= sizeof (GZIP_MAGIC)) && (memcmp(header, GZIP_MAGIC, sizeof (GZIP_MAGIC)) == 0)) {
+                        return GZIP_FORMAT;
+                    }
+                    if ((len >= sizeof (XZ_MAGIC)) && (memcmp(header, XZ_MAGIC, sizeof (XZ_MAGIC)) == 0)) {
+                        return XZ_FORMAT;
+                    }
+                    if ((len >= sizeof (ZSTD_MAGIC)) && (memcmp(header, ZSTD_MAGIC, sizeof (ZSTD_MAGIC)) == 0)) {
+                        return ZSTD_FORMAT;
+                    }
+                    if ((len == ZIP_LOCAL_HEADER_BYTES) && (get_le_uint(header, 4) == ZIP_LOCAL_HEADER_SIGNATURE)) {
+                        //The general purpose flags, compression method, file name and extra field lengths
+                        const uint32_t flags = get_le_uint(header + 6, 2);
+                        const uint32_t method = get_le_uint(header + 8, 2);
+                        if ((flags & 0x1) || (method != ZIP_DEFLATE_METHOD)) {
+                            THROW_EXCEPTION("Only the not encrypted, deflated zip archive entries are supported!");
+                        }
+                        data_offset = ZIP_LOCAL_HEADER_BYTES + get_le_uint(header + 26, 2) + get_le_uint(header + 28, 2);
+                        return ZIP_FORMAT;
+                    }
+                    return PLAIN_FORMAT;
+                }
+
+                /**
+                 * Initializes the decoder for the detected compression format
+                 */
+                inline void start_decoder() {
+                    switch (m_format) {
+                        case GZIP_FORMAT:
+                        case ZIP_FORMAT:
+                            memset(&m_z_strm, 0, sizeof (m_z_strm));
+                            m_is_decoder = (inflateInit2(&m_z_strm, (m_format == ZIP_FORMAT) ?
+                                    ZLIB_RAW_DEFLATE_WINDOW_BITS : ZLIB_AUTO_HEADER_WINDOW_BITS) == Z_OK);
+                            break;
+                        case XZ_FORMAT:
+                            memset(&m_lzma_strm, 0, sizeof (m_lzma_strm));
+                            m_is_decoder = (lzma_stream_decoder(&m_lzma_strm, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK);
+                            break;
+                        default:
+                            return;
+                    }
+                    if (!m_is_decoder) {
+                        THROW_EXCEPTION(string("Could not initialize the ") + get_format_name(m_format) + string(" decoder!"));
+                    }
+                }
+
+                /**
+                 * Frees the decoder for the detected compression format, if any
+                 */
+                inline void end_decoder() {
+                    if (m_is_decoder) {
+                        if (m_format == XZ_FORMAT) {
+                            lzma_end(&m_lzma_strm);
+                        } else {
+                            inflateEnd(&m_z_strm);
+                        }
+                        m_is_decoder = false;
+                    }
+                }
+
+                /**
+                 * Marks the reading as failed due to the corrupted compressed data
+                 * @param msg the error message
+                 */
+                inline void set_decoder_error(const char * msg) {
+                    LOG_ERROR << "Could not decompress the " << get_format_name(m_format)
+                            << " data: " << ((msg != NULL) ? msg : "unknown error") << END_LOG;
+                    m_error_no = EIO;
+                    m_is_error = true;
+                }
+
+                /**
+                 * Reads the next piece of the compressed data into the input buffer
+                 * @return the number of read bytes, 0 for the end of file or an error
+                 */
+                inline size_t read_input() {
+                    while (true) {
+                        const ssize_t num_read = read(m_file_desc, m_in_ptr, IN_BUFFER_BYTES);
+                        if (num_read >= 0) {
+                            m_is_in_eof = (num_read == 0);
+                            return num_read;
+                        }
+                        if (errno != EINTR) {
+                            m_error_no = errno;
+                            m_is_error = true;
+                            return 0;
+                        }
+                    }
+                }
+
+                /**
+                 * Inflates the gzip or zip data into the given block
+                 * @param data_ptr the block data pointer, has BLOCK_SIZE_BYTES of space
+                 * @param len [out] the number of bytes put into the block
+                 * @return true if the end of file is reached or an error occurred
+                 */
+                inline bool inflate_block(char * data_ptr, size_t & len) {
+                    bool is_last = false;
+                    m_z_strm.next_out = reinterpret_cast<Bytef *> (data_ptr);
+                    m_z_strm.avail_out = BLOCK_SIZE_BYTES;
+
+                    while ((m_z_strm.avail_out > 0) && !is_last) {
+                        if (m_z_strm.avail_in == 0) {
+                            m_z_strm.next_in = m_in_ptr;
+                            m_z_strm.avail_in = read_input();
+                            if (m_z_strm.avail_in == 0) {
+                                if (!m_is_error && !m_is_stream_end) {
+                                    set_decoder_error("unexpected end of the compressed data");
+                                }
+                                is_last = true;
+                                break;
+                            }
+                        }
+
+                        const int result = inflate(&m_z_strm, Z_NO_FLUSH);
+                        if (result == Z_STREAM_END) {
+                            m_is_stream_end = true;
+                            if (m_format == ZIP_FORMAT) {
+                                //We only read the first entry of the archive
+                                is_last = true;
+                            } else {
+                                //There can be another gzip member following
+                                inflateReset(&m_z_strm);
+                            }
+                        } else {
+                            if (result == Z_OK) {
+                                m_is_stream_end = false;
+                            } else {
+                                if (result != Z_BUF_ERROR) {
+                                    set_decoder_error(m_z_strm.msg);
+                                    is_last = true;
+                                }
+                            }
+                        }
+                    }
+
+                    len = BLOCK_SIZE_BYTES - m_z_strm.avail_out;
+                    return is_last;
+                }
+
+                /**
+                 * Decompresses the xz data into the given block
+                 * @param data_ptr the block data pointer, has BLOCK_SIZE_BYTES of space
+                 * @param len [out] the number of bytes put into the block
+                 * @return true if the end of file is reached or an error occurred
+                 */
+                inline bool unxz_block(char * data_ptr, size_t & len) {
+                    bool is_last = false;
+                    m_lzma_strm.next_out = reinterpret_cast<uint8_t *> (data_ptr);
+                    m_lzma_strm.avail_out = BLOCK_SIZE_BYTES;
+
+                    while ((m_lzma_strm.avail_out > 0) && !is_last) {
+                        if ((m_lzma_strm.avail_in == 0) && !m_is_in_eof) {
+                            m_lzma_strm.next_in = m_in_ptr;
+                            m_lzma_strm.avail_in = read_input();
+                            if (m_is_error) {
+                                is_last = true;
+                                break;
+                            }
+                        }
+
+                        const lzma_ret result = lzma_code(&m_lzma_strm, m_is_in_eof ? LZMA_FINISH : LZMA_RUN);
+                        if (result == LZMA_STREAM_END) {
+                            is_last = true;
+                        } else {
+                            if (result != LZMA_OK) {
+                                set_decoder_error((result == LZMA_BUF_ERROR) ?
+                                        "unexpected end of the compressed data" : "corrupted data");
+                                is_last = true;
+                            }
+                        }
+                    }
+
+                    len = BLOCK_SIZE_BYTES - m_lzma_strm.avail_out;
+                    return is_last;
+                }
+            };
+        }
+    }
+}
+
+#endif	/* COMPRESSEDFILEREADER_HPP */
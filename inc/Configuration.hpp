@@ -54,11 +54,102 @@ namespace uva {
             constexpr bool DO_SANITY_CHECKS = false;
         }
 
+        namespace file {
+
+            //Stores the possible file reader types
+
+            enum FileReaderTypesEnum {
+                UNDEFINED_READER = 0,
+                MMAP_POPULATE_READER = UNDEFINED_READER + 1,
+                MMAP_SEQUENTIAL_READER = MMAP_POPULATE_READER + 1,
+                C_STYLE_READER = MMAP_SEQUENTIAL_READER + 1,
+                FILE_STREAM_READER = C_STYLE_READER + 1,
+                DIRECT_IO_READER = FILE_STREAM_READER + 1,
+                ASYNC_READER = DIRECT_IO_READER + 1,
+                COMPRESSED_READER = ASYNC_READER + 1,
+                size_reader = COMPRESSED_READER + 1
+            };
+
+            namespace __MemoryMappedFileReader {
+                //In the sequential mode, the read pages are dropped in chunks of this
+                //many bytes. Must be a power of two and a multiple of the page size
+                static constexpr size_t MMAP_DROP_CHUNK_BYTES = 64 * 1024 * 1024;
+            }
+
+            namespace __AsyncFileReader {
+                //The size of one file block read by the background reader thread, in bytes
+                static constexpr size_t BLOCK_SIZE_BYTES = 32 * 1024 * 1024;
+                //The number of blocks in the ring, one block is being parsed
+                //while the remaining ones are being read from the disk
+                static constexpr size_t NUM_BLOCKS = 2;
+                //The alignment of the block buffers, needed for the direct I/O
+                static constexpr size_t BLOCK_ALIGNMENT_BYTES = 4096;
+            }
+
+            namespace __CompressedFileReader {
+                //The size of the buffer for the compressed data read from the disk, in bytes
+                static constexpr size_t IN_BUFFER_BYTES = 4 * 1024 * 1024;
+            }
+
+            //The query result output formats
+            enum ResultFormatsEnum {
+                UNDEFINED_FORMAT = 0,
+                LOG_FORMAT = UNDEFINED_FORMAT + 1,
+                TSV_FORMAT = LOG_FORMAT + 1,
+                BINARY_FORMAT = TSV_FORMAT + 1,
+                NONE_FORMAT = BINARY_FORMAT + 1,
+                size_format = NONE_FORMAT + 1
+            };
+
+            namespace __ResultWriter {
+                //The size of the query result output buffer, in bytes
+                static constexpr size_t OUTPUT_BUFFER_BYTES = 4 * 1024 * 1024;
+            }
+        }
+
+        namespace utils {
+            namespace array {
+                namespace __ExternalMergeSorter {
+                    //The environment variable specifying the directory for the sorted run files
+                    static const char * const TEMP_DIR_ENV_VAR = "TMPDIR";
+                    //The directory for the temporary files, used if the environment variable is not set
+                    static const char * const DEFAULT_TEMP_DIR = "/tmp";
+                    //The temporary file name template for mkstemp
+                    static const char * const RUN_FILE_TEMPLATE = "blm_sort_run_XXXXXX";
+                    //The minimum number of bytes read from a sorted run at a time when merging, if
+                    //there are more runs than the memory limit allows for then they are merged in passes
+                    static constexpr size_t MIN_RUN_READ_BYTES = 64 * 1024;
+                }
+            }
+        }
+
         //The following type definitions are important for storing the Tries information
         namespace tries {
 
-            //The considered maximum length of the N-gram 
-            constexpr static uint8_t M_GRAM_LEVEL_MAX = 5u;
+            //The considered maximum length of the N-gram, the tries are instantiated for
+            //all the levels from 2 up to this one and the level is chosen from the model.
+            //The m-gram ids support the levels up to MAX_SUPP_GRAM_LEVEL, to use the longer
+            //models increase this value and extend INSTANTIATE_FOR_SUPPORTED_LEVELS below.
+            constexpr static uint8_t M_GRAM_LEVEL_MAX = 7u;
+
+            //Applies the given macro, with the given arguments, to every level from 2 up to
+            //M_GRAM_LEVEL_MAX, is used for the explicit template instantiations. Each level
+            //costs the compile time and the binary size of all the tries and trie builders.
+#define INSTANTIATE_FOR_SUPPORTED_LEVELS(MACRO, ...) \
+            MACRO(M_GRAM_LEVEL_2, __VA_ARGS__) \
+            MACRO(M_GRAM_LEVEL_3, __VA_ARGS__) \
+            MACRO(M_GRAM_LEVEL_4, __VA_ARGS__) \
+            MACRO(M_GRAM_LEVEL_5, __VA_ARGS__) \
+            MACRO(M_GRAM_LEVEL_6, __VA_ARGS__) \
+            MACRO(M_GRAM_LEVEL_7, __VA_ARGS__)
+
+            namespace arpa {
+                namespace __ARPATrieBuilder {
+                    //In the parallel build, the M-gram sections of the tries allowing for concurrent
+                    //insertions are split into chunks of at least this many bytes, one thread per chunk
+                    static constexpr size_t MIN_SECTION_CHUNK_BYTES = 16 * 1024 * 1024;
+                }
+            }
 
             namespace alloc {
 
@@ -72,6 +163,25 @@ namespace uva {
                     LOG_10 = LOG_2 + 1,
                     size = LOG_10 + 1
                 };
+
+                //Stores the possible integer key map types for the context-to-data tries
+
+                enum IntegerKeyMapTypesEnum {
+                    UNDEFINED_INTEGER_KEY_MAP = 0,
+                    UNORDERED_INTEGER_KEY_MAP = UNDEFINED_INTEGER_KEY_MAP + 1,
+                    FLAT_INTEGER_KEY_MAP = UNORDERED_INTEGER_KEY_MAP + 1,
+                    size_integer_key_map = FLAT_INTEGER_KEY_MAP + 1
+                };
+
+                namespace __GreedyMemoryStorage {
+                    //The minimum size of an additional memory chunk of the greedy storage
+                    static constexpr size_t MIN_CHUNK_BYTES = 1024 * 1024;
+                    //The alignment of the allocated blocks, also the step of the small size classes
+                    static constexpr size_t BLOCK_ALIGNMENT_BYTES = 8;
+                    //The maximum block size of the small size classes, must be a power of two,
+                    //the larger blocks are put into the power of two size classes
+                    static constexpr size_t MAX_SMALL_BLOCK_BYTES = 256;
+                }
             }
 
             namespace dictionary {
@@ -112,14 +222,27 @@ namespace uva {
                 C2WA_TRIE = W2CA_TRIE + 1,
                 W2CH_TRIE = C2WA_TRIE + 1,
                 H2DM_TRIE = W2CH_TRIE + 1,
-                size_trie = H2DM_TRIE + 1
+                A2DH_TRIE = H2DM_TRIE + 1,
+                F2DM_TRIE = A2DH_TRIE + 1,
+                C2WE_TRIE = F2DM_TRIE + 1,
+                size_trie = C2WE_TRIE + 1
             };
 
             namespace __C2DHybridTrie {
+                //The map type used for the M-Grams and N-Grams, the flat map has no heap
+                //node per entry and answers the queries faster than the unordered_map
+                static constexpr alloc::IntegerKeyMapTypesEnum INTEGER_KEY_MAP_TYPE = alloc::FLAT_INTEGER_KEY_MAP;
                 //The unordered map memory factor for the M-Grams in C2DMapArrayTrie
                 static constexpr float UM_M_GRAM_MEMORY_FACTOR = 2.1;
                 //The unordered map memory factor for the N-Grams in C2DMapArrayTrie
                 static constexpr float UM_N_GRAM_MEMORY_FACTOR = 2.0;
+                //The flat map buckets factor for the M-Grams in C2DMapArrayTrie
+                static constexpr float FM_M_GRAM_BUCKETS_FACTOR = 1.2;
+                //The flat map buckets factor for the N-Grams in C2DMapArrayTrie
+                static constexpr float FM_N_GRAM_BUCKETS_FACTOR = 1.2;
+                //The memory factors for the M-Grams and N-Grams of the chosen map type
+                static constexpr float M_GRAM_MEMORY_FACTOR = (INTEGER_KEY_MAP_TYPE == alloc::FLAT_INTEGER_KEY_MAP) ? FM_M_GRAM_BUCKETS_FACTOR : UM_M_GRAM_MEMORY_FACTOR;
+                static constexpr float N_GRAM_MEMORY_FACTOR = (INTEGER_KEY_MAP_TYPE == alloc::FLAT_INTEGER_KEY_MAP) ? FM_N_GRAM_BUCKETS_FACTOR : UM_N_GRAM_MEMORY_FACTOR;
                 //Stores the word index type to be used in this trie, the COUNTING
                 //index does not seem to give any performance improvements. The optimizing
                 //word index gives about 10% performance improvement!
@@ -129,10 +252,20 @@ namespace uva {
             }
 
             namespace __C2DMapTrie {
+                //The map type used for the M-Grams and N-Grams, the flat map has no heap
+                //node per entry and answers the queries faster than the unordered_map
+                static constexpr alloc::IntegerKeyMapTypesEnum INTEGER_KEY_MAP_TYPE = alloc::FLAT_INTEGER_KEY_MAP;
                 //The unordered map memory factor for the M-Grams in CtxMultiHashMapTrie
                 static constexpr float UM_M_GRAM_MEMORY_FACTOR = 2.0;
                 //The unordered map memory factor for the N-Grams in CtxMultiHashMapTrie
                 static constexpr float UM_N_GRAM_MEMORY_FACTOR = 2.5;
+                //The flat map buckets factor for the M-Grams in CtxMultiHashMapTrie
+                static constexpr float FM_M_GRAM_BUCKETS_FACTOR = 1.2;
+                //The flat map buckets factor for the N-Grams in CtxMultiHashMapTrie
+                static constexpr float FM_N_GRAM_BUCKETS_FACTOR = 1.2;
+                //The memory factors for the M-Grams and N-Grams of the chosen map type
+                static constexpr float M_GRAM_MEMORY_FACTOR = (INTEGER_KEY_MAP_TYPE == alloc::FLAT_INTEGER_KEY_MAP) ? FM_M_GRAM_BUCKETS_FACTOR : UM_M_GRAM_MEMORY_FACTOR;
+                static constexpr float N_GRAM_MEMORY_FACTOR = (INTEGER_KEY_MAP_TYPE == alloc::FLAT_INTEGER_KEY_MAP) ? FM_N_GRAM_BUCKETS_FACTOR : UM_N_GRAM_MEMORY_FACTOR;
                 //Stores the word index type to be used in this trie, the COUNTING
                 //index does not seem to give any performance improvements. The optimizing
                 //word index gives about 10% performance improvement!
@@ -167,7 +300,54 @@ namespace uva {
                 static constexpr uint8_t BITMAP_HASH_CACHE_BUCKETS_FACTOR = 0;
             }
 
+            namespace __F2DMapTrie {
+                //Stores the number of bits in the m-gram key fingerprint, the expected
+                //false positive rate of a lookup is proportional to 2^-FINGERPRINT_BITS
+                static constexpr uint8_t FINGERPRINT_BITS = 16;
+                //This is the factor that is used to define the number of buckets,
+                //the number of buckets will be the number of m-grams * this value
+                static constexpr double BUCKETS_FACTOR = 1.5;
+                //Stores the word index type to be used in this trie, the m-grams
+                //are identified by their hash values, as in H2DMapTrie
+                static constexpr WordIndexTypesEnum WORD_INDEX_TYPE = HASHING_WORD_INDEX;
+                //With the bitmap hash caching on we are not faster with this trie
+                static constexpr uint8_t BITMAP_HASH_CACHE_BUCKETS_FACTOR = 0;
+            }
+
+            namespace __A2DHybridTrie {
+                //The representation of each level is chosen by these targets, the level
+                //gets the one, array or hash map, that exceeds its worst target the least.
+                //Stores the target memory usage in bits per m-gram
+                static constexpr double TARGET_BITS_PER_M_GRAM = 256.0;
+                //Stores the target number of cache missing memory accesses per m-gram lookup
+                static constexpr double TARGET_MISSES_PER_LOOKUP = 4.0;
+                //The lookup cost is counted in cache missing memory accesses, derived from the level
+                //sizes, rather than in nano seconds, as the latter depend on the machine. A binary search
+                //step in an array level misses the cache until the searched range fits into one cache
+                //line. A hash map lookup reads the bucket, the element and the m-gram id, see G2DMapLevel.
+                //This agrees with the timings on an x86-64 box with 2^20 m-grams per level, there one
+                //binary search step took 25 ns and one hash map lookup 93 ns, i.e. about 3.7 steps.
+                //Stores the number of bytes in a cache line
+                static constexpr double CACHE_LINE_BYTES = 64.0;
+                //Stores the number of cache missing memory accesses of one lookup in a hash map level
+                static constexpr double MISSES_PER_HASH_LOOKUP = 3.0;
+                //This is the buckets factor for the hash map levels, see __G2DMapTrie
+                static constexpr double BUCKETS_FACTOR = 3.0;
+                //Stores the word index type to be used in this trie, COUNTING
+                //index is a must to save memory for gram ids! The optimizing
+                //word index gives about 10% performance improvement!
+                static constexpr WordIndexTypesEnum WORD_INDEX_TYPE = OPTIMIZING_COUNTING_WORD_INDEX;
+                //With the bitmap hashing we get some 5% performance improvement
+                static constexpr uint8_t BITMAP_HASH_CACHE_BUCKETS_FACTOR = 5;
+            }
+
             namespace __W2CArrayTrie {
+                //In case set to true every M-gram level is stored as one contiguous array in the
+                //compressed sparse row layout, sized exactly from the M-gram counts. It needs no
+                //reallocations while reading but keeps the end word id of every M-gram until the
+                //level is read. Otherwise, the default, every word gets its own dynamic array per
+                //level that grows with the memory increase strategy given below.
+                static constexpr bool USE_CSR_LAYOUT = false;
                 //In case set to true will pre-allocate memory per word for storing contexts
                 //This can speed up the filling in of the trie but at the same time it can
                 //have a drastic effect on RSS - the maximum RSS can grow significantly
@@ -201,6 +381,13 @@ namespace uva {
                 static constexpr uint8_t BITMAP_HASH_CACHE_BUCKETS_FACTOR = 5;
             }
 
+            namespace __C2WEliasFanoTrie {
+                //Stores the word index type to be used in this trie, see __C2WArrayTrie
+                static constexpr WordIndexTypesEnum WORD_INDEX_TYPE = OPTIMIZING_COUNTING_WORD_INDEX;
+                //With the bitmap hashing we get some 5% performance improvement
+                static constexpr uint8_t BITMAP_HASH_CACHE_BUCKETS_FACTOR = 5;
+            }
+
             namespace __W2CHybridTrie {
                 //The unordered map memory factor for the unordered maps in CtxToPBMapStorage
                 static constexpr float UM_CTX_TO_PB_MAP_STORE_MEMORY_FACTOR = 5.0;
@@ -149,12 +149,14 @@ namespace uva {
                             break;
                         case MemIncTypesEnum::LOG_2:
                             inc_func = [] (const size_t fcap) -> size_t {
-                                return fcap * (1 / log(fcap));
+                                //The log of one is zero, then the minimum increase will be used!
+                                return (fcap > 1) ? fcap * (1 / log(fcap)) : 0;
                             };
                             break;
                         case MemIncTypesEnum::LOG_10:
                             inc_func = [] (const size_t fcap) -> size_t {
-                                return fcap * (1 / log10(fcap));
+                                //The log of one is zero, then the minimum increase will be used!
+                                return (fcap > 1) ? fcap * (1 / log10(fcap)) : 0;
                             };
                             break;
                         default:
@@ -409,7 +411,13 @@ namespace uva {
                         //Reallocate memory, potentially we get a new pointer!
                         new_capacity = min(new_capacity, MAX_SIZE_TYPE_VALUE);
                         ASSERT_SANITY_THROW((m_capacity == new_capacity), "The new capacity is equal to the old one!");
-                        m_ptr = (ELEMENT_TYPE_PTR) realloc(m_ptr, new_capacity * sizeof (ELEMENT_TYPE));
+                        const ELEMENT_TYPE_PTR new_ptr = (ELEMENT_TYPE_PTR) realloc(m_ptr, new_capacity * sizeof (ELEMENT_TYPE));
+
+                        //Do the null pointer check before the new memory is used, the old memory is then kept
+                        ASSERT_CONDITION_THROW((new_ptr == NULL) && (new_capacity > 0),
+                                string("Ran out of memory when trying to allocate ") +
+                                std::to_string(new_capacity) + " data elements for a word_id");
+                        m_ptr = new_ptr;
 
                         LOG_DEBUG2 << "Memory is reallocated ptr: " << SSTR(m_ptr) << END_LOG;
 
@@ -427,11 +435,6 @@ namespace uva {
 
                         LOG_DEBUG2 << "The end capacity is " << SSTR(m_capacity)
                                 << ", ptr: " << SSTR(m_ptr) << END_LOG;
-
-                        //Do the null pointer check if sanity
-                        ASSERT_SANITY_THROW((m_ptr == NULL),
-                                string("Ran out of memory when trying to allocate ") +
-                                std::to_string(new_capacity) + " data elements for a word_id");
                     }
                 };
 
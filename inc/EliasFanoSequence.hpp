@@ -0,0 +1,389 @@
+/*
+ * File:   EliasFanoSequence.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 4:05 PM
+ */
+
+#ifndef ELIASFANOSEQUENCE_HPP
+#define	ELIASFANOSEQUENCE_HPP
+
+#include <string>       // std::string
+#include <cstring>      // std::memset
+#include <inttypes.h>   // std::uint64_t
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "MemoryBreakdown.hpp"
+
+using namespace std;
+using namespace uva::smt::tries;
+
+namespace uva {
+    namespace utils {
+        namespace containers {
+
+            /**
+             * This class stores a non-decreasing sequence of unsigned integers
+             * in the Elias-Fano encoding. Each value is split into L lower bits,
+             * stored in a packed array, and the upper bits, stored in unary as
+             * gaps in a bit vector: the i'th value sets the bit (value >> L) + i.
+             * With n values from [0, u) we choose L = floor(log2(u/n)) and so use
+             * at most 2 + log2(u/n) bits per value. The positions of every
+             * SAMPLE_RATE'th one and zero bit of the upper bits are sampled, this
+             * gives a nearly constant time select and thus random access and
+             * successor queries.
+             *
+             * The sequence is filled by calling push_back for each of the values,
+             * in the non-decreasing order, then the sampling is built by finish.
+             */
+            class EliasFanoSequence {
+            public:
+
+                /**
+                 * The basic constructor
+                 * @param num_values the number of values to be stored
+                 * @param max_value the maximum value to be stored, the last one
+                 */
+                EliasFanoSequence(const uint64_t num_values, const uint64_t max_value)
+                : m_num_values(num_values), m_num_low_bits(0), m_low_mask(0),
+                m_num_next(0), m_num_zeros(0), m_low_bits(NULL), m_high_bits(NULL),
+                m_one_samples(NULL), m_zero_samples(NULL) {
+                    //Choose the number of low bits as floor(log2(u/n))
+                    const uint64_t universe = max_value + 1;
+                    if (num_values > 0) {
+                        while ((universe >> (m_num_low_bits + 1)) >= num_values) {
+                            ++m_num_low_bits;
+                        }
+                    }
+                    m_low_mask = (m_num_low_bits == 0) ? 0 : (UINT64_MAX >> (NUM_WORD_BITS - m_num_low_bits));
+
+                    //The upper bits have one one per value and one zero per possible high part
+                    m_num_zeros = (max_value >> m_num_low_bits) + 1;
+                    m_num_high_bits = m_num_values + m_num_zeros;
+
+                    m_num_low_words = num_words(m_num_values * m_num_low_bits);
+                    m_low_bits = new uint64_t[m_num_low_words];
+                    memset(m_low_bits, 0, m_num_low_words * sizeof (uint64_t));
+
+                    m_num_high_words = num_words(m_num_high_bits);
+                    m_high_bits = new uint64_t[m_num_high_words];
+                    memset(m_high_bits, 0, m_num_high_words * sizeof (uint64_t));
+
+                    m_max_value = max_value;
+                    m_last_value = 0;
+                }
+
+                /**
+                 * Allows to add the next value of the sequence
+                 * @param value the value to add, must be not smaller than the previous one
+                 */
+                inline void push_back(const uint64_t value) {
+                    ASSERT_SANITY_THROW((m_num_next >= m_num_values), string("The number of values exceeds: ") + std::to_string(m_num_values));
+                    ASSERT_SANITY_THROW(((value < m_last_value) || (value > m_max_value)), string("The value: ") + std::to_string(value)
+                            + string(" is out of order, must be within [") + std::to_string(m_last_value) + string(", ")
+                            + std::to_string(m_max_value) + string("]"));
+
+                    set_low_bits(m_num_next, value & m_low_mask);
+                    const uint64_t pos = (value >> m_num_low_bits) + m_num_next;
+                    m_high_bits[pos / NUM_WORD_BITS] |= (1ULL << (pos % NUM_WORD_BITS));
+
+                    m_last_value = value;
+                    ++m_num_next;
+                }
+
+                /**
+                 * Is to be called once all the values are added, builds the select samples
+                 */
+                void finish() {
+                    ASSERT_CONDITION_THROW((m_num_next != m_num_values), string("Added ") + std::to_string(m_num_next)
+                            + string(" values, expected: ") + std::to_string(m_num_values));
+
+                    m_one_samples = new uint64_t[m_num_values / SAMPLE_RATE + 1];
+                    m_zero_samples = new uint64_t[m_num_zeros / SAMPLE_RATE + 1];
+
+                    uint64_t num_ones = 0, num_zeros = 0;
+                    for (uint64_t pos = 0; pos < m_num_high_bits; ++pos) {
+                        if (is_high_bit(pos)) {
+                            if ((num_ones % SAMPLE_RATE) == 0) {
+                                m_one_samples[num_ones / SAMPLE_RATE] = pos;
+                            }
+                            ++num_ones;
+                        } else {
+                            if ((num_zeros % SAMPLE_RATE) == 0) {
+                                m_zero_samples[num_zeros / SAMPLE_RATE] = pos;
+                            }
+                            ++num_zeros;
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to get the number of stored values
+                 * @return the number of stored values
+                 */
+                inline uint64_t size() const {
+                    return m_num_values;
+                }
+
+                /**
+                 * Allows to get the value with the given index
+                 * @param idx the value index, must be smaller than size()
+                 * @return the value
+                 */
+                inline uint64_t get(const uint64_t idx) const {
+                    return ((select_one(idx) - idx) << m_num_low_bits) | get_low_bits(idx);
+                }
+
+                /**
+                 * Allows to get two consecutive values, is faster than two calls to get
+                 * @param idx the first value index, must be smaller than size() - 1
+                 * @param first [out] the value with the index idx
+                 * @param second [out] the value with the index idx + 1
+                 */
+                inline void get_pair(const uint64_t idx, uint64_t & first, uint64_t & second) const {
+                    const uint64_t pos = select_one(idx);
+                    first = ((pos - idx) << m_num_low_bits) | get_low_bits(idx);
+                    second = ((next_one(pos + 1) - idx - 1) << m_num_low_bits) | get_low_bits(idx + 1);
+                }
+
+                /**
+                 * Allows to find the first value that is not smaller than the given one
+                 * @param value the value to search the successor for
+                 * @param idx [out] the index of the found value, size() if there is none
+                 * @param succ [out] the found value, if any
+                 */
+                inline void successor(const uint64_t value, uint64_t & idx, uint64_t & succ) const {
+                    const uint64_t high = value >> m_num_low_bits;
+                    if (high >= m_num_zeros) {
+                        idx = m_num_values;
+                        return;
+                    }
+
+                    //Skip to the high bucket, all the values before it are smaller
+                    uint64_t pos = (high == 0) ? 0 : select_zero(high - 1) + 1;
+                    idx = pos - high;
+
+                    //Scan the values of the high bucket and beyond
+                    while (idx < m_num_values) {
+                        pos = next_one(pos);
+                        succ = ((pos - idx) << m_num_low_bits) | get_low_bits(idx);
+                        if (succ >= value) {
+                            return;
+                        }
+                        ++pos;
+                        ++idx;
+                    }
+                }
+
+                /**
+                 * Allows to get the number of bytes used by the sequence
+                 * @return the number of used bytes
+                 */
+                inline size_t get_size_bytes() const {
+                    return (m_num_low_words + m_num_high_words + (m_num_values / SAMPLE_RATE + 1)
+                            + (m_num_zeros / SAMPLE_RATE + 1)) * sizeof (uint64_t);
+                }
+
+                /**
+                 * Allows to add the sequence memory usage into the memory breakdown
+                 * @param breakdown the memory breakdown to add to
+                 * @param component the component the sequence stores
+                 * @param level the m-gram level of the stored values
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown, const string & component, const TModelLevel level) const {
+                    breakdown.add("EliasFanoSequence", component + " low bits", level, m_num_low_words * sizeof (uint64_t));
+                    breakdown.add("EliasFanoSequence", component + " high bits", level, m_num_high_words * sizeof (uint64_t));
+                    breakdown.add("EliasFanoSequence", component + " samples", level,
+                            ((m_num_values / SAMPLE_RATE + 1) + (m_num_zeros / SAMPLE_RATE + 1)) * sizeof (uint64_t));
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                virtual ~EliasFanoSequence() {
+                    delete[] m_low_bits;
+                    delete[] m_high_bits;
+                    delete[] m_one_samples;
+                    delete[] m_zero_samples;
+                }
+
+            private:
+                //Stores the number of bits in a storage word
+                static constexpr uint8_t NUM_WORD_BITS = 64;
+                //Stores the sampling rate for the ones and zeros of the upper bits
+                static constexpr uint64_t SAMPLE_RATE = 256;
+
+                //Stores the number of values
+                const uint64_t m_num_values;
+                //Stores the maximum value
+                uint64_t m_max_value;
+                //Stores the number of low bits per value
+                uint8_t m_num_low_bits;
+                //Stores the low bits mask
+                uint64_t m_low_mask;
+                //Stores the number of added values
+                uint64_t m_num_next;
+                //Stores the last added value
+                uint64_t m_last_value;
+                //Stores the number of zeros in the upper bits
+                uint64_t m_num_zeros;
+                //Stores the number of upper bits
+                uint64_t m_num_high_bits;
+                //Stores the number of low bit words
+                uint64_t m_num_low_words;
+                //Stores the number of upper bit words
+                uint64_t m_num_high_words;
+
+                //Stores the packed low bits
+                uint64_t * m_low_bits;
+                //Stores the upper bits
+                uint64_t * m_high_bits;
+                //Stores the positions of every SAMPLE_RATE'th one
+                uint64_t * m_one_samples;
+                //Stores the positions of every SAMPLE_RATE'th zero
+                uint64_t * m_zero_samples;
+
+                /**
+                 * Allows to compute the number of words needed to store the bits, plus one
+                 * extra word so that the low bits can always be read as two words
+                 * @param num_bits the number of bits
+                 * @return the number of words
+                 */
+                static inline uint64_t num_words(const uint64_t num_bits) {
+                    return num_bits / NUM_WORD_BITS + 2;
+                }
+
+                /**
+                 * Allows to check whether the upper bit at the given position is set
+                 * @param pos the bit position
+                 * @return true if the bit is set
+                 */
+                inline bool is_high_bit(const uint64_t pos) const {
+                    return (m_high_bits[pos / NUM_WORD_BITS] >> (pos % NUM_WORD_BITS)) & 1ULL;
+                }
+
+                /**
+                 * Allows to set the low bits of the value with the given index
+                 * @param idx the value index
+                 * @param bits the low bits
+                 */
+                inline void set_low_bits(const uint64_t idx, const uint64_t bits) {
+                    if (m_num_low_bits != 0) {
+                        const uint64_t pos = idx * m_num_low_bits;
+                        const uint8_t shift = pos % NUM_WORD_BITS;
+                        m_low_bits[pos / NUM_WORD_BITS] |= (bits << shift);
+                        if (shift + m_num_low_bits > NUM_WORD_BITS) {
+                            m_low_bits[pos / NUM_WORD_BITS + 1] |= (bits >> (NUM_WORD_BITS - shift));
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to get the low bits of the value with the given index
+                 * @param idx the value index
+                 * @return the low bits
+                 */
+                inline uint64_t get_low_bits(const uint64_t idx) const {
+                    if (m_num_low_bits != 0) {
+                        const uint64_t pos = idx * m_num_low_bits;
+                        const uint8_t shift = pos % NUM_WORD_BITS;
+                        uint64_t bits = m_low_bits[pos / NUM_WORD_BITS] >> shift;
+                        if (shift + m_num_low_bits > NUM_WORD_BITS) {
+                            bits |= m_low_bits[pos / NUM_WORD_BITS + 1] << (NUM_WORD_BITS - shift);
+                        }
+                        return bits & m_low_mask;
+                    } else {
+                        return 0;
+                    }
+                }
+
+                /**
+                 * Allows to find the first set upper bit starting from the given position
+                 * @param pos the position to start from, there must be a set bit at or after it
+                 * @return the position of the set bit
+                 */
+                inline uint64_t next_one(const uint64_t pos) const {
+                    uint64_t word_idx = pos / NUM_WORD_BITS;
+                    uint64_t word = m_high_bits[word_idx] & (UINT64_MAX << (pos % NUM_WORD_BITS));
+                    while (word == 0) {
+                        word = m_high_bits[++word_idx];
+                    }
+                    return word_idx * NUM_WORD_BITS + __builtin_ctzll(word);
+                }
+
+                /**
+                 * Allows to find the position of the k'th set bit in the word
+                 * @param word the word
+                 * @param k the number of the set bit, zero based
+                 * @return the bit position in the word
+                 */
+                static inline uint8_t select_in_word(uint64_t word, uint64_t k) {
+                    while (k-- > 0) {
+                        word &= word - 1;
+                    }
+                    return __builtin_ctzll(word);
+                }
+
+                /**
+                 * Allows to find the position of the idx'th one in the upper bits
+                 * @param idx the index of the one, zero based
+                 * @return the position of the one
+                 */
+                inline uint64_t select_one(const uint64_t idx) const {
+                    const uint64_t pos = m_one_samples[idx / SAMPLE_RATE];
+                    uint64_t left = idx % SAMPLE_RATE;
+                    uint64_t word_idx = pos / NUM_WORD_BITS;
+                    uint64_t word = m_high_bits[word_idx] & (UINT64_MAX << (pos % NUM_WORD_BITS));
+                    uint64_t count = __builtin_popcountll(word);
+                    while (count <= left) {
+                        left -= count;
+                        word = m_high_bits[++word_idx];
+                        count = __builtin_popcountll(word);
+                    }
+                    return word_idx * NUM_WORD_BITS + select_in_word(word, left);
+                }
+
+                /**
+                 * Allows to find the position of the idx'th zero in the upper bits
+                 * @param idx the index of the zero, zero based
+                 * @return the position of the zero
+                 */
+                inline uint64_t select_zero(const uint64_t idx) const {
+                    const uint64_t pos = m_zero_samples[idx / SAMPLE_RATE];
+                    uint64_t left = idx % SAMPLE_RATE;
+                    uint64_t word_idx = pos / NUM_WORD_BITS;
+                    uint64_t word = ~m_high_bits[word_idx] & (UINT64_MAX << (pos % NUM_WORD_BITS));
+                    uint64_t count = __builtin_popcountll(word);
+                    while (count <= left) {
+                        left -= count;
+                        word = ~m_high_bits[++word_idx];
+                        count = __builtin_popcountll(word);
+                    }
+                    return word_idx * NUM_WORD_BITS + select_in_word(word, left);
+                }
+            };
+        }
+    }
+}
+
+#endif	/* ELIASFANOSEQUENCE_HPP */
@@ -28,16 +28,26 @@
 
 #include <string>
 #include <vector>
+#include <fstream>
 
 #include "Globals.hpp"
 #include "Logger.hpp"
 #include "Exceptions.hpp"
+#include "GreedyMemoryStorage.hpp"
+#include "PerfCounters.hpp"
 
 #include "BasicWordIndex.hpp"
 #include "CountingWordIndex.hpp"
 #include "OptimizingWordIndex.hpp"
 #include "HashingWordIndex.hpp"
 
+#include "AFileReader.hpp"
+#include "MemoryMappedFileReader.hpp"
+#include "FileStreamReader.hpp"
+#include "CStyleFileReader.hpp"
+#include "AsyncFileReader.hpp"
+#include "CompressedFileReader.hpp"
+
 #include "ARPATrieBuilder.hpp"
 #include "ARPAGramBuilder.hpp"
 
@@ -48,10 +58,14 @@
 #include "C2DHybridTrie.hpp"
 #include "G2DMapTrie.hpp"
 #include "H2DMapTrie.hpp"
+#include "A2DHybridTrie.hpp"
+#include "F2DMapTrie.hpp"
+#include "C2WEliasFanoTrie.hpp"
 
 #include "QueryMGram.hpp"
 #include "MGramCumulativeQuery.hpp"
 #include "MGramSingleQuery.hpp"
+#include "ResultWriter.hpp"
 
 using namespace std;
 using namespace uva::smt::file;
@@ -60,6 +74,7 @@ using namespace uva::smt::exceptions;
 using namespace uva::smt::tries::dictionary;
 using namespace uva::smt::tries::arpa;
 using namespace uva::smt::monitore;
+using uva::smt::tries::alloc::GreedyMemoryStorage;
 
 namespace uva {
     namespace smt {
@@ -75,6 +90,22 @@ namespace uva {
                 static const string C2DHybridTrie_STR = string("c2dh");
                 static const string G2DMapTrie_STR = string("g2dm");
                 static const string H2DMapTrie_STR = string("h2dm");
+                static const string A2DHybridTrie_STR = string("a2dh");
+                static const string F2DMapTrie_STR = string("f2dm");
+                static const string C2WEliasFanoTrie_STR = string("c2we");
+
+                static const string MMAP_POPULATE_READER_STR = string("mmap");
+                static const string MMAP_SEQUENTIAL_READER_STR = string("mmap-seq");
+                static const string C_STYLE_READER_STR = string("cstyle");
+                static const string FILE_STREAM_READER_STR = string("stream");
+                static const string DIRECT_IO_READER_STR = string("direct");
+                static const string ASYNC_READER_STR = string("async");
+                static const string COMPRESSED_READER_STR = string("compressed");
+
+                static const string LOG_FORMAT_STR = string("log");
+                static const string TSV_FORMAT_STR = string("tsv");
+                static const string BINARY_FORMAT_STR = string("bin");
+                static const string NONE_FORMAT_STR = string("none");
 
                 /**
                  * Returns the default trie type name string
@@ -97,6 +128,58 @@ namespace uva {
                     p_supported_tries->push_back(C2DHybridTrie_STR);
                     p_supported_tries->push_back(G2DMapTrie_STR);
                     p_supported_tries->push_back(H2DMapTrie_STR);
+                    p_supported_tries->push_back(A2DHybridTrie_STR);
+                    p_supported_tries->push_back(F2DMapTrie_STR);
+                    p_supported_tries->push_back(C2WEliasFanoTrie_STR);
+                }
+
+                /**
+                 * Returns the default model file reader type name string
+                 * @return the default model file reader type name string
+                 */
+                static inline string get_default_model_reader_str() {
+                    return ASYNC_READER_STR;
+                }
+
+                /**
+                 * Returns the default query file reader type name string
+                 * @return the default query file reader type name string
+                 */
+                static inline string get_default_query_reader_str() {
+                    return MMAP_POPULATE_READER_STR;
+                }
+
+                /**
+                 * Allows to get a string with all available file reader types
+                 * @param p_supported_readers the pointer to the vector to be filled in with supported readers
+                 */
+                static inline void get_file_reader_types_str(vector<string> * p_supported_readers) {
+                    p_supported_readers->push_back(MMAP_POPULATE_READER_STR);
+                    p_supported_readers->push_back(MMAP_SEQUENTIAL_READER_STR);
+                    p_supported_readers->push_back(C_STYLE_READER_STR);
+                    p_supported_readers->push_back(FILE_STREAM_READER_STR);
+                    p_supported_readers->push_back(DIRECT_IO_READER_STR);
+                    p_supported_readers->push_back(ASYNC_READER_STR);
+                    p_supported_readers->push_back(COMPRESSED_READER_STR);
+                }
+
+                /**
+                 * Returns the default query result output format name string
+                 * @return the default query result output format name string
+                 */
+                static inline string get_default_output_format_str() {
+                    return LOG_FORMAT_STR;
+                }
+
+                /**
+                 * Allows to get a string with all available query result output formats
+                 * @param p_supported_formats the pointer to the vector to be filled in with supported formats
+                 */
+                static inline void get_output_formats_str(vector<string> * p_supported_formats) {
+                    p_supported_formats->push_back(LOG_FORMAT_STR);
+                    p_supported_formats->push_back(TSV_FORMAT_STR);
+                    p_supported_formats->push_back(BINARY_FORMAT_STR);
+                    p_supported_formats->push_back(NONE_FORMAT_STR);
                 }
 
                 /**
@@ -107,18 +190,45 @@ namespace uva {
                     //for each M-gram, otherwise false, and then we only compute
                     //one conditional probability for this M-gram
                     bool is_cumulative_prob;
+                    //Stores true if the model m-grams are pre-sorted
+                    //by their word ids within each of the model sections
+                    bool m_is_presorted;
+                    //Stores the trie build memory limit in Mb, zero means no limit
+                    uint32_t m_build_mem_limit_mb;
+                    //Stores true if the model m-gram levels are to be read in parallel
+                    bool m_is_parallel_build;
                     //The train file name
                     string m_model_file_name;
                     //The test file name
                     string m_queries_file_name;
                     //The Trie type name
                     string m_trie_type_name;
-                    //The word index type to be used with the trie
-                    WordIndexTypesEnum m_word_index_type;
+                    //The maximum m-gram level of the model, as read from the model file
+                    size_t m_max_level;
+                    //The model file header, it is read before the trie type is chosen
+                    TARPAHeader m_model_header;
                     //Stores the word index memory factor
                     float m_word_index_mem_fact;
                     //The trie type 
                     TrieTypesEnum m_trie_type;
+                    //The model file reader type name
+                    string m_model_reader_name;
+                    //The query file reader type name
+                    string m_query_reader_name;
+                    //The model file reader type
+                    FileReaderTypesEnum m_model_reader_type;
+                    //The query file reader type
+                    FileReaderTypesEnum m_query_reader_type;
+                    //The query result output file name, empty for the standard output
+                    string m_output_file_name;
+                    //The query result output format name
+                    string m_output_format_name;
+                    //The query result output format
+                    ResultFormatsEnum m_output_format;
+                    //The memory breakdown JSON file name, empty for no memory breakdown
+                    string m_memory_breakdown_file_name;
+                    //Stores true if the hardware performance counters are to be reported
+                    bool m_is_perf_counters;
                 } TExecutionParams;
 
                 /**
@@ -163,17 +273,52 @@ namespace uva {
                     }
                 }
 
+                /**
+                 * This function is meant to report on returning the unused memory to the system after the trie is built
+                 * @param msStart the memory usage statistics before trimming
+                 * @param msEnd the memory usage statistics after trimming
+                 * @param trimmed_bytes the number of bytes released by the greedy memory storages
+                 */
+                static void report_memory_trimming(TMemotyUsage msStart, TMemotyUsage msEnd, const size_t trimmed_bytes) {
+                    //The memory statistics are in Kb, so the trimmed bytes are reported in Kb as well
+                    const size_t trimmed_kb = trimmed_bytes / 1024u;
+                    const int vmrss = (msStart.vmrss < msEnd.vmrss) ? 0 : msStart.vmrss - msEnd.vmrss;
+                    LOG_USAGE << "Trimming the unused memory released " << trimmed_kb
+                            << " Kb of the greedy memory storages, vmrss after trimming=-" << vmrss << " Kb" << END_LOG;
+                    GreedyMemoryStorage::report_all();
+                }
+
+                /**
+                 * This function is meant to report on the exact trie memory usage per structure,
+                 * component and m-gram level, the breakdown is logged and written as JSON
+                 * @param params the execution parameters
+                 * @param trie the built trie
+                 */
+                template<typename TrieType>
+                static void report_memory_breakdown(const __Executor::TExecutionParams & params, const TrieType & trie) {
+                    MemoryBreakdown breakdown(params.m_trie_type_name, TrieType::MAX_LEVEL);
+                    trie.memory_breakdown(breakdown);
+                    breakdown.log_table();
+
+                    ofstream json_file(params.m_memory_breakdown_file_name.c_str());
+                    ASSERT_CONDITION_THROW(!json_file.is_open(), string("Could not open the memory breakdown file: ")
+                            + params.m_memory_breakdown_file_name);
+                    breakdown.write_json(json_file);
+                    LOG_USAGE << "The memory breakdown is written into: " << params.m_memory_breakdown_file_name << END_LOG;
+                }
+
                 /**
                  * This method is used to read from the corpus and initialize the Trie
-                 * @param fstr the file to read data from
+                 * @param fstr the file to read data from, positioned after the model header
+                 * @param header the model header, as read from the file
                  * @param trie the trie to put the data into
                  */
                 template<typename TrieType, typename TFileReaderModel>
-                static void fill_in_trie(TFileReaderModel & fstr, TrieType & trie) {
+                static void fill_in_trie(TFileReaderModel & fstr, const TARPAHeader & header, TrieType & trie) {
                     //A trie container and the corps file stream are already instantiated and are given
 
                     //A.1. Create the TrieBuilder and give the trie to it
-                    ARPATrieBuilder<TrieType, TFileReaderModel> builder(trie, fstr);
+                    ARPATrieBuilder<TrieType, TFileReaderModel> builder(trie, fstr, header);
 
                     LOG_INFO3 << "Collision detections are: "
                             << (DO_SANITY_CHECKS ? "ON" : "OFF")
@@ -183,23 +328,57 @@ namespace uva {
                     builder.build();
                 }
 
+                /**
+                 * This method is used to read from the corpus and initialize the Trie,
+                 * it calls the file reader type specific version of the method.
+                 * @param params the execution parameters
+                 * @param model_file the file to read data from
+                 * @param trie the trie to put the data into
+                 */
+                template<typename TrieType>
+                static void fill_in_trie(const __Executor::TExecutionParams& params, AFileReader & model_file, TrieType & trie) {
+                    switch (params.m_model_reader_type) {
+                        case FileReaderTypesEnum::MMAP_POPULATE_READER:
+                        case FileReaderTypesEnum::MMAP_SEQUENTIAL_READER:
+                            fill_in_trie(static_cast<MemoryMappedFileReader &> (model_file), params.m_model_header, trie);
+                            break;
+                        case FileReaderTypesEnum::C_STYLE_READER:
+                            fill_in_trie(static_cast<CStyleFileReader &> (model_file), params.m_model_header, trie);
+                            break;
+                        case FileReaderTypesEnum::FILE_STREAM_READER:
+                            fill_in_trie(static_cast<FileStreamReader &> (model_file), params.m_model_header, trie);
+                            break;
+                        case FileReaderTypesEnum::DIRECT_IO_READER:
+                        case FileReaderTypesEnum::ASYNC_READER:
+                        case FileReaderTypesEnum::COMPRESSED_READER:
+                            fill_in_trie(static_cast<AsyncFileReader &> (model_file), params.m_model_header, trie);
+                            break;
+                        default:
+                            THROW_EXCEPTION(string("Unrecognized model file reader type: ") + params.m_model_reader_name);
+                    }
+                }
+
                 /**
                  * Allows to read and execute test queries from the given file on the given trie.
                  * @param trie the given trie, filled in with some data
                  * @param testFile the file containing the N-Gram (5-Gram queries)
+                 * @param writer the query result writer
                  * @return the CPU seconds used to run the queries, without time needed to read the test file
                  */
                 template<typename TrieType, typename TrieQueryType, typename TFileReaderQuery>
-                static void read_and_execute_queries(TrieType & trie, TFileReaderQuery &testFile) {
+                static void read_and_execute_queries(TrieType & trie, TFileReaderQuery &testFile, ResultWriter & writer) {
                     //Declare time variables for CPU times in seconds
                     double startTime = 0.0, endTime = 0.0;
                     //Will store the read line (word1 word2 word3 word4 word5)
                     TextPieceReader line;
                     //Will store the M-gram query and its internal state
                     TrieQueryType query(trie);
+                    //The number of executed queries
+                    uint64_t num_queries = 0;
 
                     //Start the timer
                     startTime = StatisticsMonitor::getCPUTime();
+                    PerfPhase phase("Executing the queries");
 
                     //Enable the next line for the pin-point debugging of the querying process
                     //Logger::get_reporting_level() = DebugLevelsEnum::DEBUG3;
@@ -212,42 +391,111 @@ namespace uva {
                         query.execute(line);
 
                         //Print the results:
-                        query.log_results();
+                        query.log_results(writer);
+                        ++num_queries;
                     }
 
+                    //Write out the buffered results
+                    writer.flush_buffer();
+
                     //Stop the timer
                     endTime = StatisticsMonitor::getCPUTime();
+                    phase.stop(num_queries);
 
                     LOG_USAGE << "Total query execution time is " << (endTime - startTime) << " CPU seconds." << END_LOG;
                 }
 
-                template<typename TrieType, bool IS_CUM_QUERY, typename TFileReaderModel, typename TFileReaderQuery>
-                void execute(const __Executor::TExecutionParams& params, TFileReaderModel &modelFile, TFileReaderQuery &testFile) {
+                /**
+                 * Allows to read and execute test queries from the given file on the given trie,
+                 * it calls the file reader type specific version of the method.
+                 * @param params the execution parameters
+                 * @param trie the given trie, filled in with some data
+                 * @param testFile the file containing the N-Gram (5-Gram queries)
+                 */
+                template<typename TrieType, typename TrieQueryType>
+                static void read_and_execute_queries(const __Executor::TExecutionParams& params, TrieType & trie, AFileReader &testFile) {
+                    //Create the query result writer
+                    ResultWriter writer(params.m_output_format, params.m_output_file_name);
+
+                    switch (params.m_query_reader_type) {
+                        case FileReaderTypesEnum::MMAP_POPULATE_READER:
+                        case FileReaderTypesEnum::MMAP_SEQUENTIAL_READER:
+                            read_and_execute_queries<TrieType, TrieQueryType>(trie, static_cast<MemoryMappedFileReader &> (testFile), writer);
+                            break;
+                        case FileReaderTypesEnum::C_STYLE_READER:
+                            read_and_execute_queries<TrieType, TrieQueryType>(trie, static_cast<CStyleFileReader &> (testFile), writer);
+                            break;
+                        case FileReaderTypesEnum::FILE_STREAM_READER:
+                            read_and_execute_queries<TrieType, TrieQueryType>(trie, static_cast<FileStreamReader &> (testFile), writer);
+                            break;
+                        case FileReaderTypesEnum::DIRECT_IO_READER:
+                        case FileReaderTypesEnum::ASYNC_READER:
+                        case FileReaderTypesEnum::COMPRESSED_READER:
+                            read_and_execute_queries<TrieType, TrieQueryType>(trie, static_cast<AsyncFileReader &> (testFile), writer);
+                            break;
+                        default:
+                            THROW_EXCEPTION(string("Unrecognized query file reader type: ") + params.m_query_reader_name);
+                    }
+                }
+
+                template<typename TrieType, bool IS_CUM_QUERY>
+                void execute(const __Executor::TExecutionParams& params, AFileReader &modelFile, AFileReader &testFile) {
                     //Get the word index type and make an instance of the word index
                     typename TrieType::WordIndexType word_index(params.m_word_index_mem_fact);
                     //Make an instance of the trie
                     TrieType trie(word_index);
+                    //Tell the trie if the model m-grams come pre-sorted
+                    trie.set_presorted(params.m_is_presorted);
+                    //Tell the trie how much memory it may use for sorting while building
+                    trie.set_build_mem_limit(static_cast<size_t> (params.m_build_mem_limit_mb) * MB_SIZE_BYTES);
+                    //Tell the trie if the model m-gram levels are to be read in parallel
+                    trie.set_parallel_build(params.m_is_parallel_build);
                     //Declare time variables for CPU times in seconds
                     double startTime, endTime;
+                    //Declare time variables for wall-clock times in seconds
+                    double startWallTime, endWallTime;
                     //Declare the statistics monitor and its data
                     TMemotyUsage memStatStart = {}, memStatEnd = {};
 
                     //Log the usage information
                     trie.log_trie_type_usage_info();
 
+                    //Open the hardware performance counters before any build thread is started
+                    if (params.m_is_perf_counters) {
+                        PerfCounters::enable();
+                    }
+
                     LOG_USAGE << "Start creating and loading the Trie ..." << END_LOG;
                     LOG_DEBUG << "Getting the memory statistics before creating the Trie ..." << END_LOG;
                     StatisticsMonitor::getMemoryStatistics(memStatStart);
                     LOG_DEBUG << "Getting the time statistics before creating the Trie ..." << END_LOG;
                     startTime = StatisticsMonitor::getCPUTime();
-                    fill_in_trie(modelFile, trie);
+                    startWallTime = StatisticsMonitor::getWallTime();
+                    PerfPhase phase("Building the trie");
+                    fill_in_trie(params, modelFile, trie);
+                    phase.stop();
                     LOG_DEBUG << "Getting the time statistics after creating the Trie ..." << END_LOG;
                     endTime = StatisticsMonitor::getCPUTime();
+                    endWallTime = StatisticsMonitor::getWallTime();
                     LOG_USAGE << "Reading the Language Model took " << (endTime - startTime) << " CPU seconds." << END_LOG;
+                    LOG_USAGE << "Reading the Language Model with the '" << params.m_model_reader_name
+                            << "' reader took " << (endWallTime - startWallTime) << " wall-clock seconds." << END_LOG;
                     LOG_DEBUG << "Getting the memory statistics after creating the Trie ..." << END_LOG;
                     StatisticsMonitor::getMemoryStatistics(memStatEnd);
                     LOG_DEBUG << "Reporting on the memory consumption" << END_LOG;
                     report_memory_usage("Creating the Language Model Trie", memStatStart, memStatEnd, true);
+                    LOG_USAGE << "Peak resident set size with the '" << params.m_model_reader_name
+                            << "' reader is " << (memStatEnd.vmhwm / BYTES_ONE_MB) << " Mb" << END_LOG;
+
+                    LOG_DEBUG << "Returning the unused memory to the system ..." << END_LOG;
+                    StatisticsMonitor::getMemoryStatistics(memStatStart);
+                    const size_t trimmed_bytes = GreedyMemoryStorage::trim_all();
+                    StatisticsMonitor::getMemoryStatistics(memStatEnd);
+                    report_memory_trimming(memStatStart, memStatEnd, trimmed_bytes);
+
+                    if (!params.m_memory_breakdown_file_name.empty()) {
+                        report_memory_breakdown<TrieType>(params, trie);
+                    }
 
                     LOG_DEBUG << "Getting the memory statistics before closing the Model file ..." << END_LOG;
                     StatisticsMonitor::getMemoryStatistics(memStatStart);
@@ -258,9 +506,9 @@ namespace uva {
 
                     LOG_USAGE << "Start reading and executing the test queries ..." << END_LOG;
                     if (IS_CUM_QUERY) {
-                        read_and_execute_queries<TrieType, T_M_Gram_Cumulative_Query < TrieType >> (trie, testFile);
+                        read_and_execute_queries<TrieType, T_M_Gram_Cumulative_Query < TrieType >> (params, trie, testFile);
                     } else {
-                        read_and_execute_queries<TrieType, T_M_Gram_Single_Query < TrieType >> (trie, testFile);
+                        read_and_execute_queries<TrieType, T_M_Gram_Single_Query < TrieType >> (params, trie, testFile);
                     }
                     testFile.close();
 
@@ -268,30 +516,168 @@ namespace uva {
                     LOG_USAGE << "Cleaning up memory ..." << END_LOG;
                 }
 
-                template<typename WordIndexType, bool IS_CUM_QUERY, typename TFileReaderModel, typename TFileReaderQuery>
+                /**
+                 * Maps the trie type onto the trie class of the given maximum level,
+                 * every trie is used with the word index type configured for it.
+                 * @param TRIE_TYPE the trie type
+                 * @param MAX_LEVEL the maximum m-gram level of the model
+                 */
+                template<TrieTypesEnum TRIE_TYPE, TModelLevel MAX_LEVEL>
+                struct S_Trie_Type;
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::C2DH_TRIE, MAX_LEVEL> {
+                    typedef C2DHybridTrie<MAX_LEVEL, S_Word_Index_Type<__C2DHybridTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::C2DM_TRIE, MAX_LEVEL> {
+                    typedef C2DMapTrie<MAX_LEVEL, S_Word_Index_Type<__C2DMapTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::C2WA_TRIE, MAX_LEVEL> {
+                    typedef C2WArrayTrie<MAX_LEVEL, S_Word_Index_Type<__C2WArrayTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::W2CA_TRIE, MAX_LEVEL> {
+                    typedef W2CArrayTrie<MAX_LEVEL, S_Word_Index_Type<__W2CArrayTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::W2CH_TRIE, MAX_LEVEL> {
+                    typedef W2CHybridTrie<MAX_LEVEL, S_Word_Index_Type<__W2CHybridTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::G2DM_TRIE, MAX_LEVEL> {
+                    typedef G2DMapTrie<MAX_LEVEL, S_Word_Index_Type<__G2DMapTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::H2DM_TRIE, MAX_LEVEL> {
+                    typedef H2DMapTrie<MAX_LEVEL, S_Word_Index_Type<__H2DMapTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::A2DH_TRIE, MAX_LEVEL> {
+                    typedef A2DHybridTrie<MAX_LEVEL, S_Word_Index_Type<__A2DHybridTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::F2DM_TRIE, MAX_LEVEL> {
+                    typedef F2DMapTrie<MAX_LEVEL, S_Word_Index_Type<__F2DMapTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                template<TModelLevel MAX_LEVEL>
+                struct S_Trie_Type<TrieTypesEnum::C2WE_TRIE, MAX_LEVEL> {
+                    typedef C2WEliasFanoTrie<MAX_LEVEL, S_Word_Index_Type<__C2WEliasFanoTrie::WORD_INDEX_TYPE>::type> type;
+                };
+
+                /**
+                 * This recursive structure chooses the trie of the model level, it goes through
+                 * the levels from CURR_LEVEL up to M_GRAM_LEVEL_MAX, so only the instantiated
+                 * levels of the given trie type are dispatched to.
+                 * @param TRIE_TYPE the trie type
+                 * @param CURR_LEVEL the currently considered maximum level
+                 * @param IS_CUM_QUERY true if the cumulative query is to be executed
+                 */
+                template<TrieTypesEnum TRIE_TYPE, TModelLevel CURR_LEVEL, bool IS_CUM_QUERY>
+                struct S_Level_Executor {
+
+                    static inline void execute(const __Executor::TExecutionParams& params,
+                            AFileReader &modelFile, AFileReader &testFile) {
+                        if (params.m_max_level == CURR_LEVEL) {
+                            __Executor::execute<typename S_Trie_Type<TRIE_TYPE, CURR_LEVEL>::type, IS_CUM_QUERY>(params, modelFile, testFile);
+                        } else {
+                            S_Level_Executor < TRIE_TYPE, CURR_LEVEL + 1, IS_CUM_QUERY>::execute(params, modelFile, testFile);
+                        }
+                    }
+                };
+
+                template<TrieTypesEnum TRIE_TYPE, bool IS_CUM_QUERY>
+                struct S_Level_Executor<TRIE_TYPE, M_GRAM_LEVEL_MAX + 1, IS_CUM_QUERY> {
+
+                    static inline void execute(const __Executor::TExecutionParams& params,
+                            AFileReader &modelFile, AFileReader &testFile) {
+                        THROW_EXCEPTION(string("Unsupported language model level: ") + std::to_string(params.m_max_level));
+                    }
+                };
+
+                /**
+                 * Allows to choose the maximum level of the given trie type and to execute.
+                 * The templates of every trie type are instantiated in their own translation
+                 * unit, see INSTANTIATE_TRIE_EXECUTOR, so the tries can be compiled in parallel.
+                 * @param TRIE_TYPE the trie type
+                 * @param IS_CUM_QUERY true if the cumulative query is to be executed
+                 * @param params the execution parameters
+                 * @param modelFile the model file existing and opened, will be closed by this function
+                 * @param testFile the model file existing and opened, will be closed by this function
+                 */
+                template<TrieTypesEnum TRIE_TYPE, bool IS_CUM_QUERY>
+                void choose_level_and_execute_trie(const __Executor::TExecutionParams& params,
+                        AFileReader &modelFile, AFileReader &testFile) {
+                    S_Level_Executor<TRIE_TYPE, M_GRAM_LEVEL_2, IS_CUM_QUERY>::execute(params, modelFile, testFile);
+                }
+
+                //Define the macros for declaring and instantiating the executor templates of the trie type
+#define TRIE_EXECUTOR_TEMPLATES(PREFIX, TRIE_TYPE) \
+                PREFIX template void choose_level_and_execute_trie<TRIE_TYPE, true>(const __Executor::TExecutionParams&, AFileReader &, AFileReader &); \
+                PREFIX template void choose_level_and_execute_trie<TRIE_TYPE, false>(const __Executor::TExecutionParams&, AFileReader &, AFileReader &);
+#define INSTANTIATE_TRIE_EXECUTOR(TRIE_TYPE) TRIE_EXECUTOR_TEMPLATES(, TRIE_TYPE)
+
+                //The executor templates are instantiated in the trie executor translation units only
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::C2DH_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::C2DM_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::C2WA_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::W2CA_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::W2CH_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::G2DM_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::H2DM_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::A2DH_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::F2DM_TRIE);
+                TRIE_EXECUTOR_TEMPLATES(extern, TrieTypesEnum::C2WE_TRIE);
+
+                /**
+                 * Allows to choose the trie type and to execute.
+                 * @param params the execution parameters
+                 * @param modelFile the model file existing and opened, will be closed by this function
+                 * @param testFile the model file existing and opened, will be closed by this function
+                 */
+                template<bool IS_CUM_QUERY>
                 static void choose_trie_type_and_execute(const __Executor::TExecutionParams& params,
-                        TFileReaderModel &modelFile, TFileReaderQuery &testFile) {
+                        AFileReader &modelFile, AFileReader &testFile) {
                     switch (params.m_trie_type) {
                         case TrieTypesEnum::C2DH_TRIE:
-                            execute < C2DHybridTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::C2DH_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::C2DM_TRIE:
-                            execute < C2DMapTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::C2DM_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::C2WA_TRIE:
-                            execute < C2WArrayTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::C2WA_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::W2CA_TRIE:
-                            execute < W2CArrayTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::W2CA_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::W2CH_TRIE:
-                            execute < W2CHybridTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY> (params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::W2CH_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::G2DM_TRIE:
-                            execute < G2DMapTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::G2DM_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         case TrieTypesEnum::H2DM_TRIE:
-                            execute < H2DMapTrie<M_GRAM_LEVEL_MAX, WordIndexType>, IS_CUM_QUERY>(params, modelFile, testFile);
+                            choose_level_and_execute_trie<TrieTypesEnum::H2DM_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
+                            break;
+                        case TrieTypesEnum::A2DH_TRIE:
+                            choose_level_and_execute_trie<TrieTypesEnum::A2DH_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
+                            break;
+                        case TrieTypesEnum::F2DM_TRIE:
+                            choose_level_and_execute_trie<TrieTypesEnum::F2DM_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
+                            break;
+                        case TrieTypesEnum::C2WE_TRIE:
+                            choose_level_and_execute_trie<TrieTypesEnum::C2WE_TRIE, IS_CUM_QUERY>(params, modelFile, testFile);
                             break;
                         default:
                             THROW_EXCEPTION(string("Unrecognized trie type: ")+std::to_string(params.m_trie_type));
@@ -299,40 +685,89 @@ namespace uva {
                 }
 
                 /**
-                 * Allows to execute the trie tasks: create/fill/execute queries
+                 * Allows to read the model header from the model file, it calls the
+                 * file reader type specific version of the method. The model file is
+                 * not rewound, the trie builder continues reading after the header.
+                 * @param params the execution parameters, the model header is stored in them
+                 * @param model_file the model file to read from
+                 */
+                static void read_model_header(__Executor::TExecutionParams& params, AFileReader & model_file) {
+                    switch (params.m_model_reader_type) {
+                        case FileReaderTypesEnum::MMAP_POPULATE_READER:
+                        case FileReaderTypesEnum::MMAP_SEQUENTIAL_READER:
+                            read_arpa_header(static_cast<MemoryMappedFileReader &> (model_file), params.m_model_header);
+                            break;
+                        case FileReaderTypesEnum::C_STYLE_READER:
+                            read_arpa_header(static_cast<CStyleFileReader &> (model_file), params.m_model_header);
+                            break;
+                        case FileReaderTypesEnum::FILE_STREAM_READER:
+                            read_arpa_header(static_cast<FileStreamReader &> (model_file), params.m_model_header);
+                            break;
+                        case FileReaderTypesEnum::DIRECT_IO_READER:
+                        case FileReaderTypesEnum::ASYNC_READER:
+                        case FileReaderTypesEnum::COMPRESSED_READER:
+                            read_arpa_header(static_cast<AsyncFileReader &> (model_file), params.m_model_header);
+                            break;
+                        default:
+                            THROW_EXCEPTION(string("Unrecognized model file reader type: ") + params.m_model_reader_name);
+                    }
+                }
+
+                /**
+                 * Allows to read the trie maximum level, i.e. the N of the N-gram
+                 * model, from the model file and then to choose the trie type and to execute.
                  * @param params the execution parameters
                  * @param modelFile the model file existing and opened, will be closed by this function
                  * @param testFile the model file existing and opened, will be closed by this function
                  */
-                template<bool IS_CUM_QUERY, typename TFileReaderModel, typename TFileReaderQuery>
-                static void choose_word_index_and_execute(
+                template<bool IS_CUM_QUERY>
+                static void choose_level_and_execute(
                         __Executor::TExecutionParams& params,
-                        TFileReaderModel &modelFile, TFileReaderQuery &testFile) {
-                    LOG_DEBUG << "Choosing the appropriate Word index type" << END_LOG;
+                        AFileReader &modelFile, AFileReader &testFile) {
+                    LOG_DEBUG << "Choosing the maximum m-gram level from the model file" << END_LOG;
 
-                    //Chose the word index type and then the trie type
+                    //Read the model header, it gives the model level, and then choose the trie type
+                    read_model_header(params, modelFile);
+                    params.m_max_level = params.m_model_header.m_max_level;
                     params.m_word_index_mem_fact = __HashMapWordIndex::MEMORY_FACTOR;
-                    switch (params.m_word_index_type) {
-                        case WordIndexTypesEnum::BASIC_WORD_INDEX:
-                            choose_trie_type_and_execute<BasicWordIndex, IS_CUM_QUERY>(params, modelFile, testFile);
-                            break;
-                        case WordIndexTypesEnum::COUNTING_WORD_INDEX:
-                            choose_trie_type_and_execute<CountingWordIndex, IS_CUM_QUERY>(params, modelFile, testFile);
-                            break;
-                        case WordIndexTypesEnum::OPTIMIZING_BASIC_WORD_INDEX:
-                            choose_trie_type_and_execute<OptimizingWordIndex<BasicWordIndex>, IS_CUM_QUERY>(params, modelFile, testFile);
-                            break;
-                        case WordIndexTypesEnum::OPTIMIZING_COUNTING_WORD_INDEX:
-                            choose_trie_type_and_execute<OptimizingWordIndex<CountingWordIndex>, IS_CUM_QUERY>(params, modelFile, testFile);
-                            break;
-                        case WordIndexTypesEnum::HASHING_WORD_INDEX:
-                            choose_trie_type_and_execute<HashingWordIndex, IS_CUM_QUERY>(params, modelFile, testFile);
-                            break;
-                        default:
-                            stringstream msg;
-                            msg << "Unrecognized word index type: " << params.m_word_index_type;
-                            throw Exception(msg.str());
+
+                    LOG_USAGE << "The language model level is: " << params.m_max_level << END_LOG;
+
+                    //Check that the model level is supported, then choose the trie type
+                    if ((params.m_max_level < M_GRAM_LEVEL_2) || (params.m_max_level > M_GRAM_LEVEL_MAX)) {
+                        stringstream msg;
+                        msg << "Unsupported language model level: " << params.m_max_level
+                                << ", the supported levels are [" << std::to_string(M_GRAM_LEVEL_2)
+                                << ", " << std::to_string(M_GRAM_LEVEL_MAX) << "]";
+                        throw Exception(msg.str());
                     }
+                    choose_trie_type_and_execute<IS_CUM_QUERY>(params, modelFile, testFile);
+                }
+
+                /**
+                 * Allows to get the trie type for the given trie type name
+                 * @param trie_name the trie type name
+                 * @return the trie type
+                 */
+                static TrieTypesEnum get_trie_type(const string & trie_name) {
+                    static const pair<string, TrieTypesEnum> TRIE_TYPES[] = {
+                        make_pair(TC2DMapTrie_STR, TrieTypesEnum::C2DM_TRIE),
+                        make_pair(TW2CHybridTrie_STR, TrieTypesEnum::W2CH_TRIE),
+                        make_pair(TC2WArrayTrie_STR, TrieTypesEnum::C2WA_TRIE),
+                        make_pair(TW2CArrayTrie_STR, TrieTypesEnum::W2CA_TRIE),
+                        make_pair(C2DHybridTrie_STR, TrieTypesEnum::C2DH_TRIE),
+                        make_pair(G2DMapTrie_STR, TrieTypesEnum::G2DM_TRIE),
+                        make_pair(H2DMapTrie_STR, TrieTypesEnum::H2DM_TRIE),
+                        make_pair(A2DHybridTrie_STR, TrieTypesEnum::A2DH_TRIE),
+                        make_pair(F2DMapTrie_STR, TrieTypesEnum::F2DM_TRIE),
+                        make_pair(C2WEliasFanoTrie_STR, TrieTypesEnum::C2WE_TRIE)
+                    };
+                    for (const pair<string, TrieTypesEnum> & entry : TRIE_TYPES) {
+                        if (entry.first == trie_name) {
+                            return entry.second;
+                        }
+                    }
+                    THROW_EXCEPTION(string("Unrecognized trie type: ") + trie_name);
                 }
 
                 /**
@@ -341,51 +776,111 @@ namespace uva {
                  * @param modelFile the open model file, will be closed within this call stack
                  * @param testFile the open queries file, will be closed within this call stack
                  */
-                template<typename TFileReaderModel, typename TFileReaderQuery>
                 static void choose_and_execute(__Executor::TExecutionParams& params,
-                        TFileReaderModel &modelFile, TFileReaderQuery &testFile) {
-                    if (params.m_trie_type_name == TC2DMapTrie_STR) {
-                        params.m_word_index_type = __C2DMapTrie::WORD_INDEX_TYPE;
-                        params.m_trie_type = TrieTypesEnum::C2DM_TRIE;
-                    } else {
-                        if (params.m_trie_type_name == TW2CHybridTrie_STR) {
-                            params.m_word_index_type = __W2CHybridTrie::WORD_INDEX_TYPE;
-                            params.m_trie_type = TrieTypesEnum::W2CH_TRIE;
-                        } else {
-                            if (params.m_trie_type_name == TC2WArrayTrie_STR) {
-                                params.m_word_index_type = __C2WArrayTrie::WORD_INDEX_TYPE;
-                                params.m_trie_type = TrieTypesEnum::C2WA_TRIE;
-                            } else {
-                                if (params.m_trie_type_name == TW2CArrayTrie_STR) {
-                                    params.m_word_index_type = __W2CArrayTrie::WORD_INDEX_TYPE;
-                                    params.m_trie_type = TrieTypesEnum::W2CA_TRIE;
-                                } else {
-                                    if (params.m_trie_type_name == C2DHybridTrie_STR) {
-                                        params.m_word_index_type = __C2DHybridTrie::WORD_INDEX_TYPE;
-                                        params.m_trie_type = TrieTypesEnum::C2DH_TRIE;
-                                    } else {
-                                        if (params.m_trie_type_name == G2DMapTrie_STR) {
-                                            params.m_word_index_type = __G2DMapTrie::WORD_INDEX_TYPE;
-                                            params.m_trie_type = TrieTypesEnum::G2DM_TRIE;
-                                        } else {
-                                            if (params.m_trie_type_name == H2DMapTrie_STR) {
-                                                params.m_word_index_type = __H2DMapTrie::WORD_INDEX_TYPE;
-                                                params.m_trie_type = TrieTypesEnum::H2DM_TRIE;
-                                            } else {
-                                                THROW_EXCEPTION(string("Unrecognized trie type: ") + params.m_trie_type_name);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+                        AFileReader &modelFile, AFileReader &testFile) {
+                    params.m_trie_type = get_trie_type(params.m_trie_type_name);
 
-                    //Choose the word index and trie types and do all the actions
+                    //Choose the model level and trie type and do all the actions
                     if (params.is_cumulative_prob) {
-                        choose_word_index_and_execute<true>(params, modelFile, testFile);
+                        choose_level_and_execute<true>(params, modelFile, testFile);
                     } else {
-                        choose_word_index_and_execute<false>(params, modelFile, testFile);
+                        choose_level_and_execute<false>(params, modelFile, testFile);
+                    }
+                }
+
+                /**
+                 * Allows to get the file reader type for the given file reader name
+                 * @param reader_name the file reader type name
+                 * @return the file reader type
+                 */
+                static FileReaderTypesEnum get_file_reader_type(const string & reader_name) {
+                    if (reader_name == MMAP_POPULATE_READER_STR) {
+                        return FileReaderTypesEnum::MMAP_POPULATE_READER;
+                    }
+                    if (reader_name == MMAP_SEQUENTIAL_READER_STR) {
+                        return FileReaderTypesEnum::MMAP_SEQUENTIAL_READER;
+                    }
+                    if (reader_name == C_STYLE_READER_STR) {
+                        return FileReaderTypesEnum::C_STYLE_READER;
+                    }
+                    if (reader_name == FILE_STREAM_READER_STR) {
+                        return FileReaderTypesEnum::FILE_STREAM_READER;
+                    }
+                    if (reader_name == DIRECT_IO_READER_STR) {
+                        return FileReaderTypesEnum::DIRECT_IO_READER;
+                    }
+                    if (reader_name == ASYNC_READER_STR) {
+                        return FileReaderTypesEnum::ASYNC_READER;
+                    }
+                    if (reader_name == COMPRESSED_READER_STR) {
+                        return FileReaderTypesEnum::COMPRESSED_READER;
+                    }
+                    THROW_EXCEPTION(string("Unrecognized file reader type: ") + reader_name);
+                }
+
+                /**
+                 * Allows to get the query result output format by its name
+                 * @param format_name the output format name
+                 * @return the output format
+                 */
+                static ResultFormatsEnum get_output_format(const string & format_name) {
+                    if (format_name == LOG_FORMAT_STR) {
+                        return ResultFormatsEnum::LOG_FORMAT;
+                    }
+                    if (format_name == TSV_FORMAT_STR) {
+                        return ResultFormatsEnum::TSV_FORMAT;
+                    }
+                    if (format_name == BINARY_FORMAT_STR) {
+                        return ResultFormatsEnum::BINARY_FORMAT;
+                    }
+                    if (format_name == NONE_FORMAT_STR) {
+                        return ResultFormatsEnum::NONE_FORMAT;
+                    }
+                    THROW_EXCEPTION(string("Unrecognized result output format: ") + format_name);
+                }
+
+                /**
+                 * Switches to the compressed file reader if the given file is compressed
+                 * @param file_name the name of the file to be read
+                 * @param reader_name [in/out] the file reader type name
+                 * @param reader_type [in/out] the file reader type
+                 */
+                static void choose_compressed_file_reader(const string & file_name, string & reader_name, FileReaderTypesEnum & reader_type) {
+                    if ((reader_type != FileReaderTypesEnum::COMPRESSED_READER) &&
+                            CompressedFileReader::is_compressed(file_name.c_str())) {
+                        LOG_USAGE << "The file '" << file_name << "' is compressed, using the '"
+                                << COMPRESSED_READER_STR << "' reader instead of '" << reader_name << "'" << END_LOG;
+                        reader_name = COMPRESSED_READER_STR;
+                        reader_type = FileReaderTypesEnum::COMPRESSED_READER;
+                    }
+                }
+
+                /**
+                 * Allows to create a new file reader of the given type
+                 * Note: the returned pointer to the dynamically allocated
+                 * file reader is to be freed by the caller!
+                 * @param reader_type the file reader type
+                 * @param file_name the name of the file to open
+                 * @return the pointer to the newly allocated file reader
+                 */
+                static AFileReader * create_file_reader(const FileReaderTypesEnum reader_type, const string & file_name) {
+                    switch (reader_type) {
+                        case FileReaderTypesEnum::MMAP_POPULATE_READER:
+                            return new MemoryMappedFileReader(file_name.c_str(), false);
+                        case FileReaderTypesEnum::MMAP_SEQUENTIAL_READER:
+                            return new MemoryMappedFileReader(file_name.c_str(), true);
+                        case FileReaderTypesEnum::C_STYLE_READER:
+                            return new CStyleFileReader(file_name.c_str());
+                        case FileReaderTypesEnum::FILE_STREAM_READER:
+                            return new FileStreamReader(file_name.c_str());
+                        case FileReaderTypesEnum::DIRECT_IO_READER:
+                            return new AsyncFileReader(file_name.c_str(), true);
+                        case FileReaderTypesEnum::ASYNC_READER:
+                            return new AsyncFileReader(file_name.c_str(), false);
+                        case FileReaderTypesEnum::COMPRESSED_READER:
+                            return new CompressedFileReader(file_name.c_str());
+                        default:
+                            THROW_EXCEPTION(string("Unrecognized file reader type: ") + std::to_string(reader_type));
                     }
                 }
 
@@ -399,39 +894,56 @@ namespace uva {
                     //Declare the statistics monitor and its data
                     TMemotyUsage memStatStart = {}, memStatEnd = {};
 
-                    //ToDo: Add the possibility to choose between the file readers from the command line!
+                    //Get the requested file reader types
+                    params.m_model_reader_type = get_file_reader_type(params.m_model_reader_name);
+                    params.m_query_reader_type = get_file_reader_type(params.m_query_reader_name);
+
+                    //Get the requested query result output format
+                    params.m_output_format = get_output_format(params.m_output_format_name);
+
+                    //The compressed files can only be read by the compressed file reader
+                    choose_compressed_file_reader(params.m_model_file_name, params.m_model_reader_name, params.m_model_reader_type);
+                    choose_compressed_file_reader(params.m_queries_file_name, params.m_query_reader_name, params.m_query_reader_type);
+
                     LOG_DEBUG << "Getting the memory statistics before opening the model file ..." << END_LOG;
                     StatisticsMonitor::getMemoryStatistics(memStatStart);
 
                     //Attempt to open the model file
-                    //ToDo: Add the possibility to choose between the file readers from the command line!
-                    //MemoryMappedFileReader modelFile(params.m_model_file_name.c_str());
-                    //FileStreamReader modelFile(params.m_model_file_name.c_str());
-                    CStyleFileReader modelFile(params.m_model_file_name.c_str());
-                    modelFile.log_reader_type_usage_info();
-                    LOG_DEBUG << "Getting the memory statistics after opening the model file ..." << END_LOG;
-                    StatisticsMonitor::getMemoryStatistics(memStatEnd);
-                    //LOG_DEBUG << "Reporting on the memory consumption" << END_LOG;
-                    //report_memory_usage("Opening the Language Model file", memStatStart, memStatEnd, false);
-
-                    //ToDo: Add the possibility to choose between the file readers from the command line!
-                    //Attempt to open the test file
-                    MemoryMappedFileReader testFile(params.m_queries_file_name.c_str());
-                    //FileStreamReader testFile(params.m_queries_file_name.c_str());
-                    //CStyleFileReader testFile(params.m_queries_file_name.c_str());
-
-                    //If the files could be opened then proceed with training and then testing
-                    if ((modelFile.is_open()) && (testFile.is_open())) {
-                        //Choose needed class types and execute the trie tasks: create/fill/execute queries
-                        choose_and_execute(params, modelFile, testFile);
-                    } else {
-                        stringstream msg;
-                        msg << "One of the input files does not exist: " +
-                                get_file_exists_string(params.m_model_file_name, (bool)modelFile)
-                                + " , " +
-                                get_file_exists_string(params.m_queries_file_name, (bool)testFile);
-                        throw Exception(msg.str());
+                    AFileReader * modelFile = create_file_reader(params.m_model_reader_type, params.m_model_file_name);
+                    AFileReader * testFile = NULL;
+                    try {
+                        modelFile->log_reader_type_usage_info();
+                        LOG_DEBUG << "Getting the memory statistics after opening the model file ..." << END_LOG;
+                        StatisticsMonitor::getMemoryStatistics(memStatEnd);
+                        LOG_DEBUG << "Reporting on the memory consumption" << END_LOG;
+                        report_memory_usage("Opening the Language Model file", memStatStart, memStatEnd, false);
+
+                        //Attempt to open the test file
+                        testFile = create_file_reader(params.m_query_reader_type, params.m_queries_file_name);
+                        testFile->log_reader_type_usage_info();
+
+                        //If the files could be opened then proceed with training and then testing
+                        if ((modelFile->is_open()) && (testFile->is_open())) {
+                            //Choose needed class types and execute the trie tasks: create/fill/execute queries
+                            choose_and_execute(params, *modelFile, *testFile);
+                        } else {
+                            stringstream msg;
+                            msg << "One of the input files does not exist: " +
+                                    get_file_exists_string(params.m_model_file_name, (bool)*modelFile)
+                                    + " , " +
+                                    get_file_exists_string(params.m_queries_file_name, (bool)*testFile);
+                            throw Exception(msg.str());
+                        }
+                    } catch (...) {
+                        //Free the allocated file readers in case of an exception
+                        delete modelFile;
+                        delete testFile;
+                        //Re-throw the exception
+                        throw;
                     }
+                    //Free the allocated file readers in case of no exception
+                    delete modelFile;
+                    delete testFile;
 
                     LOG_INFO << "Done" << END_LOG;
                 }
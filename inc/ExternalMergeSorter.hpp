@@ -0,0 +1,402 @@
+/*
+ * File:   ExternalMergeSorter.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#ifndef EXTERNALMERGESORTER_HPP
+#define	EXTERNALMERGESORTER_HPP
+
+#include <string>       // std::string
+#include <vector>       // std::vector
+#include <queue>        // std::priority_queue
+#include <cstdio>       // std::FILE, std::fopen, std::fwrite, std::fread
+#include <cstdlib>      // std::getenv, mkstemp
+#include <cstring>      // std::strerror
+#include <cerrno>       // errno
+#include <unistd.h>     // unlink, close
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "ArrayUtils.hpp"
+
+using namespace std;
+using namespace uva::smt::logging;
+using namespace uva::smt::exceptions;
+
+namespace uva {
+    namespace smt {
+        namespace utils {
+            namespace array {
+
+                /**
+                 * Creates a new temporary file in the temporary directory, the
+                 * file is unlinked right away so it is removed even if we crash.
+                 * @return the temporary file descriptor
+                 */
+                static inline int create_temp_file() {
+                    const char * dir = getenv(__ExternalMergeSorter::TEMP_DIR_ENV_VAR);
+                    string path = string((dir != NULL) ? dir : __ExternalMergeSorter::DEFAULT_TEMP_DIR) + "/"
+                            + __ExternalMergeSorter::RUN_FILE_TEMPLATE;
+
+                    int file_desc = mkstemp(&path[0]);
+                    ASSERT_CONDITION_THROW((file_desc < 0), string("Could not create a temporary file: ") + path
+                            + string(", error: ") + strerror(errno));
+                    unlink(path.c_str());
+                    return file_desc;
+                }
+
+                /**
+                 * This is an external memory merge sorter. The elements are
+                 * collected in a bounded memory buffer, each time the buffer
+                 * is full it is sorted and appended to a temporary file as
+                 * a sorted run. In the end the runs are k-way merged and the
+                 * elements are given to a consumer in the sorted order. The
+                 * merge reads the runs back within the same memory bound, if
+                 * there are too many runs for that then they are first merged
+                 * into fewer and longer runs on the disk. The temporary files
+                 * are unlinked right after creation so they are removed even
+                 * if we crash.
+                 * @param ELEM_TYPE the element type, must be copyable with
+                 *                  memcpy and have the less operator defined
+                 */
+                template<typename ELEM_TYPE>
+                class ExternalMergeSorter {
+                public:
+
+                    /**
+                     * The basic constructor
+                     * @param max_mem_elems the maximum number of elements to be kept in memory, at least two
+                     */
+                    explicit ExternalMergeSorter(const size_t max_mem_elems)
+                    : m_max_mem_elems(max(max_mem_elems, (size_t) 2)), m_buffer(NULL), m_num_buff_elems(0),
+                    m_num_elems(0), m_runs_file_ptr(NULL), m_num_file_elems(0) {
+                        m_buffer = new ELEM_TYPE[m_max_mem_elems];
+                    }
+
+                    /**
+                     * Adds a new element to be sorted, spills a sorted run if the buffer is full
+                     * @param elem the element to add
+                     */
+                    inline void add(const ELEM_TYPE & elem) {
+                        if (m_num_buff_elems == m_max_mem_elems) {
+                            spill_run();
+                        }
+                        m_buffer[m_num_buff_elems++] = elem;
+                        ++m_num_elems;
+                    }
+
+                    /**
+                     * Allows to get the number of added elements
+                     * @return the number of added elements
+                     */
+                    inline size_t size() const {
+                        return m_num_elems;
+                    }
+
+                    /**
+                     * Allows to get the number of sorted runs written to the disk
+                     * @return the number of sorted runs
+                     */
+                    inline size_t get_num_runs() const {
+                        return m_runs.size();
+                    }
+
+                    /**
+                     * Sorts all the added elements and gives them to the consumer in the sorted
+                     * order. The memory buffer is freed before the merge, the merge then uses at
+                     * most the same amount of memory for reading the sorted runs back.
+                     * @param consume the consumer, is called with every element in the sorted order
+                     */
+                    template<typename TConsumer>
+                    void sort_into(TConsumer & consume) {
+                        if (m_runs.empty()) {
+                            //Everything fits into memory, just sort the buffer
+                            my_sort<ELEM_TYPE>(m_buffer, m_num_buff_elems);
+                            for (size_t idx = 0; idx < m_num_buff_elems; ++idx) {
+                                consume(m_buffer[idx]);
+                            }
+                            free_buffer();
+                        } else {
+                            //Write the last run and release the buffer
+                            spill_run();
+                            free_buffer();
+
+                            //Reduce the number of runs until each of them gets a large enough read buffer
+                            const size_t max_fan_in = get_max_fan_in();
+                            while (m_runs.size() > max_fan_in) {
+                                merge_pass(max_fan_in);
+                            }
+
+                            //Merge the remaining runs into the consumer
+                            merge_runs(0, m_runs.size(), consume);
+                        }
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    virtual ~ExternalMergeSorter() {
+                        free_buffer();
+                        if (m_runs_file_ptr != NULL) {
+                            fclose(m_runs_file_ptr);
+                        }
+                    }
+
+                private:
+
+                    /**
+                     * Stores the sorted run information
+                     * @param m_offset the run begin offset in the runs file, in elements
+                     * @param m_size the number of elements in the run
+                     */
+                    typedef struct {
+                        size_t m_offset;
+                        size_t m_size;
+                    } TRunInfo;
+
+                    /**
+                     * Stores the run reading state during the merge
+                     * @param m_data the read buffer
+                     * @param m_curr the current element index in the read buffer
+                     * @param m_end the number of elements in the read buffer
+                     * @param m_left the number of elements left in the run
+                     */
+                    typedef struct {
+                        ELEM_TYPE * m_data;
+                        size_t m_curr;
+                        size_t m_end;
+                        size_t m_left;
+                    } TRunReader;
+
+                    //The maximum number of elements to be kept in memory
+                    const size_t m_max_mem_elems;
+                    //The in memory buffer
+                    ELEM_TYPE * m_buffer;
+                    //The number of elements in the buffer
+                    size_t m_num_buff_elems;
+                    //The total number of added elements
+                    size_t m_num_elems;
+                    //The temporary file storing the sorted runs one after another
+                    FILE * m_runs_file_ptr;
+                    //The number of elements written into the runs file
+                    size_t m_num_file_elems;
+                    //The list of written runs
+                    vector<TRunInfo> m_runs;
+
+                    //The sorter owns its buffer and file, so copying it would free them twice
+                    ExternalMergeSorter(const ExternalMergeSorter &) = delete;
+                    ExternalMergeSorter & operator=(const ExternalMergeSorter &) = delete;
+
+                    /**
+                     * Frees the in memory buffer
+                     */
+                    inline void free_buffer() {
+                        if (m_buffer != NULL) {
+                            delete[] m_buffer;
+                            m_buffer = NULL;
+                        }
+                    }
+
+                    /**
+                     * Allows to get the maximum number of runs to be merged at once, such
+                     * that the read buffers of all of them fit into the memory bound and
+                     * each of them is not smaller than MIN_RUN_READ_BYTES, if possible.
+                     * @return the maximum number of runs to be merged at once, at least two
+                     */
+                    inline size_t get_max_fan_in() const {
+                        const size_t min_read_elems = max(__ExternalMergeSorter::MIN_RUN_READ_BYTES / sizeof (ELEM_TYPE), (size_t) 1);
+                        return max(m_max_mem_elems / min_read_elems, (size_t) 2);
+                    }
+
+                    /**
+                     * Creates a new temporary file for sorted runs,
+                     * the file is unlinked right away.
+                     * @return the temporary file pointer
+                     */
+                    static inline FILE * create_run_file() {
+                        const int file_desc = create_temp_file();
+
+                        FILE * file_ptr = fdopen(file_desc, "w+b");
+                        if (file_ptr == NULL) {
+                            close(file_desc);
+                            THROW_EXCEPTION(string("Could not open a sorted run file, error: ") + strerror(errno));
+                        }
+                        return file_ptr;
+                    }
+
+                    /**
+                     * Writes the given elements at the end of the given file
+                     * @param file_ptr the file to write into
+                     * @param data the elements to write
+                     * @param num_elems the number of elements to write
+                     */
+                    static inline void write_elems(FILE * file_ptr, const ELEM_TYPE * data, const size_t num_elems) {
+                        ASSERT_CONDITION_THROW((fwrite(data, sizeof (ELEM_TYPE), num_elems, file_ptr) != num_elems),
+                                string("Could not write a sorted run, error: ") + strerror(errno));
+                    }
+
+                    /**
+                     * Sorts the buffer and appends it to the runs file
+                     */
+                    void spill_run() {
+                        LOG_DEBUG << "Spilling a sorted run #" << m_runs.size() << " of "
+                                << m_num_buff_elems << " elements" << END_LOG;
+
+                        my_sort<ELEM_TYPE>(m_buffer, m_num_buff_elems);
+
+                        if (m_runs_file_ptr == NULL) {
+                            m_runs_file_ptr = create_run_file();
+                        }
+                        TRunInfo run = {m_num_file_elems, m_num_buff_elems};
+                        write_elems(m_runs_file_ptr, m_buffer, m_num_buff_elems);
+                        m_runs.push_back(run);
+                        m_num_file_elems += m_num_buff_elems;
+
+                        m_num_buff_elems = 0;
+                        Logger::update_progress_bar();
+                    }
+
+                    /**
+                     * Reads the next portion of the run into the run reader buffer
+                     * @param run the run information
+                     * @param reader the run reader
+                     * @param read_elems the maximum number of elements to read
+                     */
+                    inline void read_run(const TRunInfo & run, TRunReader & reader, const size_t read_elems) {
+                        const size_t offset = run.m_offset + (run.m_size - reader.m_left);
+                        reader.m_curr = 0;
+                        reader.m_end = min(read_elems, reader.m_left);
+                        ASSERT_CONDITION_THROW((fseeko(m_runs_file_ptr, offset * sizeof (ELEM_TYPE), SEEK_SET) != 0),
+                                string("Could not seek in a sorted run, error: ") + strerror(errno));
+                        ASSERT_CONDITION_THROW((fread(reader.m_data, sizeof (ELEM_TYPE), reader.m_end, m_runs_file_ptr) != reader.m_end),
+                                string("Could not read a sorted run, error: ") + strerror(errno));
+                        reader.m_left -= reader.m_end;
+                    }
+
+                    /**
+                     * The merge queue entry, stores the current element and its run index.
+                     * The less operator is inverted to get a min-heap in std::priority_queue
+                     */
+                    struct S_Merge_Entry {
+                        ELEM_TYPE m_elem;
+                        size_t m_run_idx;
+
+                        inline bool operator<(const S_Merge_Entry & other) const {
+                            return (other.m_elem < m_elem);
+                        }
+                    };
+
+                    /**
+                     * Merges the runs in groups of at most the given number of runs into
+                     * new runs, written into a new runs file that replaces the current one
+                     * @param max_fan_in the maximum number of runs to be merged at once
+                     */
+                    void merge_pass(const size_t max_fan_in) {
+                        LOG_DEBUG << "Merging " << m_runs.size() << " sorted runs into runs of at most "
+                                << max_fan_in << " runs each" << END_LOG;
+
+                        vector<TRunInfo> new_runs;
+                        FILE * new_file_ptr = create_run_file();
+                        try {
+                            size_t num_new_elems = 0;
+                            auto write_elem = [&](const ELEM_TYPE & elem) {
+                                write_elems(new_file_ptr, &elem, 1);
+                                ++num_new_elems;
+                            };
+                            for (size_t begin_idx = 0; begin_idx < m_runs.size(); begin_idx += max_fan_in) {
+                                TRunInfo run = {num_new_elems, 0};
+                                merge_runs(begin_idx, min(begin_idx + max_fan_in, m_runs.size()), write_elem);
+                                run.m_size = num_new_elems - run.m_offset;
+                                new_runs.push_back(run);
+                            }
+                            ASSERT_CONDITION_THROW((fflush(new_file_ptr) != 0),
+                                    string("Could not write a sorted run, error: ") + strerror(errno));
+                        } catch (...) {
+                            fclose(new_file_ptr);
+                            throw;
+                        }
+
+                        //The new runs replace the merged ones
+                        fclose(m_runs_file_ptr);
+                        m_runs_file_ptr = new_file_ptr;
+                        m_runs.swap(new_runs);
+                    }
+
+                    /**
+                     * Does the k-way merge of the given sorted runs into the consumer,
+                     * the read buffers of all the runs take at most m_max_mem_elems
+                     * @param begin_idx the index of the first run to merge
+                     * @param end_idx the index of the run after the last run to merge
+                     * @param consume the consumer, is called with every element in the sorted order
+                     */
+                    template<typename TConsumer>
+                    void merge_runs(const size_t begin_idx, const size_t end_idx, TConsumer & consume) {
+                        const size_t num_runs = end_idx - begin_idx;
+                        const size_t read_elems = m_max_mem_elems / num_runs;
+
+                        LOG_DEBUG << "Merging " << num_runs << " sorted runs, reading " << read_elems
+                                << " elements per run at a time" << END_LOG;
+
+                        //Make sure the runs are in the file before reading them back
+                        ASSERT_CONDITION_THROW((fflush(m_runs_file_ptr) != 0),
+                                string("Could not write a sorted run, error: ") + strerror(errno));
+
+                        //Read the first portions of the runs
+                        vector<ELEM_TYPE> read_buffer(read_elems * num_runs);
+                        vector<TRunReader> readers(num_runs);
+                        priority_queue<S_Merge_Entry> queue;
+                        for (size_t idx = 0; idx < num_runs; ++idx) {
+                            readers[idx].m_data = &read_buffer[idx * read_elems];
+                            readers[idx].m_left = m_runs[begin_idx + idx].m_size;
+                            read_run(m_runs[begin_idx + idx], readers[idx], read_elems);
+                            if (readers[idx].m_end > 0) {
+                                S_Merge_Entry entry = {readers[idx].m_data[readers[idx].m_curr++], idx};
+                                queue.push(entry);
+                            }
+                        }
+
+                        //Merge the runs into the consumer
+                        while (!queue.empty()) {
+                            S_Merge_Entry entry = queue.top();
+                            queue.pop();
+                            consume(entry.m_elem);
+
+                            TRunReader & reader = readers[entry.m_run_idx];
+                            if ((reader.m_curr == reader.m_end) && (reader.m_left > 0)) {
+                                read_run(m_runs[begin_idx + entry.m_run_idx], reader, read_elems);
+                                Logger::update_progress_bar();
+                            }
+                            if (reader.m_curr < reader.m_end) {
+                                entry.m_elem = reader.m_data[reader.m_curr++];
+                                queue.push(entry);
+                            }
+                        }
+                    }
+                };
+            }
+        }
+    }
+}
+
+#endif	/* EXTERNALMERGESORTER_HPP */
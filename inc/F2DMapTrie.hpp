@@ -0,0 +1,269 @@
+/*
+ * File:   F2DMapTrie.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:30 PM
+ */
+
+#ifndef F2DMAPTRIE_HPP
+#define	F2DMAPTRIE_HPP
+
+#include <string>       // std::string
+
+#include "Globals.hpp"
+#include "Exceptions.hpp"
+
+#include "AWordIndex.hpp"
+#include "HashingWordIndex.hpp"
+#include "ModelMGram.hpp"
+
+#include "TextPieceReader.hpp"
+
+#include "FingerprintHashMap.hpp"
+
+#include "GenericTrieBase.hpp"
+
+using namespace std;
+
+using namespace uva::smt::logging;
+using namespace uva::smt::file;
+using namespace uva::utils::containers;
+using namespace uva::smt::tries::dictionary;
+using namespace uva::smt::tries::m_grams;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            /**
+             * This is a lossy Fingerprint to Data trie that is implemented as a HashMap.
+             * As in H2DMapTrie the m-grams are identified by their hash values only,
+             * but here we do not even store the hash values. Each level is a compact
+             * open addressing hash map storing a small key fingerprint and the payload
+             * per bucket. A query m-gram that is not in the model can thus be found,
+             * with a small probability, giving a wrong payload. This trie is meant
+             * for the cases where the memory usage matters more than rare false hits.
+             * The fingerprint width is __F2DMapTrie::FINGERPRINT_BITS.
+             * @param MAX_LEVEL - the maximum level of the considered N-gram, i.e. the N value
+             */
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            class F2DMapTrie : public GenericTrieBase<F2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __F2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> {
+            public:
+                typedef GenericTrieBase<F2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __F2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> BASE;
+                typedef typename WordIndexType::TWordIdType TWordIdType;
+
+                /**
+                 * The basic constructor
+                 * @param _wordIndex the word index to be used
+                 */
+                explicit F2DMapTrie(WordIndexType & word_index);
+
+                /**
+                 * The m-grams are stored by their hashes and every level has its own fingerprint table,
+                 * so the m-gram levels 2..N can be added concurrently.
+                 * @see GenericTrieBase
+                 */
+                static constexpr bool is_levels_independent() {
+                    return true;
+                }
+
+                /**
+                 * Allows to log the information about the instantiated trie type
+                 */
+                inline void log_trie_type_usage_info() const {
+                    LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
+                    LOG_INFO << "Using the #buckets factor: "
+                            << SSTR(__F2DMapTrie::BUCKETS_FACTOR) << END_LOG;
+                    LOG_INFO << "Using the fingerprint bits: "
+                            << SSTR((uint32_t) __F2DMapTrie::FINGERPRINT_BITS) << END_LOG;
+                }
+
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    for (TModelLevel idx = 0; idx < NUM_M_GRAM_LEVELS; ++idx) {
+                        m_m_gram_data[idx]->memory_breakdown(breakdown, idx + LEVEL_IDX_OFFSET);
+                    }
+                    m_n_gram_data->memory_breakdown(breakdown, MAX_LEVEL);
+                }
+
+                /**
+                 * This method can be used to provide the N-gram count information
+                 * That should allow for pre-allocation of the memory
+                 * @see GenericTrieBase
+                 */
+                virtual void pre_allocate(const size_t counts[MAX_LEVEL]);
+
+                /**
+                 * This method adds a M-Gram (word) to the trie where 1 < M < N
+                 * @see GenericTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
+                    //If not a uni-gram then register in the cache
+                    if (CURR_LEVEL != M_GRAM_LEVEL_1) {
+                        //Register the m-gram in the hash cache
+                        this->register_m_gram_cache(gram);
+                    }
+
+                    //Compute the M-gram level index, here we store m-grams for 1 <=m < n in one structure
+                    constexpr TModelLevel LEVEL_IDX = (CURR_LEVEL - LEVEL_IDX_OFFSET);
+
+                    //Get the hash value, the fingerprint and the bucket are computed from it
+                    const uint64_t hash_value = gram.get_hash();
+                    LOG_DEBUG << "Getting the bucket for the m-gram: " << (string) gram << " hash value: " << hash_value << END_LOG;
+
+                    if (CURR_LEVEL == MAX_LEVEL) {
+                        //Set the probability data
+                        m_n_gram_data->add_new_element(hash_value) = gram.m_payload.m_prob;
+                    } else {
+                        //Check if this is an <unk> unigram, in this case we store the payload elsewhere
+                        if ((CURR_LEVEL == M_GRAM_LEVEL_1) && gram.is_unk_unigram()) {
+                            //Store the uni-gram payload - overwrite the default values.
+                            m_unk_word_payload = gram.m_payload;
+                        } else {
+                            //Set the probability and back-off data
+                            m_m_gram_data[LEVEL_IDX]->add_new_element(hash_value) = gram.m_payload;
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==1.
+                 * The retrieval of a uni-gram data is always a success.
+                 * @see GenericTrieBase
+                 */
+                inline void get_unigram_payload(typename BASE::T_Query_Exec_Data & query) const {
+                    LOG_DEBUG << "Searching in uni-grams, array index: 0" << END_LOG;
+
+                    //By default set the unknown word value
+                    query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &m_unk_word_payload;
+
+                    //Call the templated part via function pointer
+                    (void) get_payload<TProbBackMap>(m_m_gram_data[0], query);
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for 1<m<n
+                 * @see GenericTrieBase
+                 * @param query the query containing the actual query data
+                 * @param status the resulting status of the operation
+                 */
+                inline void get_m_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    //Get the current level for logging
+                    const TModelLevel & curr_level = CURR_LEVEL_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+                    //Get the current level of the sub-m-gram
+                    const TModelLevel & layer_idx = CURR_LEVEL_MIN_1_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+
+                    LOG_DEBUG << "Searching in " << SSTR(curr_level) << "-grams, array index: " << layer_idx << END_LOG;
+
+                    //Call the templated part via function pointer
+                    status = get_payload<TProbBackMap>(m_m_gram_data[layer_idx], query);
+                }
+
+                /**
+                 * Allows to attempt the sub-m-gram payload retrieval for m==n
+                 * @see GenericTrieBase
+                 * @param query the query containing the actual query data
+                 * @param status the resulting status of the operation
+                 */
+                inline void get_n_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
+                    LOG_DEBUG << "Searching in " << SSTR(MAX_LEVEL) << "-grams" << END_LOG;
+
+                    //Call the templated part via function pointer
+                    status = get_payload<TProbMap>(m_n_gram_data, query);
+                }
+
+                /**
+                 * The basic class destructor
+                 */
+                virtual ~F2DMapTrie();
+
+            private:
+
+                //The offset, relative to the M-gram level M for the m-gram mapping array index
+                const static TModelLevel LEVEL_IDX_OFFSET = 1;
+
+                //Will store the the number of M levels such that 1 <= M < N.
+                const static TModelLevel NUM_M_GRAM_LEVELS = MAX_LEVEL - LEVEL_IDX_OFFSET;
+
+                //Stores the unknown word payload data
+                T_M_Gram_Payload m_unk_word_payload;
+
+                //This is an array of hash maps for M-Gram levels with 1 < M < N
+                typedef FingerprintHashMap<T_M_Gram_Payload, __F2DMapTrie::FINGERPRINT_BITS> TProbBackMap;
+                TProbBackMap * m_m_gram_data[NUM_M_GRAM_LEVELS];
+
+                //This is hash map pointer for the N-Gram level
+                typedef FingerprintHashMap<TLogProbBackOff, __F2DMapTrie::FINGERPRINT_BITS> TProbMap;
+                TProbMap * m_n_gram_data;
+
+                /**
+                 * Allows to log the memory usage and the expected false positive rate of the level
+                 * @param curr_level the m-gram level
+                 * @param map the level map
+                 */
+                template<typename STORAGE_MAP>
+                static inline void log_level_info(const TModelLevel curr_level, const STORAGE_MAP * map) {
+                    LOG_INFO << "The " << SSTR(curr_level) << "-grams: " << map->get_buckets_size_bytes()
+                            << " bytes, expected false positive rate: " << map->get_false_positive_rate() << END_LOG;
+                }
+
+                /**
+                 * Gets the probability for the given level M-gram, searches on specific level
+                 * @param STORAGE_MAP the level map type
+                 * @param query the query M-gram state
+                 * @return the resulting status of the operation
+                 */
+                template<typename STORAGE_MAP>
+                static inline MGramStatusEnum get_payload(const STORAGE_MAP * map,
+                        typename BASE::T_Query_Exec_Data & query) {
+                    //Get the current level for logging
+                    const TModelLevel & curr_level = CURR_LEVEL_MAP[query.m_begin_word_idx][query.m_end_word_idx];
+
+                    LOG_DEBUG << "Getting the bucket for the sub-" << SSTR(curr_level) << "-gram ["
+                            << query.m_begin_word_idx << "," << query.m_end_word_idx << "] of: " << (string) query.m_gram << END_LOG;
+
+                    const uint64_t hash_value = query.m_gram.template get_hash(query.m_begin_word_idx, query.m_end_word_idx);
+
+                    //Get the payload from the map, a missing m-gram can give a false positive here
+                    const typename STORAGE_MAP::TPayloadType * payload = map->get_element(hash_value);
+                    if (payload != NULL) {
+                        //We are now done, the payload is found, can return!
+                        query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = payload;
+                        return MGramStatusEnum::GOOD_PRESENT_MGS;
+                    } else {
+                        //Could not retrieve the payload for the given sub-m-gram
+                        LOG_DEBUG << "Unable to find the sub-m-gram [" << SSTR(query.m_begin_word_idx)
+                                << ", " << SSTR(query.m_end_word_idx) << "] payload!" << END_LOG;
+                        return MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                    }
+                }
+            };
+        }
+    }
+}
+
+
+#endif	/* F2DMAPTRIE_HPP */
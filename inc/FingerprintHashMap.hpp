@@ -0,0 +1,282 @@
+/*
+ * File:   FingerprintHashMap.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:10 PM
+ */
+
+#include <string>       // std::string
+#include <cmath>        // std::ceil std::pow
+#include <algorithm>    // std::max
+#include <type_traits>  // std::conditional
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "HashingUtils.hpp"
+#include "MemoryBreakdown.hpp"
+
+using namespace std;
+using namespace uva::smt::hashing;
+using namespace uva::smt::tries;
+
+#ifndef FINGERPRINTHASHMAP_HPP
+#define	FINGERPRINTHASHMAP_HPP
+
+namespace uva {
+    namespace utils {
+        namespace containers {
+
+            /**
+             * Allows to choose the smallest unsigned integer type that can store the fingerprint
+             * @param FINGERPRINT_BITS the number of fingerprint bits, must be within [1, 32]
+             */
+            template<uint8_t FINGERPRINT_BITS>
+            struct S_Fingerprint_Type {
+                static_assert((FINGERPRINT_BITS >= 1) && (FINGERPRINT_BITS <= 32),
+                        "The number of fingerprint bits must be within [1, 32]!");
+
+                typedef typename conditional < (FINGERPRINT_BITS <= 8), uint8_t,
+                typename conditional < (FINGERPRINT_BITS <= 16), uint16_t, uint32_t>::type >::type type;
+            };
+
+            /**
+             * This class represents a fixed size lossy hash map storing a pre-defined number of elements.
+             * It is an open addressing linear probing hash map, the buckets store the elements directly.
+             * Unlike in FixedSizeHashMap the keys are not stored, each bucket only keeps a small key
+             * fingerprint next to the payload. Therefore a key that has never been added can be reported
+             * as present, if one of the probed buckets has the same fingerprint, i.e. we get a false
+             * positive, this is the price for the reduced memory usage, see also KenLM's probing hash
+             * tables or RandLM. The number of buckets is not rounded to the power of two, the buckets
+             * factor thus directly defines the load factor of the map.
+             *
+             * @param PAYLOAD_TYPE the payload type stored with each fingerprint
+             * @param FINGERPRINT_BITS the number of bits in the fingerprint, within [1, 32]
+             */
+            template<typename PAYLOAD_TYPE, uint8_t FINGERPRINT_BITS>
+            class FingerprintHashMap {
+            public:
+                typedef PAYLOAD_TYPE TPayloadType;
+
+                //The fingerprint type
+                typedef typename S_Fingerprint_Type<FINGERPRINT_BITS>::type TFingerprint;
+
+                //Stores the fingerprint of an empty bucket
+                static constexpr TFingerprint NO_FINGERPRINT = 0;
+
+                /**
+                 * The basic constructor that allows to instantiate the map for the given number of elements
+                 * @param buckets_factor the buckets factor, the number of buckets will be this value times
+                 * the number of elements, must be larger than 1.0 to have empty buckets.
+                 * @param num_elems the number of elements that will be stored in the map
+                 */
+                explicit FingerprintHashMap(const double buckets_factor, const uint_fast64_t num_elems)
+                : m_num_elems(0), m_max_num_elems(num_elems) {
+                    //Compute and set the number of buckets
+                    set_number_of_buckets(buckets_factor, num_elems);
+                    //Allocate the buckets and mark them all as empty
+                    m_buckets = new S_Bucket[m_num_buckets];
+                    for (uint_fast64_t idx = 0; idx < m_num_buckets; ++idx) {
+                        m_buckets[idx].m_fingerprint = NO_FINGERPRINT;
+                    }
+                }
+
+                //The map owns its buckets, so copying it would free the buckets twice
+                FingerprintHashMap(const FingerprintHashMap &) = delete;
+                FingerprintHashMap & operator=(const FingerprintHashMap &) = delete;
+
+                /**
+                 * Allows to add a new element for the given hash value
+                 * @param key_value the key (hash) value of the element
+                 * @return the reference to the new element's payload
+                 */
+                PAYLOAD_TYPE & add_new_element(const uint_fast64_t key_value) {
+                    //Check if the capacity is exceeded.
+                    ASSERT_CONDITION_THROW((m_num_elems >= m_max_num_elems), string("Used up all the elements, ") +
+                            string("the map capacity is: ") + std::to_string(m_max_num_elems));
+
+                    uint_fast64_t bucket_idx;
+                    const TFingerprint fingerprint = get_fingerprint(key_value, bucket_idx);
+
+                    //Search for the first empty bucket
+                    while (m_buckets[bucket_idx].m_fingerprint != NO_FINGERPRINT) {
+                        get_next_bucket_idx(bucket_idx);
+                    }
+
+                    LOG_DEBUG2 << "The first empty bucket index is: " << bucket_idx
+                            << " for the hash value: " << key_value << END_LOG;
+
+                    ++m_num_elems;
+                    m_buckets[bucket_idx].m_fingerprint = fingerprint;
+                    return m_buckets[bucket_idx].m_payload;
+                }
+
+                /**
+                 * Allows to retrieve the element's payload for the given hash value,
+                 * if the hash value was not added then the result can be a false positive
+                 * @param key_value the key (hash) value of the element
+                 * @return the pointer to the found payload or NULL if nothing is found
+                 */
+                inline const PAYLOAD_TYPE * get_element(const uint_fast64_t key_value) const {
+                    uint_fast64_t bucket_idx;
+                    const TFingerprint fingerprint = get_fingerprint(key_value, bucket_idx);
+
+                    LOG_DEBUG2 << "Got bucket_idx: " << bucket_idx << " for hash value: " << key_value << END_LOG;
+
+                    //Search until the first empty bucket
+                    while (m_buckets[bucket_idx].m_fingerprint != NO_FINGERPRINT) {
+                        if (m_buckets[bucket_idx].m_fingerprint == fingerprint) {
+                            return &m_buckets[bucket_idx].m_payload;
+                        }
+                        get_next_bucket_idx(bucket_idx);
+                    }
+
+                    LOG_DEBUG2 << "Encountered an empty bucket, the element is unknown!" << END_LOG;
+
+                    return NULL;
+                }
+
+                /**
+                 * Allows to get the expected false positive rate of looking up a key that was not
+                 * added, when the map is filled with the number of elements given to the constructor.
+                 * A miss in a linear probing hash map with the load factor A is expected to look
+                 * through (1 + 1/(1-A)^2)/2 buckets, see Knuth, the last of which is empty. The
+                 * fingerprints are not uniform: the zero fingerprint is replaced by one, so for
+                 * N = 2^FINGERPRINT_BITS the fingerprint one has the probability 2/N and the others
+                 * 1/N. Therefore every non-empty bucket has the same fingerprint as the looked up key
+                 * with the probability (2/N)^2 + (N-2)/N^2 = (N+2)/N^2, not 1/(N-1).
+                 * @return the expected false positive rate
+                 */
+                inline double get_false_positive_rate() const {
+                    const double load = ((double) m_max_num_elems) / ((double) m_num_buckets);
+                    const double num_probes = (1.0 + 1.0 / ((1.0 - load) * (1.0 - load))) / 2.0;
+                    const double num_fingerprints = pow(2.0, FINGERPRINT_BITS);
+                    return (num_probes - 1.0) * (num_fingerprints + 2.0) / (num_fingerprints * num_fingerprints);
+                }
+
+                /**
+                 * Allows to get the number of bytes allocated for the buckets
+                 * @return the number of bytes allocated for the buckets
+                 */
+                inline size_t get_buckets_size_bytes() const {
+                    return m_num_buckets * sizeof (S_Bucket);
+                }
+
+                /**
+                 * Allows to add the map memory usage into the memory breakdown
+                 * @param breakdown the memory breakdown to add to
+                 * @param level the m-gram level of the stored elements
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown, const TModelLevel level) const {
+                    breakdown.add("FingerprintHashMap", "buckets", level, get_buckets_size_bytes());
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                ~FingerprintHashMap() {
+                    delete[] m_buckets;
+                }
+
+            private:
+
+#pragma pack(push, 1) // exact fit - no padding
+
+                /**
+                 * The bucket structure stores the key fingerprint and the payload
+                 */
+                typedef struct {
+                    TFingerprint m_fingerprint;
+                    PAYLOAD_TYPE m_payload;
+                } S_Bucket;
+#pragma pack(pop) //back to whatever the previous packing mode was
+
+                //Stores the number of buckets
+                uint_fast64_t m_num_buckets;
+                //Stores the current number of stored elements
+                uint_fast64_t m_num_elems;
+                //Stores the maximum number of stored elements
+                const uint_fast64_t m_max_num_elems;
+                //Stores the buckets
+                S_Bucket * m_buckets;
+
+                /**
+                 * Sets the number of buckets based on the number of elements
+                 * @param buckets_factor the buckets factor that the number of elements will be
+                 * multiplied with before converting it into the number of buckets.
+                 * @param num_elems the number of elements to compute the buckets for
+                 */
+                inline void set_number_of_buckets(const double buckets_factor, const uint_fast64_t num_elems) {
+                    //Do a compulsory assert on the buckets factor
+                    ASSERT_CONDITION_THROW((buckets_factor <= 1.0), string("buckets_factor: ") +
+                            std::to_string(buckets_factor) + string(", must be > 1.0"));
+
+                    //Compute the number of buckets, there is always at least one empty bucket
+                    m_num_buckets = max((uint_fast64_t) ceil(buckets_factor * num_elems), num_elems + 1);
+
+                    //The bucket index is computed from the lower 32 bits of the mixed hash
+                    ASSERT_CONDITION_THROW((m_num_buckets > UINT32_MAX), string("Too many buckets: ") +
+                            std::to_string(m_num_buckets) + string(", at most ") + std::to_string(UINT32_MAX));
+
+                    LOG_DEBUG << "FPHM: num_elems: " << num_elems << ", m_num_buckets: " << m_num_buckets << END_LOG;
+                }
+
+                /**
+                 * Allows to get the fingerprint and the bucket index for the given hash value.
+                 * The bucket index is computed from the lower 32 bits of the mixed hash
+                 * using multiplication instead of modulo, the fingerprint is taken from the
+                 * upper bits of the mixed hash. The zero fingerprint marks an empty bucket,
+                 * so it is replaced by one.
+                 * @param key_value the key value to compute the fingerprint for
+                 * @param bucket_idx [out] the resulting bucket index
+                 * @return the fingerprint
+                 */
+                inline TFingerprint get_fingerprint(uint_fast64_t key_value, uint_fast64_t & bucket_idx) const {
+                    const uint_fast64_t mixed = mix_fasthash(key_value);
+
+                    bucket_idx = ((mixed & UINT32_MAX) * m_num_buckets) >> 32;
+
+                    const TFingerprint fingerprint = (TFingerprint) (mixed >> (64 - FINGERPRINT_BITS));
+
+                    LOG_DEBUG3 << "The mixed key value is: " << mixed << ", bucket_idx: " << SSTR(bucket_idx)
+                            << ", fingerprint: " << SSTR(fingerprint) << END_LOG;
+
+                    return (fingerprint == NO_FINGERPRINT) ? 1 : fingerprint;
+                }
+
+                /**
+                 * Provides the next bucket index
+                 * @param bucket_idx [in/out] the bucket index
+                 */
+                inline void get_next_bucket_idx(uint_fast64_t & bucket_idx) const {
+                    if (++bucket_idx == m_num_buckets) {
+                        bucket_idx = 0;
+                    }
+                }
+            };
+
+            template<typename PAYLOAD_TYPE, uint8_t FINGERPRINT_BITS>
+            constexpr typename FingerprintHashMap<PAYLOAD_TYPE, FINGERPRINT_BITS>::TFingerprint FingerprintHashMap<PAYLOAD_TYPE, FINGERPRINT_BITS>::NO_FINGERPRINT;
+        }
+    }
+}
+
+#endif	/* FINGERPRINTHASHMAP_HPP */
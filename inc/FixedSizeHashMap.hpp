@@ -31,9 +31,11 @@
 #include "Logger.hpp"
 #include "Exceptions.hpp"
 #include "ArrayUtils.hpp"
+#include "MemoryBreakdown.hpp"
 
 using namespace std;
 using namespace uva::smt::utils::array;
+using namespace uva::smt::tries;
 
 #ifndef FIXEDSIZEHASHMAP_HPP
 #define	FIXEDSIZEHASHMAP_HPP
@@ -119,6 +121,55 @@ namespace uva {
                     return m_elems[elem_idx];
                 }
 
+                /**
+                 * Allows to add a new element for the given hash value, this method may be called
+                 * from several threads at once. The element index is taken with an atomic fetch-add
+                 * and the first empty bucket is claimed with a compare-and-swap, so the buckets
+                 * taken by the other threads are just skipped over, as in add_new_element.
+                 * 
+                 * The atomic operations are relaxed: the element is only written by the calling
+                 * thread and the map may only be queried once all the inserting threads are joined.
+                 * The join makes all the bucket and element writes visible to the querying threads.
+                 * 
+                 * WARNING: Is not to be mixed with concurrent add_new_element or get_element calls!
+                 * 
+                 * @param key_value the key value of the element
+                 * @return the reference to the new element
+                 */
+                ELEMENT_TYPE & add_new_element_concurrent(const uint_fast64_t key_value) {
+                    //Get the element index and increment
+                    const IDX_TYPE elem_idx = __atomic_fetch_add(&m_next_elem_idx, 1, __ATOMIC_RELAXED);
+
+                    //Check if the capacity is exceeded.
+                    if (elem_idx > MAX_ELEMENT_INDEX) {
+                        THROW_EXCEPTION(string("Used up all the elements, the last ") +
+                                string("issued id was: ") + std::to_string(elem_idx));
+                    }
+
+                    //Get the bucket index from the hash
+                    uint_fast64_t bucket_idx = get_bucket_idx(key_value);
+
+                    LOG_DEBUG2 << "---------------->Got bucket_idx: " << bucket_idx
+                            << " for hash value: " << key_value << END_LOG;
+
+                    //Claim the first empty bucket, the full buckets are not tried to be swapped
+                    IDX_TYPE empty_idx = NO_ELEMENT_INDEX;
+                    while ((__atomic_load_n(&m_buckets[bucket_idx], __ATOMIC_RELAXED) != NO_ELEMENT_INDEX) ||
+                            !__atomic_compare_exchange_n(&m_buckets[bucket_idx], &empty_idx, elem_idx,
+                            false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                        LOG_DEBUG2 << "The bucket: " << bucket_idx <<
+                                " is full, skipping to the next." << END_LOG;
+                        empty_idx = NO_ELEMENT_INDEX;
+                        get_next_bucket_idx(bucket_idx);
+                    }
+
+                    LOG_DEBUG2 << "<----------------The claimed empty bucket index is: "
+                            << bucket_idx << END_LOG;
+
+                    //Return the element under the index
+                    return m_elems[elem_idx];
+                }
+
                 /**
                  * Allows to retrieve the element for the given hash value and key
                  * @param key_value the key value of the element
@@ -149,6 +200,17 @@ namespace uva {
                     return NULL;
                 }
 
+                /**
+                 * Allows to add the map memory usage into the memory breakdown, the
+                 * memory allocated by the elements themselves is not accounted for
+                 * @param breakdown the memory breakdown to add to
+                 * @param level the m-gram level of the stored elements
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown, const TModelLevel level) const {
+                    breakdown.add("FixedSizeHashMap", "buckets", level, m_num_buckets * sizeof (IDX_TYPE));
+                    breakdown.add("FixedSizeHashMap", "elements", level, (MAX_ELEMENT_INDEX + 1) * sizeof (ELEMENT_TYPE));
+                }
+
                 /**
                  * The basic destructor
                  */
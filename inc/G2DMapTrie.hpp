@@ -62,8 +62,10 @@ namespace uva {
                 /**
                  * This template structure is used for storing trie hash map elements
                  * Each element contains and id of the m-gram and its payload -
-                 * the probability/back-off data, the latter is the template parameter
-                 * @param id stores the M-gram id
+                 * the probability/back-off data, the latter is the template parameter.
+                 * The id itself is stored in the level's Byte_M_Gram_Id_Arena, the
+                 * element only keeps its offset, the arena is given with the key.
+                 * @param id stores the M-gram id offset
                  * @param payload stores the payload which is either probability or probability with back-off
                  */
                 template<typename TPayloadType, typename TWordIdType, TModelLevel MAX_LEVEL>
@@ -73,15 +75,15 @@ namespace uva {
                     //The self typedef
                     typedef S_M_GramData<TPayloadType, TWordIdType, MAX_LEVEL> SELF;
 
-                    //The m-gram id pointer
-                    TM_Gram_Id_Value_Ptr m_id;
+                    //The m-gram id offset in the id arena
+                    TM_Gram_Id_Offset m_id;
                     //The m-gram payload
                     TPayloadType m_payload;
 
                     /**
                      * The basic constructor
                      */
-                    S_M_GramData() : m_id(NULL) {
+                    S_M_GramData() : m_id(0) {
                     }
 
                     /**
@@ -90,25 +92,157 @@ namespace uva {
                      * @return true if the ids are equal, otherwise false
                      */
                     inline bool operator==(const T_Gram_Id_Key & key) const {
-                        return (TM_Gram_Id::compare(key.m_len_bytes, key.m_id, m_id) == 0);
+                        return (TM_Gram_Id::compare(key.m_len_bytes, key.m_id, key.m_arena + m_id) == 0);
                     }
 
                     /**
-                     * Allows to clear the data allocated for the given element
+                     * Allows to clear the data allocated for the given element,
+                     * the ids are owned by the arena so there is nothing to clear
                      * @param elem the element to clear
                      */
                     static inline void clear(SELF & elem) {
-                        if (elem.m_id != NULL) {
-                            m_gram_id::destroy(elem.m_id);
-                        }
                     }
                 };
 
 #pragma pack(pop) //back to whatever the previous packing mode was 
+
+                /**
+                 * Allows to add the m-gram id of the given m-gram into the id arena
+                 * @param CURR_LEVEL the level of the m-gram
+                 * @param gram the m-gram to add the id for
+                 * @param ids the id arena of the m-gram level
+                 * @return the offset of the added id in the arena
+                 */
+                template<TModelLevel CURR_LEVEL, typename TModelMGram>
+                inline TM_Gram_Id_Offset add_m_gram_id(const TModelMGram & gram, Byte_M_Gram_Id_Arena & ids) {
+                    TM_Gram_Id_Value_Ptr id = ids.get_free_ptr(TModelMGram::T_M_Gram_Id::MAX_ID_LEN_BYTES[CURR_LEVEL]);
+                    return ids.commit(gram.compute_m_gram_id(gram.get_begin_word_idx(), CURR_LEVEL, id));
+                }
+
+                /**
+                 * This class stores an m-gram level as a hash map of the m-gram ids, the ids
+                 * themselves are stored in the level's id arena. The levels do not depend on
+                 * each other, no context ids are needed, so they can be added concurrently.
+                 * It is used by the tries storing such levels.
+                 * @param TPayloadType the payload type, the probability with or without the back-off
+                 * @param TWordIdType the word id type
+                 * @param MAX_LEVEL the maximum level of the trie
+                 */
+                template<typename TPayloadType, typename TWordIdType, TModelLevel MAX_LEVEL>
+                class G2DMapLevel {
+                public:
+                    //The hash map element type
+                    typedef S_M_GramData<TPayloadType, TWordIdType, MAX_LEVEL> TElemType;
+                    //The hash map type
+                    typedef FixedSizeHashMap<TElemType, T_Gram_Id_Key> TMap;
+
+                    /**
+                     * The basic constructor, the level is to be allocated before use
+                     */
+                    G2DMapLevel() : m_level(0), m_map(NULL) {
+                    }
+
+                    /**
+                     * Allocates the level's hash map and reserves its id arena
+                     * @param buckets_factor the hash map buckets factor
+                     * @param level the m-gram level
+                     * @param num_m_grams the number of m-grams
+                     * @param max_word_id the maximum word id
+                     */
+                    inline void allocate(const double buckets_factor, const TModelLevel level,
+                            const size_t num_m_grams, const TShortId max_word_id) {
+                        m_level = level;
+                        m_map = new TMap(buckets_factor, num_m_grams);
+                        m_ids.reserve(num_m_grams, Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::get_max_id_len_bytes(level, max_word_id));
+                    }
+
+                    /**
+                     * Adds the m-gram to the level
+                     * @param CURR_LEVEL the level of the m-gram
+                     * @param gram the m-gram to add
+                     * @param payload the m-gram payload
+                     */
+                    template<TModelLevel CURR_LEVEL, typename TModelMGram>
+                    inline void add_m_gram(const TModelMGram & gram, const TPayloadType & payload) {
+                        //Create a new M-Gram data entry
+                        TElemType & data = m_map->add_new_element(gram.get_hash());
+                        //Create the M-gram id from the word ids
+                        data.m_id = add_m_gram_id<CURR_LEVEL>(gram, m_ids);
+                        //Set the payload
+                        data.m_payload = payload;
+                    }
+
+                    /**
+                     * Gets the payload of the sub-m-gram of the query
+                     * @param query the query object
+                     * @return the resulting status of the operation
+                     */
+                    template<typename TQueryExecData>
+                    inline MGramStatusEnum get_payload(TQueryExecData & query) const {
+                        LOG_DEBUG << "Getting the bucket id for the sub-" << std::to_string(m_level) << "-gram ["
+                                << query.m_begin_word_idx << "," << query.m_end_word_idx << "] of: " << (string) query.m_gram << END_LOG;
+
+                        //Obtain the m-gram key
+                        T_Gram_Id_Key key;
+                        key.m_id = query.m_gram.get_m_gram_id_ref(query.m_begin_word_idx, m_level, key.m_len_bytes);
+                        key.m_arena = m_ids.data();
+
+                        //Get the element from the map
+                        const TElemType * elem = m_map->get_element(query.m_gram.get_hash(query.m_begin_word_idx, query.m_end_word_idx), key);
+                        if (elem != NULL) {
+                            //We are now done, the payload is found, can return!
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &elem->m_payload;
+                            return MGramStatusEnum::GOOD_PRESENT_MGS;
+                        } else {
+                            //Could not retrieve the payload for the given sub-m-gram
+                            LOG_DEBUG << "Unable to find the sub-m-gram [" << SSTR(query.m_begin_word_idx)
+                                    << ", " << SSTR(query.m_end_word_idx) << "] payload!" << END_LOG;
+                            return MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
+                        }
+                    }
+
+                    /**
+                     * Frees the reserved but unused id arena memory, is to be called after all the m-grams are added
+                     */
+                    inline void post_m_grams() {
+                        m_ids.shrink();
+                        LOG_DEBUG << "The " << std::to_string(m_level) << "-gram ids take " << m_ids.size() << " bytes" << END_LOG;
+                    }
+
+                    /**
+                     * Allows to add the level memory usage into the memory breakdown
+                     * @param trie_name the name of the trie storing the level
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(const char * trie_name, MemoryBreakdown & breakdown) const {
+                        m_map->memory_breakdown(breakdown, m_level);
+                        breakdown.add(trie_name, "keys", m_level, m_ids.capacity());
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~G2DMapLevel() {
+                        delete m_map;
+                    }
+
+                private:
+                    //Stores the m-gram level
+                    TModelLevel m_level;
+                    //Stores the m-gram hash map
+                    TMap * m_map;
+                    //Stores the m-gram id arena
+                    Byte_M_Gram_Id_Arena m_ids;
+
+                    //The level owns its map, so copying it would free it twice
+                    G2DMapLevel(const G2DMapLevel &) = delete;
+                    G2DMapLevel & operator=(const G2DMapLevel &) = delete;
+                };
             }
 
             /**
              * This is a Gram to Data trie that is implemented as a HashMap.
+             * The m-gram levels are stored in G2DMapLevel.
              * @param MAX_LEVEL - the maximum level of the considered N-gram, i.e. the N value
              */
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -116,8 +250,8 @@ namespace uva {
             public:
                 typedef GenericTrieBase<G2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __G2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR> BASE;
                 typedef typename WordIndexType::TWordIdType TWordIdType;
-                typedef __G2DMapTrie::S_M_GramData<T_M_Gram_Payload, TWordIdType, MAX_LEVEL> T_M_Gram_PB_Entry;
-                typedef __G2DMapTrie::S_M_GramData<TLogProbBackOff, TWordIdType, MAX_LEVEL> T_M_Gram_Prob_Entry;
+                typedef __G2DMapTrie::G2DMapLevel<T_M_Gram_Payload, TWordIdType, MAX_LEVEL> TProbBackLevel;
+                typedef __G2DMapTrie::G2DMapLevel<TLogProbBackOff, TWordIdType, MAX_LEVEL> TProbLevel;
 
                 /**
                  * The basic constructor
@@ -125,6 +259,15 @@ namespace uva {
                  */
                 explicit G2DMapTrie(WordIndexType & word_index);
 
+                /**
+                 * The m-grams are stored by their hashes and every level has its own hash map and m-gram id arena,
+                 * so the m-gram levels 2..N can be added concurrently.
+                 * @see GenericTrieBase
+                 */
+                static constexpr bool is_levels_independent() {
+                    return true;
+                }
+
                 /**
                  * Allows to log the information about the instantiated trie type
                  */
@@ -134,6 +277,19 @@ namespace uva {
                             << SSTR(__G2DMapTrie::BUCKETS_FACTOR) << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    breakdown.add("G2DMapTrie", "payloads", M_GRAM_LEVEL_1, BASE::get_num_word_ids() * sizeof (T_M_Gram_Payload));
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                        m_m_gram_levels[idx].memory_breakdown("G2DMapTrie", breakdown);
+                    }
+                    m_n_gram_level.memory_breakdown("G2DMapTrie", breakdown);
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -141,12 +297,44 @@ namespace uva {
                  */
                 virtual void pre_allocate(const size_t counts[MAX_LEVEL]);
 
+                /**
+                 * This method allows to check if post processing should be called after
+                 * all the X level grams are read. This method is virtual.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel level>
+                bool is_post_grams() const {
+                    //The m-gram id arenas are to be shrunk after reading
+                    return (level > M_GRAM_LEVEL_1) || BASE::template is_post_grams<level>();
+                };
+
+                /**
+                 * This method should be called after all the X level grams are read.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void post_grams() {
+                    //Call the base class method first
+                    if (BASE::template is_post_grams<CURR_LEVEL>()) {
+                        BASE::template post_grams<CURR_LEVEL>();
+                    }
+
+                    //Free the reserved but unused id arena memory
+                    if (CURR_LEVEL == MAX_LEVEL) {
+                        m_n_gram_level.post_m_grams();
+                    } else {
+                        if (CURR_LEVEL > M_GRAM_LEVEL_1) {
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].post_m_grams();
+                        }
+                    }
+                };
+
                 /**
                  * This method adds a M-Gram (word) to the trie where 1 < M < N
                  * @see GenericTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Get the word id of this unigram, so there is just one word in it and its the end one
                         const TShortId word_id = gram.get_end_word_id();
@@ -157,21 +345,11 @@ namespace uva {
                         this->register_m_gram_cache(gram);
 
                         if (CURR_LEVEL == MAX_LEVEL) {
-                            //Create a new M-Gram data entry
-                            T_M_Gram_Prob_Entry & data = m_n_gram_data->add_new_element(gram.get_hash());
-                            //Create the N-gram id from the word ids
-                            gram.create_m_gram_id(gram.get_begin_word_idx(), CURR_LEVEL, data.m_id);
-                            //Set the probability data
-                            data.m_payload = gram.m_payload.m_prob;
+                            //Add the N-gram with its probability data
+                            m_n_gram_level.template add_m_gram<CURR_LEVEL>(gram, gram.m_payload.m_prob);
                         } else {
-                            //Compute the M-gram level index
-                            constexpr TModelLevel LEVEL_IDX = (CURR_LEVEL - BASE::MGRAM_IDX_OFFSET);
-                            //Create a new M-Gram data entry
-                            T_M_Gram_PB_Entry & data = m_m_gram_data[LEVEL_IDX]->add_new_element(gram.get_hash());
-                            //Create the M-gram id from the word ids.
-                            gram.create_m_gram_id(gram.get_begin_word_idx(), CURR_LEVEL, data.m_id);
-                            //Set the probability and back-off data
-                            data.m_payload = gram.m_payload;
+                            //Add the M-gram with its probability and back-off data
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].template add_m_gram<CURR_LEVEL>(gram, gram.m_payload);
                         }
                     }
                 }
@@ -199,16 +377,12 @@ namespace uva {
                  * @param status the resulting status of the operation
                  */
                 inline void get_m_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
-                    //Get the current level for logging
-                    const TModelLevel & curr_level = CURR_LEVEL_MAP[query.m_begin_word_idx][query.m_end_word_idx];
-
                     //Get the current level of the sub-m-gram
                     const TModelLevel & layer_idx = CURR_LEVEL_MIN_2_MAP[query.m_begin_word_idx][query.m_end_word_idx];
 
-                    LOG_DEBUG << "Searching in " << SSTR(curr_level) << "-grams, array index: " << layer_idx << END_LOG;
+                    LOG_DEBUG << "Searching in the m-grams, array index: " << layer_idx << END_LOG;
 
-                    //Call the templated part via function pointer
-                    status = get_payload<TProbBackMap>(m_m_gram_data[layer_idx], query);
+                    status = m_m_gram_levels[layer_idx].get_payload(query);
                 }
 
                 /**
@@ -220,8 +394,7 @@ namespace uva {
                 inline void get_n_gram_payload(typename BASE::T_Query_Exec_Data & query, MGramStatusEnum & status) const {
                     LOG_DEBUG << "Searching in " << SSTR(MAX_LEVEL) << "-grams" << END_LOG;
 
-                    //Call the templated part via function pointer
-                    status = get_payload<TProbMap>(m_n_gram_data, query);
+                    status = m_n_gram_level.get_payload(query);
                 }
 
                 /**
@@ -234,63 +407,14 @@ namespace uva {
                 //Stores the 1-gram data
                 T_M_Gram_Payload * m_1_gram_data;
 
-                //This is an array of hash maps for M-Gram levels with 1 < M < N
-                typedef FixedSizeHashMap<T_M_Gram_PB_Entry, T_Gram_Id_Key> TProbBackMap;
-                TProbBackMap * m_m_gram_data[BASE::NUM_M_GRAM_LEVELS];
-
-                //This is hash map pointer for the N-Gram level
-                typedef FixedSizeHashMap<T_M_Gram_Prob_Entry, T_Gram_Id_Key> TProbMap;
-                TProbMap * m_n_gram_data;
-
-                /**
-                 * Gets the probability for the given level M-gram, searches on specific level
-                 * @param map the map storing the elements
-                 * @param query the query object
-                 * @return the resulting status of the operation
-                 */
-                template<typename STORAGE_MAP>
-                static inline MGramStatusEnum get_payload(const STORAGE_MAP * map,
-                        typename BASE::T_Query_Exec_Data & query) {
-                    //Get the current level for logging
-                    const TModelLevel & curr_level = CURR_LEVEL_MAP[query.m_begin_word_idx][query.m_end_word_idx];
-
-                    LOG_DEBUG << "Getting the bucket id for the sub-" << SSTR(curr_level) << "-gram ["
-                            << query.m_begin_word_idx << "," << query.m_end_word_idx << "] of: " << (string) query.m_gram << END_LOG;
-
-                    //Obtain the m-gram key
-                    T_Gram_Id_Key key;
-                    key.m_id = query.m_gram.get_m_gram_id_ref(query.m_begin_word_idx, curr_level, key.m_len_bytes);
-
-                    //Get the hash value
-                    const uint64_t hash_value = query.m_gram.get_hash(query.m_begin_word_idx, query.m_end_word_idx);
-
-                    LOG_DEBUG << "Retrieving payload for a sub-" << SSTR(curr_level) << "-gram ["
-                            << SSTR(query.m_begin_word_idx) << ", " << SSTR(query.m_end_word_idx) << "]" << END_LOG;
-
-                    //Get the element from the map
-                    const typename STORAGE_MAP::TElemType * elem = map->get_element(hash_value, key);
-                    if (elem != NULL) {
-                        //We are now done, the payload is found, can return!
-                        query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &elem->m_payload;
-                        return MGramStatusEnum::GOOD_PRESENT_MGS;
-                    } else {
-                        //Could not retrieve the payload for the given sub-m-gram
-                        LOG_DEBUG << "Unable to find the sub-m-gram [" << SSTR(query.m_begin_word_idx)
-                                << ", " << SSTR(query.m_end_word_idx) << "] payload!" << END_LOG;
-                        return MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
-                    }
-                }
+                //Stores the M-Gram levels with 1 < M < N
+                TProbBackLevel m_m_gram_levels[BASE::NUM_M_GRAM_LEVELS];
+                //Stores the N-Gram level
+                TProbLevel m_n_gram_level;
             };
-
-            typedef G2DMapTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TG2DMapTrieBasic;
-            typedef G2DMapTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TG2DMapTrieCount;
-            typedef G2DMapTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TG2DMapTrieOptBasic;
-            typedef G2DMapTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TG2DMapTrieOptCount;
-            typedef G2DMapTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TG2DMapTrieHashing;
         }
     }
 }
 
 
 #endif	/* G2DHASHMAPTRIE_HPP */
-
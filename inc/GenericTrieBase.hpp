@@ -98,6 +98,9 @@ namespace uva {
                 typedef WordIndexTrieBase<MAX_LEVEL, WordIndexType> BASE;
                 //The flag indicating if the bitmap hash caching is needed
                 const static bool NEEDS_BITMAP_HASH_CACHE = (BITMAP_HASH_CACHE_BUCKETS_FACTOR > 1);
+                //Typedef the model and query m-gram types, their capacity is the trie's maximum level
+                typedef T_Model_M_Gram<WordIndexType, MAX_LEVEL> TModelMGram;
+                typedef T_Query_M_Gram<WordIndexType, MAX_LEVEL> TQueryMGram;
 
                 /**
                  * This structure stores the basic data required for a query execution.
@@ -109,7 +112,7 @@ namespace uva {
                  * @param m_end_word_idx the currently considered end word index
                  */
                 struct S_Query_Exec_Data {
-                    T_Query_M_Gram<WordIndexType> m_gram;
+                    TQueryMGram m_gram;
                     const void * m_payloads[MAX_LEVEL][MAX_LEVEL];
                     TLongId m_last_ctx_ids[MAX_LEVEL];
                     TLogProbBackOff m_probs[MAX_LEVEL];
@@ -144,7 +147,8 @@ namespace uva {
                  * @param word_index the word index to be used
                  */
                 explicit GenericTrieBase(WordIndexType & word_index)
-                : WordIndexTrieBase<MAX_LEVEL, WordIndexType> (word_index) {
+                : WordIndexTrieBase<MAX_LEVEL, WordIndexType> (word_index), m_is_presorted(false), m_build_mem_limit(0),
+                m_is_parallel_build(false) {
                     ASSERT_CONDITION_THROW((MAX_LEVEL> MAX_SUPP_GRAM_LEVEL), string("Unsupported max level: ") + 
                             std::to_string(MAX_LEVEL) + string(", the maximum supported is: ") + std::to_string(MAX_SUPP_GRAM_LEVEL));
                 }
@@ -157,6 +161,83 @@ namespace uva {
                     return false;
                 }
 
+                /**
+                 * Allows to indicate whether the m-gram levels 2..N do not depend on each
+                 * other, i.e. the m-grams of these levels can be added in any level order
+                 * and the m-grams of different levels can be added concurrently.
+                 * @return returns false, by default the m-gram levels are added one by one
+                 */
+                static constexpr bool is_levels_independent() {
+                    return false;
+                }
+
+                /**
+                 * Allows to indicate whether the m-grams of one level can be added
+                 * by several threads at once, i.e. the level sections can be split
+                 * into chunks read concurrently. Requires is_levels_independent().
+                 * @return returns false, by default one level is added by one thread
+                 */
+                static constexpr bool is_level_concurrent() {
+                    return false;
+                }
+
+                /**
+                 * Allows to indicate that the m-grams of every level will be added
+                 * sorted by their word ids, i.e. by the context and then by the last
+                 * word id. The tries storing sorted arrays can then build them in their
+                 * final layout without sorting, the other tries ignore this hint.
+                 * Must be called before pre_allocate.
+                 * @param is_presorted true if the m-grams are added pre-sorted
+                 */
+                inline void set_presorted(const bool is_presorted) {
+                    m_is_presorted = is_presorted;
+                }
+
+                /**
+                 * Allows to check if the m-grams are to be added pre-sorted
+                 * @return true if the m-grams are to be added pre-sorted
+                 */
+                inline bool is_presorted() const {
+                    return m_is_presorted;
+                }
+
+                /**
+                 * Allows to set the memory limit for the sorting done while building
+                 * the trie. The tries storing large sorted arrays can then sort the
+                 * exceeding data on the disk, the other tries ignore this hint.
+                 * Must be called before pre_allocate.
+                 * @param mem_limit the memory limit in bytes, zero means no limit
+                 */
+                inline void set_build_mem_limit(const size_t mem_limit) {
+                    m_build_mem_limit = mem_limit;
+                }
+
+                /**
+                 * Allows to get the memory limit for the sorting done while building the trie
+                 * @return the memory limit in bytes, zero means no limit
+                 */
+                inline size_t get_build_mem_limit() const {
+                    return m_build_mem_limit;
+                }
+
+                /**
+                 * Allows to request the m-gram levels 2..N to be read in parallel,
+                 * this is only done for the tries with independent m-gram levels.
+                 * @see is_levels_independent
+                 * @param is_parallel_build true if the levels are to be read in parallel
+                 */
+                inline void set_parallel_build(const bool is_parallel_build) {
+                    m_is_parallel_build = is_parallel_build;
+                }
+
+                /**
+                 * Allows to check if the m-gram levels 2..N are to be read in parallel
+                 * @return true if the levels are to be read in parallel
+                 */
+                inline bool is_parallel_build() const {
+                    return m_is_parallel_build;
+                }
+
                 /**
                  * @see WordIndexTrieBase
                  */
@@ -172,13 +253,27 @@ namespace uva {
                     }
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 * Adds the bitmap hash caches, if any
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    if (NEEDS_BITMAP_HASH_CACHE) {
+                        for (size_t idx = 0; idx < NUM_M_N_GRAM_LEVELS; ++idx) {
+                            m_bitmap_hash_cach[idx].memory_breakdown(breakdown, idx + MGRAM_IDX_OFFSET);
+                        }
+                    }
+                }
+
                 /**
                  * This method adds a M-Gram (word) to the trie where 1 < M < N
                  * @param gram the M-Gram data
                  * @throws Exception if the level of this M-gram is not such that  1 < M < N
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     THROW_MUST_OVERRIDE();
                 };
 
@@ -346,11 +441,15 @@ namespace uva {
                  * 
                  * @param gram the M-gram to cache
                  */
-                inline void register_m_gram_cache(const T_Model_M_Gram<WordIndexType> &gram) {
+                inline void register_m_gram_cache(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> &gram) {
                     if (NEEDS_BITMAP_HASH_CACHE) {
                         const TModelLevel curr_level = gram.get_m_gram_level();
                         ASSERT_SANITY_THROW((curr_level == M_GRAM_LEVEL_1), "Trying to add a uni-gram to a bitmap hash cache!");
-                        m_bitmap_hash_cach[curr_level - MGRAM_IDX_OFFSET].template cache_m_gram_hash<WordIndexType>(gram);
+                        if (TrieType::is_level_concurrent() && m_is_parallel_build) {
+                            m_bitmap_hash_cach[curr_level - MGRAM_IDX_OFFSET].template cache_m_gram_hash_concurrent<WordIndexType>(gram);
+                        } else {
+                            m_bitmap_hash_cach[curr_level - MGRAM_IDX_OFFSET].template cache_m_gram_hash<WordIndexType>(gram);
+                        }
                     }
                 }
 
@@ -362,6 +461,13 @@ namespace uva {
 
             private:
 
+                //Stores true if the m-grams are added pre-sorted
+                bool m_is_presorted;
+                //Stores the memory limit for sorting while building, in bytes
+                size_t m_build_mem_limit;
+                //Stores true if the m-gram levels 2..N are to be read in parallel
+                bool m_is_parallel_build;
+
                 //Stores the bitmap hash caches per M-gram level for 1 < M <= N
                 BitmapHashCache m_bitmap_hash_cach[NUM_M_N_GRAM_LEVELS];
 
@@ -518,19 +624,11 @@ namespace uva {
                 }
             };
 
-            //Define the macro for instantiating the generic trie class children templates
-#define INSTANTIATE_TRIE_FUNCS_LEVEL(LEVEL, TRIE_TYPE_NAME, ...) \
-            template void TRIE_TYPE_NAME<__VA_ARGS__>::add_m_gram<LEVEL>(const T_Model_M_Gram<TRIE_TYPE_NAME<__VA_ARGS__>::WordIndexType> & gram);
-
-#define INSTANTIATE_TRIE_TEMPLATE_TYPE(TRIE_TYPE_NAME, ...) \
-            template class TRIE_TYPE_NAME<__VA_ARGS__>; \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_1, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_2, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_3, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_4, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_5, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_6, TRIE_TYPE_NAME, __VA_ARGS__); \
-            INSTANTIATE_TRIE_FUNCS_LEVEL(M_GRAM_LEVEL_7, TRIE_TYPE_NAME, __VA_ARGS__);
+            //Define the macro for instantiating the generic trie class children templates for all the supported levels
+#define INSTANTIATE_TRIE_TEMPLATE_TYPE_LEVEL(LEVEL, TRIE_TYPE_NAME, WORD_IDX_TYPE) \
+            template class TRIE_TYPE_NAME<LEVEL, WORD_IDX_TYPE >;
+#define INSTANTIATE_TRIE_TEMPLATE_TYPE(TRIE_TYPE_NAME, WORD_IDX_TYPE) \
+            INSTANTIATE_FOR_SUPPORTED_LEVELS(INSTANTIATE_TRIE_TEMPLATE_TYPE_LEVEL, TRIE_TYPE_NAME, WORD_IDX_TYPE)
 
         }
     }
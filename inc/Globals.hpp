@@ -75,6 +75,8 @@ namespace uva {
         const uint32_t EXPECTED_USER_NUMBER_OF_ARGUMENTS = (EXPECTED_NUMBER_OF_ARGUMENTS - 1);
         //The number of bytes in one Mb
         const uint32_t BYTES_ONE_MB = 1024u;
+        //The number of bytes in one Mb, for sizes in bytes, BYTES_ONE_MB is for Kb to Mb
+        const size_t MB_SIZE_BYTES = 1024u * 1024u;
 
         //The following type definitions are important for storing the Tries information
         namespace tries {
@@ -110,40 +112,107 @@ namespace uva {
                 const static TModelLevel M_GRAM_LEVEL_6 = 6u;
                 const static TModelLevel M_GRAM_LEVEL_7 = 7u;
                 const static TModelLevel M_GRAM_LEVEL_8 = 8u;
-
+                const static TModelLevel M_GRAM_LEVEL_9 = 9u;
+                const static TModelLevel M_GRAM_LEVEL_10 = 10u;
 
                 //Stores the maximum sopported level
-                static constexpr TModelLevel MAX_SUPP_GRAM_LEVEL = M_GRAM_LEVEL_6;
+                static constexpr TModelLevel MAX_SUPP_GRAM_LEVEL = M_GRAM_LEVEL_10;
+
+                static_assert((M_GRAM_LEVEL_MAX >= M_GRAM_LEVEL_2) && (M_GRAM_LEVEL_MAX <= MAX_SUPP_GRAM_LEVEL),
+                        "The M_GRAM_LEVEL_MAX must be within [M_GRAM_LEVEL_2, MAX_SUPP_GRAM_LEVEL]!");
+
+                //Stores the levels the templates are instantiated for, used to check them against M_GRAM_LEVEL_MAX
+#define GET_SUPPORTED_LEVEL(LEVEL, ...) LEVEL,
+                static constexpr TModelLevel INSTANTIATED_LEVELS[] = {INSTANTIATE_FOR_SUPPORTED_LEVELS(GET_SUPPORTED_LEVEL, _)};
+#undef GET_SUPPORTED_LEVEL
+
+                static_assert((sizeof (INSTANTIATED_LEVELS) == (M_GRAM_LEVEL_MAX - M_GRAM_LEVEL_1) * sizeof (TModelLevel))
+                        && (INSTANTIATED_LEVELS[M_GRAM_LEVEL_MAX - M_GRAM_LEVEL_2] == M_GRAM_LEVEL_MAX),
+                        "The INSTANTIATE_FOR_SUPPORTED_LEVELS must list all the levels from 2 up to M_GRAM_LEVEL_MAX!");
+
+                /**
+                 * This namespace contains the compile-time generators for the
+                 * current level maps, the maps are indexed by the [begin,end]
+                 * word index pair and are computed for all the supported levels.
+                 */
+                namespace level_map {
+
+                    /**
+                     * Stores the compile-time sequence of level indexes
+                     */
+                    template<TModelLevel... IDX>
+                    struct S_Idx_Seq {
+                    };
+
+                    /**
+                     * Generates the compile-time sequence of level indexes 0, ..., NUM - 1
+                     */
+                    template<TModelLevel NUM, TModelLevel... IDX>
+                    struct S_Gen_Idx_Seq : S_Gen_Idx_Seq<NUM - 1, NUM - 1, IDX...> {
+                    };
+
+                    template<TModelLevel... IDX>
+                    struct S_Gen_Idx_Seq<0, IDX...> {
+                        typedef S_Idx_Seq<IDX...> type;
+                    };
+
+                    //The sequence of all the supported begin/end word indexes
+                    typedef S_Gen_Idx_Seq<MAX_SUPP_GRAM_LEVEL>::type TSuppIdxSeq;
+
+                    /**
+                     * Allows to compute the level of the sub-m-gram [begin,end] minus the given value
+                     * @param begin the begin word index
+                     * @param end the end word index
+                     * @param minus the value to subtract from the level
+                     * @return the resulting level or M_GRAM_LEVEL_UNDEF if it is not positive
+                     */
+                    constexpr inline TModelLevel get_curr_level(const TModelLevel begin, const TModelLevel end, const TModelLevel minus) {
+                        return ((end + 1) >= (begin + minus)) ? ((end + 1) - (begin + minus)) : M_GRAM_LEVEL_UNDEF;
+                    }
+
+                    /**
+                     * Stores the row of the level map for a fixed begin word index
+                     */
+                    struct S_Level_Row {
+                        TModelLevel m_levels[MAX_SUPP_GRAM_LEVEL];
+
+                        constexpr const TModelLevel & operator[](const size_t end) const {
+                            return m_levels[end];
+                        }
+                    };
+
+                    /**
+                     * Stores the level map indexed by the [begin,end] word index pair
+                     */
+                    struct S_Level_Map {
+                        S_Level_Row m_rows[MAX_SUPP_GRAM_LEVEL];
+
+                        constexpr const S_Level_Row & operator[](const size_t begin) const {
+                            return m_rows[begin];
+                        }
+                    };
+
+                    template<TModelLevel... END>
+                    constexpr inline S_Level_Row make_level_row(const TModelLevel begin, const TModelLevel minus, S_Idx_Seq<END...>) {
+                        return S_Level_Row{
+                            {get_curr_level(begin, END, minus)...}};
+                    }
+
+                    template<TModelLevel... BEGIN>
+                    constexpr inline S_Level_Map make_level_map(const TModelLevel minus, S_Idx_Seq<BEGIN...>) {
+                        return S_Level_Map{
+                            {make_level_row(BEGIN, minus, TSuppIdxSeq())...}};
+                    }
+                }
 
                 //This structure stores the current level value mapping from the [begin,end] value pair
-                static constexpr TModelLevel CURR_LEVEL_MAP[MAX_SUPP_GRAM_LEVEL][MAX_SUPP_GRAM_LEVEL] = {
-                    {M_GRAM_LEVEL_1, M_GRAM_LEVEL_2, M_GRAM_LEVEL_3, M_GRAM_LEVEL_4, M_GRAM_LEVEL_5, M_GRAM_LEVEL_6},
-                    {M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_1, M_GRAM_LEVEL_2, M_GRAM_LEVEL_3, M_GRAM_LEVEL_4, M_GRAM_LEVEL_5},
-                    {M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_1, M_GRAM_LEVEL_2, M_GRAM_LEVEL_3, M_GRAM_LEVEL_4},
-                    {M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_1, M_GRAM_LEVEL_2, M_GRAM_LEVEL_3},
-                    {M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_1, M_GRAM_LEVEL_2},
-                    {M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_UNDEF, M_GRAM_LEVEL_1},
-                };
+                static constexpr level_map::S_Level_Map CURR_LEVEL_MAP = level_map::make_level_map(0, level_map::TSuppIdxSeq());
 
                 //This structure stores the current level minus 1 value mapping from the [begin,end] value pair
-                static constexpr TModelLevel CURR_LEVEL_MIN_1_MAP[MAX_SUPP_GRAM_LEVEL][MAX_SUPP_GRAM_LEVEL] = {
-                    {0, 1, 2, 3, 4, 5},
-                    {0, 0, 1, 2, 3, 4},
-                    {0, 0, 0, 1, 2, 3},
-                    {0, 0, 0, 0, 1, 2},
-                    {0, 0, 0, 0, 0, 1},
-                    {0, 0, 0, 0, 0, 0},
-                };
+                static constexpr level_map::S_Level_Map CURR_LEVEL_MIN_1_MAP = level_map::make_level_map(1, level_map::TSuppIdxSeq());
 
                 //This structure stores the current level minus 2 value mapping from the [begin,end] value pair
-                static constexpr TModelLevel CURR_LEVEL_MIN_2_MAP[MAX_SUPP_GRAM_LEVEL][MAX_SUPP_GRAM_LEVEL] = {
-                    {0, 0, 1, 2, 3, 4},
-                    {0, 0, 0, 1, 2, 3},
-                    {0, 0, 0, 0, 1, 2},
-                    {0, 0, 0, 0, 0, 1},
-                    {0, 0, 0, 0, 0, 0},
-                    {0, 0, 0, 0, 0, 0},
-                };
+                static constexpr level_map::S_Level_Map CURR_LEVEL_MIN_2_MAP = level_map::make_level_map(2, level_map::TSuppIdxSeq());
             }
         }
 
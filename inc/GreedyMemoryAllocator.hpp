@@ -73,7 +73,7 @@ namespace uva {
 
                     //Allocate the allocator
                     LOG_DEBUG4 << "Allocating the " << ctName << " allocator for " << factoredNumElems << " elements!" << END_LOG;
-                    *ppAllocator = new TAllocator(factoredNumElems);
+                    *ppAllocator = new TAllocator(factoredNumElems, ctName);
 
                     //Allocate the map with the given allocator
                     LOG_DEBUG4 << "Allocating the " << ctName << " container with the created allocator!" << END_LOG;
@@ -147,10 +147,11 @@ namespace uva {
                     /**
                      * The basic constructor.
                      * @param numElems the number of elements of template type T to pre-allocate memory for.
+                     * @param name the name of the allocator's storage for the statistics reports
                      */
-                    GreedyMemoryAllocator(size_type numElems) throw () :
-                    _manager(_storage),
-                    _storage(numElems * sizeof (T)) {
+                    GreedyMemoryAllocator(size_type numElems, const string & name = "Greedy Memory") :
+                    _pStorage(new GreedyMemoryStorage(numElems * sizeof (T), name)),
+                    _manager(*_pStorage) {
                         LOG_DEBUG4 << "Creating FixedMemoryAllocator for "
                                 << SSTR(numElems) << " " << typeid (T).name()
                                 << " elements of size " << SSTR(sizeof (T)) << END_LOG;
@@ -160,7 +161,7 @@ namespace uva {
                      * The basic copy constructor. 
                      */
                     GreedyMemoryAllocator(const GreedyMemoryAllocator& other) throw () :
-                    _manager(other.getStorageRef()) {
+                    _pStorage(NULL), _manager(other.getStorageRef()) {
                         LOG_DEBUG4 << "Calling the FixedMemoryAllocator copy constructor." << END_LOG;
                     }
 
@@ -171,7 +172,7 @@ namespace uva {
                      */
                     template <typename U>
                     GreedyMemoryAllocator(const GreedyMemoryAllocator<U>& other) throw () :
-                    _manager(other.getStorageRef()) {
+                    _pStorage(NULL), _manager(other.getStorageRef()) {
                         LOG_DEBUG4 << "Calling the FixedMemoryAllocator re-bind constructor for " << typeid (T).name() << "." << END_LOG;
                     }
 
@@ -179,8 +180,9 @@ namespace uva {
                      * The standard destructor
                      */
                     virtual ~GreedyMemoryAllocator() throw () {
-                        //Nothing to be done!
                         LOG_DEBUG4 << "" << __FUNCTION__ << END_LOG;
+                        //Delete the storage if this object isn't copy-constructed
+                        delete _pStorage;
                     }
 
                     /**
@@ -223,14 +225,16 @@ namespace uva {
                     }
 
                     /**
-                     * This function is supposed to deallocate the memory.
-                     * We do not do that as this is fixed memory allocator
+                     * Deallocates the memory, the memory block is returned to the
+                     * storage's free lists and is re-used by the next allocations
                      * @param ptr the pointer to free memory from
                      * @param num the number of objects to deallocate
                      */
                     void deallocate(pointer ptr, size_type num) {
                         LOG_DEBUG4 << "Requested to deallocate: " << SSTR(num)
-                                << " objects starting from: " << ptr << ". Ignoring!" << END_LOG;
+                                << " objects starting from: " << ptr << END_LOG;
+
+                        _manager.deallocate(ptr, num * sizeof (T));
                     }
 
                     /**
@@ -276,19 +280,23 @@ namespace uva {
                         return _manager;
                     }
 
+                private:
+                    //The buffer_manager object if this object isn't copy-constructed, it is
+                    //not stored by value to keep small the allocator copies of the containers
+                    GreedyMemoryStorage * _pStorage;
+
                 protected:
                     //The reference to the buffer manager that is actively being used
                     GreedyMemoryStorage& _manager;
 
                 private:
-                    //The space for a buffer_manager object if this object isn't copy-constructed
-                    GreedyMemoryStorage _storage;
 
                     /**
                      * The default constructor
                      */
                     GreedyMemoryAllocator() throw () :
-                    _manager(_storage), _storage(0) {
+                    _pStorage(new GreedyMemoryStorage()), _manager(*_pStorage) {
+                        delete _pStorage;
                         throw Exception("The default constructor is not to be used!");
                     }
 
@@ -30,6 +30,14 @@
 #define	FIXEDMEMORYSTORAGE_HPP
 
 #include <vector>       // std::vector
+#include <string>       // std::string
+#include <mutex>        // std::mutex std::lock_guard
+#include <algorithm>    // std::max std::find
+#include <unistd.h>     // sysconf
+#include <sys/mman.h>   // madvise
+#ifdef __GLIBC__
+#include <malloc.h>     // malloc_trim
+#endif
 
 #include "Logger.hpp"
 #include "Exceptions.hpp"
@@ -48,6 +56,17 @@ namespace uva {
                 /**
                  * This is the greedy memory storage class that in the first place
                  * allocates some storage and then only grows it if more space is needed!
+                 * 
+                 * The storage is an arena: the memory is given out from large chunks, the
+                 * first one is pre-allocated and the next ones are added when needed. The
+                 * freed blocks are kept in per size class free lists and are re-used by the
+                 * next allocations. The small size classes are multiples of the alignment,
+                 * the large ones are powers of two, the large free blocks are split when
+                 * re-used. This recycles, e.g., the bucket arrays of re-hashed unordered maps.
+                 * 
+                 * Every storage keeps its usage, free list, high-water mark statistics and is
+                 * registered in the list of storages, so that all of them can be reported on
+                 * and trimmed after the trie is built, see report_all and trim_all.
                  */
                 class GreedyMemoryStorage {
                 public:
@@ -61,24 +80,29 @@ namespace uva {
                     /**
                      * The basic constructor
                      */
-                    explicit GreedyMemoryStorage() {}
+                    explicit GreedyMemoryStorage() : _pBuffer(NULL), _numBytes(0), _allocBytes(0),
+                    _isRegistered(false) {
+                        clear_statistics();
+                    }
 
                     /**
                      * The basic constructor of the greedy storage.
                      * @param numBytes the number of bytes to pre-allocate the buffer for - the initial buffer capacity
+                     * @param name the storage name for the statistics reports
                      */
-                    explicit GreedyMemoryStorage(size_type numBytes) :
-                    _numBytes(numBytes),
-                    _allocBytes(0) {
+                    explicit GreedyMemoryStorage(size_type numBytes, const string & name = "Greedy Memory") :
+                    _name(name), _pBuffer(NULL), _numBytes(0), _allocBytes(0), _isRegistered(true) {
+                        clear_statistics();
+
                         //Allocate the data buffer
                         LOG_DEBUG3 << "Pre-Allocating " << numBytes << " bytes storage!" << END_LOG;
-                        if (_numBytes > 0) {
-                            _pBuffer = new TStorageData[_numBytes];
-                            //Register the first allocated memory buffer
-                            _memoryBuffers.push_back(_pBuffer);
-                        } else {
-                            _pBuffer = NULL;
+                        if (numBytes > 0) {
+                            add_chunk(round_up(numBytes));
                         }
+
+                        //Register the storage
+                        lock_guard<mutex> lock(get_storages_mutex());
+                        get_storages().push_back(this);
                     }
 
                     /**
@@ -95,6 +119,13 @@ namespace uva {
                      * The basic destructor.
                      */
                     ~GreedyMemoryStorage() {
+                        //Un-register the storage
+                        if (_isRegistered) {
+                            lock_guard<mutex> lock(get_storages_mutex());
+                            vector<GreedyMemoryStorage *> & storages = get_storages();
+                            storages.erase(std::find(storages.begin(), storages.end(), this));
+                        }
+
                         //Deallocate the actual storage
                         for (std::vector<void*>::iterator it = _memoryBuffers.begin(); it != _memoryBuffers.end(); ++it) {
                             delete [] static_cast<TStorageData*> (*it);
@@ -106,7 +137,7 @@ namespace uva {
                      * @return the current buffer size
                      */
                     size_type getBufferSizeBytes() const {
-                        return _numBytes;
+                        return _reservedBytes;
                     }
 
                     /**
@@ -114,44 +145,315 @@ namespace uva {
                      * @return the number of free bytes remaining
                      */
                     size_type getAvailableBytes() const {
-                        return (_numBytes - _allocBytes);
+                        return (_numBytes - _allocBytes) + _freeBytes;
                     }
 
                     /**
-                     * Allocates the memory of required size,if there is no enough space in the buffer, then reallocates!
+                     * Allocates the memory of required size, first tries to re-use a free block of
+                     * the matching size class, then the remains of the current chunk, if there is
+                     * not enough space there then a new chunk is allocated.
                      * @param num the number of bytes to allocate in the buffer
                      * @return the pointer to the beginning of the allocated memory block
                      */
                     void* allocate(size_type num) {
-                        const size_type remains = getAvailableBytes();
-                        void* ptr = NULL;
+                        const size_type bytes = round_up(num);
+                        void* ptr = pop_free_block(bytes);
+
+                        if (ptr == NULL) {
+                            //Check if there is more space needed!
+                            if ((_numBytes - _allocBytes) < bytes) {
+                                //Keep the current chunk's remains, if any, as a free block
+                                if (_numBytes > _allocBytes) {
+                                    push_free_block(_pBuffer + _allocBytes, _numBytes - _allocBytes);
+                                    _allocBytes = _numBytes;
+                                }
+                                //Add a new chunk, grow the storage by at least a quarter
+                                LOG_DEBUG3 << "Allocating additional chunk for: " << bytes << " bytes!" << END_LOG;
+                                add_chunk(max(max(bytes, __GreedyMemoryStorage::MIN_CHUNK_BYTES), round_up(_reservedBytes / 4)));
+                            }
 
-                        //Check if there is more space needed!
-                        if (remains > num) {
                             //Allocate the requested memory in the buffer
-                            ptr = static_cast<void*> (static_cast<char*> (_pBuffer) + _allocBytes);
-                            _allocBytes += num;
-                        } else {
-                            //WARNING: If we need more space we allocate it additionally in a not so efficient way.
-                            LOG_DEBUG3 << "Allocating additional: " << num << " bytes!" << END_LOG;
-                            ptr = static_cast<void*> (new TStorageData[num]);
-                            _memoryBuffers.push_back(ptr);
+                            ptr = static_cast<void*> (_pBuffer + _allocBytes);
+                            _allocBytes += bytes;
                         }
+
+                        _usedBytes += bytes;
+                        _maxUsedBytes = max(_maxUsedBytes, _usedBytes);
                         return ptr;
                     }
 
+                    /**
+                     * Puts the given memory block into the free list of its size class
+                     * @param ptr the pointer to the memory block
+                     * @param num the number of bytes that were allocated for the block
+                     */
+                    void deallocate(void* ptr, size_type num) {
+                        const size_type bytes = round_up(num);
+                        push_free_block(static_cast<TStorageData*> (ptr), bytes);
+                        _usedBytes -= bytes;
+                    }
+
+                    /**
+                     * Returns the unused memory pages of the storage to the system: the tail
+                     * of the current chunk and the free blocks. The storage remains usable,
+                     * the released pages are zero filled once they are touched again.
+                     * @return the number of bytes returned to the system
+                     */
+                    size_type trim() {
+                        size_type trimmed = release_pages(_pBuffer + _allocBytes, _pBuffer + _numBytes);
+                        for (size_type cls = NUM_SMALL_SIZE_CLASSES; cls < NUM_SIZE_CLASSES; ++cls) {
+                            for (S_Free_Block * block = static_cast<S_Free_Block *> (_freeLists[cls]);
+                                    block != NULL; block = block->m_next) {
+                                TStorageData * begin = reinterpret_cast<TStorageData *> (block);
+                                trimmed += release_pages(begin + sizeof (S_Free_Block), begin + block->m_size);
+                            }
+                        }
+                        _trimmedBytes += trimmed;
+                        return trimmed;
+                    }
+
+                    /**
+                     * Allows to report the usage statistics of the storage, in Kb
+                     */
+                    void report() const {
+                        LOG_INFO << "  " << _name << ": reserved " << get_kb(_reservedBytes) << " Kb in "
+                                << _memoryBuffers.size() << " chunk(s), used " << get_kb(_usedBytes)
+                                << " Kb, high-water mark " << get_kb(_maxUsedBytes) << " Kb, free blocks "
+                                << get_kb(_freeBytes) << " Kb, unused tail " << get_kb(_numBytes - _allocBytes)
+                                << " Kb, trimmed " << get_kb(_trimmedBytes) << " Kb" << END_LOG;
+                    }
+
+                    /**
+                     * Allows to trim all the registered storages and the heap
+                     * @return the number of bytes returned to the system by the storages
+                     */
+                    static size_type trim_all() {
+                        lock_guard<mutex> lock(get_storages_mutex());
+                        size_type trimmed = 0;
+                        for (GreedyMemoryStorage * storage : get_storages()) {
+                            trimmed += storage->trim();
+                        }
+#ifdef __GLIBC__
+                        //Return the freed heap memory, e.g. of the build time structures
+                        malloc_trim(0);
+#endif
+                        return trimmed;
+                    }
+
+                    /**
+                     * Allows to report the usage statistics of all the registered storages
+                     */
+                    static void report_all() {
+                        lock_guard<mutex> lock(get_storages_mutex());
+                        if (!get_storages().empty()) {
+                            LOG_INFO << "The greedy memory storages usage:" << END_LOG;
+                            for (const GreedyMemoryStorage * storage : get_storages()) {
+                                storage->report();
+                            }
+                        }
+                    }
+
                 protected:
-                    //The pre-allocated block of memory
-                    void* _pBuffer;
+                    //The number of small size classes, the small blocks sizes are multiples of the alignment
+                    static constexpr size_type NUM_SMALL_SIZE_CLASSES =
+                            __GreedyMemoryStorage::MAX_SMALL_BLOCK_BYTES / __GreedyMemoryStorage::BLOCK_ALIGNMENT_BYTES;
+                    //The log2 of the maximum small block size
+                    static constexpr size_type LOG2_MAX_SMALL_BLOCK_BYTES = __builtin_ctzll(__GreedyMemoryStorage::MAX_SMALL_BLOCK_BYTES);
+                    //The total number of size classes, the large classes are the powers of two
+                    static constexpr size_type NUM_SIZE_CLASSES = NUM_SMALL_SIZE_CLASSES + 64 - LOG2_MAX_SMALL_BLOCK_BYTES;
+
+                    //The header of a large free block, the small ones only store the next pointer
 
-                    //The additionally allocated memory will be stored here
+                    struct S_Free_Block {
+                        S_Free_Block * m_next;
+                        size_type m_size;
+                    };
+
+                    //The name of the storage
+                    string _name;
+
+                    //The current chunk of memory
+                    TStorageData * _pBuffer;
+
+                    //The allocated memory chunks will be stored here
                     vector<void*> _memoryBuffers;
 
-                    //The pre-allocated buffer size
+                    //The current chunk size
                     size_type _numBytes;
 
-                    //The number of pre-allocated bytes in the preallocated buffer
+                    //The number of allocated bytes in the current chunk
                     size_type _allocBytes;
+
+                    //Stores true if the storage is registered
+                    bool _isRegistered;
+
+                    //The free lists per size class
+                    void * _freeLists[NUM_SIZE_CLASSES];
+
+                    //The total number of bytes in the chunks
+                    size_type _reservedBytes;
+                    //The number of bytes given out and not yet freed
+                    size_type _usedBytes;
+                    //The maximum number of bytes in use at once
+                    size_type _maxUsedBytes;
+                    //The number of bytes in the free lists
+                    size_type _freeBytes;
+                    //The number of bytes returned to the system
+                    size_type _trimmedBytes;
+
+                    /**
+                     * Allows to get the list of the registered storages
+                     * @return the list of the registered storages
+                     */
+                    static inline vector<GreedyMemoryStorage *> & get_storages() {
+                        static vector<GreedyMemoryStorage *> storages;
+                        return storages;
+                    }
+
+                    /**
+                     * Allows to get the mutex guarding the list of the registered storages
+                     * @return the mutex guarding the list of the registered storages
+                     */
+                    static inline mutex & get_storages_mutex() {
+                        static mutex storages_mutex;
+                        return storages_mutex;
+                    }
+
+                    /**
+                     * Allows to clear the free lists and the statistics
+                     */
+                    inline void clear_statistics() {
+                        for (size_type cls = 0; cls < NUM_SIZE_CLASSES; ++cls) {
+                            _freeLists[cls] = NULL;
+                        }
+                        _reservedBytes = 0;
+                        _usedBytes = 0;
+                        _maxUsedBytes = 0;
+                        _freeBytes = 0;
+                        _trimmedBytes = 0;
+                    }
+
+                    /**
+                     * Rounds the number of bytes up to the block alignment, at least one alignment unit
+                     * @param num the number of bytes
+                     * @return the rounded number of bytes
+                     */
+                    static inline size_type round_up(const size_type num) {
+                        const size_type align = __GreedyMemoryStorage::BLOCK_ALIGNMENT_BYTES;
+                        return max(align, (num + align - 1) & ~(align - 1));
+                    }
+
+                    /**
+                     * Allows to get the size class of the block, the large blocks
+                     * of the class are at least as big as the class power of two
+                     * @param bytes the rounded block size
+                     * @return the size class index
+                     */
+                    static inline size_type get_size_class(const size_type bytes) {
+                        if (bytes <= __GreedyMemoryStorage::MAX_SMALL_BLOCK_BYTES) {
+                            return (bytes / __GreedyMemoryStorage::BLOCK_ALIGNMENT_BYTES) - 1;
+                        } else {
+                            return NUM_SMALL_SIZE_CLASSES + (63 - __builtin_clzll(bytes)) - LOG2_MAX_SMALL_BLOCK_BYTES;
+                        }
+                    }
+
+                    /**
+                     * Allows to add a new chunk and make it current
+                     * @param bytes the chunk size
+                     */
+                    inline void add_chunk(const size_type bytes) {
+                        _pBuffer = new TStorageData[bytes];
+                        _memoryBuffers.push_back(_pBuffer);
+                        _numBytes = bytes;
+                        _allocBytes = 0;
+                        _reservedBytes += bytes;
+                    }
+
+                    /**
+                     * Allows to put the block into the free list of its size class
+                     * @param ptr the block pointer
+                     * @param bytes the rounded block size
+                     */
+                    inline void push_free_block(TStorageData * ptr, const size_type bytes) {
+                        const size_type cls = get_size_class(bytes);
+                        if (cls < NUM_SMALL_SIZE_CLASSES) {
+                            *reinterpret_cast<void **> (ptr) = _freeLists[cls];
+                        } else {
+                            reinterpret_cast<S_Free_Block *> (ptr)->m_next = static_cast<S_Free_Block *> (_freeLists[cls]);
+                            reinterpret_cast<S_Free_Block *> (ptr)->m_size = bytes;
+                        }
+                        _freeLists[cls] = ptr;
+                        _freeBytes += bytes;
+                    }
+
+                    /**
+                     * Allows to take a free block of the given size. A small block is
+                     * taken from its size class. A large block is taken from the first
+                     * non-empty larger class, or the head of its own class if it fits,
+                     * the remains of the large block are put back into the free lists.
+                     * @param bytes the rounded block size
+                     * @return the block pointer or NULL if there is no free block
+                     */
+                    inline void * pop_free_block(const size_type bytes) {
+                        const size_type cls = get_size_class(bytes);
+                        if (cls < NUM_SMALL_SIZE_CLASSES) {
+                            void * ptr = _freeLists[cls];
+                            if (ptr != NULL) {
+                                _freeLists[cls] = *static_cast<void **> (ptr);
+                                _freeBytes -= bytes;
+                            }
+                            return ptr;
+                        } else {
+                            S_Free_Block * block = static_cast<S_Free_Block *> (_freeLists[cls]);
+                            size_type found_cls = cls;
+                            if ((block == NULL) || (block->m_size < bytes)) {
+                                block = NULL;
+                                for (found_cls = cls + 1; found_cls < NUM_SIZE_CLASSES; ++found_cls) {
+                                    if (_freeLists[found_cls] != NULL) {
+                                        block = static_cast<S_Free_Block *> (_freeLists[found_cls]);
+                                        break;
+                                    }
+                                }
+                            }
+                            if (block != NULL) {
+                                const size_type block_size = block->m_size;
+                                _freeLists[found_cls] = block->m_next;
+                                _freeBytes -= block_size;
+                                if (block_size > bytes) {
+                                    push_free_block(reinterpret_cast<TStorageData *> (block) + bytes, block_size - bytes);
+                                }
+                            }
+                            return block;
+                        }
+                    }
+
+                    /**
+                     * Allows to return the whole memory pages within the given range to the system
+                     * @param begin the range begin
+                     * @param end the range end
+                     * @return the number of bytes returned to the system
+                     */
+                    static inline size_type release_pages(TStorageData * begin, TStorageData * end) {
+                        static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+                        const uintptr_t page_begin = (reinterpret_cast<uintptr_t> (begin) + page_size - 1) & ~(page_size - 1);
+                        const uintptr_t page_end = reinterpret_cast<uintptr_t> (end) & ~(page_size - 1);
+                        if ((begin != NULL) && (page_begin < page_end)) {
+                            if (madvise(reinterpret_cast<void *> (page_begin), page_end - page_begin, MADV_DONTNEED) == 0) {
+                                return page_end - page_begin;
+                            }
+                        }
+                        return 0;
+                    }
+
+                    /**
+                     * Allows to convert the number of bytes into Kb, note that
+                     * BYTES_ONE_MB converts the Kb memory statistics into Mb
+                     * @param bytes the number of bytes
+                     * @return the number of Kb
+                     */
+                    static inline size_type get_kb(const size_type bytes) {
+                        return bytes / 1024u;
+                    }
                 };
 
             }
@@ -161,4 +463,3 @@ namespace uva {
 
 
 #endif	/* FIXEDMEMORYSTORAGE_HPP */
-
@@ -123,6 +123,25 @@ namespace uva {
                  */
                 explicit H2DMapTrie(WordIndexType & word_index);
 
+                /**
+                 * The m-grams are stored by their hashes and every level has its own hash map,
+                 * so the m-gram levels 2..N can be added concurrently.
+                 * @see GenericTrieBase
+                 */
+                static constexpr bool is_levels_independent() {
+                    return true;
+                }
+
+                /**
+                 * The hash maps allow for concurrent insertions, and the m-gram
+                 * ids are the hash values, so one level can be filled by several
+                 * threads at once, this is done for the parallel build.
+                 * @see GenericTrieBase
+                 */
+                static constexpr bool is_level_concurrent() {
+                    return true;
+                }
+
                 /**
                  * Allows to log the information about the instantiated trie type
                  */
@@ -132,6 +151,18 @@ namespace uva {
                             << SSTR(__H2DMapTrie::BUCKETS_FACTOR) << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    for (TModelLevel idx = 0; idx < NUM_M_GRAM_LEVELS; ++idx) {
+                        m_m_gram_data[idx]->memory_breakdown(breakdown, idx + LEVEL_IDX_OFFSET);
+                    }
+                    m_n_gram_data->memory_breakdown(breakdown, MAX_LEVEL);
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -144,7 +175,7 @@ namespace uva {
                  * @see GenericTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     //If not a uni-gram then register in the cache
                     if (CURR_LEVEL != M_GRAM_LEVEL_1) {
                         //Register the m-gram in the hash cache
@@ -160,7 +191,9 @@ namespace uva {
 
                     if (CURR_LEVEL == MAX_LEVEL) {
                         //Create a new M-Gram data entry
-                        T_M_Gram_Prob_Entry & data = m_n_gram_data->add_new_element(hash_value);
+                        T_M_Gram_Prob_Entry & data = BASE::is_parallel_build()
+                                ? m_n_gram_data->add_new_element_concurrent(hash_value)
+                                : m_n_gram_data->add_new_element(hash_value);
                         //The n-gram id is equal to its hash value
                         data.m_id = hash_value;
                         //Set the probability data
@@ -172,7 +205,9 @@ namespace uva {
                             m_unk_word_payload = gram.m_payload;
                         } else {
                             //Create a new M-Gram data entry
-                            T_M_Gram_PB_Entry & data = m_m_gram_data[LEVEL_IDX]->add_new_element(hash_value);
+                            T_M_Gram_PB_Entry & data = BASE::is_parallel_build()
+                                    ? m_m_gram_data[LEVEL_IDX]->add_new_element_concurrent(hash_value)
+                                    : m_m_gram_data[LEVEL_IDX]->add_new_element(hash_value);
                             //The m-gram id is equal to its hash value
                             data.m_id = hash_value;
                             //Set the probability and back-off data
@@ -291,12 +326,6 @@ namespace uva {
                     }
                 }
             };
-
-            typedef H2DMapTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TH2DMapTrieBasic;
-            typedef H2DMapTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TH2DMapTrieCount;
-            typedef H2DMapTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TH2DMapTrieOptBasic;
-            typedef H2DMapTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TH2DMapTrieOptCount;
-            typedef H2DMapTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TH2DMapTrieHashing;
         }
     }
 }
@@ -129,6 +129,14 @@ namespace uva {
                         return false;
                     }
 
+                    /**
+                     * @see AWordIndex
+                     * The word ids are the word hashes, so there is no data stored
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                        breakdown.add("HashingWordIndex", "none", MemoryBreakdown::NO_LEVEL, 0);
+                    }
+
                     /**
                      * The basic destructor
                      */
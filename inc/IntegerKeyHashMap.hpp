@@ -0,0 +1,378 @@
+/*
+ * File:   IntegerKeyHashMap.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 6:20 PM
+ */
+
+#include <string>         // std::string
+#include <cmath>          // std::ceil
+#include <algorithm>      // std::max
+#include <utility>        // std::pair
+#include <unordered_map>  // std::unordered_map
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "HashingUtils.hpp"
+#include "GreedyMemoryAllocator.hpp"
+#include "MemoryBreakdown.hpp"
+
+using namespace std;
+using namespace uva::smt::hashing;
+
+#ifndef INTEGERKEYHASHMAP_HPP
+#define	INTEGERKEYHASHMAP_HPP
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+            namespace alloc {
+
+                /**
+                 * This class represents a flat open addressing linear probing hash map for 64 bit
+                 * integer keys. The keys and values are stored next to each other in one array of
+                 * buckets, so there is no heap node per entry and a lookup is typically one cache
+                 * miss. Unlike std::hash<TLongId>, which is an identity on libstdc++, the keys are
+                 * mixed with mix_fasthash before taking the bucket index, so the structured context
+                 * keys, e.g. Szudzik pairs, do not cluster. The number of buckets is a power of two.
+                 *
+                 * The map is meant to be pre-sized from the ARPA header counts, if there are more
+                 * elements added than there was reserved for, the map is re-hashed into twice as
+                 * many buckets. Therefore the value pointers returned by find are only stable once
+                 * the map is filled, which is the case for the tries after they are built.
+                 *
+                 * The all-ones key is used to mark the empty buckets, the value of this key, if it
+                 * is ever added, is stored aside from the buckets array.
+                 *
+                 * @param VALUE_TYPE the value type, must be default constructible and copyable
+                 */
+                template<typename VALUE_TYPE>
+                class FlatIntegerKeyMap {
+                public:
+                    //The key type of the map
+                    typedef uint64_t TKeyType;
+
+                    //Stores the key marking the empty bucket
+                    static constexpr TKeyType EMPTY_KEY = UINT64_MAX;
+
+                    /**
+                     * The basic constructor that allows to instantiate the map for the given number of elements
+                     * @param num_elems the number of elements that will be stored in the map
+                     * @param buckets_factor the buckets factor, the number of buckets will be the smallest
+                     * power of two larger than this value times the number of elements, must be > 1.0
+                     */
+                    explicit FlatIntegerKeyMap(const size_t num_elems, const float buckets_factor)
+                    : m_num_elems(0), m_buckets(NULL), m_is_empty_key_set(false), m_empty_key_value() {
+                        //Do a compulsory assert on the buckets factor
+                        ASSERT_CONDITION_THROW((buckets_factor <= 1.0), string("buckets_factor: ") +
+                                std::to_string(buckets_factor) + string(", must be > 1.0"));
+
+                        //Compute the number of buckets as a power of two
+                        uint_fast64_t num_buckets = 1;
+                        const uint_fast64_t min_num_buckets = (uint_fast64_t) ceil(buckets_factor * (num_elems + 1));
+                        while (num_buckets < min_num_buckets) {
+                            num_buckets <<= 1;
+                        }
+
+                        //Allocate the buckets
+                        allocate_buckets(num_buckets);
+
+                        LOG_DEBUG << "FIKM: num_elems: " << num_elems << ", m_num_buckets: " << m_num_buckets << END_LOG;
+                    }
+
+                    //The map owns its buckets, so copying it would free them twice
+                    FlatIntegerKeyMap(const FlatIntegerKeyMap &) = delete;
+                    FlatIntegerKeyMap & operator=(const FlatIntegerKeyMap &) = delete;
+
+                    /**
+                     * Allows to get the value for the given key, if the key is not
+                     * present then a new default constructed value is added for it.
+                     * @param key the key to get the value for
+                     * @return the reference to the value
+                     */
+                    inline VALUE_TYPE & operator[](const TKeyType key) {
+                        //The empty key value is stored aside from the buckets
+                        if (key == EMPTY_KEY) {
+                            m_is_empty_key_set = true;
+                            return m_empty_key_value;
+                        }
+
+                        //Search for the key or the first empty bucket
+                        uint_fast64_t bucket_idx = get_bucket_idx(key);
+                        while (m_buckets[bucket_idx].m_key != EMPTY_KEY) {
+                            if (m_buckets[bucket_idx].m_key == key) {
+                                return m_buckets[bucket_idx].m_value;
+                            }
+                            bucket_idx = (bucket_idx + 1) & m_buckets_mask;
+                        }
+
+                        //The key is not present, if the map is full then re-hash and find the empty bucket again
+                        if (m_num_elems >= m_max_num_elems) {
+                            LOG_WARNING << "The flat integer key map capacity " << m_max_num_elems
+                                    << " is exceeded, re-hashing into " << (2 * m_num_buckets)
+                                    << " buckets!" << END_LOG;
+                            re_hash(2 * m_num_buckets);
+                            bucket_idx = get_bucket_idx(key);
+                            while (m_buckets[bucket_idx].m_key != EMPTY_KEY) {
+                                bucket_idx = (bucket_idx + 1) & m_buckets_mask;
+                            }
+                        }
+
+                        //Claim the empty bucket
+                        ++m_num_elems;
+                        m_buckets[bucket_idx].m_key = key;
+                        return m_buckets[bucket_idx].m_value;
+                    }
+
+                    /**
+                     * Allows to find the value for the given key
+                     * @param key the key to find the value for
+                     * @return the pointer to the value or NULL if the key is not present
+                     */
+                    inline const VALUE_TYPE * find(const TKeyType key) const {
+                        if (key == EMPTY_KEY) {
+                            return (m_is_empty_key_set ? &m_empty_key_value : NULL);
+                        }
+
+                        //Search until the first empty bucket
+                        uint_fast64_t bucket_idx = get_bucket_idx(key);
+                        while (m_buckets[bucket_idx].m_key != EMPTY_KEY) {
+                            if (m_buckets[bucket_idx].m_key == key) {
+                                return &m_buckets[bucket_idx].m_value;
+                            }
+                            bucket_idx = (bucket_idx + 1) & m_buckets_mask;
+                        }
+
+                        LOG_DEBUG2 << "Encountered an empty bucket, the key " << key << " is unknown!" << END_LOG;
+
+                        return NULL;
+                    }
+
+                    /**
+                     * Allows to get the number of elements stored in the map
+                     * @return the number of elements stored in the map
+                     */
+                    inline size_t size() const {
+                        return m_num_elems + (m_is_empty_key_set ? 1 : 0);
+                    }
+
+                    /**
+                     * Allows to add the map memory usage into the memory breakdown,
+                     * the buckets store the keys together with the values
+                     * @param breakdown the memory breakdown to add to
+                     * @param level the m-gram level of the stored data
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown, const TModelLevel level) const {
+                        breakdown.add("FlatIntegerKeyMap", "buckets", level, m_num_buckets * sizeof (S_Bucket));
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~FlatIntegerKeyMap() {
+                        delete[] m_buckets;
+                    }
+
+                private:
+
+                    //The bucket structure storing the key and the value
+
+                    struct S_Bucket {
+                        TKeyType m_key;
+                        VALUE_TYPE m_value;
+                    };
+
+                    //Stores the number of buckets, a power of two
+                    uint_fast64_t m_num_buckets;
+                    //Stores the buckets mask, the number of buckets minus one
+                    uint_fast64_t m_buckets_mask;
+                    //Stores the number of elements stored in the buckets
+                    uint_fast64_t m_num_elems;
+                    //Stores the maximum number of elements, 7/8 of the buckets, to keep the probe
+                    //sequences short, there is always at least one empty bucket to stop the search
+                    uint_fast64_t m_max_num_elems;
+                    //Stores the buckets array
+                    S_Bucket * m_buckets;
+
+                    //Stores the flag indicating that there is a value for the empty key
+                    bool m_is_empty_key_set;
+                    //Stores the value for the empty key
+                    VALUE_TYPE m_empty_key_value;
+
+                    /**
+                     * Allows to allocate the given number of empty buckets
+                     * @param num_buckets the number of buckets, must be a power of two
+                     */
+                    inline void allocate_buckets(const uint_fast64_t num_buckets) {
+                        m_num_buckets = num_buckets;
+                        m_buckets_mask = m_num_buckets - 1;
+                        m_max_num_elems = m_num_buckets - max<uint_fast64_t>(m_num_buckets >> 3, 1);
+                        m_buckets = new S_Bucket[m_num_buckets];
+                        for (uint_fast64_t idx = 0; idx < m_num_buckets; ++idx) {
+                            m_buckets[idx].m_key = EMPTY_KEY;
+                            m_buckets[idx].m_value = VALUE_TYPE();
+                        }
+                    }
+
+                    /**
+                     * Allows to re-hash the map into the given number of buckets
+                     * @param num_buckets the new number of buckets, must be a power of two
+                     */
+                    inline void re_hash(const uint_fast64_t num_buckets) {
+                        S_Bucket * old_buckets = m_buckets;
+                        const uint_fast64_t old_num_buckets = m_num_buckets;
+
+                        allocate_buckets(num_buckets);
+
+                        for (uint_fast64_t idx = 0; idx < old_num_buckets; ++idx) {
+                            if (old_buckets[idx].m_key != EMPTY_KEY) {
+                                uint_fast64_t bucket_idx = get_bucket_idx(old_buckets[idx].m_key);
+                                while (m_buckets[bucket_idx].m_key != EMPTY_KEY) {
+                                    bucket_idx = (bucket_idx + 1) & m_buckets_mask;
+                                }
+                                m_buckets[bucket_idx] = old_buckets[idx];
+                            }
+                        }
+
+                        delete[] old_buckets;
+                    }
+
+                    /**
+                     * Allows to get the bucket index for the given key
+                     * @param key the key to compute the bucket index for
+                     * @return the resulting bucket index
+                     */
+                    inline uint_fast64_t get_bucket_idx(uint_fast64_t key) const {
+                        return mix_fasthash(key) & m_buckets_mask;
+                    }
+                };
+
+                template<typename VALUE_TYPE>
+                constexpr typename FlatIntegerKeyMap<VALUE_TYPE>::TKeyType FlatIntegerKeyMap<VALUE_TYPE>::EMPTY_KEY;
+
+                /**
+                 * This class wraps the std::unordered_map with the GreedyMemoryAllocator into
+                 * the interface of the FlatIntegerKeyMap, this is the original map of the tries.
+                 * @param VALUE_TYPE the value type
+                 */
+                template<typename VALUE_TYPE>
+                class UnorderedIntegerKeyMap {
+                public:
+                    //The key type of the map
+                    typedef uint64_t TKeyType;
+
+                    /**
+                     * The basic constructor that allows to instantiate the map for the given number of elements
+                     * @param num_elems the number of elements that will be stored in the map
+                     * @param mem_factor the memory factor for the greedy allocator, see reserve_mem_unordered_map
+                     */
+                    explicit UnorderedIntegerKeyMap(const size_t num_elems, const float mem_factor)
+                    : m_alloc_ptr(NULL), m_map_ptr(NULL) {
+                        reserve_mem_unordered_map<TMap, TAllocator>(&m_map_ptr, &m_alloc_ptr, num_elems, "Integer Key Map", mem_factor);
+                    }
+
+                    //The map owns its map and allocator, so copying it would free them twice
+                    UnorderedIntegerKeyMap(const UnorderedIntegerKeyMap &) = delete;
+                    UnorderedIntegerKeyMap & operator=(const UnorderedIntegerKeyMap &) = delete;
+
+                    /**
+                     * Allows to get the value for the given key, if the key is not
+                     * present then a new default constructed value is added for it.
+                     * @param key the key to get the value for
+                     * @return the reference to the value
+                     */
+                    inline VALUE_TYPE & operator[](const TKeyType key) {
+                        return m_map_ptr->operator[](key);
+                    }
+
+                    /**
+                     * Allows to find the value for the given key
+                     * @param key the key to find the value for
+                     * @return the pointer to the value or NULL if the key is not present
+                     */
+                    inline const VALUE_TYPE * find(const TKeyType key) const {
+                        typename TMap::const_iterator result = m_map_ptr->find(key);
+                        return ((result == m_map_ptr->end()) ? NULL : &result->second);
+                    }
+
+                    /**
+                     * Allows to get the number of elements stored in the map
+                     * @return the number of elements stored in the map
+                     */
+                    inline size_t size() const {
+                        return m_map_ptr->size();
+                    }
+
+                    /**
+                     * Allows to add the map memory usage into the memory breakdown,
+                     * the map nodes and buckets are in the greedy memory storage
+                     * @param breakdown the memory breakdown to add to
+                     * @param level the m-gram level of the stored data
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown, const TModelLevel level) const {
+                        breakdown.add("UnorderedIntegerKeyMap", "map", level, m_alloc_ptr->getStorageRef().getBufferSizeBytes());
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~UnorderedIntegerKeyMap() {
+                        deallocate_container<TMap, TAllocator>(&m_map_ptr, &m_alloc_ptr);
+                    }
+
+                private:
+                    //The type of key,value pairs to be stored in the map
+                    typedef pair< const TKeyType, VALUE_TYPE> TEntry;
+                    //The typedef for the map allocator
+                    typedef GreedyMemoryAllocator< TEntry > TAllocator;
+                    //The map type
+                    typedef unordered_map<TKeyType, VALUE_TYPE, std::hash<TKeyType>, std::equal_to<TKeyType>, TAllocator > TMap;
+
+                    //The allocator for the map
+                    TAllocator * m_alloc_ptr;
+                    //The map itself
+                    TMap * m_map_ptr;
+                };
+
+                /**
+                 * Allows to choose the integer key map implementation based on the configuration value
+                 * @param INTEGER_KEY_MAP_TYPE the integer key map type value
+                 * @param VALUE_TYPE the value type of the map
+                 */
+                template<IntegerKeyMapTypesEnum INTEGER_KEY_MAP_TYPE, typename VALUE_TYPE>
+                struct S_Integer_Key_Map_Type;
+
+                template<typename VALUE_TYPE>
+                struct S_Integer_Key_Map_Type<IntegerKeyMapTypesEnum::UNORDERED_INTEGER_KEY_MAP, VALUE_TYPE> {
+                    typedef UnorderedIntegerKeyMap<VALUE_TYPE> type;
+                };
+
+                template<typename VALUE_TYPE>
+                struct S_Integer_Key_Map_Type<IntegerKeyMapTypesEnum::FLAT_INTEGER_KEY_MAP, VALUE_TYPE> {
+                    typedef FlatIntegerKeyMap<VALUE_TYPE> type;
+                };
+            }
+        }
+    }
+}
+
+#endif	/* INTEGERKEYHASHMAP_HPP */
@@ -68,33 +68,20 @@ namespace uva {
                 template<typename TrieType, TModelLevel CURR_LEVEL, bool GET_BACK_OFF_CTX_ID, DebugLevelsEnum LOG_LEVEL = DebugLevelsEnum::DEBUG1>
                 inline TModelLevel search_m_gram_ctx_id(const TrieType & trie, const typename TrieType::WordIndexType::TWordIdType * const word_ids, TLongId & prev_ctx_id, TLongId & ctx_id) {
                     //Assert that this method is called for proper m-gram levels
-                    ASSERT_SANITY_THROW(((CURR_LEVEL < M_GRAM_LEVEL_2) || (CURR_LEVEL > M_GRAM_LEVEL_5)), string("The level: ") + std::to_string(CURR_LEVEL) + string(" is not supported yet!"));
+                    ASSERT_SANITY_THROW(((CURR_LEVEL < M_GRAM_LEVEL_2) || (CURR_LEVEL > MAX_SUPP_GRAM_LEVEL)), string("The level: ") + std::to_string(CURR_LEVEL) + string(" is not supported yet!"));
 
                     //The initial context for anything larger than a unigram is the first word id
                     ctx_id = word_ids[0];
 
-                    //If we are at least at a level 3 m-gram
-                    if (CURR_LEVEL >= M_GRAM_LEVEL_3) {
-                        if (GET_BACK_OFF_CTX_ID && (CURR_LEVEL == M_GRAM_LEVEL_3)) prev_ctx_id = ctx_id;
-                        if (trie.get_ctx_id(M_GRAM_LEVEL_2 - M_GRAM_LEVEL_2, word_ids[1], ctx_id)) {
-                            //If we are at least at a level 4 m-gram
-                            if (CURR_LEVEL >= M_GRAM_LEVEL_4) {
-                                if (GET_BACK_OFF_CTX_ID && (CURR_LEVEL == M_GRAM_LEVEL_4)) prev_ctx_id = ctx_id;
-                                if (trie.get_ctx_id(M_GRAM_LEVEL_3 - M_GRAM_LEVEL_2, word_ids[2], ctx_id)) {
-                                    //If we are at least at a level 5 m-gram
-                                    if (CURR_LEVEL >= M_GRAM_LEVEL_5) {
-                                        if (GET_BACK_OFF_CTX_ID && (CURR_LEVEL == M_GRAM_LEVEL_5)) prev_ctx_id = ctx_id;
-                                        if (trie.get_ctx_id(M_GRAM_LEVEL_4 - M_GRAM_LEVEL_2, word_ids[3], ctx_id)) {
-                                            return M_GRAM_LEVEL_5;
-                                        }
-                                    }
-                                    return M_GRAM_LEVEL_4;
-                                }
-                            }
-                            return M_GRAM_LEVEL_3;
+                    //Go up the levels, the loop bound is a template parameter so it gets unrolled
+                    for (TModelLevel level = M_GRAM_LEVEL_3; level <= CURR_LEVEL; ++level) {
+                        if (GET_BACK_OFF_CTX_ID && (CURR_LEVEL == level)) prev_ctx_id = ctx_id;
+                        if (!trie.get_ctx_id(level - M_GRAM_LEVEL_3, word_ids[level - M_GRAM_LEVEL_2], ctx_id)) {
+                            //The context of this level could not be found
+                            return level - 1;
                         }
                     }
-                    return M_GRAM_LEVEL_2;
+                    return CURR_LEVEL;
                 }
 
                 /**
@@ -108,7 +95,7 @@ namespace uva {
                  * @return true if the context was found otherwise false
                  */
                 template<typename TrieType, TModelLevel CURR_LEVEL, DebugLevelsEnum LOG_LEVEL>
-                inline void get_context_id(TrieType & trie, const T_Model_M_Gram<typename TrieType::WordIndexType> &gram, TLongId & ctx_id) {
+                inline void get_context_id(TrieType & trie, const typename TrieType::TModelMGram &gram, TLongId & ctx_id) {
                     //Perform sanity check for the level values they should be the same!
                     ASSERT_SANITY_THROW(CURR_LEVEL != gram.get_m_gram_level(),
                             string("The improper level values! Template level parameter = ") + std::to_string(CURR_LEVEL) +
@@ -197,7 +184,7 @@ namespace uva {
                  * @return true if there was nothing cached, otherwise false
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline bool get_cached_context_id(const T_Model_M_Gram<WordIndexType> &gram, TLongId & result) const {
+                inline bool get_cached_context_id(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> &gram, TLongId & result) const {
                     //Compute the context level
                     constexpr TModelLevel CONTEXT_LEVEL = CURR_LEVEL - 1;
                     //Check if this is the same m-gram
@@ -216,7 +203,7 @@ namespace uva {
                  * @param ctx_id the m-gram context id to cache.
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void set_cache_context_id(const T_Model_M_Gram<WordIndexType> &gram, TLongId & ctx_id) {
+                inline void set_cache_context_id(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> &gram, TLongId & ctx_id) {
                     //Compute the context level
                     constexpr TModelLevel CONTEXT_LEVEL = CURR_LEVEL - 1;
                     //Copy the context word ids
@@ -311,9 +298,11 @@ namespace uva {
                 TContextCacheEntry m_cached_ctx[MAX_LEVEL];
             };
 
-            //Define the template for instantiating the layered trie class children templates
+            //Define the template for instantiating the layered trie class children templates for all the supported levels
+#define INSTANTIATE_LAYERED_TRIE_TEMPLATES_LEVEL_NAME_TYPE(LEVEL, CLASS_NAME, WORD_IDX_TYPE) \
+            template class CLASS_NAME<LEVEL, WORD_IDX_TYPE >;
 #define INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(CLASS_NAME, WORD_IDX_TYPE) \
-            template class CLASS_NAME<M_GRAM_LEVEL_MAX, WORD_IDX_TYPE >;
+            INSTANTIATE_FOR_SUPPORTED_LEVELS(INSTANTIATE_LAYERED_TRIE_TEMPLATES_LEVEL_NAME_TYPE, CLASS_NAME, WORD_IDX_TYPE)
 
         }
     }
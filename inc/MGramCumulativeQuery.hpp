@@ -35,6 +35,7 @@
 #include "QueryMGram.hpp"
 #include "TextPieceReader.hpp"
 #include "MGramQuery.hpp"
+#include "ResultWriter.hpp"
 
 #include "AWordIndex.hpp"
 #include "BasicWordIndex.hpp"
@@ -81,36 +82,72 @@ namespace uva {
                 }
 
                 /**
-                 * Allows to log the query results after its execution.
-                 * Different logging is done based on enabled logging level
-                 * and the class template parameters.
+                 * Allows to write the query results after its execution.
+                 * The results are written in the format of the given writer,
+                 * the additional diagnostics are logged depending on the
+                 * enabled logging level.
+                 * @param writer the query result writer
                  */
-                inline void log_results() const {
-                    //Initialize the current index, with the proper start value
-                    TModelLevel curr_idx = BASE::m_query.m_gram.get_begin_word_idx();
+                inline void log_results(ResultWriter & writer) const {
+                    static const char sub_separator[] = "---";
+                    static const char separator[] = "-------------------------------------------";
+                    const TModelLevel begin_word_idx = BASE::m_query.m_gram.get_begin_word_idx();
+                    const TModelLevel end_word_idx = BASE::m_query.m_gram.get_end_word_idx();
+                    const ResultFormatsEnum format = writer.get_format();
+
+                    //Compute the cumulative probability
                     TLogProbBackOff cumulative_prob = ZERO_PROB_WEIGHT;
-
-                    //Print the intermediate results
-                    for (; curr_idx <= BASE::m_query.m_gram.get_end_word_idx(); ++curr_idx) {
-                        const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str(curr_idx + 1);
-                        LOG_RESULT << "  log_" << LOG_PROB_WEIGHT_BASE << "( Prob( " << gram_str
-                                << " ) ) = " << SSTR(BASE::m_query.m_probs[curr_idx]) << END_LOG;
-                        LOG_INFO << "  Prob( " << gram_str << " ) = "
-                                << SSTR(pow(LOG_PROB_WEIGHT_BASE, BASE::m_query.m_probs[curr_idx])) << END_LOG;
+                    for (TModelLevel curr_idx = begin_word_idx; curr_idx <= end_word_idx; ++curr_idx) {
                         if (BASE::m_query.m_probs[curr_idx] > ZERO_LOG_PROB_WEIGHT) {
                             cumulative_prob += BASE::m_query.m_probs[curr_idx];
                         }
                     }
-                    LOG_RESULT << "---" << END_LOG;
-
-                    //Print the total cumulative probability if needed
-                    const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str();
-                    LOG_RESULT << "  log_" << LOG_PROB_WEIGHT_BASE << "( Prob( " << gram_str
-                            << " ) ) = " << SSTR(cumulative_prob) << END_LOG;
-                    LOG_INFO << "  Prob( " << gram_str << " ) = "
-                            << SSTR(pow(LOG_PROB_WEIGHT_BASE, cumulative_prob)) << END_LOG;
 
-                    LOG_RESULT << "-------------------------------------------" << END_LOG;
+                    //Print the query results
+                    switch (format) {
+                        case ResultFormatsEnum::LOG_FORMAT:
+                        {
+                            //Print the intermediate results
+                            for (TModelLevel curr_idx = begin_word_idx; curr_idx <= end_word_idx; ++curr_idx) {
+                                const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str(curr_idx + 1);
+                                writer.write_log_prob(gram_str, BASE::m_query.m_probs[curr_idx]);
+                                writer.end_record();
+                                LOG_INFO << "  Prob( " << gram_str << " ) = "
+                                        << SSTR(pow(LOG_PROB_WEIGHT_BASE, BASE::m_query.m_probs[curr_idx])) << END_LOG;
+                            }
+                            writer.write_log_line(sub_separator, sizeof (sub_separator) - 1);
+
+                            //Print the total cumulative probability
+                            const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str();
+                            writer.write_log_prob(gram_str, cumulative_prob);
+                            writer.end_record();
+                            LOG_INFO << "  Prob( " << gram_str << " ) = "
+                                    << SSTR(pow(LOG_PROB_WEIGHT_BASE, cumulative_prob)) << END_LOG;
+
+                            writer.write_log_line(separator, sizeof (separator) - 1);
+                            break;
+                        }
+                        case ResultFormatsEnum::TSV_FORMAT:
+                            //The m-gram, the cumulative probability and then the sub-m-gram probabilities
+                            writer.write_tokens(BASE::m_query.m_gram.tokens(), begin_word_idx, end_word_idx);
+                            writer.write_tsv_prob(cumulative_prob);
+                            for (TModelLevel curr_idx = begin_word_idx; curr_idx <= end_word_idx; ++curr_idx) {
+                                writer.write_tsv_prob(BASE::m_query.m_probs[curr_idx]);
+                            }
+                            writer.write('\n');
+                            break;
+                        case ResultFormatsEnum::BINARY_FORMAT:
+                            //The number of sub-m-grams, the cumulative probability and then the sub-m-gram probabilities
+                            writer.write_binary(static_cast<uint8_t> (end_word_idx - begin_word_idx + 1));
+                            writer.write_binary(cumulative_prob);
+                            for (TModelLevel curr_idx = begin_word_idx; curr_idx <= end_word_idx; ++curr_idx) {
+                                writer.write_binary(BASE::m_query.m_probs[curr_idx]);
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                    writer.end_record();
                 }
 
                 /**
@@ -140,24 +177,6 @@ namespace uva {
                     LOG_DEBUG << "Finished executing:" << (string) BASE::m_query.m_gram << END_LOG;
                 }
             };
-
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-#define INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, WORD_INDEX_TYPE); \
-            template class T_M_Gram_Cumulative_Query<C2DHybridTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<C2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<C2WArrayTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<W2CArrayTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<W2CHybridTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<G2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Cumulative_Query<H2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>;
-
-#define INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL(M_GRAM_LEVEL); \
-            INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, BasicWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, CountingWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, TOptBasicWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, TOptCountWordIndex);
-
-            INSTANTIATE_TYPEDEF_M_GRAM_CUMULATIVE_QUERY_LEVEL(M_GRAM_LEVEL_MAX);
         }
     }
 }
@@ -35,6 +35,7 @@
 #include "QueryMGram.hpp"
 #include "TextPieceReader.hpp"
 #include "MGramQuery.hpp"
+#include "ResultWriter.hpp"
 
 #include "AWordIndex.hpp"
 #include "BasicWordIndex.hpp"
@@ -79,20 +80,43 @@ namespace uva {
                 }
 
                 /**
-                 * Allows to log the query results after its execution.
-                 * Different logging is done based on enabled logging level
-                 * and the class template parameters.
+                 * Allows to write the query results after its execution.
+                 * The results are written in the format of the given writer,
+                 * the additional diagnostics are logged depending on the
+                 * enabled logging level.
+                 * @param writer the query result writer
                  */
-                inline void log_results() const {
-                    //Print the query results
-                    const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str(BASE::m_query.m_gram.get_m_gram_level());
-
-                    LOG_RESULT << "  log_" << LOG_PROB_WEIGHT_BASE << "( Prob( " << gram_str
-                            << " ) ) = " << SSTR(BASE::m_query.m_probs[BASE::m_query.m_gram.get_end_word_idx()]) << END_LOG;
-                    LOG_INFO << "  Prob( " << gram_str << " ) = "
-                            << SSTR(pow(LOG_PROB_WEIGHT_BASE, BASE::m_query.m_probs[BASE::m_query.m_gram.get_end_word_idx()])) << END_LOG;
+                inline void log_results(ResultWriter & writer) const {
+                    static const char separator[] = "-------------------------------------------";
+                    const TModelLevel end_word_idx = BASE::m_query.m_gram.get_end_word_idx();
+                    const TLogProbBackOff prob = BASE::m_query.m_probs[end_word_idx];
 
-                    LOG_RESULT << "-------------------------------------------" << END_LOG;
+                    //Print the query results
+                    switch (writer.get_format()) {
+                        case ResultFormatsEnum::LOG_FORMAT:
+                        {
+                            const string gram_str = BASE::m_query.m_gram.get_mgram_prob_str(BASE::m_query.m_gram.get_m_gram_level());
+
+                            writer.write_log_prob(gram_str, prob);
+                            writer.end_record();
+                            LOG_INFO << "  Prob( " << gram_str << " ) = "
+                                    << SSTR(pow(LOG_PROB_WEIGHT_BASE, prob)) << END_LOG;
+
+                            writer.write_log_line(separator, sizeof (separator) - 1);
+                            break;
+                        }
+                        case ResultFormatsEnum::TSV_FORMAT:
+                            writer.write_tokens(BASE::m_query.m_gram.tokens(), BASE::m_query.m_gram.get_begin_word_idx(), end_word_idx);
+                            writer.write_tsv_prob(prob);
+                            writer.write('\n');
+                            break;
+                        case ResultFormatsEnum::BINARY_FORMAT:
+                            writer.write_binary(prob);
+                            break;
+                        default:
+                            break;
+                    }
+                    writer.end_record();
                 }
 
                 /**
@@ -122,24 +146,6 @@ namespace uva {
                     LOG_DEBUG << "Finished executing:" << (string) BASE::m_query.m_gram << END_LOG;
                 }
             };
-
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-#define INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, WORD_INDEX_TYPE); \
-            template class T_M_Gram_Single_Query<C2DHybridTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<C2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<C2WArrayTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<W2CArrayTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<W2CHybridTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<G2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>; \
-            template class T_M_Gram_Single_Query<H2DMapTrie<M_GRAM_LEVEL, WORD_INDEX_TYPE>>;
-
-#define INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL(M_GRAM_LEVEL); \
-            INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, BasicWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, CountingWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, TOptBasicWordIndex); \
-            INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL_WORD_IDX(M_GRAM_LEVEL, TOptCountWordIndex);
-
-            INSTANTIATE_TYPEDEF_M_GRAM_SINGLE_QUERY_LEVEL(M_GRAM_LEVEL_MAX);
         }
     }
 }
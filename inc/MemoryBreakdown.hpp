@@ -0,0 +1,279 @@
+/*
+ * File:   MemoryBreakdown.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 9:10 PM
+ */
+
+#ifndef MEMORYBREAKDOWN_HPP
+#define	MEMORYBREAKDOWN_HPP
+
+#include <string>       // std::string
+#include <vector>       // std::vector
+#include <ostream>      // std::ostream
+#include <iomanip>      // std::setw
+#include <sstream>      // std::stringstream
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+
+using namespace std;
+using namespace uva::smt::logging;
+using namespace uva::smt::tries::m_grams;
+using namespace uva::smt::exceptions;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            /**
+             * This class stores the exact memory accounting of a trie: the number of bytes
+             * allocated by every data structure of the trie, per component and per m-gram
+             * level. The structures add their entries in their memory_breakdown methods,
+             * the entries not related to one m-gram level, e.g. the word index, are added
+             * with the NO_LEVEL level. The breakdown can be logged as a table or written
+             * as JSON, both with the number of bytes per m-gram.
+             *
+             * The accounted bytes are the sizes of the allocated arrays and pools, i.e.
+             * the used and the reserved but unused memory, without the heap overhead.
+             */
+            class MemoryBreakdown {
+            public:
+                //The level value of the entries that are not related to one m-gram level
+                static constexpr TModelLevel NO_LEVEL = 0;
+
+                //The memory breakdown entry
+
+                struct S_Entry {
+                    //The data structure name
+                    string m_structure;
+                    //The component name of the data structure
+                    string m_component;
+                    //The m-gram level or NO_LEVEL
+                    TModelLevel m_level;
+                    //The number of bytes
+                    uint64_t m_bytes;
+                };
+
+                /**
+                 * The basic constructor
+                 * @param name the name of the accounted trie
+                 * @param max_level the maximum m-gram level of the trie
+                 */
+                explicit MemoryBreakdown(const string & name, const TModelLevel max_level)
+                : m_name(name), m_max_level(max_level), m_num_m_grams(max_level + 1, 0) {
+                }
+
+                /**
+                 * Allows to add the memory breakdown entry, the entries of the same
+                 * structure, component and level are summed up
+                 * @param structure the data structure name
+                 * @param component the component name of the data structure
+                 * @param level the m-gram level or NO_LEVEL
+                 * @param bytes the number of bytes
+                 */
+                inline void add(const string & structure, const string & component,
+                        const TModelLevel level, const uint64_t bytes) {
+                    ASSERT_SANITY_THROW((level > m_max_level), string("The m-gram level: ") +
+                            std::to_string(level) + string(" is above the maximum: ") + std::to_string(m_max_level));
+
+                    for (S_Entry & entry : m_entries) {
+                        if ((entry.m_level == level) && (entry.m_structure == structure) && (entry.m_component == component)) {
+                            entry.m_bytes += bytes;
+                            return;
+                        }
+                    }
+                    m_entries.push_back({structure, component, level, bytes});
+                }
+
+                /**
+                 * Allows to set the number of m-grams of the given level
+                 * @param level the m-gram level
+                 * @param num_m_grams the number of m-grams
+                 */
+                inline void set_num_m_grams(const TModelLevel level, const uint64_t num_m_grams) {
+                    m_num_m_grams[level] = num_m_grams;
+                }
+
+                /**
+                 * Allows to get the total number of bytes of the given level
+                 * @param level the m-gram level or NO_LEVEL
+                 * @return the total number of bytes of the level entries
+                 */
+                inline uint64_t get_level_bytes(const TModelLevel level) const {
+                    uint64_t bytes = 0;
+                    for (const S_Entry & entry : m_entries) {
+                        if (entry.m_level == level) {
+                            bytes += entry.m_bytes;
+                        }
+                    }
+                    return bytes;
+                }
+
+                /**
+                 * Allows to get the total number of bytes
+                 * @return the total number of bytes
+                 */
+                inline uint64_t get_total_bytes() const {
+                    uint64_t bytes = 0;
+                    for (const S_Entry & entry : m_entries) {
+                        bytes += entry.m_bytes;
+                    }
+                    return bytes;
+                }
+
+                /**
+                 * Allows to get the total number of m-grams
+                 * @return the total number of m-grams
+                 */
+                inline uint64_t get_num_m_grams() const {
+                    uint64_t num_m_grams = 0;
+                    for (TModelLevel level = M_GRAM_LEVEL_1; level <= m_max_level; ++level) {
+                        num_m_grams += m_num_m_grams[level];
+                    }
+                    return num_m_grams;
+                }
+
+                /**
+                 * Allows to log the memory breakdown as a table, the level totals
+                 * are given with the number of bytes per m-gram of the level
+                 */
+                void log_table() const {
+                    LOG_USAGE << "The '" << m_name << "' memory breakdown:" << END_LOG;
+                    LOG_USAGE << get_row("Structure", "Component", "Level", "Bytes", "Bytes/m-gram") << END_LOG;
+                    for (const S_Entry & entry : m_entries) {
+                        LOG_USAGE << get_row(entry.m_structure, entry.m_component, get_level_str(entry.m_level),
+                                std::to_string(entry.m_bytes), get_level_bytes_per_m_gram_str(entry.m_bytes, entry.m_level)) << END_LOG;
+                    }
+                    for (TModelLevel level = NO_LEVEL; level <= m_max_level; ++level) {
+                        const uint64_t bytes = get_level_bytes(level);
+                        LOG_USAGE << get_row("Total", "", get_level_str(level), std::to_string(bytes),
+                                get_level_bytes_per_m_gram_str(bytes, level)) << END_LOG;
+                    }
+                    LOG_USAGE << get_row("Total", "", "all", std::to_string(get_total_bytes()),
+                            get_bytes_per_m_gram_str(get_total_bytes(), get_num_m_grams())) << END_LOG;
+                }
+
+                /**
+                 * Allows to write the memory breakdown as a JSON object
+                 * @param out the stream to write into
+                 */
+                void write_json(ostream & out) const {
+                    out << "{\"trie\":\"" << m_name << "\""
+                            << ",\"total_bytes\":" << get_total_bytes()
+                            << ",\"num_m_grams\":" << get_num_m_grams()
+                            << ",\"bytes_per_m_gram\":" << get_bytes_per_m_gram(get_total_bytes(), get_num_m_grams())
+                            << ",\"shared_bytes\":" << get_level_bytes(NO_LEVEL)
+                            << ",\"levels\":[";
+                    for (TModelLevel level = M_GRAM_LEVEL_1; level <= m_max_level; ++level) {
+                        const uint64_t bytes = get_level_bytes(level);
+                        out << ((level == M_GRAM_LEVEL_1) ? "" : ",")
+                                << "{\"level\":" << std::to_string(level)
+                                << ",\"num_m_grams\":" << m_num_m_grams[level]
+                                << ",\"bytes\":" << bytes
+                                << ",\"bytes_per_m_gram\":" << get_bytes_per_m_gram(bytes, m_num_m_grams[level]) << "}";
+                    }
+                    out << "],\"components\":[";
+                    for (size_t idx = 0; idx < m_entries.size(); ++idx) {
+                        const S_Entry & entry = m_entries[idx];
+                        out << ((idx == 0) ? "" : ",")
+                                << "{\"structure\":\"" << entry.m_structure << "\""
+                                << ",\"component\":\"" << entry.m_component << "\""
+                                << ",\"level\":" << std::to_string(entry.m_level)
+                                << ",\"bytes\":" << entry.m_bytes << "}";
+                    }
+                    out << "]}" << endl;
+                }
+
+            private:
+                //Stores the name of the accounted trie
+                const string m_name;
+                //Stores the maximum m-gram level
+                const TModelLevel m_max_level;
+                //Stores the number of m-grams per level, indexed by the level
+                vector<uint64_t> m_num_m_grams;
+                //Stores the memory breakdown entries, in the order they were added
+                vector<S_Entry> m_entries;
+
+                /**
+                 * Allows to get the number of bytes per m-gram
+                 * @param bytes the number of bytes
+                 * @param num_m_grams the number of m-grams
+                 * @return the number of bytes per m-gram or zero if there are no m-grams
+                 */
+                static inline double get_bytes_per_m_gram(const uint64_t bytes, const uint64_t num_m_grams) {
+                    return (num_m_grams == 0) ? 0.0 : (((double) bytes) / num_m_grams);
+                }
+
+                /**
+                 * Allows to get the number of bytes per m-gram string
+                 * @param bytes the number of bytes
+                 * @param num_m_grams the number of m-grams
+                 * @return the number of bytes per m-gram string or "-" if there are no m-grams
+                 */
+                static inline string get_bytes_per_m_gram_str(const uint64_t bytes, const uint64_t num_m_grams) {
+                    if (num_m_grams == 0) {
+                        return "-";
+                    } else {
+                        stringstream str;
+                        str << fixed << setprecision(2) << get_bytes_per_m_gram(bytes, num_m_grams);
+                        return str.str();
+                    }
+                }
+
+                /**
+                 * Allows to get the number of bytes per m-gram string of the level
+                 * @param bytes the number of bytes
+                 * @param level the m-gram level or NO_LEVEL
+                 * @return the number of bytes per m-gram string or "-" for NO_LEVEL
+                 */
+                inline string get_level_bytes_per_m_gram_str(const uint64_t bytes, const TModelLevel level) const {
+                    return get_bytes_per_m_gram_str(bytes, (level == NO_LEVEL) ? 0 : m_num_m_grams[level]);
+                }
+
+                /**
+                 * Allows to get the level string
+                 * @param level the m-gram level or NO_LEVEL
+                 * @return the level string or "-" for NO_LEVEL
+                 */
+                static inline string get_level_str(const TModelLevel level) {
+                    return (level == NO_LEVEL) ? string("-") : std::to_string(level);
+                }
+
+                /**
+                 * Allows to get the table row string
+                 * @return the table row string
+                 */
+                static inline string get_row(const string & structure, const string & component,
+                        const string & level, const string & bytes, const string & bytes_per_m_gram) {
+                    stringstream str;
+                    str << left << setw(24) << structure << setw(20) << component << right
+                            << setw(6) << level << setw(14) << bytes << setw(14) << bytes_per_m_gram;
+                    return str.str();
+                }
+            };
+        }
+    }
+}
+
+#endif	/* MEMORYBREAKDOWN_HPP */
+
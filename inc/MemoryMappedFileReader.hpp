@@ -49,14 +49,12 @@
 
 using namespace std;
 using namespace uva::smt::utils::text;
+using namespace uva::smt::file::__MemoryMappedFileReader;
 
 namespace uva {
     namespace smt {
         namespace file {
 
-            //The value of the undefined file descriptor
-            static const int UNDEFINED_FILE_DESCRIPTOR = -1;
-
             /**
              * This is the file reader for the memory mapped file. It is supposed to provide fast memory reads from large files.
              * 
@@ -106,14 +104,23 @@ namespace uva {
 
                 //The file descriptor of the mapped file
                 int m_fileDesc;
+                //Stores true if the file is mapped for sequential reading,
+                //without populating it and with dropping the read pages
+                const bool m_is_sequential;
+                //Stores the pointer to the first not yet dropped page
+                const char * m_drop_ptr;
 
             public:
 
                 /**
                  * The basic constructor
                  * @param fileName the file name
+                 * @param is_sequential if false then the file is populated into memory
+                 * right away, if true then the file is only advised to be read sequentially
+                 * and the memory pages of the already read data are dropped on the way.
                  */
-                MemoryMappedFileReader(const char * fileName) : AFileReader(), m_fileDesc(0) {
+                MemoryMappedFileReader(const char * fileName, const bool is_sequential = false)
+                : AFileReader(), m_fileDesc(0), m_is_sequential(is_sequential), m_drop_ptr(NULL) {
                     m_fileDesc = open(fileName, O_RDONLY);
                     LOG_DEBUG << "Opened the file '" << fileName << "' descriptor: " << SSTR(m_fileDesc) << END_LOG;
 
@@ -138,28 +145,81 @@ namespace uva {
                             //  MAP_POPULATE Populate (prefault) page tables for a mapping.
                             //For a file mapping, this causes read-ahead on the file. Later
                             //accesses to the mapping will not be blocked by page faults.
+                            //NOTE: In the sequential mode we do not populate, but advise the
+                            //kernel that the pages will be needed soon and in the sequential
+                            //order. This allows for aggressive read-ahead without faulting in
+                            //the entire file first.
 #if __APPLE__
                             void * beginPtr = mmap(NULL, len, PROT_READ, MAP_PRIVATE, m_fileDesc, 0);
 #else
-                            void * beginPtr = mmap(NULL, len, PROT_READ, MAP_PRIVATE | MAP_POPULATE, m_fileDesc, 0);
+                            void * beginPtr = mmap(NULL, len, PROT_READ,
+                                    (m_is_sequential ? MAP_PRIVATE : MAP_PRIVATE | MAP_POPULATE), m_fileDesc, 0);
 #endif
                             LOG_DEBUG << "Memory mapping the file '" << fileName << "' gave: " << SSTR(beginPtr) << " pointer." << END_LOG;
 
+                            if (beginPtr == MAP_FAILED) {
+                                LOG_ERROR << "Could not memory map the file '" << fileName << "'! ERROR: " << strerror(errno) << END_LOG;
+                                beginPtr = NULL;
+                            } else {
+                                if (m_is_sequential) {
+                                    (void) madvise(beginPtr, len, MADV_SEQUENTIAL);
+                                    (void) madvise(beginPtr, len, MADV_WILLNEED);
+                                }
+                            }
+
                             //Set the data to the base class
                             TextPieceReader::set(beginPtr, len);
+                            m_drop_ptr = static_cast<const char *> (beginPtr);
                         }
                     }
                 }
 
+                /**
+                 * The basic destructor, un-maps and closes the file if needed
+                 */
+                virtual ~MemoryMappedFileReader() {
+                    close();
+                }
+
                 /**
                  * Allows to log the information about the instantiated file reader type
                  */
                 virtual void log_reader_type_usage_info() {
-                    LOG_USAGE << "Using the <" << __FILE__ << "> file reader!" << END_LOG;
+                    LOG_USAGE << "Using the <" << __FILE__ << "> file reader"
+                            << (m_is_sequential ? " in sequential mode" : "") << "!" << END_LOG;
+                }
+
+                /**
+                 * This method allows to reset the reading process and
+                 * start reading the file from the first line again.
+                 */
+                virtual void reset() {
+                    const void * filePtr = TextPieceReader::get_begin_ptr();
+                    const size_t len = TextPieceReader::length();
+                    if (m_is_sequential && (filePtr != NULL)) {
+                        //The pages could have been dropped, so advise again
+                        (void) madvise(const_cast<void*> (filePtr), len, MADV_WILLNEED);
+                    }
+                    TextPieceReader::set(filePtr, len);
+                    m_drop_ptr = static_cast<const char *> (filePtr);
                 }
 
                 inline bool get_first_line(TextPieceReader& out) {
-                    return TextPieceReader::get_first_line(out);
+                    const bool result = TextPieceReader::get_first_line(out);
+
+                    //In the sequential mode, drop the pages that we have read already
+                    if (m_is_sequential && result) {
+                        const char * line_ptr = out.get_begin_c_str();
+                        if (static_cast<size_t> (line_ptr - m_drop_ptr) >= MMAP_DROP_CHUNK_BYTES) {
+                            //Only drop whole pages before the current line
+                            const size_t drop_len = (line_ptr - m_drop_ptr) & ~(MMAP_DROP_CHUNK_BYTES - 1);
+                            LOG_DEBUG1 << "Dropping " << drop_len << " bytes of read memory mapped file pages" << END_LOG;
+                            (void) madvise(const_cast<char *> (m_drop_ptr), drop_len, MADV_DONTNEED);
+                            m_drop_ptr += drop_len;
+                        }
+                    }
+
+                    return result;
                 }
                 
                 /**
@@ -246,6 +246,26 @@ namespace uva {
                         return true;
                     }
 
+                    /**
+                     * @see AWordIndex
+                     * While the disposable word index is present its memory is accounted for
+                     */
+                    inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                        if (m_disp_word_index_ptr != NULL) {
+                            m_disp_word_index_ptr->memory_breakdown(breakdown);
+                        }
+                        if (m_word_buckets != NULL) {
+                            breakdown.add("OptimizingWordIndex", "buckets", MemoryBreakdown::NO_LEVEL, m_num_buckets * sizeof (TBucketEntry));
+                            uint64_t strings_bytes = 0;
+                            for (size_t idx = 0; idx < m_num_buckets; ++idx) {
+                                if (m_word_buckets[idx].m_word != NULL) {
+                                    strings_bytes += m_word_buckets[idx].m_len;
+                                }
+                            }
+                            breakdown.add("OptimizingWordIndex", "strings", MemoryBreakdown::NO_LEVEL, strings_bytes);
+                        }
+                    }
+
                     /**
                      * The basic destructor
                      */
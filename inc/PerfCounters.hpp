@@ -0,0 +1,276 @@
+/*
+ * File:   PerfCounters.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 11:40 PM
+ */
+
+#ifndef PERFCOUNTERS_HPP
+#define	PERFCOUNTERS_HPP
+
+#include <string>       // std::string
+#include <sstream>      // std::stringstream
+#include <iomanip>      // std::setprecision
+#include <cstring>      // std::memset std::strerror
+#include <cerrno>       // errno
+#include <inttypes.h>   // std::uint64_t
+
+#if defined(__linux__)
+#include <unistd.h>             // syscall read close
+#include <sys/syscall.h>        // __NR_perf_event_open
+#include <linux/perf_event.h>   // perf_event_attr
+#endif
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "StatisticsMonitor.hpp"
+
+using namespace std;
+using namespace uva::smt::logging;
+
+namespace uva {
+    namespace smt {
+        namespace monitore {
+
+            //Defines the supported hardware performance events
+            enum PerfEventsEnum {
+                CYCLES_EVENT = 0,
+                INSTRUCTIONS_EVENT = CYCLES_EVENT + 1,
+                LLC_MISSES_EVENT = INSTRUCTIONS_EVENT + 1,
+                DTLB_MISSES_EVENT = LLC_MISSES_EVENT + 1,
+                BRANCH_MISSES_EVENT = DTLB_MISSES_EVENT + 1,
+                size_event = BRANCH_MISSES_EVENT + 1
+            };
+
+            /**
+             * This structure stores the times and the hardware performance
+             * counter values at some moment of the program execution.
+             */
+            struct SPerfCounts {
+                //The CPU time in seconds
+                double m_cpu_time;
+                //The wall-clock time in seconds
+                double m_wall_time;
+                //The counter values, indexed by the PerfEventsEnum values
+                uint64_t m_values[PerfEventsEnum::size_event];
+
+                SPerfCounts() : m_cpu_time(0.0), m_wall_time(0.0) {
+                    memset(m_values, 0, sizeof (m_values));
+                }
+            };
+
+            typedef SPerfCounts TPerfCounts;
+
+            /**
+             * This class gives access to the hardware performance counters of the process,
+             * the counters are opened with perf_event_open once and keep counting until the
+             * program exits, the phases compute the differences of the read counter values.
+             * The counters are inherited by the threads started after they are opened, e.g.
+             * the parallel build threads, and count the user space events only, so they
+             * also work with the default perf_event_paranoid setting. If a counter can not
+             * be opened, e.g. in a virtual machine or without perf support, it is not
+             * reported and the phases degrade to the CPU and wall-clock times only.
+             * This class is a trivial singleton
+             */
+            class PerfCounters {
+            public:
+
+                /**
+                 * Allows to enable the performance counters, opens the counters and
+                 * warns about the ones that are not available. Is to be called once,
+                 * before any thread that is to be counted is started.
+                 */
+                static void enable() {
+                    is_enabled() = true;
+#if defined(__linux__)
+                    const uint32_t types[PerfEventsEnum::size_event] = {
+                        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+                    };
+                    const uint64_t configs[PerfEventsEnum::size_event] = {
+                        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                        PERF_COUNT_HW_BRANCH_MISSES
+                    };
+                    for (size_t idx = 0; idx < PerfEventsEnum::size_event; ++idx) {
+                        struct perf_event_attr attr;
+                        memset(&attr, 0, sizeof (attr));
+                        attr.size = sizeof (attr);
+                        attr.type = types[idx];
+                        attr.config = configs[idx];
+                        attr.exclude_kernel = 1;
+                        attr.exclude_hv = 1;
+                        attr.inherit = 1;
+                        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                        get_fds()[idx] = static_cast<int> (syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+                        if (get_fds()[idx] < 0) {
+                            LOG_WARNING << "The '" << get_event_name(idx) << "' performance counter is not available: "
+                                    << strerror(errno) << END_LOG;
+                        }
+                    }
+#else
+                    LOG_WARNING << "The performance counters are not supported on this platform, "
+                            << "only the times are reported!" << END_LOG;
+#endif
+                }
+
+                /**
+                 * Allows to check if the performance counters are enabled
+                 * @return the reference to the enabled flag
+                 */
+                static inline bool & is_enabled() {
+                    static bool is_enabled = false;
+                    return is_enabled;
+                }
+
+                /**
+                 * Allows to read the current times and counter values
+                 * @param counts the structure to read into
+                 */
+                static void read_counts(TPerfCounts & counts) {
+                    counts.m_cpu_time = StatisticsMonitor::getCPUTime();
+                    counts.m_wall_time = StatisticsMonitor::getWallTime();
+#if defined(__linux__)
+                    for (size_t idx = 0; idx < PerfEventsEnum::size_event; ++idx) {
+                        uint64_t data[3] = {0, 0, 0};
+                        if ((get_fds()[idx] >= 0) && (read(get_fds()[idx], data, sizeof (data)) == sizeof (data))) {
+                            //Scale the value in case the counter was multiplexed
+                            counts.m_values[idx] = ((data[2] > 0) && (data[2] < data[1]))
+                                    ? static_cast<uint64_t> (((double) data[0]) * data[1] / data[2]) : data[0];
+                        }
+                    }
+#endif
+                }
+
+                /**
+                 * Allows to report the times and the counter values of the phase
+                 * @param phase the phase name
+                 * @param start the counts at the phase start
+                 * @param end the counts at the phase end
+                 * @param num_items the number of items, e.g. queries, processed
+                 *        in the phase or zero if no per item values are needed
+                 */
+                static void report(const string & phase, const TPerfCounts & start,
+                        const TPerfCounts & end, const uint64_t num_items) {
+                    LOG_USAGE << "Counters of '" << phase << "': cpu=" << (end.m_cpu_time - start.m_cpu_time)
+                            << " sec, wall=" << (end.m_wall_time - start.m_wall_time) << " sec"
+                            << get_counters_str(start, end, 1) << END_LOG;
+                    if (num_items > 0) {
+                        LOG_USAGE << "Counters of '" << phase << "' per item (" << num_items << "): "
+                                << "cpu=" << ((end.m_cpu_time - start.m_cpu_time) * 1.0e9 / num_items) << " nsec"
+                                << get_counters_str(start, end, num_items) << END_LOG;
+                    }
+                }
+
+            private:
+
+                PerfCounters() {
+                }
+
+                /**
+                 * Allows to get the counter file descriptors, the negative ones are not available
+                 * @return the counter file descriptors, indexed by the PerfEventsEnum values
+                 */
+                static inline int * get_fds() {
+                    static int fds[PerfEventsEnum::size_event] = {-1, -1, -1, -1, -1};
+                    return fds;
+                }
+
+                /**
+                 * Allows to get the performance event name
+                 * @param idx the PerfEventsEnum value
+                 * @return the event name
+                 */
+                static inline const char * get_event_name(const size_t idx) {
+                    static const char * const names[PerfEventsEnum::size_event] = {
+                        "cycles", "instructions", "LLC-misses", "dTLB-misses", "branch-misses"
+                    };
+                    return names[idx];
+                }
+
+                /**
+                 * Allows to get the string of the available counter differences
+                 * @param start the counts at the phase start
+                 * @param end the counts at the phase end
+                 * @param num_items the number to divide the differences by
+                 * @return the counters string
+                 */
+                static string get_counters_str(const TPerfCounts & start, const TPerfCounts & end, const uint64_t num_items) {
+                    stringstream str;
+                    str << fixed << setprecision((num_items > 1) ? 2 : 0);
+                    for (size_t idx = 0; idx < PerfEventsEnum::size_event; ++idx) {
+                        if (get_fds()[idx] >= 0) {
+                            str << ", " << get_event_name(idx) << "="
+                                    << (((double) (end.m_values[idx] - start.m_values[idx])) / num_items);
+                        }
+                    }
+                    const uint64_t cycles = end.m_values[CYCLES_EVENT] - start.m_values[CYCLES_EVENT];
+                    if ((get_fds()[CYCLES_EVENT] >= 0) && (get_fds()[INSTRUCTIONS_EVENT] >= 0) && (cycles > 0)) {
+                        str << setprecision(2) << ", IPC=" << (((double) (end.m_values[INSTRUCTIONS_EVENT]
+                                - start.m_values[INSTRUCTIONS_EVENT])) / cycles);
+                    }
+                    return str.str();
+                }
+            };
+
+            /**
+             * This class measures one program phase, it reads the counts when
+             * created and reports the phase when stopped. If the performance
+             * counters are not enabled then it does nothing.
+             */
+            class PerfPhase {
+            public:
+
+                /**
+                 * The basic constructor, starts the phase
+                 * @param name the phase name
+                 */
+                explicit PerfPhase(const string & name) : m_name(name) {
+                    if (PerfCounters::is_enabled()) {
+                        PerfCounters::read_counts(m_start);
+                    }
+                }
+
+                /**
+                 * Allows to stop the phase and to report it
+                 * @param num_items the number of items, e.g. queries, processed
+                 *        in the phase or zero if no per item values are needed
+                 */
+                inline void stop(const uint64_t num_items = 0) {
+                    if (PerfCounters::is_enabled()) {
+                        TPerfCounts end;
+                        PerfCounters::read_counts(end);
+                        PerfCounters::report(m_name, m_start, end, num_items);
+                    }
+                }
+
+            private:
+                //Stores the phase name
+                const string m_name;
+                //Stores the counts at the phase start
+                TPerfCounts m_start;
+            };
+        }
+    }
+}
+
+#endif	/* PERFCOUNTERS_HPP */
+
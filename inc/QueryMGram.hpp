@@ -196,8 +196,8 @@ namespace uva {
                         //Initialize the actual level with undefined (zero)
                         BASE::m_actual_level = M_GRAM_LEVEL_UNDEF;
 
-                        //Read the tokens one by one backwards and decrement the index
-                        while (text.get_first_space(BASE::m_tokens[BASE::m_actual_level])) {
+                        //Read the tokens one by one, at most as many as the maximum level
+                        while ((BASE::m_actual_level < MAX_LEVEL) && text.get_first_space(BASE::m_tokens[BASE::m_actual_level])) {
                             //Retrieve the word id
                             BASE::m_word_ids[BASE::m_actual_level] = BASE::m_word_index.get_word_id(BASE::m_tokens[BASE::m_actual_level]);
                             LOG_DEBUG2 << "The word: '" << BASE::m_tokens[BASE::m_actual_level] << "' is: "
@@ -209,10 +209,13 @@ namespace uva {
                         //Set the actual end word index
                         BASE::m_actual_end_word_idx = BASE::m_actual_level - 1;
 
-                        ASSERT_SANITY_THROW(((BASE::m_actual_level < M_GRAM_LEVEL_1) ||
-                                (BASE::m_actual_level > MAX_LEVEL)),
+                        ASSERT_SANITY_THROW((BASE::m_actual_level < M_GRAM_LEVEL_1),
                                 string("A broken N-gram query: ") + ((string) * this) +
                                 string(", level: ") + std::to_string(BASE::m_actual_level));
+
+                        //The query may not be longer than the maximum level of the model
+                        ASSERT_CONDITION_THROW(text.has_more(), string("The N-gram query starting with: ") + ((string) * this) +
+                                string(" has more words than the model level: ") + std::to_string(MAX_LEVEL));
                     }
 
                 private:
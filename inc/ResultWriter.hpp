@@ -0,0 +1,437 @@
+/*
+ * File:   ResultWriter.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 6:10 PM
+ */
+
+#ifndef RESULTWRITER_HPP
+#define	RESULTWRITER_HPP
+
+#include <string>       // std::string
+#include <sstream>      // std::stringstream
+#include <cstring>      // std::memcpy
+#include <cstdio>       // std::fopen std::fwrite std::snprintf
+#include <cstdlib>      // std::strtof
+#include <cmath>        // std::isnan std::log10 std::llround
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+#include "TextPieceReader.hpp"
+
+using namespace std;
+using namespace uva::smt::logging;
+using namespace uva::smt::exceptions;
+using namespace uva::smt::utils::text;
+
+namespace uva {
+    namespace smt {
+        namespace file {
+
+            /**
+             * The query result sink. The results are collected in a large
+             * output buffer and are written to the file or to the standard
+             * output in big chunks, without any per-line stream formatting
+             * or flushing. The supported formats are:
+             *      LOG_FORMAT - the "RESULT:" lines as printed by the logger
+             *      TSV_FORMAT - one "<m-gram>\t<log_10 prob>..." line per query
+             *      BINARY_FORMAT - the raw float log_10 probabilities
+             *      NONE_FORMAT - nothing is written, for benchmarking
+             * In the TSV format the probabilities are given with the shortest
+             * number of digits that still allows to read back the same float.
+             */
+            class ResultWriter {
+            public:
+
+                //The number of bytes sufficient to store a formatted float
+                static constexpr size_t MAX_FLOAT_STR_LEN = 32;
+
+                /**
+                 * The basic constructor
+                 * @param format the result output format
+                 * @param file_name the output file name, if empty then the results go to the standard output
+                 */
+                ResultWriter(const ResultFormatsEnum format, const string & file_name)
+                : m_format(format), m_file_ptr(stdout), m_is_own_file(false),
+                m_is_flush_record(false), m_log_prob_prefix(), m_buff_ptr(NULL), m_buff_pos(0) {
+                    //Open the output file, if any
+                    if (!file_name.empty() && (m_format != ResultFormatsEnum::NONE_FORMAT)) {
+                        m_file_ptr = fopen(file_name.c_str(), "wb");
+                        ASSERT_CONDITION_THROW((m_file_ptr == NULL),
+                                string("Could not open the result output file: ") + file_name);
+                        m_is_own_file = true;
+                    }
+
+                    //The log format on the standard output obeys the debug level,
+                    //if the diagnostics are printed as well then the results are
+                    //flushed per query to keep the output in the right order.
+                    if ((m_format == ResultFormatsEnum::LOG_FORMAT) && !m_is_own_file) {
+                        if ((DebugLevelsEnum::RESULT > LOGER_MAX_LEVEL) ||
+                                (DebugLevelsEnum::RESULT > Logger::get_reporting_level())) {
+                            m_format = ResultFormatsEnum::NONE_FORMAT;
+                        } else {
+                            m_is_flush_record = (DebugLevelsEnum::RESULT < Logger::get_reporting_level());
+                        }
+                    }
+
+                    //Prepare the log format line prefix, as printed by the logger
+                    stringstream prefix;
+                    prefix << RESULT_PARAM_VALUE << ":\t  log_" << LOG_PROB_WEIGHT_BASE << "( Prob( ";
+                    m_log_prob_prefix = prefix.str();
+
+                    //Allocate the output buffer, if needed
+                    if (m_format != ResultFormatsEnum::NONE_FORMAT) {
+                        m_buff_ptr = new char[__ResultWriter::OUTPUT_BUFFER_BYTES];
+                    }
+
+                    LOG_DEBUG << "The result writer format: " << m_format << ", the output file: '"
+                            << file_name << "'" << END_LOG;
+                }
+
+                /**
+                 * The basic destructor, flushes the remaining results. The results
+                 * are to be flushed explicitly once the queries are executed, here
+                 * it is only done in case of an error, so a write error is logged
+                 * and not thrown as a destructor must not throw.
+                 */
+                virtual ~ResultWriter() {
+                    try {
+                        flush_buffer();
+                    } catch (Exception & ex) {
+                        LOG_ERROR << ex.getMessage() << END_LOG;
+                    }
+                    if (m_is_own_file) {
+                        fclose(m_file_ptr);
+                    }
+                    delete[] m_buff_ptr;
+                }
+
+                /**
+                 * Allows to get the actual result output format
+                 * @return the result output format
+                 */
+                inline ResultFormatsEnum get_format() const {
+                    return m_format;
+                }
+
+                /**
+                 * Allows to write the log format probability line:
+                 *      RESULT:\t  log_<base>( Prob( <gram_str> ) ) = <prob>
+                 * The probability is printed as the logger does, by "%g".
+                 * @param gram_str the m-gram string
+                 * @param prob the log_10 probability
+                 */
+                inline void write_log_prob(const string & gram_str, const TLogProbBackOff prob) {
+                    static const char infix[] = " ) ) = ";
+                    write(m_log_prob_prefix.c_str(), m_log_prob_prefix.length());
+                    write(gram_str.c_str(), gram_str.length());
+                    write(infix, sizeof (infix) - 1);
+                    char str[MAX_FLOAT_STR_LEN];
+                    write(str, snprintf(str, MAX_FLOAT_STR_LEN, "%g", prob));
+                    write('\n');
+                }
+
+                /**
+                 * Allows to write the log format separator line:
+                 *      RESULT:\t<text>
+                 * @param text the separator text
+                 * @param len the separator text length
+                 */
+                inline void write_log_line(const char * text, const size_t len) {
+                    static const char prefix[] = RESULT_PARAM_VALUE ":\t";
+                    write(prefix, sizeof (prefix) - 1);
+                    write(text, len);
+                    write('\n');
+                }
+
+                /**
+                 * Allows to write the space separated m-gram tokens
+                 * @param tokens the m-gram tokens
+                 * @param begin_idx the first token index
+                 * @param end_idx the last token index
+                 */
+                inline void write_tokens(const TextPieceReader * tokens, const TModelLevel begin_idx, const TModelLevel end_idx) {
+                    for (TModelLevel idx = begin_idx; idx <= end_idx; ++idx) {
+                        if (idx != begin_idx) {
+                            write(' ');
+                        }
+                        write(tokens[idx].get_begin_c_str(), tokens[idx].length());
+                    }
+                }
+
+                /**
+                 * Allows to write a tab followed by the shortest round-trip
+                 * string representation of the given probability
+                 * @param prob the log_10 probability
+                 */
+                inline void write_tsv_prob(const TLogProbBackOff prob) {
+                    char str[MAX_FLOAT_STR_LEN];
+                    write('\t');
+                    write(str, format_shortest(prob, str));
+                }
+
+                /**
+                 * Allows to write the binary representation of a value
+                 * @param value the value to write
+                 */
+                template<typename VALUE_TYPE>
+                inline void write_binary(const VALUE_TYPE value) {
+                    write(reinterpret_cast<const char *> (&value), sizeof (VALUE_TYPE));
+                }
+
+                /**
+                 * Allows to write a single character
+                 * @param symbol the character to write
+                 */
+                inline void write(const char symbol) {
+                    if (m_buff_pos == __ResultWriter::OUTPUT_BUFFER_BYTES) {
+                        flush_buffer();
+                    }
+                    m_buff_ptr[m_buff_pos++] = symbol;
+                }
+
+                /**
+                 * Allows to write the given bytes
+                 * @param data the pointer to the data
+                 * @param len the number of bytes
+                 */
+                inline void write(const char * data, const size_t len) {
+                    if (m_buff_pos + len > __ResultWriter::OUTPUT_BUFFER_BYTES) {
+                        flush_buffer();
+                        //The data that does not fit into the buffer is written directly
+                        if (len > __ResultWriter::OUTPUT_BUFFER_BYTES) {
+                            write_out(data, len);
+                            return;
+                        }
+                    }
+                    memcpy(m_buff_ptr + m_buff_pos, data, len);
+                    m_buff_pos += len;
+                }
+
+                /**
+                 * Must be called once the results of one query, or a part
+                 * thereof followed by the logged diagnostics, are written
+                 */
+                inline void end_record() {
+                    if (m_is_flush_record) {
+                        flush_buffer();
+                    }
+                }
+
+                /**
+                 * Allows to write out the buffered results
+                 */
+                inline void flush_buffer() {
+                    if (m_buff_pos != 0) {
+                        write_out(m_buff_ptr, m_buff_pos);
+                        m_buff_pos = 0;
+                    }
+                    if (m_format != ResultFormatsEnum::NONE_FORMAT) {
+                        fflush(m_file_ptr);
+                    }
+                }
+
+                /**
+                 * Allows to get the shortest decimal string representation of
+                 * the float value that is read back as the same value. For the
+                 * values in the fixed point range the digits are searched for
+                 * directly by scaling with the exact powers of ten, the result
+                 * is verified by reading it back. The remaining values, and the
+                 * values not passing the check, are printed with snprintf.
+                 * @param value the value to convert
+                 * @param str the output buffer of MAX_FLOAT_STR_LEN bytes
+                 * @return the length of the resulting string
+                 */
+                static inline int format_shortest(const float value, char * str) {
+                    if (std::isfinite(value) && (value != 0.0f)) {
+                        const int len = format_fixed_shortest(value, str);
+                        if ((len > 0) && (strtof(str, NULL) == value)) {
+                            return len;
+                        }
+                    }
+                    return format_shortest_slow(value, str);
+                }
+
+            private:
+                //The number of significant digits that is always enough to round trip a float
+                static constexpr int FLOAT_ROUND_TRIP_DIGITS = 9;
+                //The fixed point notation is used for the decimal exponents in this range
+                static constexpr int MIN_FIXED_EXP10 = -5;
+                static constexpr int MAX_FIXED_EXP10 = 8;
+                //The maximum power of ten that is exactly representable as a double
+                static constexpr int MAX_EXACT_POW10 = 22;
+
+                /**
+                 * Allows to get the exact double power of ten
+                 * @param exp the power, must be within [0, MAX_EXACT_POW10]
+                 * @return the power of ten
+                 */
+                static inline double pow10(const int exp) {
+                    static const double POW10[MAX_EXACT_POW10 + 1] = {
+                        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                    };
+                    return POW10[exp];
+                }
+
+                /**
+                 * Allows to get the shortest fixed point string representation
+                 * of the non-zero finite float value, without the read back check.
+                 * @param value the value to convert
+                 * @param str the output buffer of MAX_FLOAT_STR_LEN bytes
+                 * @return the length of the resulting string or zero if the value is out of the fixed point range
+                 */
+                static inline int format_fixed_shortest(const float value, char * str) {
+                    const double abs_value = fabs(static_cast<double> (value));
+
+                    //Get the decimal exponent, correct the possible log10 rounding
+                    int exp10 = static_cast<int> (floor(log10(abs_value)));
+                    if ((exp10 < MIN_FIXED_EXP10) || (exp10 > MAX_FIXED_EXP10)) {
+                        return 0;
+                    }
+                    const double scaled = (exp10 >= 0) ? (abs_value / pow10(exp10)) : (abs_value * pow10(-exp10));
+                    if (scaled < 1.0) {
+                        --exp10;
+                    } else if (scaled >= 10.0) {
+                        ++exp10;
+                    }
+
+                    //Search for the least number of significant digits
+                    uint64_t digits = 0;
+                    int prec = 1;
+                    for (; prec <= FLOAT_ROUND_TRIP_DIGITS; ++prec) {
+                        //The value is scaled by 10^scale_exp to get prec digits
+                        const int scale_exp = prec - 1 - exp10;
+                        if (scale_exp >= 0) {
+                            digits = static_cast<uint64_t> (llround(abs_value * pow10(scale_exp)));
+                            if (static_cast<float> (digits / pow10(scale_exp)) == fabs(value)) break;
+                        } else {
+                            digits = static_cast<uint64_t> (llround(abs_value / pow10(-scale_exp)));
+                            if (static_cast<float> (digits * pow10(-scale_exp)) == fabs(value)) break;
+                        }
+                    }
+                    if (prec > FLOAT_ROUND_TRIP_DIGITS) {
+                        return 0;
+                    }
+                    //The rounding may have carried into an extra digit
+                    if (digits == static_cast<uint64_t> (pow10(prec))) {
+                        digits /= 10;
+                        ++exp10;
+                    }
+
+                    //Get the significant digits
+                    char digit_chars[FLOAT_ROUND_TRIP_DIGITS];
+                    for (int idx = prec - 1; idx >= 0; --idx) {
+                        digit_chars[idx] = static_cast<char> ('0' + (digits % 10));
+                        digits /= 10;
+                    }
+                    //Skip the trailing zero digits
+                    while ((prec > 1) && (digit_chars[prec - 1] == '0')) {
+                        --prec;
+                    }
+
+                    //Print the digits in the fixed point notation
+                    char * ptr = str;
+                    if (value < 0.0f) {
+                        *ptr++ = '-';
+                    }
+                    if (exp10 >= 0) {
+                        for (int idx = 0; idx <= exp10; ++idx) {
+                            *ptr++ = (idx < prec) ? digit_chars[idx] : '0';
+                        }
+                        if (prec > exp10 + 1) {
+                            *ptr++ = '.';
+                            for (int idx = exp10 + 1; idx < prec; ++idx) {
+                                *ptr++ = digit_chars[idx];
+                            }
+                        }
+                    } else {
+                        *ptr++ = '0';
+                        *ptr++ = '.';
+                        for (int idx = exp10 + 1; idx < 0; ++idx) {
+                            *ptr++ = '0';
+                        }
+                        for (int idx = 0; idx < prec; ++idx) {
+                            *ptr++ = digit_chars[idx];
+                        }
+                    }
+                    *ptr = '\0';
+                    return static_cast<int> (ptr - str);
+                }
+
+                /**
+                 * Allows to get the shortest "%g" string representation of
+                 * the float value that is read back as the same value.
+                 * The round trip is monotone in the precision so the binary
+                 * search is used on the precision from 1 up to 9 digits.
+                 * @param value the value to convert
+                 * @param str the output buffer of MAX_FLOAT_STR_LEN bytes
+                 * @return the length of the resulting string
+                 */
+                static inline int format_shortest_slow(const float value, char * str) {
+                    if (std::isnan(value)) {
+                        return snprintf(str, MAX_FLOAT_STR_LEN, "nan");
+                    }
+                    int min_prec = 1, max_prec = FLOAT_ROUND_TRIP_DIGITS;
+                    while (min_prec < max_prec) {
+                        const int prec = (min_prec + max_prec) / 2;
+                        snprintf(str, MAX_FLOAT_STR_LEN, "%.*g", prec, value);
+                        if (strtof(str, NULL) == value) {
+                            max_prec = prec;
+                        } else {
+                            min_prec = prec + 1;
+                        }
+                    }
+                    return snprintf(str, MAX_FLOAT_STR_LEN, "%.*g", min_prec, value);
+                }
+
+                //Stores the result output format
+                ResultFormatsEnum m_format;
+                //Stores the output file
+                FILE * m_file_ptr;
+                //Stores true if the output file is opened by this writer
+                bool m_is_own_file;
+                //Stores true if the results are to be flushed after every query
+                bool m_is_flush_record;
+                //Stores the log format probability line prefix
+                string m_log_prob_prefix;
+                //Stores the output buffer
+                char * m_buff_ptr;
+                //Stores the number of used output buffer bytes
+                size_t m_buff_pos;
+
+                /**
+                 * Allows to write the data into the output file
+                 * @param data the pointer to the data
+                 * @param len the number of bytes
+                 */
+                inline void write_out(const char * data, const size_t len) {
+                    ASSERT_CONDITION_THROW((fwrite(data, 1, len, m_file_ptr) != len),
+                            "Could not write the query results!");
+                }
+            };
+        }
+    }
+}
+
+#endif	/* RESULTWRITER_HPP */
+
@@ -80,6 +80,14 @@ namespace uva {
                  */
                 static double getCPUTime();
 
+                /**
+                 * This function returns the current wall-clock time, unlike the CPU
+                 * time it also includes the time spent on waiting for the I/O.
+                 * @return Returns the wall-clock time in seconds since some fixed
+                 *         point in the past, or -1.0 if an error occurred.
+                 */
+                static double getWallTime();
+
             private:
 
                 StatisticsMonitor() {
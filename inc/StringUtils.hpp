@@ -31,7 +31,9 @@
 #include <sstream> // std::stringstream
 #include <cstddef> // std::size_t
 #include <limits>  // std::numeric_limits
-#include <cstring> // std::memchr
+#include <cstring> // std::memchr std::memcpy
+#include <cstdlib> // std::strtof
+#include <stdint.h> // std::uint64_t
 
 #include "Logger.hpp"
 #include "Globals.hpp"
@@ -229,25 +231,56 @@ namespace uva {
 
 #define valid_digit(c) ((c) >= '0' && (c) <= '9')
 
-                // See: http://pastebin.com/dHP1pgQ4
+                //The maximum number of decimal digits that always fit into uint64_t
+                static constexpr size_t MAX_FAST_MANTISSA_DIGITS = 19;
+                //The maximum integer mantissa that is exactly representable by a double
+                static constexpr uint64_t MAX_EXACT_DOUBLE_MANTISSA = (static_cast<uint64_t> (1) << 53);
+                //The maximum absolute power of ten used by the fast path
+                static constexpr int32_t MAX_FAST_DOUBLE_POW10 = 22;
+                //The exponent value above which we stop accumulating the exponent digits
+                static constexpr int32_t MAX_PARSED_EXPONENT = 100000;
+                //The number of the double mantissa bits that are dropped when rounding to float
+                static constexpr uint32_t DOUBLE_TO_FLOAT_DROPPED_BITS = 29;
+                //The dropped bits value of a double that is exactly half way between two floats
+                static constexpr uint64_t DOUBLE_TO_FLOAT_HALF_WAY_BITS = (static_cast<uint64_t> (1) << (DOUBLE_TO_FLOAT_DROPPED_BITS - 1));
+                //The mask of the dropped bits
+                static constexpr uint64_t DOUBLE_TO_FLOAT_DROPPED_MASK = (static_cast<uint64_t> (1) << DOUBLE_TO_FLOAT_DROPPED_BITS) - 1;
+                //The upper bound of the fast path double error in ulps, with a safety margin
+                static constexpr uint64_t DOUBLE_ERROR_ULPS = 8;
+
+                //The powers of ten used by the fast path, from 1e-22 to 1e22
+                static const double DOUBLE_POW10[2 * MAX_FAST_DOUBLE_POW10 + 1] = {
+                    1e-22, 1e-21, 1e-20, 1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12,
+                    1e-11, 1e-10, 1e-9, 1e-8, 1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1,
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
 
                 /**
                  * This function tries to read from a piece of memory and interpret
-                 * it as a float or double or other decimal type given as template
-                 * parameter. This function is more efficient than atof and it does
-                 * not check for the lengh of the input, e.g. does no rely on the
+                 * it as a float. The result is correctly rounded, the same as the
+                 * one of strtof. This function is more efficient than strtof and it
+                 * does not check for the lengh of the input, e.g. does no rely on the
                  * \0 terminating symbol in general. It reads until it gets something
                  * that it can not interpret as a part of a decimal. Then it stops!
                  * 
+                 * The accepted format is: [+|-]digits[.digits][(e|E)[+|-]digits]
+                 * where either the integer or the fractional digits can be omitted.
+                 * 
+                 * The value is computed with a variant of the Clinger's fast path.
+                 * The mantissa of up to 19 digits is exact in uint64_t, if it also
+                 * fits into 53 bits then one multiplication by a power of ten gives
+                 * a double that is within a few ulps from the exact value. A double
+                 * has 29 more mantissa bits than a float, so rounding it to float
+                 * can only be wrong if it is that close to half way between two
+                 * floats. This, as well as very long mantissas, large exponents and
+                 * subnormal values are rare in ARPA files and are given to strtof.
+                 * 
                  * WARNING: This function does at least one symbol look ahead and
                  * does not check on the \0 of the c string or its length. This is
                  * perfectly good when reading ARPA file floats, if the file format
                  * is correct. We can not generally rely on \0 as the input string
-                 * is not guaranteed to have it! Yet we could try to take into account
-                 * the string length, but this might cost performance!
-                 * 
-                 * ToDo: Try to impose the string length limit and test the performance
-                 * on reading large ARPA files!
+                 * is not guaranteed to have it!
                  * 
                  * @param res the type to read into
                  * @param p the pointer to read from,
@@ -255,8 +288,12 @@ namespace uva {
                  * input, otherwise false.
                  */
                 inline bool fast_s_to_f(float & res, const char *p) {
-                    uint32_t int_part = 0.0;
-                    int c = 0; // counter to check how many numbers we got!
+                    //Remember the number beginning for the slow path
+                    const char * const begin_p = p;
+                    //The decimal digits, read two at a time
+                    uint64_t mantissa = 0;
+                    //The decimal exponent of the mantissa
+                    int32_t exp10 = 0;
 
                     // Get the sign!
                     bool neg = false;
@@ -264,87 +301,88 @@ namespace uva {
                         neg = true;
                         ++p;
                     } else if (*p == '+') {
-                        neg = false;
                         ++p;
                     }
 
                     // Get the digits before decimal point
-                    while (valid_digit(*p)) {
-                        int_part = (int_part * 10) + (*p - '0');
+                    const char * const int_begin_p = p;
+                    while (valid_digit(p[0]) && valid_digit(p[1])) {
+                        mantissa = (mantissa * 100) + ((p[0] - '0') * 10 + (p[1] - '0'));
+                        p += 2;
+                    }
+                    if (valid_digit(*p)) {
+                        mantissa = (mantissa * 10) + (*p - '0');
                         ++p;
-                        ++c;
                     }
-                    res = int_part;
+                    size_t num_digits = p - int_begin_p;
 
                     // Get the digits after decimal point
                     if (*p == '.') {
-                        uint32_t dec_part = 0;
-                        uint32_t scale = 1;
                         ++p;
-                        while (valid_digit(*p)) {
-                            dec_part = (dec_part * 10) + (*p - '0');
+                        const char * const frac_begin_p = p;
+                        while (valid_digit(p[0]) && valid_digit(p[1])) {
+                            mantissa = (mantissa * 100) + ((p[0] - '0') * 10 + (p[1] - '0'));
+                            p += 2;
+                        }
+                        if (valid_digit(*p)) {
+                            mantissa = (mantissa * 10) + (*p - '0');
                             ++p;
-                            scale *= 10;
-                            ++c;
                         }
-                        res += dec_part * ( 1.0f / scale );
+                        exp10 = -static_cast<int32_t> (p - frac_begin_p);
+                        num_digits -= exp10;
                     }
 
                     // FIRST CHECK:
-                    if (c == 0) {
+                    if (num_digits == 0) {
                         return false;
                     } // we got no dezimal places! this cannot be any number!
 
-
                     // Get the digits after the "e"/"E" (exponenet)
                     if (*p == 'e' || *p == 'E') {
-                        unsigned int e = 0;
-
                         bool negE = false;
                         ++p;
                         if (*p == '-') {
                             negE = true;
                             ++p;
                         } else if (*p == '+') {
-                            negE = false;
                             ++p;
                         }
-                        // Get exponent
-                        c = 0;
-                        while (valid_digit(*p)) {
-                            e = (e * 10) + (*p - '0');
-                            ++p;
-                            ++c;
-                        }
-                        if (!neg && e > (uint) std::numeric_limits<float>::max_exponent10) {
-                            e = (uint) std::numeric_limits<float>::max_exponent10;
-                        } else if (e < (uint) std::numeric_limits<float>::min_exponent10) {
-                            e = (uint) std::numeric_limits<float>::max_exponent10;
-                        }
+
                         // SECOND CHECK:
-                        if (c == 0) {
+                        if (!valid_digit(*p)) {
                             return false;
                         } // we got no  exponent! this was not intended!!
 
-                        uint32_t scale_exp = 1.0;
-                        // Calculate scaling factor.
-                        while (e > 0) {
-                            scale_exp *= 10;
-                            e -= 1;
-                        }
-
-                        if (negE) {
-                            res *= 1.0f / scale_exp;
-                        } else {
-                            res *= scale_exp;
+                        // Get exponent
+                        int32_t e = 0;
+                        while (valid_digit(*p)) {
+                            if (e < MAX_PARSED_EXPONENT) {
+                                e = (e * 10) + (*p - '0');
+                            }
+                            ++p;
                         }
+                        exp10 += (negE ? -e : e);
                     }
 
-                    // Apply sign to number
-                    if (neg) {
-                        res = -res;
+                    //Try the fast path, this is what we get for the ARPA files
+                    if ((num_digits <= MAX_FAST_MANTISSA_DIGITS) && (mantissa <= MAX_EXACT_DOUBLE_MANTISSA) &&
+                            (exp10 >= -MAX_FAST_DOUBLE_POW10) && (exp10 <= MAX_FAST_DOUBLE_POW10)) {
+                        //The mantissa is exact, the result is within a few double ulps
+                        const double value = static_cast<double> (mantissa) * DOUBLE_POW10[exp10 + MAX_FAST_DOUBLE_POW10];
+
+                        //Check that the value is not close to half way between two floats, given
+                        //the mantissa and exponent bounds it is zero or within the normal float range
+                        uint64_t bits = 0;
+                        memcpy(&bits, &value, sizeof (bits));
+                        if (((bits - DOUBLE_TO_FLOAT_HALF_WAY_BITS + DOUBLE_ERROR_ULPS) & DOUBLE_TO_FLOAT_DROPPED_MASK) > 2 * DOUBLE_ERROR_ULPS) {
+                            const float fvalue = static_cast<float> (value);
+                            res = (neg ? -fvalue : fvalue);
+                            return true;
+                        }
                     }
 
+                    //The slow path, the syntax is already checked so strtof reads the same number
+                    res = strtof(begin_p, NULL);
                     return true;
                 }
             }
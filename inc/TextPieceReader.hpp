@@ -29,6 +29,11 @@
 #include <string.h>     // std::memrchr
 #include <cstring>      // std::memchr std::strncpy
 #include <algorithm>    // std::min
+#include <stdint.h>     // std::uint64_t
+
+#if defined(__SSE2__)
+#include <immintrin.h>  // _mm_cmpeq_epi8 _mm256_cmpeq_epi8
+#endif
 
 #include "Globals.hpp"
 #include "Logger.hpp"
@@ -51,6 +56,8 @@ namespace uva {
             static const string TEXT_TOO_LARGE_STR("<text-too-large>");
             //This stores the NOTHING string to be used in conversion
             static const string TEXT_NOTHING_STR("<NULL>");
+            //The number of characters covered by the delimiters index of the text piece
+            static constexpr size_t DELIM_INDEX_BYTES = 64;
 
             /**
              * This basic storage class that stores the pointer to pre-allocated memory
@@ -77,13 +84,25 @@ namespace uva {
                 //The remaining length of the file to read
                 size_t m_rest_len;
 
+                //The delimiters index: the bit masks of the space and tab positions
+                //within the window of DELIM_INDEX_BYTES characters, starting at m_index_ptr.
+                //It allows to find several tokens of a line with just one text scan.
+                const char * m_index_ptr;
+                //The number of indexed characters
+                size_t m_index_len;
+                //The bit mask of the space positions within the index window
+                uint64_t m_space_mask;
+                //The bit mask of the tab positions within the index window
+                uint64_t m_tab_mask;
+
             public:
 
                 /**
                  * The basic constructor initializes empty text
                  */
                 TextPieceReader()
-                : m_beginPtr(NULL), m_len(0), m_is_gen_str(true), m_str(""), m_cursor_ptr(NULL), m_rest_len(0) {
+                : m_beginPtr(NULL), m_len(0), m_is_gen_str(true), m_str(""), m_cursor_ptr(NULL), m_rest_len(0),
+                m_index_ptr(NULL), m_index_len(0), m_space_mask(0), m_tab_mask(0) {
                 }
 
                 /**
@@ -92,7 +111,8 @@ namespace uva {
                  * @param len the length of the text
                  */
                 explicit TextPieceReader(void * beginPtr, const size_t len)
-                : m_beginPtr(NULL), m_len(0), m_is_gen_str(true), m_str(""), m_cursor_ptr(NULL), m_rest_len(0) {
+                : m_beginPtr(NULL), m_len(0), m_is_gen_str(true), m_str(""), m_cursor_ptr(NULL), m_rest_len(0),
+                m_index_ptr(NULL), m_index_len(0), m_space_mask(0), m_tab_mask(0) {
                     set(beginPtr, len);
                 }
 
@@ -107,6 +127,10 @@ namespace uva {
                     m_str = other.m_str;
                     m_cursor_ptr = other.m_cursor_ptr;
                     m_rest_len = other.m_rest_len;
+                    m_index_ptr = other.m_index_ptr;
+                    m_index_len = other.m_index_len;
+                    m_space_mask = other.m_space_mask;
+                    m_tab_mask = other.m_tab_mask;
                 }
 
                 /**
@@ -121,6 +145,7 @@ namespace uva {
                     m_str.clear();
                     m_cursor_ptr = m_beginPtr;
                     m_rest_len = m_len;
+                    m_index_ptr = NULL;
 
                     LOG_DEBUG3 << "Setting the data to BasicTextPiece: m_beginPtr = "
                             << SSTR(static_cast<const void*> (m_beginPtr)) << ", m_cursorPtr = "
@@ -207,7 +232,7 @@ namespace uva {
                     size_t out_m_len = 0;
 
                     //Search for the next new delimiter from the front
-                    const char * char_ptr = static_cast<const char *> (memchr(m_cursor_ptr, delim, m_rest_len));
+                    const char * char_ptr = find_first_char<delim>();
 
                     LOG_DEBUG4 << "Forward searching for the character got: "
                             << SSTR(static_cast<const void *> (char_ptr)) << END_LOG;
@@ -476,6 +501,94 @@ namespace uva {
                     }
                     return m_str;
                 }
+
+            private:
+
+                /**
+                 * Computes the bit mask of the delimiter positions within the given characters
+                 * @param data_ptr the pointer to DELIM_INDEX_BYTES characters
+                 * @return the bit mask, the lowest bit is the first character
+                 */
+                template<const char delim>
+                static inline uint64_t get_delim_mask(const char * data_ptr) {
+#if defined(__AVX2__)
+                    const __m256i pattern = _mm256_set1_epi8(delim);
+                    const uint64_t lo_mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *> (data_ptr)), pattern)));
+                    const uint64_t hi_mask = static_cast<uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *> (data_ptr + 32)), pattern)));
+                    return lo_mask | (hi_mask << 32);
+#elif defined(__SSE2__)
+                    const __m128i pattern = _mm_set1_epi8(delim);
+                    uint64_t mask = 0;
+                    for (size_t idx = 0; idx != DELIM_INDEX_BYTES; idx += sizeof (__m128i)) {
+                        const uint64_t part = static_cast<uint16_t> (_mm_movemask_epi8(_mm_cmpeq_epi8(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i *> (data_ptr + idx)), pattern)));
+                        mask |= (part << idx);
+                    }
+                    return mask;
+#else
+                    uint64_t mask = 0;
+                    for (size_t idx = 0; idx != DELIM_INDEX_BYTES; ++idx) {
+                        mask |= (static_cast<uint64_t> (data_ptr[idx] == delim) << idx);
+                    }
+                    return mask;
+#endif
+                }
+
+                /**
+                 * Builds the delimiters index for the text starting at the cursor.
+                 * Never reads beyond the remaining text, the shorter remainder
+                 * is first copied into a padded buffer.
+                 */
+                inline void build_index() {
+                    m_index_ptr = m_cursor_ptr;
+                    m_index_len = min(m_rest_len, DELIM_INDEX_BYTES);
+
+                    const char * data_ptr = m_cursor_ptr;
+                    char buffer[DELIM_INDEX_BYTES];
+                    if (m_index_len < DELIM_INDEX_BYTES) {
+                        memset(buffer, 0, DELIM_INDEX_BYTES);
+                        memcpy(buffer, m_cursor_ptr, m_index_len);
+                        data_ptr = buffer;
+                    }
+
+                    m_space_mask = get_delim_mask<' '>(data_ptr);
+                    m_tab_mask = get_delim_mask<'\t'>(data_ptr);
+                }
+
+                /**
+                 * Searches forward from the cursor for the first delimiter occurrence.
+                 * The spaces and tabs are looked up in the delimiters index, as they
+                 * are searched for several times within one short line.
+                 * @return the pointer to the found delimiter or NULL
+                 */
+                template<const char delim>
+                inline const char * find_first_char() {
+                    if ((delim == ' ') || (delim == '\t')) {
+                        //Re-build the index if the cursor has left the indexed window
+                        if ((m_index_ptr == NULL) || (m_cursor_ptr >= (m_index_ptr + m_index_len))) {
+                            build_index();
+                        }
+
+                        const char * const rest_end_ptr = m_cursor_ptr + m_rest_len;
+                        const uint64_t mask = ((delim == ' ') ? m_space_mask : m_tab_mask) >> (m_cursor_ptr - m_index_ptr);
+                        if (mask) {
+                            const char * char_ptr = m_cursor_ptr + __builtin_ctzll(mask);
+                            //The end of the text could have been moved back by get_last
+                            return (char_ptr < rest_end_ptr) ? char_ptr : NULL;
+                        }
+
+                        //The delimiter is not in the index, search the rest of the text, if any
+                        const char * const index_end_ptr = m_index_ptr + m_index_len;
+                        if (index_end_ptr < rest_end_ptr) {
+                            return static_cast<const char *> (memchr(index_end_ptr, delim, rest_end_ptr - index_end_ptr));
+                        }
+                        return NULL;
+                    } else {
+                        return static_cast<const char *> (memchr(m_cursor_ptr, delim, m_rest_len));
+                    }
+                }
             };
 
             /**
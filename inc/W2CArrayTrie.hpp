@@ -29,7 +29,9 @@
 #include <string>       // std::string
 #include <cstdlib>      // std::calloc std::realloc std::free
 #include <cmath>        // std::log std::log10
-#include <algorithm>    // std::max
+#include <algorithm>    // std::max std::sort std::swap
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::conditional
 
 #include "Globals.hpp"
 #include "Logger.hpp"
@@ -93,11 +95,518 @@ namespace uva {
                 inline bool operator<(const T_N_GramData& one, const T_N_GramData& two) {
                     return one.id < two.id;
                 }
+
+                /**
+                 * This class is to store the word mapping to the data for
+                 * the 1< M <= N grams. Demending on whether M == N or not this
+                 * structure is to be instantiated with a different template
+                 * parameter - defines the stored data.
+                 * @param ptr the pointer to the storage array
+                 * @param capacity the number of allocated elements
+                 * @param size the number of used elements
+                 * @param cio the context index offset for computing the next contex index.
+                 */
+                template<typename ARRAY_ELEM_TYPE>
+                class WordDataEntry : public DynamicStackArray<ARRAY_ELEM_TYPE, uint32_t> {
+                public:
+                    TShortId cio;
+                };
+
+                /**
+                 * This class stores an M-gram level, 1 < M <= N, as one dynamic array per
+                 * end word id. The arrays grow with the memory increase strategy while the
+                 * level is read and are then sorted by the context ids. The next level
+                 * context id of an entry is its index in the word array plus the context
+                 * index offset of the word, the offsets are assigned in the word id order.
+                 * This is the default level layout, see __W2CArrayTrie::USE_CSR_LAYOUT.
+                 * 
+                 * If the m-grams are added sorted by the end word id and then by the context
+                 * id, see allocate, then the word arrays are not sorted again. The order is
+                 * verified while adding, if the level is found unsorted then it falls back
+                 * to being sorted in the post actions.
+                 * 
+                 * @param ELEM_TYPE the level entry type
+                 * @param TRIE_BASE the trie base class, defines the first valid context id
+                 */
+                template<typename ELEM_TYPE, typename TRIE_BASE>
+                class W2CArrayWordLevel {
+                public:
+
+                    /**
+                     * The basic constructor, the level is to be allocated before use
+                     */
+                    W2CArrayWordLevel() : m_level(0), m_num_word_ids(0), m_word_entries(NULL),
+                    m_num_entries(0), m_is_sorted(false), m_last_key(0) {
+                    }
+
+                    /**
+                     * Allows to allocate word related data per word for the level.
+                     * Depends on the global __W2CArrayTrie::PRE_ALLOCATE_MEMORY if true
+                     * then will preallocate some memory for each word bucket! Default is false.
+                     * Depending on the number of words and n-grams in the given Trie level,
+                     * plus the value of:
+                     *      __W2CArrayTrie::INIT_MEM_ALLOC_PRCT
+                     * This can have a drastic influence on MAX RSS.
+                     * @param level the M-gram level
+                     * @param num_word_ids the number of word ids
+                     * @param num_m_grams the number of M-grams on this level
+                     * @param is_presorted true if the M-grams are to be added in the layout order
+                     */
+                    inline void allocate(const TModelLevel level, const TShortId num_word_ids,
+                            const size_t num_m_grams, const bool is_presorted) {
+                        m_level = level;
+                        m_num_word_ids = num_word_ids;
+                        m_is_sorted = is_presorted;
+
+                        //Allocate dynamic array entries and initialize it with the memory increase strategy
+                        m_word_entries = new TWordEntry[m_num_word_ids];
+
+                        if (__W2CArrayTrie::PRE_ALLOCATE_MEMORY) {
+                            //Compute the average number of data elements per word on the given M-gram level
+                            const float avg_num_elems = ((float) num_m_grams) / ((float) m_num_word_ids);
+                            //Compute the corrected number of elements to preallocate, minimum __W2CArrayTrie::MIN_MEM_INC_NUM.
+                            const size_t capacity = max(static_cast<size_t> (avg_num_elems * __W2CArrayTrie::INIT_MEM_ALLOC_PRCT),
+                                    __W2CArrayTrie::MIN_MEM_INC_NUM);
+
+                            //Pre-allocate capacity
+                            for (TShortId word_id = AWordIndex<TShortId>::MIN_KNOWN_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                                m_word_entries[word_id].pre_allocate(capacity);
+                            }
+                        }
+                    }
+
+                    /**
+                     * For a M-gram allows to create a new level entry for the given word id.
+                     * If the level is still sorted then the order of the entry is verified.
+                     * @param word_id the end word id of the M-gram
+                     * @param ctx_id the context id of the M-gram
+                     * @return the new level entry, with the context id set
+                     */
+                    inline ELEM_TYPE & add_entry(const TShortId word_id, const TLongId ctx_id) {
+                        LOG_DEBUG2 << "Making entry for M-gram with word_id:\t" << SSTR(word_id) << END_LOG;
+
+                        //Verify the pre-sorted order against the previous entry of the level
+                        if (m_is_sorted) {
+                            const uint64_t key = (static_cast<uint64_t> (word_id) << 32) | static_cast<TShortId> (ctx_id);
+                            if ((m_num_entries > 0) && (key <= m_last_key)) {
+                                LOG_WARNING << "The " << std::to_string(m_level) << "-grams are not sorted by the end "
+                                        << "word and context ids, will sort them after reading!" << END_LOG;
+                                m_is_sorted = false;
+                            } else {
+                                m_last_key = key;
+                            }
+                        }
+                        ++m_num_entries;
+
+                        //Get the next new element new/free and store the context id
+                        ELEM_TYPE & ref = m_word_entries[word_id].allocate();
+                        ref.id = ctx_id;
+                        return ref;
+                    }
+
+                    /**
+                     * The purpose of this function is three fold:
+                     * 1. First we compute the context index offset values.
+                     * 2. Second we re-order the context data arrays per word.
+                     * 3. Free the unneeded memory allocated earlier.
+                     */
+                    inline void post_grams() {
+                        //Define and initialize the current context index offset.
+                        //The initial value is 1, although in this Trie it should
+                        //not matter much, but it is better to reserve 0 for
+                        //an undefined context value
+                        TShortId cio = TRIE_BASE::FIRST_VALID_CTX_ID;
+
+                        if (m_is_sorted) {
+                            LOG_DEBUG << "The " << std::to_string(m_level) << "-grams are pre-sorted, no sorting is needed!" << END_LOG;
+                        }
+
+                        //Iterate through all the word_id sub-array mappings in the level and sort sub arrays
+                        for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                            //First get the sub-array reference. 
+                            TWordEntry & ref = m_word_entries[word_id];
+
+                            //Assign the context index offset
+                            ref.cio = cio;
+                            //Compute the next context index offset, for the next word
+                            cio += ref.size();
+
+                            //Reduce capacity if there is unused memory
+                            ref.shrink();
+
+                            //Order the N-gram array as it is unordered and we will binary search it later!
+                            if (!m_is_sorted) {
+                                ref.sort();
+                            }
+                        }
+                    }
+
+                    /**
+                     * For the given M-gram defined by the word id and a context id it allows to retrieve the data entry.
+                     * @param word_id the word id we need the to find the context entry by
+                     * @param ctx_id [in/out] the context id we are after, becomes the next context id
+                     * @param ppData [out] the pointer to the found entry
+                     * @return true if the data was found, otherwise false
+                     * @throw nothing
+                     */
+                    inline bool get_entry(const TShortId word_id, TLongId & ctx_id, const ELEM_TYPE **ppData) const {
+                        LOG_DEBUG2 << "Getting sub arr data for an m/n-gram with word_id: " << SSTR(word_id) << END_LOG;
+
+                        //Get the sub-array reference. 
+                        const TWordEntry & ref = m_word_entries[word_id];
+
+                        //Check if there is data to search in
+                        if (ref.has_data()) {
+                            //The data is available search for the word index in the array
+                            //WQRNING: Switching to linear search here significantly worsens
+                            //the performance!
+                            typename TWordEntry::TIndexType local_idx;
+                            if (my_bsearch_id<ELEM_TYPE, typename TWordEntry::TIndexType > (ref.data(), 0, ref.size() - 1, ctx_id, local_idx)) {
+                                LOG_DEBUG2 << "Found sub array local index = " << SSTR(local_idx) << END_LOG;
+
+                                //Return the pointer to the data located by the local index
+                                *ppData = &ref[local_idx];
+
+                                //The next ctx_id is the sum of the local index and the context index offset
+                                ctx_id = ref.cio + local_idx;
+                                return true;
+                            } else {
+                                LOG_DEBUG1 << "Unable to find M-gram context id for a word, prev ctx_id: "
+                                        << SSTR(ctx_id) << ", ctx_id range: [" << SSTR(ref[0].id)
+                                        << ", " << SSTR(ref[ref.size() - 1].id) << "]" << END_LOG;
+                                return false;
+                            }
+                        } else {
+                            LOG_DEBUG1 << "Unable to find M-gram word id data for a word, nothing is present!" << END_LOG;
+                            return false;
+                        }
+                    }
+
+                    /**
+                     * Allows to add the level memory usage into the memory breakdown
+                     * @param trie_name the name of the trie storing the level
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(const char * trie_name, MemoryBreakdown & breakdown) const {
+                        if (m_word_entries != NULL) {
+                            size_t num_elems = 0;
+                            for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                                num_elems += m_word_entries[word_id].size();
+                            }
+                            breakdown.add(trie_name, "word arrays", m_level, m_num_word_ids * sizeof (TWordEntry));
+                            breakdown.add(trie_name, "entries", m_level, num_elems * sizeof (ELEM_TYPE));
+                        }
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~W2CArrayWordLevel() {
+                        delete[] m_word_entries;
+                    }
+
+                private:
+                    //The word entry type, a dynamic array per word
+                    typedef WordDataEntry<ELEM_TYPE> TWordEntry;
+
+                    //Stores the M-gram level
+                    TModelLevel m_level;
+                    //Stores the number of word ids
+                    TShortId m_num_word_ids;
+                    //Stores the word entries, one per word id
+                    TWordEntry * m_word_entries;
+                    //Stores the number of added entries
+                    size_t m_num_entries;
+                    //Stores the flag indicating that the level is still sorted in the pre-sorted mode
+                    bool m_is_sorted;
+                    //Stores the (end word id, context id) key of the last entry,
+                    //is used to verify the entries order in the pre-sorted mode
+                    uint64_t m_last_key;
+
+                    //The level owns its arrays, so copying it would free them twice
+                    W2CArrayWordLevel(const W2CArrayWordLevel &) = delete;
+                    W2CArrayWordLevel & operator=(const W2CArrayWordLevel &) = delete;
+                };
+
+                /**
+                 * This class stores an M-gram level, 1 < M <= N, as one contiguous array in
+                 * the compressed sparse row layout: the entries are grouped by their end word
+                 * id and are sorted by the context id within the group. The group of the word
+                 * id w is [offsets[w], offsets[w+1]) where offsets is the word offsets table.
+                 * The next level context id of an entry is its array index plus the first
+                 * valid context id, the same as for W2CArrayWordLevel. This layout is used
+                 * if __W2CArrayTrie::USE_CSR_LAYOUT is set.
+                 * 
+                 * While reading the level the entries are appended to the array, which is
+                 * pre-allocated from the M-gram count, and the number of entries per word is
+                 * counted. The model readers stream the file and can not rewind it, so instead
+                 * of a counting pre-scan of the level the end word ids of the entries are kept
+                 * until the level is read. Then the counts are turned into the offsets and the
+                 * entries are moved into their groups in place, so no reallocations are needed.
+                 * 
+                 * If the m-grams are added in the final layout order, see allocate, then the
+                 * level is neither grouped nor sorted, nor does it need the end word ids. The
+                 * order is verified while adding, if the level is found unsorted then it falls
+                 * back to being grouped and sorted in the post actions.
+                 * 
+                 * @param ELEM_TYPE the level entry type
+                 * @param TRIE_BASE the trie base class, defines the first valid context id
+                 */
+                template<typename ELEM_TYPE, typename TRIE_BASE>
+                class W2CArrayCSRLevel {
+                public:
+
+                    /**
+                     * The basic constructor, the level is to be allocated before use
+                     */
+                    W2CArrayCSRLevel() : m_level(0), m_num_word_ids(0), m_word_offsets(NULL), m_word_ids(NULL),
+                    m_data(NULL), m_max_entries(0), m_num_entries(0), m_is_sorted(false), m_last_key(0) {
+                    }
+
+                    /**
+                     * Allocates the word offsets, the entries and the end word ids, the
+                     * pre-sorted level needs no end word ids unless it turns out to be unsorted
+                     * @param level the M-gram level
+                     * @param num_word_ids the number of word ids
+                     * @param num_m_grams the number of M-grams on this level
+                     * @param is_presorted true if the M-grams are to be added in the layout order
+                     */
+                    inline void allocate(const TModelLevel level, const TShortId num_word_ids,
+                            const size_t num_m_grams, const bool is_presorted) {
+                        ASSERT_CONDITION_THROW((num_m_grams > numeric_limits<TShortId>::max()),
+                                string("The number of ") + std::to_string(level) +
+                                string("-grams is too large: ") + std::to_string(num_m_grams));
+
+                        m_level = level;
+                        m_num_word_ids = num_word_ids;
+                        m_max_entries = num_m_grams;
+                        m_is_sorted = is_presorted;
+
+                        m_word_offsets = new TShortId[m_num_word_ids + 1];
+                        memset(m_word_offsets, 0, (m_num_word_ids + 1) * sizeof (TShortId));
+                        if (!m_is_sorted) {
+                            m_word_ids = new TShortId[m_max_entries];
+                        }
+                        m_data = new ELEM_TYPE[m_max_entries];
+                    }
+
+                    /**
+                     * For a M-gram allows to create a new level entry for the given word id.
+                     * The entry is appended to the level array and the word entries are counted.
+                     * If the level is still sorted then the order of the entry is verified.
+                     * @param word_id the end word id of the M-gram
+                     * @param ctx_id the context id of the M-gram
+                     * @return the new level entry, with the context id set
+                     */
+                    inline ELEM_TYPE & add_entry(const TShortId word_id, const TLongId ctx_id) {
+                        LOG_DEBUG2 << "Making entry for M-gram with word_id:\t" << SSTR(word_id) << END_LOG;
+
+                        //Check if the capacity is exceeded.
+                        ASSERT_CONDITION_THROW((m_num_entries >= m_max_entries),
+                                string("The number of ") + std::to_string(m_level) +
+                                string("-grams exceeds the expected ") + std::to_string(m_max_entries));
+
+                        //Verify the pre-sorted order against the previous entry of the level
+                        if (m_is_sorted) {
+                            const uint64_t key = (static_cast<uint64_t> (word_id) << 32) | static_cast<TShortId> (ctx_id);
+                            if ((m_num_entries > 0) && (key <= m_last_key)) {
+                                set_unsorted();
+                            } else {
+                                m_last_key = key;
+                            }
+                        }
+
+                        //Count the word entry and remember the word of the entry, if the level is to be grouped
+                        m_word_offsets[word_id + 1]++;
+                        const TShortId entry_idx = m_num_entries++;
+                        if (!m_is_sorted) {
+                            m_word_ids[entry_idx] = word_id;
+                        }
+
+                        //Store the context id
+                        ELEM_TYPE & ref = m_data[entry_idx];
+                        ref.id = ctx_id;
+                        return ref;
+                    }
+
+                    /**
+                     * The purpose of this function is three fold:
+                     * 1. First we turn the per word entry counts into the word offsets.
+                     * 2. Second we move the level entries into their word groups, in place.
+                     * 3. Third we order the word groups by the context ids.
+                     */
+                    inline void post_grams() {
+                        //Compute the word offsets, offsets[w + 1] stores the number of word w entries
+                        for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                            m_word_offsets[word_id + 1] += m_word_offsets[word_id];
+                        }
+
+                        //The pre-sorted entries are already grouped and ordered
+                        if (m_is_sorted) {
+                            LOG_DEBUG << "The " << std::to_string(m_level) << "-grams are pre-sorted, no sorting is needed!" << END_LOG;
+                            return;
+                        }
+
+                        //Move the entries into their word groups, an entry is swapped
+                        //to the next free place in its group until the group is full
+                        TShortId * next_idx = new TShortId[m_num_word_ids];
+                        copy(m_word_offsets, m_word_offsets + m_num_word_ids, next_idx);
+                        for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                            while (next_idx[word_id] < m_word_offsets[word_id + 1]) {
+                                const TShortId entry_idx = next_idx[word_id];
+                                const TShortId entry_word_id = m_word_ids[entry_idx];
+                                if (entry_word_id != word_id) {
+                                    const TShortId place_idx = next_idx[entry_word_id]++;
+                                    swap(m_data[entry_idx], m_data[place_idx]);
+                                    swap(m_word_ids[entry_idx], m_word_ids[place_idx]);
+                                } else {
+                                    next_idx[word_id]++;
+                                }
+                            }
+                        }
+                        delete[] next_idx;
+
+                        //The end word ids are not needed any more
+                        delete[] m_word_ids;
+                        m_word_ids = NULL;
+
+                        //Order the word groups as we will binary search them later!
+                        for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                            sort(m_data + m_word_offsets[word_id], m_data + m_word_offsets[word_id + 1]);
+                        }
+                    }
+
+                    /**
+                     * For the given M-gram defined by the word id and a context id it allows to retrieve the data entry.
+                     * @param word_id the word id we need the to find the context entry by
+                     * @param ctx_id [in/out] the context id we are after, becomes the next context id
+                     * @param ppData [out] the pointer to the found entry
+                     * @return true if the data was found, otherwise false
+                     * @throw nothing
+                     */
+                    inline bool get_entry(const TShortId word_id, TLongId & ctx_id, const ELEM_TYPE **ppData) const {
+                        LOG_DEBUG2 << "Searching word data entry for ctx_id: " << SSTR(ctx_id) << END_LOG;
+
+                        //Get the word group borders
+                        const TShortId begin_idx = m_word_offsets[word_id];
+                        const TShortId end_idx = m_word_offsets[word_id + 1];
+
+                        //Check if there is data to search in
+                        if (begin_idx < end_idx) {
+                            //The data is available search for the word index in the array
+                            //WQRNING: Switching to linear search here significantly worsens
+                            //the performance!
+                            TShortId entry_idx;
+                            if (my_bsearch_id<ELEM_TYPE, TShortId>(m_data, begin_idx, end_idx - 1, ctx_id, entry_idx)) {
+                                LOG_DEBUG2 << "Found the entry index = " << SSTR(entry_idx) << END_LOG;
+
+                                //Return the pointer to the data located by the entry index
+                                *ppData = &m_data[entry_idx];
+
+                                //The next ctx_id is the entry index shifted by the first valid context id
+                                ctx_id = TRIE_BASE::FIRST_VALID_CTX_ID + entry_idx;
+                                return true;
+                            } else {
+                                LOG_DEBUG1 << "Unable to find M-gram context id for a word, prev ctx_id: "
+                                        << SSTR(ctx_id) << ", ctx_id range: [" << SSTR(m_data[begin_idx].id)
+                                        << ", " << SSTR(m_data[end_idx - 1].id) << "]" << END_LOG;
+                                return false;
+                            }
+                        } else {
+                            LOG_DEBUG1 << "Unable to find M-gram word id data for a word, nothing is present!" << END_LOG;
+                            return false;
+                        }
+                    }
+
+                    /**
+                     * Allows to add the level memory usage into the memory breakdown
+                     * @param trie_name the name of the trie storing the level
+                     * @param breakdown the memory breakdown to add to
+                     */
+                    inline void memory_breakdown(const char * trie_name, MemoryBreakdown & breakdown) const {
+                        if (m_word_offsets != NULL) {
+                            breakdown.add(trie_name, "offsets", m_level, (m_num_word_ids + 1) * sizeof (TShortId));
+                        }
+                        if (m_word_ids != NULL) {
+                            breakdown.add(trie_name, "word ids", m_level, m_max_entries * sizeof (TShortId));
+                        }
+                        if (m_data != NULL) {
+                            breakdown.add(trie_name, "entries", m_level, m_max_entries * sizeof (ELEM_TYPE));
+                        }
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~W2CArrayCSRLevel() {
+                        delete[] m_word_offsets;
+                        delete[] m_word_ids;
+                        delete[] m_data;
+                    }
+
+                private:
+                    //Stores the M-gram level
+                    TModelLevel m_level;
+                    //Stores the number of word ids
+                    TShortId m_num_word_ids;
+                    //Stores the word offsets table, has m_num_word_ids + 1 elements. While the level
+                    //is read the element w + 1 stores the number of word id w entries, afterwards
+                    //the element w is the group begin.
+                    TShortId * m_word_offsets;
+                    //Stores the end word ids of the level entries, only needed until the level is grouped
+                    TShortId * m_word_ids;
+                    //Stores the level entries
+                    ELEM_TYPE * m_data;
+                    //Stores the maximum number of entries
+                    TShortId m_max_entries;
+                    //Stores the current number of entries
+                    TShortId m_num_entries;
+                    //Stores the flag indicating that the level is still sorted in the pre-sorted mode
+                    bool m_is_sorted;
+                    //Stores the (end word id, context id) key of the last entry,
+                    //is used to verify the entries order in the pre-sorted mode
+                    uint64_t m_last_key;
+
+                    /**
+                     * Is called when an M-gram violating the pre-sorted order is added. Marks
+                     * the level as unsorted so that it is grouped and sorted in the post actions
+                     * and allocates the end word ids array. The entries added so far are sorted,
+                     * so their end word ids are restored from the per word entry counts.
+                     */
+                    inline void set_unsorted() {
+                        LOG_WARNING << "The " << std::to_string(m_level) << "-grams are not sorted by the end "
+                                << "word and context ids, will sort them after reading!" << END_LOG;
+                        m_is_sorted = false;
+
+                        m_word_ids = new TShortId[m_max_entries];
+                        TShortId entry_idx = 0;
+                        for (TShortId word_id = AWordIndex<TShortId>::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
+                            for (TShortId count = m_word_offsets[word_id + 1]; count > 0; --count) {
+                                m_word_ids[entry_idx++] = word_id;
+                            }
+                        }
+                    }
+
+                    //The level owns its arrays, so copying it would free them twice
+                    W2CArrayCSRLevel(const W2CArrayCSRLevel &) = delete;
+                    W2CArrayCSRLevel & operator=(const W2CArrayCSRLevel &) = delete;
+                };
             }
 
             /**
              * This is the Context to word array memory trie implementation class.
              * 
+             * The M-gram data of every level 1 < M <= N is stored per end word id and is
+             * sorted by the context id. By default every word has its own dynamic array
+             * per level, see W2CArrayWordLevel. If __W2CArrayTrie::USE_CSR_LAYOUT is set
+             * then every level is one contiguous array in the compressed sparse row layout,
+             * see W2CArrayCSRLevel. Both layouts give the same context ids.
+             * 
+             * If the m-grams are pre-sorted, see set_presorted, then they are to come
+             * in the layout order: by the end word id and then by the context id.
+             * The order is verified while reading and the levels that stay sorted
+             * are not sorted again.
+             * 
              * @param MAX_LEVEL the maximum number of levels in the trie.
              */
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -126,15 +635,6 @@ namespace uva {
                             << "-gram with word_id: " << SSTR(word_id) << ", ctx_id: "
                             << SSTR(ctx_id) << END_LOG;
 
-                    //First get the sub-array reference. 
-                    const T_M_GramWordEntry & ref = m_m_gram_word_2_data[level_idx][word_id];
-                    
-                    if (DO_SANITY_CHECKS && ref.has_data()) {
-                        LOG_DEBUG3 << "ref.size: " << SSTR(ref.size()) << ", ref.cio: "
-                                << SSTR(ref.cio) << ", ctx_id range: [" << SSTR(ref[0].id) << ", "
-                                << SSTR(ref[ref.size() - 1].id) << "]" << END_LOG;
-                    }
- 
                     //Check that if this is the 2-Gram case and the previous context
                     //id is 0 then it is the unknown word id, at least this is how it
                     //is now in ATrie implementation, so we need to do a warning!
@@ -145,20 +645,13 @@ namespace uva {
                                 << ") or unknown(" << SSTR(WordIndexType::UNKNOWN_WORD_ID) << ") word ids!" << END_LOG;
                     }
 
-                    //Get the local entry index and then use it to compute the next context id
-                    typename T_M_GramWordEntry::TIndexType local_idx;
-                    //If the local entry index could be found then compute the next ctx_id
-                    if (get_m_n_gram_local_entry_idx(ref, ctx_id, local_idx)) {
-                        LOG_DEBUG2 << "Got context mapping for ctx_id: " << SSTR(ctx_id)
-                                << ", size = " << SSTR(ref.size()) << ", localIdx = "
-                                << SSTR(local_idx) << ", resulting ctx_id = "
-                                << SSTR(ref.cio + local_idx) << END_LOG;
-
-                        //The next ctx_id is the sum of the local index and the context index offset
-                        ctx_id = ref.cio + local_idx;
+                    //Get the entry, if it is found then the ctx_id becomes the next context id
+                    const T_M_GramData * entry_ptr;
+                    if (m_m_gram_levels[level_idx].get_entry(word_id, ctx_id, &entry_ptr)) {
+                        LOG_DEBUG2 << "Got context mapping, resulting ctx_id = " << SSTR(ctx_id) << END_LOG;
                         return true;
                     } else {
-                        //The local index could not be found
+                        //The entry could not be found
                         return false;
                     }
                 }
@@ -168,8 +661,27 @@ namespace uva {
                  */
                 inline void log_trie_type_usage_info() const {
                     LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
-                    LOG_INFO << "Using the " << T_M_GramData::m_mem_strat.get_strategy_info()
-                            << "' memory allocation strategy." << END_LOG;
+                    if (__W2CArrayTrie::USE_CSR_LAYOUT) {
+                        LOG_INFO << "Using the compressed sparse row level layout." << END_LOG;
+                    } else {
+                        LOG_INFO << "Using the " << T_M_GramData::m_mem_strat.get_strategy_info()
+                                << "' memory allocation strategy." << END_LOG;
+                    }
+                }
+
+                /**
+                 * @see WordIndexTrieBase
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    if (m_1_gram_data != NULL) {
+                        breakdown.add("W2CArrayTrie", "payloads", M_GRAM_LEVEL_1, m_num_word_ids * sizeof (T_M_Gram_Payload));
+                    }
+                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                        m_m_gram_levels[idx].memory_breakdown("W2CArrayTrie", breakdown);
+                    }
+                    m_n_gram_level.memory_breakdown("W2CArrayTrie", breakdown);
                 }
 
                 /**
@@ -207,10 +719,10 @@ namespace uva {
 
                     //Do the post actions here
                     if (CURR_LEVEL == MAX_LEVEL) {
-                        post_n_grams();
+                        m_n_gram_level.post_grams();
                     } else {
                         if (CURR_LEVEL > M_GRAM_LEVEL_1) {
-                            post_m_grams<CURR_LEVEL>();
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].post_grams();
                         }
                     }
                 };
@@ -222,7 +734,7 @@ namespace uva {
                  * For more details @see LayeredTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     const TShortId word_id = gram.get_end_word_id();
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Store the payload
@@ -236,21 +748,13 @@ namespace uva {
                         //Obtain the m-gram context id
                         __LayeredTrieBase::get_context_id<W2CArrayTrie<MAX_LEVEL, WordIndexType>, CURR_LEVEL, DebugLevelsEnum::DEBUG2>(*this, gram, ctx_id);
 
-                        //Store the payload
+                        //Store the payload in the new level entry, the entry stores the context id
                         if (CURR_LEVEL == MAX_LEVEL) {
-                            //Get the sub-array reference. 
-                            typename T_N_GramWordEntry::TElemType & ref = make_m_n_gram_entry<T_N_GramWordEntry>(m_n_gram_word_2_data, word_id);
-                            //Store the context and word ids
-                            ref.id = ctx_id;
-                            //Return the reference to the probability
-                            ref.payload = gram.m_payload.m_prob;
+                            //Store the probability
+                            m_n_gram_level.add_entry(word_id, ctx_id).payload = gram.m_payload.m_prob;
                         } else {
-                            //Get the sub-array reference. 
-                            typename T_M_GramWordEntry::TElemType & ref = make_m_n_gram_entry<T_M_GramWordEntry>(m_m_gram_word_2_data[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET], word_id);
-                            //Store the context and word ids
-                            ref.id = ctx_id;
-                            //Return the reference to the newly allocated element
-                            ref.payload = gram.m_payload;
+                            //Store the probability and back-off
+                            m_m_gram_levels[CURR_LEVEL - BASE::MGRAM_IDX_OFFSET].add_entry(word_id, ctx_id).payload = gram.m_payload;
                         }
                     }
                 }
@@ -292,10 +796,9 @@ namespace uva {
                                 << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
 
                         //Get the entry
-                        const typename T_M_GramWordEntry::TElemType * entry_ptr;
+                        const T_M_GramData * entry_ptr;
                         const TModelLevel level_idx = (query.m_end_word_idx - query.m_begin_word_idx) + 1 - BASE::MGRAM_IDX_OFFSET;
-                        const T_M_GramWordEntry * ptr = m_m_gram_word_2_data[level_idx];
-                        if (get_m_n_gram_entry<T_M_GramWordEntry>(ptr, word_id, ctx_id, &entry_ptr)) {
+                        if (m_m_gram_levels[level_idx].get_entry(word_id, ctx_id, &entry_ptr)) {
                             //Return the data
                             query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &entry_ptr->payload;
                             LOG_DEBUG << "The payload is retrieved: " << (string) entry_ptr->payload << END_LOG;
@@ -326,8 +829,8 @@ namespace uva {
                                 << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
 
                         //Get the entry
-                        const typename T_N_GramWordEntry::TElemType * entry_ptr;
-                        if (get_m_n_gram_entry<T_N_GramWordEntry>(m_n_gram_word_2_data, word_id, ctx_id, &entry_ptr)) {
+                        const T_N_GramData * entry_ptr;
+                        if (m_n_gram_level.get_entry(word_id, ctx_id, &entry_ptr)) {
                             //Return the data
                             query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &entry_ptr->payload;
                             LOG_DEBUG << "The payload is retrieved: " << entry_ptr->payload << END_LOG;
@@ -347,71 +850,13 @@ namespace uva {
 
             protected:
 
-                /**
-                 * This class is to store the word mapping to the data for
-                 * the 1< M <= N grams. Demending on whether M == N or not this
-                 * structure is to be instantiated with a different template
-                 * parameter - defines the stored data.
-                 * @param ptr the pointer to the storage array
-                 * @param capacity the number of allocated elements
-                 * @param size the number of used elements
-                 * @param cio the context index offset for computing the next contex index.
-                 */
-                template<typename ARRAY_ELEM_TYPE>
-                class WordDataEntry : public DynamicStackArray<ARRAY_ELEM_TYPE, uint32_t> {
-                public:
-                    TShortId cio;
-                };
+                //The M-gram level type, 1 < M < N, depends on the configured level layout
+                typedef typename conditional<__W2CArrayTrie::USE_CSR_LAYOUT,
+                W2CArrayCSRLevel<T_M_GramData, BASE>, W2CArrayWordLevel<T_M_GramData, BASE> >::type TMGramLevel;
 
-                //The entries for the M-grams to store information about the end words
-                typedef WordDataEntry<T_M_GramData> T_M_GramWordEntry;
-                //The entries for the N-grams to store information about the end words
-                typedef WordDataEntry<T_N_GramData> T_N_GramWordEntry;
-
-                /**
-                 * The purpose of this local function is three fold:
-                 * 1. First we compute the context index offset values.
-                 * 2. Second we re-order the context data arrays per word.
-                 * 3. Free the unneeded memory allocated earlier.
-                 * @param WORD_ENTRY_TYPE word array element type
-                 * @param wordsArray the word array to work with
-                 */
-                template<typename WORD_ENTRY_TYPE>
-                void post_M_N_Grams(WORD_ENTRY_TYPE * wordsArray) {
-                    //Define and initialize the current context index offset.
-                    //The initial value is 1, although in this Trie it should
-                    //not matter much, but it is better to reserve 0 for
-                    //an undefined context value
-                    TShortId cio = BASE::FIRST_VALID_CTX_ID;
-
-                    //Iterate through all the word_id sub-array mappings in the level and sort sub arrays
-                    for (TShortId word_id = WordIndexType::UNDEFINED_WORD_ID; word_id < m_num_word_ids; word_id++) {
-                        //First get the sub-array reference. 
-                        WORD_ENTRY_TYPE & ref = wordsArray[word_id];
-
-                        //Assign the context index offset
-                        ref.cio = cio;
-                        //Compute the next context index offset, for the next word
-                        cio += ref.size();
-
-                        //Reduce capacity if there is unused memory
-                        ref.shrink();
-
-                        //Order the N-gram array as it is unordered and we will binary search it later!
-                        ref.sort();
-                    }
-                }
-
-                template<TModelLevel level>
-                inline void post_m_grams() {
-                    //Sort the level's data
-                    post_M_N_Grams<T_M_GramWordEntry>(m_m_gram_word_2_data[level - BASE::MGRAM_IDX_OFFSET]);
-                }
-
-                inline void post_n_grams() {
-                    //Sort the level's data
-                    post_M_N_Grams<T_N_GramWordEntry>(m_n_gram_word_2_data);
-                };
+                //The N-gram level type, depends on the configured level layout
+                typedef typename conditional<__W2CArrayTrie::USE_CSR_LAYOUT,
+                W2CArrayCSRLevel<T_N_GramData, BASE>, W2CArrayWordLevel<T_N_GramData, BASE> >::type TNGramLevel;
 
             private:
 
@@ -421,144 +866,15 @@ namespace uva {
                 //Stores the 1-gram data
                 T_M_Gram_Payload * m_1_gram_data;
 
-                //Stores the M-gram word to data mappings for: 1 < M < N
-                //This is a two dimensional array
-                T_M_GramWordEntry * m_m_gram_word_2_data[BASE::NUM_M_GRAM_LEVELS];
-
-                //Stores the M-gram word to data mappings for: 1 < M < N
-                //This is a one dimensional array
-                T_N_GramWordEntry * m_n_gram_word_2_data;
-
-                /**
-                 * For a M-gram allows to create a new context entry for the given word id.
-                 * This method words for 1 < M <= N.
-                 * @param WORD_ENTRY_TYPE the word entry type
-                 * @param wordsArray the array where the word entries of this level are stored
-                 * @param word_id the word id we need the new context entry from
-                 */
-                template<typename WORD_ENTRY_TYPE>
-                static inline typename WORD_ENTRY_TYPE::TElemType & make_m_n_gram_entry(WORD_ENTRY_TYPE* wordsArray, const TShortId & word_id) {
-                    LOG_DEBUG2 << "Making entry for M-gram with word_id:\t" << SSTR(word_id) << END_LOG;
-
-                    //Return the next new element new/free!
-                    return wordsArray[word_id].allocate();
-                };
-
-                /**
-                 * For the given M-gram defined by the word id and a context id it allows to retrieve local index where the m-gram's entry is stored.
-                 * This method words for 1 < M <= N.
-                 * @param WORD_ENTRY_TYPE the word entry type
-                 * @param wordEntry the word entry to search in
-                 * @param ctx_id the context id we are after
-                 * @param localIdx the [out] parameter which is the found local array index
-                 * @return true if the index was found otherwise false
-                 * @throw nothing
-                 */
-                template<typename WORD_ENTRY_TYPE>
-                bool get_m_n_gram_local_entry_idx(const WORD_ENTRY_TYPE & ref, const TLongId ctx_id, typename WORD_ENTRY_TYPE::TIndexType & local_idx) const {
-                    LOG_DEBUG2 << "Searching word data entry for ctx_id: " << SSTR(ctx_id) << END_LOG;
-
-                    //Check if there is data to search in
-                    if (ref.has_data()) {
-                        //The data is available search for the word index in the array
-                        //WQRNING: Switching to linear search here significantly worsens
-                        //the performance!
-                        if (my_bsearch_id<typename WORD_ENTRY_TYPE::TElemType, typename WORD_ENTRY_TYPE::TIndexType > (ref.data(), 0, ref.size() - 1, ctx_id, local_idx)) {
-                            LOG_DEBUG2 << "Found sub array local index = " << SSTR(local_idx) << END_LOG;
-                            return true;
-                        } else {
-                            LOG_DEBUG1 << "Unable to find M-gram context id for a word, prev ctx_id: "
-                                    << SSTR(ctx_id) << ", ctx_id range: [" << SSTR(ref[0].id)
-                                    << ", " << SSTR(ref[ref.size() - 1].id) << "]" << END_LOG;
-                            return false;
-                        }
-                    } else {
-                        LOG_DEBUG1 << "Unable to find M-gram word id data for a word, nothing is present!" << END_LOG;
-
-                        return false;
-                    }
-                }
-
-                /**
-                 * For the given M-gram defined by the word id and a context id it allows to retrieve the data entry.
-                 * This method words for 1 < M <= N. The level parameter is only used for debugging.
-                 * @param WORD_ENTRY_TYPE the word entry type
-                 * @param wordsArray the array where the word entries of this level are stored
-                 * @param word_id the word id we need the to find the context entry by
-                 * @param ctx_id the context id we are after
-                 * @return true if the data was found, otherwise false
-                 * @throw nothing
-                 */
-                template<typename WORD_ENTRY_TYPE>
-                inline bool get_m_n_gram_entry(const WORD_ENTRY_TYPE* wordsArray,
-                        const TShortId word_id, TLongId & ctx_id,
-                        const typename WORD_ENTRY_TYPE::TElemType **ppData) const {
-                    LOG_DEBUG2 << "Getting sub arr data for an m/n-gram with word_id: " << SSTR(word_id) << END_LOG;
-                    //Get the sub-array reference. 
-                    const WORD_ENTRY_TYPE & ref = wordsArray[word_id];
-
-                    //Get the local entry index
-                    typename WORD_ENTRY_TYPE::TIndexType local_idx;
-                    if (get_m_n_gram_local_entry_idx<WORD_ENTRY_TYPE>(ref, ctx_id, local_idx)) {
-                        //Return the pointer to the data located by the local index
-                        *ppData = &ref[local_idx];
-
-                        //The next ctx_id is the sum of the local index and the context index offset
-                        ctx_id = ref.cio + local_idx;
-
-                        return true;
-                    } else {
-                        LOG_DEBUG2 << "Unable to find data entry for an m/n-gram ctx_id: "
-                                << SSTR(ctx_id) << ", word_id: " << SSTR(word_id) << END_LOG;
-
-                        return false;
-                    }
-                }
+                //Stores the M-gram levels for: 1 < M < N
+                TMGramLevel m_m_gram_levels[BASE::NUM_M_GRAM_LEVELS];
 
-                /**
-                 * Allows to allocate word related data per word for the given M/N gram level
-                 * Depends on the global __W2COrderedArrayTrie::PRE_ALLOCATE_MEMORY if true
-                 * then will preallocate some memory for each word bucket! Default is false.
-                 * Depending on the number of words and n-grams in the given Trie level,
-                 * plus the value of:
-                 *      __W2COrderedArrayTrie::INIT_MEM_ALLOC_PRCT
-                 * This can have a drastic influence on MAX RSS.
-                 * @param WORD_ENTRY_TYPE the word entry type
-                 * @param wordsArray the reference to the word entry array to initialize
-                 * @param numMGrams the number of M-grams on this level
-                 * @param numWords the number of words in the Trie
-                 */
-                template<typename WORD_ENTRY_TYPE>
-                void preAllocateWordsData(WORD_ENTRY_TYPE* & wordsArray, const TShortId numMGrams, const TShortId numWords) {
-                    //Allocate dynamic array entries and initialize it with the memory increase strategy
-                    wordsArray = new WORD_ENTRY_TYPE[m_num_word_ids];
-
-                    //Compute the initial capacity
-                    size_t capacity = 0;
-                    if (__W2CArrayTrie::PRE_ALLOCATE_MEMORY) {
-                        //Compute the average number of data elements per word on the given M-gram level
-                        const float avg_num_elems = ((float) numMGrams) / ((float) numWords);
-                        //Compute the corrected number of elements to preallocate, minimum __W2COrderedArrayTrie::MIN_MEM_INC_NUM.
-                        capacity = max(static_cast<size_t> (avg_num_elems * __W2CArrayTrie::INIT_MEM_ALLOC_PRCT),
-                                __W2CArrayTrie::MIN_MEM_INC_NUM);
-
-                        //Pre-allocate capacity
-                        for (TShortId word_id = WordIndexType::MIN_KNOWN_WORD_ID; word_id < m_num_word_ids; word_id++) {
-                            wordsArray[word_id].pre_allocate(capacity);
-                        }
-                    }
-                }
+                //Stores the N-gram level
+                TNGramLevel m_n_gram_level;
             };
-
-            typedef W2CArrayTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TW2CArrayTrieBasic;
-            typedef W2CArrayTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TW2CArrayTrieCount;
-            typedef W2CArrayTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TW2CArrayTrieOptBasic;
-            typedef W2CArrayTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TW2CArrayTrieOptCount;
-            typedef W2CArrayTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TW2CArrayTrieHashing;
         }
     }
 }
 
 
 #endif	/* CONTEXTTOWORDHYBRIDMEMORYTRIE_HPP */
-
@@ -85,6 +85,14 @@ namespace uva {
                     return m_p_map->end();
                 };
 
+                inline const_iterator begin() const {
+                    return m_p_map->begin();
+                };
+
+                inline size_t size() const {
+                    return m_p_map->size();
+                };
+
             private:
                 //The map storage
                 TStorageUnsignedMap * m_p_map;
@@ -107,7 +115,7 @@ namespace uva {
                 {
                     for (size_t i = 1; i < N; i++) {
                         const GreedyMemoryStorage::size_type size = _counts[i] * factor;
-                        m_p_alloc[i - 1] = new TStorageMapAllocator(size);
+                        m_p_alloc[i - 1] = new TStorageMapAllocator(size, string("W2CH ") + std::to_string(i + 1) + string("-Grams"));
                         LOG_DEBUG2 << "Allocating a new TStorageMapAllocator("
                                 << size << ") for level " << i+1
                                 << ", the allocator m_p_alloc[" << (i - 1)
@@ -137,6 +145,19 @@ namespace uva {
                     return new W2CH_UM_Storage(*m_p_alloc[idx]);
                 }
 
+                /**
+                 * Releases the memory of the given M-gram level, all the containers
+                 * created for this level must be deleted before calling this method
+                 * @param level the N-gram level must be > 1 and <= N
+                 */
+                void release(const TModelLevel level) {
+                    const TModelLevel idx = level - 2;
+                    LOG_DEBUG3 << "Releasing the allocator m_p_alloc[" << idx
+                            << "] = " << SSTR(m_p_alloc[idx]) << END_LOG;
+                    delete m_p_alloc[idx];
+                    m_p_alloc[idx] = NULL;
+                }
+
             protected:
 
                 //The array of length ACtxToPBStorage::m_max_level
@@ -27,11 +27,13 @@
 #define	W2CHYBRIDMEMORYTRIE_HPP
 
 #include <string>   // std::string
+#include <algorithm> // std::sort
 
 #include "Globals.hpp"
 #include "Logger.hpp"
 
 #include "LayeredTrieBase.hpp"
+#include "ArrayUtils.hpp"
 
 #include "AWordIndex.hpp"
 #include "HashingWordIndex.hpp"
@@ -39,13 +41,38 @@
 
 using namespace std;
 using namespace uva::smt::tries::dictionary;
+using namespace uva::smt::utils::array;
 
 namespace uva {
     namespace smt {
         namespace tries {
 
+            namespace __W2CHybridTrie {
+
+                /**
+                 * The frozen context entry, maps the context id of an M-gram
+                 * ending with the given word into the M-gram id, for the
+                 * N-grams the probability is stored in place of the M-gram id.
+                 */
+                struct S_Ctx_Entry {
+                    TShortId id;
+                    TShortId data;
+
+                    inline bool operator<(const S_Ctx_Entry & other) const {
+                        return (id < other.id);
+                    }
+                };
+            }
+
             /**
              * This is the hybrid memory trie implementation class. It has three template parameters.
+             * 
+             * The M-grams of a level are first collected in per word storage containers. Once
+             * the level is read it is frozen: the containers of all the words are converted into
+             * one per level array of context entries, grouped by word and ordered by context id,
+             * plus an array of per word offsets into it. The containers are then deleted, so the
+             * queries, and the reading of the next levels, search the frozen arrays only.
+             * 
              * @param MAX_LEVEL the maximum number of levelns in the trie.
              * @param StorageFactory the factory to create storage containers
              * @param StorageContainer the storage container type that is created by the factory
@@ -71,27 +98,18 @@ namespace uva {
                     LOG_DEBUG3 << "Retrieving context level: " << curr_level << ", word_id: "
                             << word_id << ", ctx_id: " << ctx_id << END_LOG;
 
-                    //Retrieve the context data for the given word
-                    StorageContainer* ctx_mapping = m_mgram_mapping[level_idx][word_id];
-
-                    //Check that the context data is available
-                    if (ctx_mapping != NULL) {
-                        typename StorageContainer::const_iterator result = ctx_mapping->find(ctx_id);
-                        if (result == ctx_mapping->end()) {
-                            LOG_DEBUG2 << "Can not find ctx_id: " << SSTR(ctx_id) << " for level: "
-                                    << SSTR(curr_level) << ", word_id: " << SSTR(word_id) << END_LOG;
-                            return false;
-                        } else {
-                            LOG_DEBUG2 << "Found next ctx_id: " << SSTR(result->second)
-                                    << " for level: " << SSTR(curr_level) << ", word_id: "
-                                    << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
+                    //Retrieve the frozen context data for the given word
+                    const T_Ctx_Entry * entry;
+                    if (get_ctx_entry(level_idx, word_id, ctx_id, entry)) {
+                        LOG_DEBUG2 << "Found next ctx_id: " << SSTR(entry->data)
+                                << " for level: " << SSTR(curr_level) << ", word_id: "
+                                << SSTR(word_id) << ", ctx_id: " << SSTR(ctx_id) << END_LOG;
 
-                            ctx_id = result->second;
-                            return true;
-                        }
+                        ctx_id = entry->data;
+                        return true;
                     } else {
-                        LOG_DEBUG2 << "No context data for: " << SSTR(curr_level)
-                                << ", word_id: " << SSTR(word_id) << END_LOG;
+                        LOG_DEBUG2 << "Can not find ctx_id: " << SSTR(ctx_id) << " for level: "
+                                << SSTR(curr_level) << ", word_id: " << SSTR(word_id) << END_LOG;
                         return false;
                     }
                 }
@@ -103,6 +121,30 @@ namespace uva {
                     LOG_USAGE << "Using the <" << __FILE__ << "> model." << END_LOG;
                 }
 
+                /**
+                 * @see WordIndexTrieBase
+                 * The storage containers only exist while a level is read, so
+                 * only the frozen level arrays are accounted for
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    BASE::memory_breakdown(breakdown);
+
+                    for (TModelLevel idx = 0; idx < (MAX_LEVEL - 1); ++idx) {
+                        if (m_mgram_data[idx] != NULL) {
+                            const size_t num_payloads = (idx == 0) ? m_word_arr_size : BASE::get_num_m_grams(idx + 1);
+                            breakdown.add("W2CHybridTrie", "payloads", idx + 1, num_payloads * sizeof (T_M_Gram_Payload));
+                        }
+                        if (m_mgram_mapping[idx] != NULL) {
+                            breakdown.add("W2CHybridTrie", "mapping", idx + BASE::MGRAM_IDX_OFFSET, m_word_arr_size * sizeof (StorageContainer*));
+                        }
+                        if (m_word_offsets[idx] != NULL) {
+                            breakdown.add("W2CHybridTrie", "offsets", idx + BASE::MGRAM_IDX_OFFSET, (m_word_arr_size + 1) * sizeof (TShortId));
+                            breakdown.add("W2CHybridTrie", "entries", idx + BASE::MGRAM_IDX_OFFSET,
+                                    m_word_offsets[idx][m_word_arr_size] * sizeof (T_Ctx_Entry));
+                        }
+                    }
+                }
+
                 /**
                  * This method can be used to provide the N-gram count information
                  * That should allow for pre-allocation of the memory
@@ -110,6 +152,35 @@ namespace uva {
                  */
                 virtual void pre_allocate(const size_t counts[MAX_LEVEL]);
 
+                /**
+                 * This method allows to check if post processing should be called after
+                 * all the X level grams are read. This method is virtual.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                bool is_post_grams() const {
+                    //Check the base class and we need to do post actions
+                    //for all the M-grams with 1 < M <= N, they are frozen
+                    return (CURR_LEVEL > M_GRAM_LEVEL_1) || BASE::template is_post_grams<CURR_LEVEL>();
+                }
+
+                /**
+                 * This method should be called after all the X level grams are read.
+                 * For more details @see WordIndexTrieBase
+                 */
+                template<TModelLevel CURR_LEVEL>
+                inline void post_grams() {
+                    //Call the base class method first
+                    if (BASE::template is_post_grams<CURR_LEVEL>()) {
+                        BASE::template post_grams<CURR_LEVEL>();
+                    }
+
+                    //Freeze the level's context mappings
+                    if (CURR_LEVEL > M_GRAM_LEVEL_1) {
+                        freeze_level(CURR_LEVEL);
+                    }
+                };
+
                 /**
                  * Allows to retrieve the data storage structure for the M gram
                  * with the given M-gram level Id. M-gram context and last word Id.
@@ -117,7 +188,7 @@ namespace uva {
                  * For more details @see LayeredTrieBase
                  */
                 template<TModelLevel CURR_LEVEL>
-                inline void add_m_gram(const T_Model_M_Gram<WordIndexType> & gram) {
+                inline void add_m_gram(const T_Model_M_Gram<WordIndexType, MAX_LEVEL> & gram) {
                     const TShortId word_id = gram.get_end_word_id();
                     if (CURR_LEVEL == M_GRAM_LEVEL_1) {
                         //Store the payload
@@ -234,20 +305,12 @@ namespace uva {
                         TLongId & ctx_id = query.m_last_ctx_ids[query.m_begin_word_idx];
                         const TShortId & word_id = query.m_gram[query.m_end_word_idx];
 
-                        //Try to find the word mapping first
-                        StorageContainer*& ctx_mapping = m_mgram_mapping[BASE::N_GRAM_IDX_IN_M_N_ARR][word_id];
-
-                        //If the mapping is present the search further, otherwise return false
-                        if (ctx_mapping != NULL) {
-                            typename StorageContainer::const_iterator result = ctx_mapping->find(ctx_id);
-                            if (result == ctx_mapping->end()) {
-                                //The data could not be found
-                                status = MGramStatusEnum::BAD_NO_PAYLOAD_MGS;
-                            } else {
-                                //The data could be found
-                                query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &result->second;
-                                LOG_DEBUG << "The payload is retrieved: " << result->second << END_LOG;
-                            }
+                        //Search for the frozen context entry of the end word
+                        const T_Ctx_Entry * entry;
+                        if (get_ctx_entry(BASE::N_GRAM_IDX_IN_M_N_ARR, word_id, ctx_id, entry)) {
+                            //The data could be found, the entry stores the probability in place of the id
+                            query.m_payloads[query.m_begin_word_idx][query.m_end_word_idx] = &entry->data;
+                            LOG_DEBUG << "The payload is retrieved: " << reinterpret_cast<const TLogProbBackOff&> (entry->data) << END_LOG;
                         } else {
                             //The payload could not be found
                             LOG_DEBUG1 << "Unable to find " << SSTR(MAX_LEVEL) << "-gram data for ctx_id: "
@@ -302,13 +365,43 @@ namespace uva {
                 //for 1 < M < N.
                 const static TModelLevel NUM_IDX_COUNTERS = MAX_LEVEL - 2;
                 TShortId next_ctx_id[NUM_IDX_COUNTERS];
-            };
 
-            typedef W2CHybridTrie<M_GRAM_LEVEL_MAX, BasicWordIndex > TW2CHybridTrieBasic;
-            typedef W2CHybridTrie<M_GRAM_LEVEL_MAX, CountingWordIndex > TW2CHybridTrieCount;
-            typedef W2CHybridTrie<M_GRAM_LEVEL_MAX, TOptBasicWordIndex > TW2CHybridTrieOptBasic;
-            typedef W2CHybridTrie<M_GRAM_LEVEL_MAX, TOptCountWordIndex > TW2CHybridTrieOptCount;
-            typedef W2CHybridTrie<M_GRAM_LEVEL_MAX, HashingWordIndex > TW2CHybridTrieHashing;
+                //The frozen context entry type
+                typedef __W2CHybridTrie::S_Ctx_Entry T_Ctx_Entry;
+
+                //The frozen M-Gram data for 1 < M <= N, per level an array of
+                //#words + 1 offsets into the level's context entries array:
+                //the entries of word w are in [offsets[w], offsets[w + 1])
+                TShortId * m_word_offsets[MAX_LEVEL - 1];
+                //The frozen M-Gram data for 1 < M <= N, per level an array of
+                //the context entries grouped by word and ordered by context id
+                T_Ctx_Entry * m_ctx_entries[MAX_LEVEL - 1];
+
+                /**
+                 * Allows to search for the frozen context entry
+                 * @param level_idx the M-gram level index in the M/N-gram arrays
+                 * @param word_id the end word id of the M-gram
+                 * @param ctx_id the context id of the M-gram
+                 * @param entry [out] the found entry
+                 * @return true if the entry is found, otherwise false
+                 */
+                inline bool get_ctx_entry(const TModelLevel level_idx, const TShortId word_id,
+                        const TLongId ctx_id, const T_Ctx_Entry * & entry) const {
+                    const TShortId * offsets = m_word_offsets[level_idx];
+                    const TShortId begin_idx = offsets[word_id];
+                    const TShortId end_idx = offsets[word_id + 1];
+
+                    return (begin_idx != end_idx) &&
+                            my_branchless_search_id(m_ctx_entries[level_idx] + begin_idx, end_idx - begin_idx, ctx_id, entry);
+                }
+
+                /**
+                 * Allows to freeze the given M-gram level: to convert the per word
+                 * storage containers into the arrays of ordered context entries
+                 * @param level the M-gram level to freeze, 1 < M <= N
+                 */
+                void freeze_level(const TModelLevel level);
+            };
         }
     }
 }
@@ -27,6 +27,7 @@
 #define	WORDINDEXTRIE_HPP
 
 #include <string>       // std::string
+#include <cstring>      // std::memcpy std::memset
 
 #include "Globals.hpp"
 #include "Exceptions.hpp"
@@ -37,6 +38,8 @@
 #include "BasicWordIndex.hpp"
 #include "CountingWordIndex.hpp"
 #include "OptimizingWordIndex.hpp"
+#include "HashingWordIndex.hpp"
+#include "MemoryBreakdown.hpp"
 
 using namespace std;
 using namespace uva::smt::logging;
@@ -65,7 +68,8 @@ namespace uva {
                  * @param word_index the word index to be used
                  */
                 explicit WordIndexTrieBase(WordIndexType & word_index)
-                : m_word_index(word_index) {
+                : m_word_index(word_index), m_num_word_ids(0) {
+                    memset(m_num_m_grams, 0, N * sizeof (size_t));
                 }
 
                 /**
@@ -76,6 +80,10 @@ namespace uva {
                 inline void pre_allocate(const size_t counts[N]) {
                     m_word_index.reserve(counts[0]);
                     Logger::update_progress_bar();
+
+                    //Store the m-gram counts for the memory breakdown
+                    memcpy(m_num_m_grams, counts, N * sizeof (size_t));
+                    m_num_word_ids = m_word_index.get_number_of_words(counts[0]);
                 };
 
                 /**
@@ -105,19 +113,84 @@ namespace uva {
                     return m_word_index;
                 };
 
+                /**
+                 * Allows to get the number of word ids, including the reserved ones,
+                 * is the size of the word id indexed uni-gram arrays
+                 * @return the number of word ids as computed in pre_allocate
+                 */
+                inline size_t get_num_word_ids() const {
+                    return m_num_word_ids;
+                }
+
+                /**
+                 * Allows to get the number of m-grams of the given level
+                 * @param level the m-gram level
+                 * @return the number of m-grams as given to pre_allocate
+                 */
+                inline size_t get_num_m_grams(const TModelLevel level) const {
+                    return m_num_m_grams[level - 1];
+                }
+
+                /**
+                 * Allows to add the trie memory usage into the memory breakdown.
+                 * Sets the number of m-grams per level and adds the word index.
+                 * The tries are to extend it with their data structures.
+                 * @param breakdown the memory breakdown to add to
+                 */
+                inline void memory_breakdown(MemoryBreakdown & breakdown) const {
+                    for (TModelLevel level = M_GRAM_LEVEL_1; level <= N; ++level) {
+                        breakdown.set_num_m_grams(level, get_num_m_grams(level));
+                    }
+                    m_word_index.memory_breakdown(breakdown);
+                }
+
             protected:
                 //Stores the reference to the word index to be used
                 WordIndexType & m_word_index;
+
+            private:
+                //Stores the number of m-grams per level, as given to pre_allocate
+                size_t m_num_m_grams[N];
+                //Stores the number of word ids, as computed in pre_allocate
+                size_t m_num_word_ids;
             };
 
             template<TModelLevel N, typename WordIndex>
             const TModelLevel WordIndexTrieBase<N, WordIndex>::MAX_LEVEL = N;
 
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-            template class WordIndexTrieBase<M_GRAM_LEVEL_MAX, BasicWordIndex >;
-            template class WordIndexTrieBase<M_GRAM_LEVEL_MAX, CountingWordIndex>;
-            template class WordIndexTrieBase<M_GRAM_LEVEL_MAX, OptimizingWordIndex<BasicWordIndex> >;
-            template class WordIndexTrieBase<M_GRAM_LEVEL_MAX, OptimizingWordIndex<CountingWordIndex> >;
+            /**
+             * Allows to get the word index class for the given word index type value.
+             * The tries are only instantiated and used with the word index type
+             * configured for them, i.e. their WORD_INDEX_TYPE constants.
+             * @param WORD_INDEX_TYPE the word index type value
+             */
+            template<WordIndexTypesEnum WORD_INDEX_TYPE>
+            struct S_Word_Index_Type;
+
+            template<>
+            struct S_Word_Index_Type<WordIndexTypesEnum::BASIC_WORD_INDEX> {
+                typedef BasicWordIndex type;
+            };
+
+            template<>
+            struct S_Word_Index_Type<WordIndexTypesEnum::COUNTING_WORD_INDEX> {
+                typedef CountingWordIndex type;
+            };
+
+            template<>
+            struct S_Word_Index_Type<WordIndexTypesEnum::OPTIMIZING_BASIC_WORD_INDEX> {
+                typedef OptimizingWordIndex<BasicWordIndex> type;
+            };
+
+            template<>
+            struct S_Word_Index_Type<WordIndexTypesEnum::OPTIMIZING_COUNTING_WORD_INDEX> {
+                typedef OptimizingWordIndex<CountingWordIndex> type;
+            };
+
+            template<>
+            struct S_Word_Index_Type<WordIndexTypesEnum::HASHING_WORD_INDEX> {
+                typedef HashingWordIndex type;
+            };
         }
     }
 }
@@ -35,19 +35,30 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 
 # Object Files
 OBJECTFILES= \
-	${OBJECTDIR}/src/ARPAGramBuilder.o \
-	${OBJECTDIR}/src/ARPATrieBuilder.o \
+	${OBJECTDIR}/src/A2DHybridTrie.o \
+	${OBJECTDIR}/src/A2DHybridTrieExecutor.o \
 	${OBJECTDIR}/src/AWordIndex.o \
 	${OBJECTDIR}/src/ByteMGramId.o \
 	${OBJECTDIR}/src/C2DHybridTrie.o \
+	${OBJECTDIR}/src/C2DHybridTrieExecutor.o \
 	${OBJECTDIR}/src/C2DMapTrie.o \
+	${OBJECTDIR}/src/C2DMapTrieExecutor.o \
 	${OBJECTDIR}/src/C2WArrayTrie.o \
+	${OBJECTDIR}/src/C2WArrayTrieExecutor.o \
+	${OBJECTDIR}/src/C2WEliasFanoTrie.o \
+	${OBJECTDIR}/src/C2WEliasFanoTrieExecutor.o \
+	${OBJECTDIR}/src/F2DMapTrie.o \
+	${OBJECTDIR}/src/F2DMapTrieExecutor.o \
 	${OBJECTDIR}/src/G2DMapTrie.o \
+	${OBJECTDIR}/src/G2DMapTrieExecutor.o \
 	${OBJECTDIR}/src/H2DMapTrie.o \
+	${OBJECTDIR}/src/H2DMapTrieExecutor.o \
 	${OBJECTDIR}/src/Logger.o \
 	${OBJECTDIR}/src/StatisticsMonitor.o \
 	${OBJECTDIR}/src/W2CArrayTrie.o \
+	${OBJECTDIR}/src/W2CArrayTrieExecutor.o \
 	${OBJECTDIR}/src/W2CHybridTrie.o \
+	${OBJECTDIR}/src/W2CHybridTrieExecutor.o \
 	${OBJECTDIR}/src/main.o \
 	${OBJECTDIR}/src/xxhash.o
 
@@ -74,17 +85,17 @@ LDLIBSOPTIONS=
 
 ${CND_DISTDIR}/${CND_CONF}/back-off-language-model-smt: ${OBJECTFILES}
 	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}
-	g++ -o ${CND_DISTDIR}/${CND_CONF}/back-off-language-model-smt ${OBJECTFILES} ${LDLIBSOPTIONS} -g -O0 -m64 -pg -Wall -fno-omit-frame-pointer
+	g++ -o ${CND_DISTDIR}/${CND_CONF}/back-off-language-model-smt ${OBJECTFILES} ${LDLIBSOPTIONS} -g -O0 -m64 -pg -Wall -fno-omit-frame-pointer -pthread -lz -llzma
 
-${OBJECTDIR}/src/ARPAGramBuilder.o: src/ARPAGramBuilder.cpp 
+${OBJECTDIR}/src/A2DHybridTrie.o: src/A2DHybridTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
-	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/ARPAGramBuilder.o src/ARPAGramBuilder.cpp
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/A2DHybridTrie.o src/A2DHybridTrie.cpp
 
-${OBJECTDIR}/src/ARPATrieBuilder.o: src/ARPATrieBuilder.cpp 
+${OBJECTDIR}/src/A2DHybridTrieExecutor.o: src/A2DHybridTrieExecutor.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
-	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/ARPATrieBuilder.o src/ARPATrieBuilder.cpp
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/A2DHybridTrieExecutor.o src/A2DHybridTrieExecutor.cpp
 
 ${OBJECTDIR}/src/AWordIndex.o: src/AWordIndex.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
@@ -101,26 +112,71 @@ ${OBJECTDIR}/src/C2DHybridTrie.o: src/C2DHybridTrie.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2DHybridTrie.o src/C2DHybridTrie.cpp
 
+${OBJECTDIR}/src/C2DHybridTrieExecutor.o: src/C2DHybridTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2DHybridTrieExecutor.o src/C2DHybridTrieExecutor.cpp
+
 ${OBJECTDIR}/src/C2DMapTrie.o: src/C2DMapTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2DMapTrie.o src/C2DMapTrie.cpp
 
+${OBJECTDIR}/src/C2DMapTrieExecutor.o: src/C2DMapTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2DMapTrieExecutor.o src/C2DMapTrieExecutor.cpp
+
 ${OBJECTDIR}/src/C2WArrayTrie.o: src/C2WArrayTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2WArrayTrie.o src/C2WArrayTrie.cpp
 
+${OBJECTDIR}/src/C2WArrayTrieExecutor.o: src/C2WArrayTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2WArrayTrieExecutor.o src/C2WArrayTrieExecutor.cpp
+
+${OBJECTDIR}/src/C2WEliasFanoTrie.o: src/C2WEliasFanoTrie.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2WEliasFanoTrie.o src/C2WEliasFanoTrie.cpp
+
+${OBJECTDIR}/src/C2WEliasFanoTrieExecutor.o: src/C2WEliasFanoTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/C2WEliasFanoTrieExecutor.o src/C2WEliasFanoTrieExecutor.cpp
+
+${OBJECTDIR}/src/F2DMapTrie.o: src/F2DMapTrie.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/F2DMapTrie.o src/F2DMapTrie.cpp
+
+${OBJECTDIR}/src/F2DMapTrieExecutor.o: src/F2DMapTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/F2DMapTrieExecutor.o src/F2DMapTrieExecutor.cpp
+
 ${OBJECTDIR}/src/G2DMapTrie.o: src/G2DMapTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/G2DMapTrie.o src/G2DMapTrie.cpp
 
+${OBJECTDIR}/src/G2DMapTrieExecutor.o: src/G2DMapTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/G2DMapTrieExecutor.o src/G2DMapTrieExecutor.cpp
+
 ${OBJECTDIR}/src/H2DMapTrie.o: src/H2DMapTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/H2DMapTrie.o src/H2DMapTrie.cpp
 
+${OBJECTDIR}/src/H2DMapTrieExecutor.o: src/H2DMapTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/H2DMapTrieExecutor.o src/H2DMapTrieExecutor.cpp
+
 ${OBJECTDIR}/src/Logger.o: src/Logger.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
@@ -136,11 +192,21 @@ ${OBJECTDIR}/src/W2CArrayTrie.o: src/W2CArrayTrie.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/W2CArrayTrie.o src/W2CArrayTrie.cpp
 
+${OBJECTDIR}/src/W2CArrayTrieExecutor.o: src/W2CArrayTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/W2CArrayTrieExecutor.o src/W2CArrayTrieExecutor.cpp
+
 ${OBJECTDIR}/src/W2CHybridTrie.o: src/W2CHybridTrie.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/W2CHybridTrie.o src/W2CHybridTrie.cpp
 
+${OBJECTDIR}/src/W2CHybridTrieExecutor.o: src/W2CHybridTrieExecutor.cpp 
+	${MKDIR} -p ${OBJECTDIR}/src
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -Werror -Iext -Iinc -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/src/W2CHybridTrieExecutor.o src/W2CHybridTrieExecutor.cpp
+
 ${OBJECTDIR}/src/main.o: src/main.cpp 
 	${MKDIR} -p ${OBJECTDIR}/src
 	${RM} "$@.d"
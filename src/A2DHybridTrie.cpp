@@ -0,0 +1,167 @@
+/*
+ * File:   A2DHybridTrie.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:15 PM
+ */
+
+#include "A2DHybridTrie.hpp"
+
+#include <inttypes.h>   // std::uint32_t
+#include <algorithm>    // std::max
+#include <cmath>        // std::log2 std::ceil std::pow
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+
+#include "BasicWordIndex.hpp"
+#include "CountingWordIndex.hpp"
+#include "OptimizingWordIndex.hpp"
+
+using namespace uva::smt::tries::dictionary;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            A2DHybridTrie<MAX_LEVEL, WordIndexType>::A2DHybridTrie(WordIndexType & word_index)
+            : LayeredTrieBase<A2DHybridTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __A2DHybridTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
+            m_first_map_level(MAX_LEVEL + 1), m_1_gram_data(NULL), m_one_gram_arr_size(0) {
+                //Perform an error check! This container has bounds on the supported trie level
+                ASSERT_CONDITION_THROW((MAX_LEVEL < M_GRAM_LEVEL_2), string("The minimum supported trie level is") + std::to_string(M_GRAM_LEVEL_2));
+                ASSERT_CONDITION_THROW((MAX_LEVEL > MAX_SUPP_GRAM_LEVEL), string("The maximum supported trie level is") + std::to_string(MAX_SUPP_GRAM_LEVEL));
+                ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            double A2DHybridTrie<MAX_LEVEL, WordIndexType>::get_array_bits_per_m_gram(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const {
+                const double num_m_grams = max(counts[curr_level - 1], (size_t) 1);
+                if (curr_level == MAX_LEVEL) {
+                    //The N-grams are stored with their context ids
+                    return BYTES_TO_BITS(sizeof (TCtxIdProbEntry));
+                } else {
+                    //The M-grams are stored with the sub-array references of the previous level contexts
+                    const double num_ctx = (curr_level == M_GRAM_LEVEL_2) ? m_one_gram_arr_size : (counts[curr_level - 2] + BASE::FIRST_VALID_CTX_ID);
+                    return BYTES_TO_BITS(sizeof (TWordIdPBEntry) + (sizeof (TSubArrReference) * num_ctx) / num_m_grams);
+                }
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            double A2DHybridTrie<MAX_LEVEL, WordIndexType>::get_array_misses_per_lookup(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const {
+                //The N-grams are binary searched in the entire array, the M-grams within their context
+                //sub-array, found by one more memory access. The steps within one cache line are free.
+                const double num_m_grams = counts[curr_level - 1];
+                if (curr_level == MAX_LEVEL) {
+                    const double num_lines = (num_m_grams * sizeof (TCtxIdProbEntry)) / __A2DHybridTrie::CACHE_LINE_BYTES;
+                    return std::log2(num_lines + 1.0) + 1.0;
+                } else {
+                    const double num_search = num_m_grams / max(counts[curr_level - 2], (size_t) 1);
+                    const double num_lines = (num_search * sizeof (TWordIdPBEntry)) / __A2DHybridTrie::CACHE_LINE_BYTES;
+                    return std::log2(num_lines + 1.0) + 2.0;
+                }
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            double A2DHybridTrie<MAX_LEVEL, WordIndexType>::get_map_bits_per_m_gram(const TModelLevel curr_level, const size_t counts[MAX_LEVEL]) const {
+                const double num_m_grams = max(counts[curr_level - 1], (size_t) 1);
+
+                //The elements and the buckets, the number of buckets is a power of two, see FixedSizeHashMap
+                const double elem_bytes = (curr_level == MAX_LEVEL) ? sizeof (typename TProbLevel::TElemType) : sizeof (typename TProbBackLevel::TElemType);
+                const double num_buckets = std::pow(2.0, std::ceil(std::log2(__A2DHybridTrie::BUCKETS_FACTOR * (num_m_grams + 1.0))));
+                const double bucket_bytes = (sizeof (uint32_t) * num_buckets) / num_m_grams;
+
+                //The m-gram id is stored in the level's id arena, it stores the id type and the significant word id bytes
+                const double word_id_bytes = std::ceil(std::log2(m_one_gram_arr_size + 1.0) / NUM_BITS_IN_UINT_8);
+                const double id_bytes = Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::ID_TYPE_LEN_BYTES[curr_level]
+                        + curr_level * word_id_bytes;
+
+                return BYTES_TO_BITS(elem_bytes + bucket_bytes + id_bytes);
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            void A2DHybridTrie<MAX_LEVEL, WordIndexType>::pre_allocate(const size_t counts[MAX_LEVEL]) {
+                //01) Pre-allocate the word index super class call
+                BASE::pre_allocate(counts);
+
+                //02) Pre-allocate the 1-Gram data, it is a dense array indexed by the word ids
+                m_one_gram_arr_size = BASE::get_word_index().get_number_of_words(counts[0]);
+                m_1_gram_data = new T_M_Gram_Payload[m_one_gram_arr_size];
+                memset(m_1_gram_data, 0, m_one_gram_arr_size * sizeof (T_M_Gram_Payload));
+
+                //Insert the unknown word data into the allocated array
+                T_M_Gram_Payload & pb_data = m_1_gram_data[WordIndexType::UNKNOWN_WORD_ID];
+                pb_data.m_prob = UNK_WORD_LOG_PROB_WEIGHT;
+                pb_data.m_back = ZERO_BACK_OFF_WEIGHT;
+
+                //03) Choose the representation per level, the level gets the one that exceeds
+                //its worst target the least, once a hash map is chosen the rest are hash maps.
+                m_first_map_level = MAX_LEVEL + 1;
+                for (TModelLevel curr_level = M_GRAM_LEVEL_2; curr_level <= MAX_LEVEL; ++curr_level) {
+                    const double arr_bits = get_array_bits_per_m_gram(curr_level, counts);
+                    const double arr_misses = get_array_misses_per_lookup(curr_level, counts);
+                    const double map_bits = get_map_bits_per_m_gram(curr_level, counts);
+                    const double map_misses = __A2DHybridTrie::MISSES_PER_HASH_LOOKUP;
+
+                    const double arr_excess = max(arr_bits / __A2DHybridTrie::TARGET_BITS_PER_M_GRAM, arr_misses / __A2DHybridTrie::TARGET_MISSES_PER_LOOKUP);
+                    const double map_excess = max(map_bits / __A2DHybridTrie::TARGET_BITS_PER_M_GRAM, map_misses / __A2DHybridTrie::TARGET_MISSES_PER_LOOKUP);
+
+                    if ((m_first_map_level > MAX_LEVEL) && (map_excess < arr_excess)) {
+                        m_first_map_level = curr_level;
+                    }
+
+                    LOG_INFO << "The " << SSTR(curr_level) << "-grams: array " << arr_bits << " bits, " << arr_misses
+                            << " misses; hash map " << map_bits << " bits, " << map_misses << " misses; using the "
+                            << (is_array_level(curr_level) ? "array" : "hash map") << END_LOG;
+                }
+
+                //04) Allocate the sorted array and the hash map levels, the number of contexts of
+                //an array level is the number of entries of the previous level, or of words
+                for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; ++idx) {
+                    const TModelLevel curr_level = idx + BASE::MGRAM_IDX_OFFSET;
+                    if (is_array_level(curr_level)) {
+                        const size_t num_ctx = (idx == 0) ? m_one_gram_arr_size : m_m_gram_arrays[idx - 1].get_num_entries();
+                        m_m_gram_arrays[idx].allocate(curr_level, num_ctx, counts[idx + 1], BASE::is_presorted(), BASE::get_build_mem_limit());
+                    } else {
+                        m_m_gram_maps[idx].allocate(__A2DHybridTrie::BUCKETS_FACTOR, curr_level, counts[idx + 1], m_one_gram_arr_size - 1);
+                    }
+                }
+
+                //05) Allocate the N-gram level
+                if (is_array_level(MAX_LEVEL)) {
+                    m_n_gram_array.allocate(MAX_LEVEL, counts[MAX_LEVEL - 1], BASE::is_presorted(), BASE::get_build_mem_limit());
+                } else {
+                    m_n_gram_map.allocate(__A2DHybridTrie::BUCKETS_FACTOR, MAX_LEVEL, counts[MAX_LEVEL - 1], m_one_gram_arr_size - 1);
+                }
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            A2DHybridTrie<MAX_LEVEL, WordIndexType>::~A2DHybridTrie() {
+                //The array and hash map levels free their own data
+                delete[] m_1_gram_data;
+            }
+
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(A2DHybridTrie, S_Word_Index_Type<__A2DHybridTrie::WORD_INDEX_TYPE>::type);
+        }
+    }
+}
@@ -170,10 +170,10 @@ namespace uva {
                     uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::create_m_gram_id(const TWordIdType * word_ids,
                             const uint8_t num_word_ids, TM_Gram_Id_Value_Ptr & m_p_gram_id) {
                         //Do the sanity check if needed
-                        ASSERT_SANITY_THROW((num_word_ids < M_GRAM_LEVEL_2) || (num_word_ids > M_GRAM_LEVEL_6),
+                        ASSERT_SANITY_THROW((num_word_ids < M_GRAM_LEVEL_2) || (num_word_ids > MAX_SUPP_GRAM_LEVEL),
                                 string("create_m_gram_id: Unsupported m-gram level: ") + std::to_string(num_word_ids) +
                                 string(", must be within [") + std::to_string(M_GRAM_LEVEL_2) + string(", ") +
-                                std::to_string(M_GRAM_LEVEL_6) + string("]"));
+                                std::to_string(MAX_SUPP_GRAM_LEVEL) + string("]"));
 
                         //Get the id len in bytes
                         const uint8_t TYPE_LEN_BYTES = ID_TYPE_LEN_BYTES[num_word_ids];
@@ -199,7 +199,7 @@ namespace uva {
                         //memset(m_p_gram_id, 0, id_len_bytes);
 
                         //Determine the type id value from the bit lengths of the words
-                        const uint32_t & id_type_value = gram_id_byte_len_2_type(num_word_ids, len_bytes);
+                        const uint32_t id_type_value = gram_id_byte_len_2_type(num_word_ids, len_bytes);
                         LOG_DEBUG3 << "ID_TYPE_LEN_BYTES: " << (uint32_t) TYPE_LEN_BYTES
                                 << ", id_type_value: " << id_type_value << END_LOG;
 
@@ -249,10 +249,10 @@ namespace uva {
                     uint8_t Byte_M_Gram_Id<TWordIdType, MAX_LEVEL>::compute_m_gram_id(const TWordIdType * word_ids,
                             const uint8_t num_word_ids, TM_Gram_Id_Value_Ptr m_p_gram_id) {
                         //Do the sanity check if needed
-                        ASSERT_SANITY_THROW((num_word_ids < M_GRAM_LEVEL_2) || (num_word_ids > M_GRAM_LEVEL_6),
+                        ASSERT_SANITY_THROW((num_word_ids < M_GRAM_LEVEL_2) || (num_word_ids > MAX_SUPP_GRAM_LEVEL),
                                 string("create_m_gram_id: Unsupported m-gram level: ") + std::to_string(num_word_ids) +
                                 string(", must be within [") + std::to_string(M_GRAM_LEVEL_2) + string(", ") +
-                                std::to_string(M_GRAM_LEVEL_6) + string("]"));
+                                std::to_string(MAX_SUPP_GRAM_LEVEL) + string("]"));
 
                         //Get the id len in bytes
                         const uint8_t TYPE_LEN_BYTES = ID_TYPE_LEN_BYTES[num_word_ids];
@@ -281,7 +281,7 @@ namespace uva {
                         LOG_DEBUG3 << "Total len. in bytes: " << SSTR((uint32_t) id_len_bytes) << END_LOG;
 
                         //Determine the type id value from the bit lengths of the words
-                        const uint32_t & id_type_value = gram_id_byte_len_2_type(num_word_ids, len_bytes);
+                        const uint32_t id_type_value = gram_id_byte_len_2_type(num_word_ids, len_bytes);
                         LOG_DEBUG3 << "ID_TYPE_LEN_BYTES: " << (uint32_t) TYPE_LEN_BYTES
                                 << ", id_type_value: " << id_type_value << END_LOG;
 
@@ -295,9 +295,12 @@ namespace uva {
                         return id_len_bytes;
                     }
 
-                    //Make sure at least the following templates are instantiated
-                    template class Byte_M_Gram_Id<uint32_t, M_GRAM_LEVEL_MAX>;
-                    template class Byte_M_Gram_Id<uint64_t, M_GRAM_LEVEL_MAX>;
+                    //Make sure the templates are instantiated for all the supported levels
+#define INSTANTIATE_BYTE_M_GRAM_ID_LEVEL(LEVEL, ID_TYPE) \
+                    template class Byte_M_Gram_Id<ID_TYPE, LEVEL>;
+
+                    INSTANTIATE_FOR_SUPPORTED_LEVELS(INSTANTIATE_BYTE_M_GRAM_ID_LEVEL, uint32_t);
+                    INSTANTIATE_FOR_SUPPORTED_LEVELS(INSTANTIATE_BYTE_M_GRAM_ID_LEVEL, uint64_t);
                 }
             }
         }
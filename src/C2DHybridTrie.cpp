@@ -56,7 +56,6 @@ namespace uva {
                 ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
 
                 //Memset the M grams reference and data arrays
-                memset(m_m_gram_alloc_ptrs, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (TMGramAllocator *));
                 memset(m_m_gram_map_ptrs, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (TMGramsMap *));
                 memset(m_m_gram_data, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (T_M_Gram_Payload *));
 
@@ -65,7 +64,6 @@ namespace uva {
                 memset(m_M_gram_next_ctx_id, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (TShortId));
 
                 //Initialize the N-gram level data
-                m_n_gram_alloc_ptr = NULL;
                 m_n_gram_map_ptr = NULL;
             }
 
@@ -95,7 +93,7 @@ namespace uva {
                     const uint num_grams = counts[idx + 1];
 
                     //Reserve the memory for the map
-                    reserve_mem_unordered_map<TMGramsMap, TMGramAllocator>(&m_m_gram_map_ptrs[idx], &m_m_gram_alloc_ptrs[idx], num_grams, "M-Grams", m_mgram_mem_factor);
+                    m_m_gram_map_ptrs[idx] = new TMGramsMap(num_grams, m_mgram_mem_factor);
 
                     //Get the number of M-gram indexes on this level
                     const uint num_ngram_idx = m_M_gram_num_ctx_ids[idx];
@@ -112,7 +110,7 @@ namespace uva {
                 const size_t numEntries = counts[MAX_LEVEL - 1];
 
                 //Reserve the memory for the map
-                reserve_mem_unordered_map<TNGramsMap, TNGramAllocator>(&m_n_gram_map_ptr, &m_n_gram_alloc_ptr, numEntries, "N-Grams", m_ngram_mem_factor);
+                m_n_gram_map_ptr = new TNGramsMap(numEntries, m_ngram_mem_factor);
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -148,20 +146,16 @@ namespace uva {
 
                 //Deallocate M-Grams there are N-2 M-gram levels in the array
                 for (int idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; idx++) {
-                    deallocate_container<TMGramsMap, TMGramAllocator>(&m_m_gram_map_ptrs[idx], &m_m_gram_alloc_ptrs[idx]);
+                    delete m_m_gram_map_ptrs[idx];
                     delete[] m_m_gram_data[idx];
                 }
 
                 //Deallocate N-Grams
-                deallocate_container<TNGramsMap, TNGramAllocator>(&m_n_gram_map_ptr, &m_n_gram_alloc_ptr);
+                delete m_n_gram_map_ptr;
             }
 
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, BasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, CountingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, HashingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, TOptBasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, TOptCountWordIndex);
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DHybridTrie, S_Word_Index_Type<__C2DHybridTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+/* 
+ * File:   C2DHybridTrieExecutor.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 6:05 PM
+ */
+#include "Executor.hpp"
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+            namespace __Executor {
+
+                //Make sure that the trie builder, queries and executor templates are instantiated for all the supported levels of this trie
+                INSTANTIATE_TRIE_EXECUTOR(TrieTypesEnum::C2DH_TRIE);
+            }
+        }
+    }
+}
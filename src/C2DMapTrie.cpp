@@ -63,6 +63,10 @@ namespace uva {
                 //Perform an error check! This container has bounds on the supported trie level
                 ASSERT_CONDITION_THROW((MAX_LEVEL < M_GRAM_LEVEL_2), string("The minimum supported trie level is") + std::to_string(M_GRAM_LEVEL_2));
                 ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
+
+                //Clear the M-Gram and N-Gram map pointers
+                memset(m_m_gram_map_ptrs, 0, (MAX_LEVEL - BASE::MGRAM_IDX_OFFSET) * sizeof (TMGramsMap *));
+                m_n_gram_map_ptr = NULL;
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -90,7 +94,7 @@ namespace uva {
                     const uint numEntries = counts[idx];
 
                     //Reserve the memory for the map
-                    reserve_mem_unordered_map<TMGramsMap, TMGramAllocator>(&m_m_gram_map_ptrs[idx - 1], &m_m_gram_alloc_ptrs[idx - 1], numEntries, "M-Grams", m_mgram_mem_factor);
+                    m_m_gram_map_ptrs[idx - 1] = new TMGramsMap(numEntries, m_mgram_mem_factor);
                 }
             }
 
@@ -101,7 +105,7 @@ namespace uva {
                 const size_t numEntries = counts[MAX_LEVEL - 1];
 
                 //Reserve the memory for the map
-                reserve_mem_unordered_map<TNGramsMap, TNGramAllocator>(&m_n_gram_map_ptr, &m_n_gram_alloc_ptr, numEntries, "N-Grams", m_ngram_mem_factor);
+                m_n_gram_map_ptr = new TNGramsMap(numEntries, m_ngram_mem_factor);
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -136,19 +140,15 @@ namespace uva {
 
                 //Deallocate M-Grams there are N-2 M-gram levels in the array
                 for (int idx = 0; idx < (MAX_LEVEL - 2); idx++) {
-                    deallocate_container<TMGramsMap, TMGramAllocator>(&m_m_gram_map_ptrs[idx], &m_m_gram_alloc_ptrs[idx]);
+                    delete m_m_gram_map_ptrs[idx];
                 }
 
                 //Deallocate N-Grams
-                deallocate_container<TNGramsMap, TNGramAllocator>(&m_n_gram_map_ptr, &m_n_gram_alloc_ptr);
+                delete m_n_gram_map_ptr;
             }
 
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, BasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, CountingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, HashingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, TOptBasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, TOptCountWordIndex);
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2DMapTrie, S_Word_Index_Type<__C2DMapTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
\ No newline at end of file
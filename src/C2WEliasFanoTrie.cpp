@@ -0,0 +1,111 @@
+/*
+ * File:   C2WEliasFanoTrie.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 4:40 PM
+ */
+
+#include "C2WEliasFanoTrie.hpp"
+
+#include <inttypes.h>       // std::uint32_t
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+
+#include "BasicWordIndex.hpp"
+#include "CountingWordIndex.hpp"
+#include "OptimizingWordIndex.hpp"
+
+using namespace uva::smt::tries::dictionary;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>::C2WEliasFanoTrie(WordIndexType & word_index)
+            : LayeredTrieBase<C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __C2WEliasFanoTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
+            m_1_gram_data(NULL), m_one_gram_arr_size(0), m_n_gram_probs(NULL), m_n_gram_entries(NULL) {
+                //Perform an error check! This container has bounds on the supported trie level
+                ASSERT_CONDITION_THROW((MAX_LEVEL < M_GRAM_LEVEL_2), string("The minimum supported trie level is") + std::to_string(M_GRAM_LEVEL_2));
+                ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
+
+                //Clear the level arrays and counters
+                memset(m_num_ctx_ids, 0, BASE::NUM_M_N_GRAM_LEVELS * sizeof (uint64_t));
+                memset(m_ctx_begin_idx, 0, BASE::NUM_M_N_GRAM_LEVELS * sizeof (EliasFanoSequence *));
+                memset(m_word_ids, 0, BASE::NUM_M_N_GRAM_LEVELS * sizeof (EliasFanoSequence *));
+                memset(m_m_gram_payloads, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (T_M_Gram_Payload *));
+                memset(m_max_m_n_grams, 0, BASE::NUM_M_N_GRAM_LEVELS * sizeof (uint64_t));
+                memset(m_num_m_n_grams, 0, BASE::NUM_M_N_GRAM_LEVELS * sizeof (uint64_t));
+                memset(m_m_gram_entries, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (TCtxWordPBEntry *));
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            void C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>::pre_allocate(const size_t counts[MAX_LEVEL]) {
+                //01) Pre-allocate the word index super class call
+                BASE::pre_allocate(counts);
+
+                //02) Pre-allocate the 1-Gram data, see C2WArrayTrie
+                m_one_gram_arr_size = BASE::get_word_index().get_number_of_words(counts[0]);
+                m_1_gram_data = new T_M_Gram_Payload[m_one_gram_arr_size];
+                memset(m_1_gram_data, 0, m_one_gram_arr_size * sizeof (T_M_Gram_Payload));
+
+                //03) Insert the unknown word data into the allocated array
+                T_M_Gram_Payload & pbData = m_1_gram_data[WordIndexType::UNKNOWN_WORD_ID];
+                pbData.m_prob = UNK_WORD_LOG_PROB_WEIGHT;
+                pbData.m_back = ZERO_BACK_OFF_WEIGHT;
+
+                //04) Store the number of contexts and m-grams per level, the 2-gram contexts
+                //are the word ids, the other contexts are the previous level m-gram indexes
+                //shifted by one, as the zero context id is reserved for the UNDEFINED_ARR_IDX
+                for (TModelLevel i = 0; i < BASE::NUM_M_N_GRAM_LEVELS; i++) {
+                    m_num_ctx_ids[i] = (i == 0) ? m_one_gram_arr_size : (counts[i] + BASE::FIRST_VALID_CTX_ID);
+                    m_max_m_n_grams[i] = counts[i + 1];
+                }
+
+                //05) Allocate the read buffers for the M-grams and N-grams
+                for (TModelLevel i = 0; i < BASE::NUM_M_GRAM_LEVELS; i++) {
+                    m_m_gram_entries[i] = new TCtxWordPBEntry[m_max_m_n_grams[i]];
+                }
+                m_n_gram_entries = new TCtxWordProbEntry[m_max_m_n_grams[BASE::N_GRAM_IDX_IN_M_N_ARR]];
+            }
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            C2WEliasFanoTrie<MAX_LEVEL, WordIndexType>::~C2WEliasFanoTrie() {
+                delete[] m_1_gram_data;
+                for (TModelLevel i = 0; i < BASE::NUM_M_N_GRAM_LEVELS; i++) {
+                    delete m_ctx_begin_idx[i];
+                    delete m_word_ids[i];
+                }
+                for (TModelLevel i = 0; i < BASE::NUM_M_GRAM_LEVELS; i++) {
+                    delete[] m_m_gram_payloads[i];
+                    delete[] m_m_gram_entries[i];
+                }
+                delete[] m_n_gram_probs;
+                delete[] m_n_gram_entries;
+            }
+
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(C2WEliasFanoTrie, S_Word_Index_Type<__C2WEliasFanoTrie::WORD_INDEX_TYPE>::type);
+        }
+    }
+}
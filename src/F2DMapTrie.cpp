@@ -0,0 +1,90 @@
+/*
+ * File:   F2DMapTrie.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 19, 2026, 2:30 PM
+ */
+
+#include "F2DMapTrie.hpp"
+
+#include <inttypes.h>   // std::uint32_t
+
+#include "Globals.hpp"
+#include "Logger.hpp"
+#include "Exceptions.hpp"
+
+#include "BasicWordIndex.hpp"
+#include "CountingWordIndex.hpp"
+#include "OptimizingWordIndex.hpp"
+
+using namespace uva::smt::tries::dictionary;
+using namespace uva::smt::tries::__F2DMapTrie;
+
+namespace uva {
+    namespace smt {
+        namespace tries {
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            F2DMapTrie<MAX_LEVEL, WordIndexType>::F2DMapTrie(WordIndexType & word_index)
+            : GenericTrieBase<F2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __F2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
+            m_n_gram_data(NULL) {
+                //Perform an error check! This container has bounds on the supported trie level
+                ASSERT_CONDITION_THROW((MAX_LEVEL > MAX_SUPP_GRAM_LEVEL), string("The maximum supported trie level is") + std::to_string(MAX_SUPP_GRAM_LEVEL));
+                ASSERT_CONDITION_THROW((word_index.is_word_index_continuous()), "This trie can not be used with a continuous word index!");
+
+                //Clear the M-Gram bucket arrays
+                memset(m_m_gram_data, 0, NUM_M_GRAM_LEVELS * sizeof (TProbBackMap*));
+            };
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            void F2DMapTrie<MAX_LEVEL, WordIndexType>::pre_allocate(const size_t counts[MAX_LEVEL]) {
+                //Call the base-class
+                BASE::pre_allocate(counts);
+
+                //Default initialize the unknown word payload data
+                m_unk_word_payload.m_prob = UNK_WORD_LOG_PROB_WEIGHT;
+                m_unk_word_payload.m_back = ZERO_BACK_OFF_WEIGHT;
+
+                //Initialize the m-gram maps
+                for (TModelLevel idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                    m_m_gram_data[idx] = new TProbBackMap(__F2DMapTrie::BUCKETS_FACTOR, counts[idx]);
+                    log_level_info(idx + LEVEL_IDX_OFFSET, m_m_gram_data[idx]);
+                }
+
+                //Initialize the n-gram's map
+                m_n_gram_data = new TProbMap(__F2DMapTrie::BUCKETS_FACTOR, counts[MAX_LEVEL - 1]);
+                log_level_info(MAX_LEVEL, m_n_gram_data);
+            };
+
+            template<TModelLevel MAX_LEVEL, typename WordIndexType>
+            F2DMapTrie<MAX_LEVEL, WordIndexType>::~F2DMapTrie() {
+                //De-allocate M-Grams
+                for (TModelLevel idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                    delete m_m_gram_data[idx];
+                }
+                //De-allocate N-Grams
+                delete m_n_gram_data;
+            };
+
+            INSTANTIATE_TRIE_TEMPLATE_TYPE(F2DMapTrie, S_Word_Index_Type<__F2DMapTrie::WORD_INDEX_TYPE>::type);
+        }
+    }
+}
@@ -45,18 +45,15 @@ namespace uva {
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
             G2DMapTrie<MAX_LEVEL, WordIndexType>::G2DMapTrie(WordIndexType & word_index)
             : GenericTrieBase<G2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __G2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
-            m_1_gram_data(NULL), m_n_gram_data(NULL) {
+            m_1_gram_data(NULL) {
                 //Perform an error check! This container has bounds on the supported trie level
-                ASSERT_CONDITION_THROW((MAX_LEVEL > M_GRAM_LEVEL_6), string("The maximum supported trie level is") + std::to_string(M_GRAM_LEVEL_6));
+                ASSERT_CONDITION_THROW((MAX_LEVEL > MAX_SUPP_GRAM_LEVEL), string("The maximum supported trie level is") + std::to_string(MAX_SUPP_GRAM_LEVEL));
                 ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
 
-                //Clear the M-Gram bucket arrays
-                memset(m_m_gram_data, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (TProbBackMap*));
-
-                LOG_DEBUG << "sizeof(T_M_Gram_PB_Entry)= " << sizeof (T_M_Gram_PB_Entry) << END_LOG;
-                LOG_DEBUG << "sizeof(T_M_Gram_Prob_Entry)= " << sizeof (T_M_Gram_Prob_Entry) << END_LOG;
-                LOG_DEBUG << "sizeof(TProbBackMap)= " << sizeof (TProbBackMap) << END_LOG;
-                LOG_DEBUG << "sizeof(TProbMap)= " << sizeof (TProbMap) << END_LOG;
+                LOG_DEBUG << "sizeof(TProbBackLevel::TElemType)= " << sizeof (typename TProbBackLevel::TElemType) << END_LOG;
+                LOG_DEBUG << "sizeof(TProbLevel::TElemType)= " << sizeof (typename TProbLevel::TElemType) << END_LOG;
+                LOG_DEBUG << "sizeof(TProbBackLevel::TMap)= " << sizeof (typename TProbBackLevel::TMap) << END_LOG;
+                LOG_DEBUG << "sizeof(TProbLevel::TMap)= " << sizeof (typename TProbLevel::TMap) << END_LOG;
             };
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -74,35 +71,22 @@ namespace uva {
                 pb_data.m_prob = UNK_WORD_LOG_PROB_WEIGHT;
                 pb_data.m_back = ZERO_BACK_OFF_WEIGHT;
 
-                //Initialize the m-gram maps
+                //Initialize the m-gram levels, their maps and id arenas
                 for (TModelLevel idx = 1; idx <= BASE::NUM_M_GRAM_LEVELS; ++idx) {
-                    m_m_gram_data[idx - 1] = new TProbBackMap(__G2DMapTrie::BUCKETS_FACTOR, counts[idx]);
+                    m_m_gram_levels[idx - 1].allocate(__G2DMapTrie::BUCKETS_FACTOR, idx + 1, counts[idx], num_words - 1);
                 }
 
-                //Initialize the n-gram's map
-                m_n_gram_data = new TProbMap(__G2DMapTrie::BUCKETS_FACTOR, counts[MAX_LEVEL - 1]);
+                //Initialize the n-gram level, its map and id arena
+                m_n_gram_level.allocate(__G2DMapTrie::BUCKETS_FACTOR, MAX_LEVEL, counts[MAX_LEVEL - 1], num_words - 1);
             };
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
             G2DMapTrie<MAX_LEVEL, WordIndexType>::~G2DMapTrie() {
-                //Check that the one grams were allocated, if yes then the rest must have been either
-                if (m_1_gram_data != NULL) {
-                    //De-allocate one grams
-                    delete[] m_1_gram_data;
-                    //De-allocate m-gram maps
-                    for (TModelLevel idx = 0; idx < BASE::NUM_M_GRAM_LEVELS; idx++) {
-                        delete m_m_gram_data[idx];
-                    }
-                    //De-allocate n-grams map
-                    delete m_n_gram_data;
-                }
+                //De-allocate one grams, the m-gram levels free their own data
+                delete[] m_1_gram_data;
             };
 
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, M_GRAM_LEVEL_MAX, BasicWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, M_GRAM_LEVEL_MAX, CountingWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, M_GRAM_LEVEL_MAX, HashingWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, M_GRAM_LEVEL_MAX, TOptBasicWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, M_GRAM_LEVEL_MAX, TOptCountWordIndex);
+            INSTANTIATE_TRIE_TEMPLATE_TYPE(G2DMapTrie, S_Word_Index_Type<__G2DMapTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
\ No newline at end of file
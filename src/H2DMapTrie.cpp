@@ -47,7 +47,7 @@ namespace uva {
             : GenericTrieBase<H2DMapTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __H2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
             m_n_gram_data(NULL) {
                 //Perform an error check! This container has bounds on the supported trie level
-                ASSERT_CONDITION_THROW((MAX_LEVEL > M_GRAM_LEVEL_6), string("The maximum supported trie level is") + std::to_string(M_GRAM_LEVEL_6));
+                ASSERT_CONDITION_THROW((MAX_LEVEL > MAX_SUPP_GRAM_LEVEL), string("The maximum supported trie level is") + std::to_string(MAX_SUPP_GRAM_LEVEL));
                 ASSERT_CONDITION_THROW((word_index.is_word_index_continuous()), "This trie can not be used with a continuous word index!");
 
                 //Clear the M-Gram bucket arrays
@@ -87,11 +87,7 @@ namespace uva {
                 delete m_n_gram_data;
             };
 
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, M_GRAM_LEVEL_MAX, BasicWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, M_GRAM_LEVEL_MAX, CountingWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, M_GRAM_LEVEL_MAX, HashingWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, M_GRAM_LEVEL_MAX, TOptBasicWordIndex);
-            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, M_GRAM_LEVEL_MAX, TOptCountWordIndex);
+            INSTANTIATE_TRIE_TEMPLATE_TYPE(H2DMapTrie, S_Word_Index_Type<__H2DMapTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
\ No newline at end of file
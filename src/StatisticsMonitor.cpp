@@ -34,6 +34,7 @@
 #include <unistd.h>
 #include <sys/resource.h>
 #include <sys/times.h>
+#include <sys/time.h>
 #include <time.h>
 
 #else
@@ -215,6 +216,19 @@ namespace uva {
 
                 return -1; /* Failed. */
             }
+
+            double StatisticsMonitor::getWallTime() {
+#if defined(_WIN32)
+                return (double) GetTickCount64() / 1000.0;
+#else
+                struct timeval tv;
+                if (gettimeofday(&tv, NULL) != -1)
+                    return (double) tv.tv_sec +
+                        (double) tv.tv_usec / 1000000.0;
+
+                return -1; /* Failed. */
+#endif
+            }
         }
     }
 }
\ No newline at end of file
@@ -25,6 +25,7 @@
 #include "W2CArrayTrie.hpp"
 
 #include <inttypes.h>   // std::uint32_t
+#include <limits>       // std::numeric_limits
 
 #include "Globals.hpp"
 #include "Logger.hpp"
@@ -45,13 +46,10 @@ namespace uva {
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
             W2CArrayTrie<MAX_LEVEL, WordIndexType>::W2CArrayTrie(WordIndexType & word_index)
             : LayeredTrieBase<W2CArrayTrie<MAX_LEVEL, WordIndexType>, MAX_LEVEL, WordIndexType, __W2CArrayTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
-            m_num_word_ids(0), m_1_gram_data(NULL), m_n_gram_word_2_data(NULL) {
+            m_num_word_ids(0), m_1_gram_data(NULL) {
                 //Perform an error check! This container has bounds on the supported trie level
                 ASSERT_CONDITION_THROW((MAX_LEVEL < M_GRAM_LEVEL_2), string("The minimum supported trie level is") + std::to_string(M_GRAM_LEVEL_2));
                 ASSERT_CONDITION_THROW((!word_index.is_word_index_continuous()), "This trie can not be used with a discontinuous word index!");
-
-                //Memset the M/N grams reference and data arrays
-                memset(m_m_gram_word_2_data, 0, BASE::NUM_M_GRAM_LEVELS * sizeof (T_M_GramWordEntry *));
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
@@ -69,34 +67,23 @@ namespace uva {
                 pbData.m_prob = UNK_WORD_LOG_PROB_WEIGHT;
                 pbData.m_back = ZERO_BACK_OFF_WEIGHT;
 
-                //04) Allocate data for the M-grams
-
+                //04) Allocate the data for the M-grams
                 for (TModelLevel i = 0; i < BASE::NUM_M_GRAM_LEVELS; i++) {
-                    preAllocateWordsData<T_M_GramWordEntry>(m_m_gram_word_2_data[i], counts[i + 1], counts[0]);
+                    m_m_gram_levels[i].allocate(i + BASE::MGRAM_IDX_OFFSET, m_num_word_ids, counts[i + 1], BASE::is_presorted());
                 }
 
                 //05) Allocate the data for the N-Grams 
-                preAllocateWordsData<T_N_GramWordEntry>(m_n_gram_word_2_data, counts[MAX_LEVEL - 1], counts[0]);
+                m_n_gram_level.allocate(MAX_LEVEL, m_num_word_ids, counts[MAX_LEVEL - 1], BASE::is_presorted());
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType>
             W2CArrayTrie<MAX_LEVEL, WordIndexType>::~W2CArrayTrie() {
-                //Check that the one grams were allocated, if yes then the rest must have been either
-                if (m_1_gram_data != NULL) {
-                    delete[] m_1_gram_data;
-                    for (TModelLevel i = 0; i < BASE::NUM_M_GRAM_LEVELS; i++) {
-                        delete[] m_m_gram_word_2_data[i];
-                    }
-                    delete[] m_n_gram_word_2_data;
-                }
+                //The M/N-gram levels free their own data
+                delete[] m_1_gram_data;
             }
 
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, BasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, CountingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, HashingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, TOptBasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, TOptCountWordIndex);
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CArrayTrie, S_Word_Index_Type<__W2CArrayTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
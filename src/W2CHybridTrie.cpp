@@ -63,6 +63,12 @@ namespace uva {
 
                 //Initialize the array of counters
                 memset(next_ctx_id, 0, NUM_IDX_COUNTERS * sizeof (TShortId));
+
+                //Clear the level arrays
+                memset(m_mgram_data, 0, (MAX_LEVEL - 1) * sizeof (T_M_Gram_Payload *));
+                memset(m_mgram_mapping, 0, (MAX_LEVEL - 1) * sizeof (StorageContainer **));
+                memset(m_word_offsets, 0, (MAX_LEVEL - 1) * sizeof (TShortId *));
+                memset(m_ctx_entries, 0, (MAX_LEVEL - 1) * sizeof (T_Ctx_Entry *));
             }
 
             template<TModelLevel MAX_LEVEL, typename WordIndexType, template<TModelLevel > class StorageFactory, class StorageContainer>
@@ -105,6 +111,46 @@ namespace uva {
                 }
             }
 
+            template<TModelLevel MAX_LEVEL, typename WordIndexType, template<TModelLevel > class StorageFactory, class StorageContainer>
+            void W2CHybridTrie<MAX_LEVEL, WordIndexType, StorageFactory, StorageContainer>::freeze_level(const TModelLevel level) {
+                const TModelLevel idx = level - BASE::MGRAM_IDX_OFFSET;
+                StorageContainer ** mapping = m_mgram_mapping[idx];
+
+                //01) Compute the word offsets from the per word container sizes
+                TShortId * offsets = new TShortId[m_word_arr_size + 1];
+                offsets[0] = 0;
+                for (TShortId word_id = 0; word_id < m_word_arr_size; word_id++) {
+                    offsets[word_id + 1] = offsets[word_id] + ((mapping[word_id] != NULL) ? mapping[word_id]->size() : 0);
+                }
+
+                LOG_DEBUG << "Freezing level " << SSTR(level) << " with " << SSTR(offsets[m_word_arr_size]) << " context entries" << END_LOG;
+
+                //02) Copy the containers into the word groups, order them
+                //by the context id and delete the containers right away
+                T_Ctx_Entry * entries = new T_Ctx_Entry[offsets[m_word_arr_size]];
+                for (TShortId word_id = 0; word_id < m_word_arr_size; word_id++) {
+                    if (mapping[word_id] != NULL) {
+                        T_Ctx_Entry * entry = entries + offsets[word_id];
+                        for (typename StorageContainer::const_iterator iter = mapping[word_id]->begin();
+                                iter != mapping[word_id]->end(); ++iter, ++entry) {
+                            entry->id = iter->first;
+                            entry->data = iter->second;
+                        }
+                        sort(entries + offsets[word_id], entries + offsets[word_id + 1]);
+
+                        delete mapping[word_id];
+                    }
+                }
+                delete[] mapping;
+                m_mgram_mapping[idx] = NULL;
+
+                //03) The containers' memory of this level can now be released
+                m_storage_factory->release(level);
+
+                m_word_offsets[idx] = offsets;
+                m_ctx_entries[idx] = entries;
+            }
+
             template<TModelLevel MAX_LEVEL, typename WordIndexType, template<TModelLevel > class StorageFactory, class StorageContainer>
             W2CHybridTrie<MAX_LEVEL, WordIndexType, StorageFactory, StorageContainer>::~W2CHybridTrie() {
                 //Delete the probability and back-off data
@@ -126,18 +172,17 @@ namespace uva {
                         }
                         delete[] m_mgram_mapping[idx];
                     }
+                    //Delete the frozen data
+                    delete[] m_word_offsets[idx];
+                    delete[] m_ctx_entries[idx];
                 }
                 if (m_storage_factory != NULL) {
                     delete m_storage_factory;
                 }
             }
 
-            //Make sure that there will be templates instantiated, at least for the given parameter values
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, BasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, CountingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, HashingWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, TOptBasicWordIndex);
-            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, TOptCountWordIndex);
+            //Make sure that there will be templates instantiated for all the supported levels and the configured word index
+            INSTANTIATE_LAYERED_TRIE_TEMPLATES_NAME_TYPE(W2CHybridTrie, S_Word_Index_Type<__W2CHybridTrie::WORD_INDEX_TYPE>::type);
         }
     }
 }
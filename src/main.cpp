@@ -44,6 +44,8 @@
 #include "MemoryMappedFileReader.hpp"
 #include "FileStreamReader.hpp"
 #include "CStyleFileReader.hpp"
+#include "AsyncFileReader.hpp"
+#include "CompressedFileReader.hpp"
 
 #include "Executor.hpp"
 
@@ -87,7 +89,20 @@ static ValueArg<string> * p_query_arg = NULL;
 static vector<string> trie_types;
 static ValuesConstraint<string> * p_trie_types_constr = NULL;
 static ValueArg<string> * p_trie_type_arg = NULL;
+static vector<string> file_reader_types;
+static ValuesConstraint<string> * p_file_reader_types_constr = NULL;
+static ValueArg<string> * p_model_reader_arg = NULL;
+static ValueArg<string> * p_query_reader_arg = NULL;
 static SwitchArg * p_cumulative_prob_arg = NULL;
+static SwitchArg * p_presorted_arg = NULL;
+static SwitchArg * p_parallel_build_arg = NULL;
+static ValueArg<uint32_t> * p_build_mem_limit_arg = NULL;
+static ValueArg<string> * p_output_arg = NULL;
+static vector<string> output_formats;
+static ValuesConstraint<string> * p_output_formats_constr = NULL;
+static ValueArg<string> * p_output_format_arg = NULL;
+static ValueArg<string> * p_memory_breakdown_arg = NULL;
+static SwitchArg * p_perf_counters_arg = NULL;
 static vector<string> debug_levels;
 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
 static ValueArg<string> * p_debug_level_arg = NULL;
@@ -110,9 +125,38 @@ void create_arguments_parser() {
     p_trie_types_constr = new ValuesConstraint<string>(trie_types);
     p_trie_type_arg = new ValueArg<string>("t", "trie", "The trie type to be used", false, __Executor::get_default_trie_type_str(), p_trie_types_constr, *p_cmd_args);
 
+    //Add the --model-reader and --query-reader the file reader type parameters - optional
+    __Executor::get_file_reader_types_str(&file_reader_types);
+    p_file_reader_types_constr = new ValuesConstraint<string>(file_reader_types);
+    p_model_reader_arg = new ValueArg<string>("", "model-reader", "The file reader type to be used for the model file", false, __Executor::get_default_model_reader_str(), p_file_reader_types_constr, *p_cmd_args);
+    p_query_reader_arg = new ValueArg<string>("", "query-reader", "The file reader type to be used for the query file", false, __Executor::get_default_query_reader_str(), p_file_reader_types_constr, *p_cmd_args);
+
     //Add the -c the "cumulative" probability switch - optional, default is cumulative
     p_cumulative_prob_arg = new SwitchArg("c", "cumulative", "Compute the sum of cumulative log probabilities for each query m-gram", *p_cmd_args, false);
 
+    //Add the --presorted the "pre-sorted model" switch - optional, default is not pre-sorted
+    p_presorted_arg = new SwitchArg("", "presorted", "The m-grams of every model section are sorted by their word ids in the layout order of the trie: by the context and then the last word for c2wa, by the last word and then the context for w2ca. The order is verified while loading and the sorted sections are not sorted again", *p_cmd_args, false);
+
+    //Add the --parallel-build the "parallel levels" switch - optional, default is sequential
+    p_parallel_build_arg = new SwitchArg("", "parallel-build", "Read the 2-grams to N-grams model sections in parallel, one thread per level, for g2dm, h2dm and f2dm with an mmap model reader", *p_cmd_args, false);
+
+    //Add the --build-mem-limit the trie build memory limit parameter - optional, default is unlimited
+    p_build_mem_limit_arg = new ValueArg<uint32_t>("", "build-mem-limit", "The memory limit in Mb for sorting the m-grams when building the c2wa trie and the a2dh array levels, the levels exceeding it are sorted on the disk, the build then takes about this much memory on top of the trie, 0 means no limit", false, 0, "memory limit in Mb", *p_cmd_args);
+
+    //Add the -o the query result output file parameter - optional, default is the standard output
+    p_output_arg = new ValueArg<string>("o", "output", "The file to write the query results into, by default the standard output is used", false, "", "output file name", *p_cmd_args);
+
+    //Add the --output-format the query result output format parameter - optional, default is log
+    __Executor::get_output_formats_str(&output_formats);
+    p_output_formats_constr = new ValuesConstraint<string>(output_formats);
+    p_output_format_arg = new ValueArg<string>("", "output-format", "The query result output format: the logger's RESULT lines, tab separated values with the shortest round-trip probabilities, binary float probabilities or no output for benchmarking", false, __Executor::get_default_output_format_str(), p_output_formats_constr, *p_cmd_args);
+
+    //Add the --perf-counters the hardware performance counters switch - optional, default is false
+    p_perf_counters_arg = new SwitchArg("", "perf-counters", "Report the cycles, instructions, LLC, dTLB and branch misses of the build phases and the queries, only the times are reported if the hardware performance counters are not available", *p_cmd_args, false);
+
+    //Add the --memory-breakdown the trie memory breakdown file parameter - optional, default is no breakdown
+    p_memory_breakdown_arg = new ValueArg<string>("", "memory-breakdown", "Log the exact trie memory usage per structure, component and m-gram level after the trie is built and write it as JSON into the given file", false, "", "JSON file name", *p_cmd_args);
+
     //Add the -d the debug level parameter - optional, default is e.g. RESULT
     Logger::get_reporting_levels(&debug_levels);
     p_debug_levels_constr = new ValuesConstraint<string>(debug_levels);
@@ -135,7 +179,20 @@ void destroy_arguments_parser() {
     SAFE_DESTROY(p_trie_types_constr);
     SAFE_DESTROY(p_trie_type_arg);
 
+    SAFE_DESTROY(p_file_reader_types_constr);
+    SAFE_DESTROY(p_model_reader_arg);
+    SAFE_DESTROY(p_query_reader_arg);
+
     SAFE_DESTROY(p_cumulative_prob_arg);
+    SAFE_DESTROY(p_presorted_arg);
+    SAFE_DESTROY(p_parallel_build_arg);
+    SAFE_DESTROY(p_build_mem_limit_arg);
+
+    SAFE_DESTROY(p_output_arg);
+    SAFE_DESTROY(p_output_formats_constr);
+    SAFE_DESTROY(p_output_format_arg);
+    SAFE_DESTROY(p_memory_breakdown_arg);
+    SAFE_DESTROY(p_perf_counters_arg);
 
     SAFE_DESTROY(p_debug_levels_constr);
     SAFE_DESTROY(p_debug_level_arg);
@@ -161,9 +218,18 @@ static void extract_arguments(const uint argc, char const * const * const argv,
 
     //Store the parsed parameter values
     params.is_cumulative_prob = p_cumulative_prob_arg->getValue();
+    params.m_is_presorted = p_presorted_arg->getValue();
+    params.m_is_parallel_build = p_parallel_build_arg->getValue();
+    params.m_build_mem_limit_mb = p_build_mem_limit_arg->getValue();
     params.m_model_file_name = p_model_arg->getValue();
     params.m_queries_file_name = p_query_arg->getValue();
     params.m_trie_type_name = p_trie_type_arg->getValue();
+    params.m_model_reader_name = p_model_reader_arg->getValue();
+    params.m_query_reader_name = p_query_reader_arg->getValue();
+    params.m_output_file_name = p_output_arg->getValue();
+    params.m_output_format_name = p_output_format_arg->getValue();
+    params.m_memory_breakdown_file_name = p_memory_breakdown_arg->getValue();
+    params.m_is_perf_counters = p_perf_counters_arg->getValue();
 
     //Set the logging level right away
     Logger::set_reporting_level(p_debug_level_arg->getValue());
@@ -0,0 +1,37 @@
+#!/bin/sh
+
+NUM_PARAMS=3
+if [ "$#" -lt ${NUM_PARAMS} ]; then
+   echo "Illegal number of parameters: $# expected ${NUM_PARAMS}"
+   echo "1 - the platform: {Linux, MaxOs, Centos}"
+   echo "2 - the model to load"
+   echo "3 - the query input file to use, e.g. a small one"
+   echo "4 - [optional] the number of runs per trie type, default is 5"
+   echo "5 - [optional] the parameter that goes straight to the tool, e.g. --model-reader=mmap"
+   exit 1
+fi
+
+NUM_RUNS=${4:-5}
+TRIE_TYPES="c2wa c2dm w2ca w2ch c2dh g2dm h2dm a2dh f2dm c2we"
+
+#The run outputs are kept in a temporary directory, removed on exit
+OUT_DIR=`mktemp -d`
+trap 'rm -rf "${OUT_DIR}"' EXIT
+trap 'exit 1' INT TERM
+
+echo "Model: ${2}, runs per trie: ${NUM_RUNS}"
+echo "trie CPU_min CPU_avg WALL_min WALL_avg"
+
+for TRIE in ${TRIE_TYPES}; do
+   OUT_FILE=${OUT_DIR}/bench.load.${TRIE}.out
+   RUN=0
+   while [ ${RUN} -lt ${NUM_RUNS} ]; do
+      ../dist/Release__${1}_/back-off-language-model-smt ${5} -m ${2} -q ${3} -t ${TRIE} 2>&1 | grep "Reading the Language Model" >> ${OUT_FILE}
+      RUN=`expr ${RUN} + 1`
+   done
+   CPU=`grep "CPU seconds" ${OUT_FILE} | sed -e 's/.* took \([0-9.e+-]*\) CPU seconds.*/\1/'`
+   WALL=`grep "wall-clock seconds" ${OUT_FILE} | sed -e 's/.* took \([0-9.e+-]*\) wall-clock seconds.*/\1/'`
+   CPU_STAT=`echo "${CPU}" | awk 'NF>0{if(n==0||$1<min)min=$1; sum+=$1; n++} END{if(n>0) printf "%.4f %.4f", min, sum/n; else printf "n/a n/a"}'`
+   WALL_STAT=`echo "${WALL}" | awk 'NF>0{if(n==0||$1<min)min=$1; sum+=$1; n++} END{if(n>0) printf "%.4f %.4f", min, sum/n; else printf "n/a n/a"}'`
+   echo "${TRIE} ${CPU_STAT} ${WALL_STAT}"
+done
@@ -27,6 +27,12 @@ echo "g2dm"
 eval "../dist/Release__${1}_/back-off-language-model-smt ${4} -m ${2} -q ${3} -t g2dm ${FILTER} > release.g2dm.out"
 echo "h2dm"
 eval "../dist/Release__${1}_/back-off-language-model-smt ${4} -m ${2} -q ${3} -t h2dm ${FILTER} > release.h2dm.out"
+echo "a2dh"
+eval "../dist/Release__${1}_/back-off-language-model-smt ${4} -m ${2} -q ${3} -t a2dh ${FILTER} > release.a2dh.out"
+echo "c2we"
+eval "../dist/Release__${1}_/back-off-language-model-smt ${4} -m ${2} -q ${3} -t c2we ${FILTER} > release.c2we.out"
+echo "f2dm"
+eval "../dist/Release__${1}_/back-off-language-model-smt ${4} -m ${2} -q ${3} -t f2dm ${FILTER} > release.f2dm.out"
 
 echo "----> c2wa vs. c2dm"
 diff release.c2wa.out release.c2dm.out > diff.c2wa.c2dm.out
@@ -52,6 +58,14 @@ echo "----> c2wa vs. h2dm"
 diff release.c2wa.out release.h2dm.out > diff.c2wa.h2dm.out
 cat diff.c2wa.h2dm.out | wc -l
 
+echo "----> c2wa vs. a2dh"
+diff release.c2wa.out release.a2dh.out > diff.c2wa.a2dh.out
+cat diff.c2wa.a2dh.out | wc -l
+
+echo "----> c2wa vs. c2we"
+diff release.c2wa.out release.c2we.out > diff.c2wa.c2we.out
+cat diff.c2wa.c2we.out | wc -l
+
 echo "------------------------------"
 
 echo "----> c2dm vs. c2wa"
@@ -77,3 +91,19 @@ cat diff.c2dm.g2dm.out | wc -l
 echo "----> c2dm vs. h2dm"
 diff release.c2dm.out release.h2dm.out > diff.c2dm.h2dm.out
 cat diff.c2dm.h2dm.out | wc -l
+
+echo "----> c2dm vs. a2dh"
+diff release.c2dm.out release.a2dh.out > diff.c2dm.a2dh.out
+cat diff.c2dm.a2dh.out | wc -l
+
+echo "----> c2dm vs. c2we"
+diff release.c2dm.out release.c2we.out > diff.c2dm.c2we.out
+cat diff.c2dm.c2we.out | wc -l
+
+echo "------------------------------"
+
+#The f2dm trie stores only the m-gram fingerprints, so the false positives give a few
+#different results, the number of the differing results is reported, not the failure
+echo "----> c2dm vs. f2dm (lossy, the differing results are expected)"
+diff release.c2dm.out release.f2dm.out > diff.c2dm.f2dm.out
+echo "differing RESULT lines: `grep -c "^> RESULT" diff.c2dm.f2dm.out`"